@@ -18,6 +18,25 @@
 #include "pasteboard_hilog.h"
 
 namespace OHOS::MiscServices {
+namespace {
+enum TAG_GLOBAL_EVENT : uint16_t {
+    TAG_EVENT_VERSION = TAG_BUFF + 1,
+    TAG_EVENT_FRAME_NUM,
+    TAG_EVENT_USER,
+    TAG_EVENT_SEQ_ID,
+    TAG_EVENT_STATUS,
+    TAG_EVENT_SYNC_TIME,
+    TAG_EVENT_DATA_ID,
+    TAG_EVENT_EXPIRATION,
+    TAG_EVENT_IS_DELAY,
+    TAG_EVENT_DEVICE_ID,
+    TAG_EVENT_ACCOUNT,
+    TAG_EVENT_DATA_TYPE,
+    TAG_EVENT_PASTE_ID,
+};
+constexpr uint8_t JSON_OBJECT_BEGIN = '{';
+} // namespace
+
 std::map<std::string, ClipPlugin::Factory *> ClipPlugin::factories_;
 DefaultClip g_defaultClip;
 bool ClipPlugin::RegCreator(const std::string &name, Factory *factory)
@@ -186,6 +205,123 @@ bool ClipPlugin::GlobalEvent::Unmarshal(const Serializable::json &node)
     return true;
 }
 
+bool ClipPlugin::GlobalEvent::EncodeTLV(WriteOnlyBuffer &buffer) const
+{
+    // the version tag must stay first, its big-endian head never starts with '{' so JSON and TLV can be told apart
+    bool ret = buffer.Write(TAG_EVENT_VERSION, static_cast<int8_t>(version));
+    ret = ret && buffer.Write(TAG_EVENT_FRAME_NUM, static_cast<int8_t>(frameNum));
+    ret = ret && buffer.Write(TAG_EVENT_USER, static_cast<int16_t>(user));
+    ret = ret && buffer.Write(TAG_EVENT_SEQ_ID, static_cast<int16_t>(seqId));
+    ret = ret && buffer.Write(TAG_EVENT_STATUS, static_cast<int16_t>(status));
+    ret = ret && buffer.Write(TAG_EVENT_SYNC_TIME, syncTime);
+    ret = ret && buffer.Write(TAG_EVENT_DATA_ID, dataId);
+    ret = ret && buffer.Write(TAG_EVENT_EXPIRATION, static_cast<int64_t>(expiration));
+    ret = ret && buffer.Write(TAG_EVENT_IS_DELAY, isDelay);
+    ret = ret && buffer.Write(TAG_EVENT_DEVICE_ID, deviceId);
+    ret = ret && buffer.Write(TAG_EVENT_ACCOUNT, account);
+    ret = ret && buffer.Write(TAG_EVENT_DATA_TYPE, dataType);
+    ret = ret && buffer.Write(TAG_EVENT_PASTE_ID, pasteId);
+    return ret;
+}
+
+bool ClipPlugin::GlobalEvent::DecodeTLV(ReadOnlyBuffer &buffer)
+{
+    int8_t rawVersion = 0;
+    int8_t rawFrameNum = 0;
+    int16_t rawUser = 0;
+    int16_t rawSeqId = 0;
+    int16_t rawStatus = 0;
+    int64_t rawExpiration = 0;
+    for (; buffer.IsEnough();) {
+        TLVHead head{};
+        bool ret = buffer.ReadHead(head);
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret, false, PASTEBOARD_MODULE_SERVICE, "read head failed");
+        if (head.tag == TAG_EVENT_VERSION) {
+            ret = buffer.ReadValue(rawVersion, head);
+            version = static_cast<uint8_t>(rawVersion);
+        } else if (head.tag == TAG_EVENT_FRAME_NUM) {
+            ret = buffer.ReadValue(rawFrameNum, head);
+            frameNum = static_cast<uint8_t>(rawFrameNum);
+        } else if (head.tag == TAG_EVENT_USER) {
+            ret = buffer.ReadValue(rawUser, head);
+            user = static_cast<uint16_t>(rawUser);
+        } else if (head.tag == TAG_EVENT_SEQ_ID) {
+            ret = buffer.ReadValue(rawSeqId, head);
+            seqId = static_cast<uint16_t>(rawSeqId);
+        } else if (head.tag == TAG_EVENT_STATUS) {
+            ret = buffer.ReadValue(rawStatus, head);
+            status = static_cast<uint16_t>(rawStatus);
+        } else if (head.tag == TAG_EVENT_SYNC_TIME) {
+            ret = buffer.ReadValue(syncTime, head);
+        } else if (head.tag == TAG_EVENT_DATA_ID) {
+            ret = buffer.ReadValue(dataId, head);
+        } else if (head.tag == TAG_EVENT_EXPIRATION) {
+            ret = buffer.ReadValue(rawExpiration, head);
+            expiration = static_cast<uint64_t>(rawExpiration);
+        } else if (head.tag == TAG_EVENT_IS_DELAY) {
+            ret = buffer.ReadValue(isDelay, head);
+        } else if (head.tag == TAG_EVENT_DEVICE_ID) {
+            ret = buffer.ReadValue(deviceId, head);
+        } else if (head.tag == TAG_EVENT_ACCOUNT) {
+            ret = buffer.ReadValue(account, head);
+        } else if (head.tag == TAG_EVENT_DATA_TYPE) {
+            dataType.clear();
+            ret = buffer.ReadValue(dataType, head);
+        } else if (head.tag == TAG_EVENT_PASTE_ID) {
+            ret = buffer.ReadValue(pasteId, head);
+        } else {
+            ret = buffer.Skip(head.len);
+        }
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret, false, PASTEBOARD_MODULE_SERVICE,
+            "read value failed, tag=%{public}hu, len=%{public}u", head.tag, head.len);
+    }
+    return true;
+}
+
+size_t ClipPlugin::GlobalEvent::CountTLV() const
+{
+    size_t expectSize = 0;
+    expectSize += TLVCountable::Count(static_cast<int8_t>(version));
+    expectSize += TLVCountable::Count(static_cast<int8_t>(frameNum));
+    expectSize += TLVCountable::Count(static_cast<int16_t>(user));
+    expectSize += TLVCountable::Count(static_cast<int16_t>(seqId));
+    expectSize += TLVCountable::Count(static_cast<int16_t>(status));
+    expectSize += TLVCountable::Count(syncTime);
+    expectSize += TLVCountable::Count(dataId);
+    expectSize += TLVCountable::Count(static_cast<int64_t>(expiration));
+    expectSize += TLVCountable::Count(isDelay);
+    expectSize += TLVCountable::Count(deviceId);
+    expectSize += TLVCountable::Count(account);
+    expectSize += TLVCountable::Count(dataType);
+    expectSize += TLVCountable::Count(pasteId);
+    return expectSize;
+}
+
+bool ClipPlugin::GlobalEvent::Serialize(std::vector<uint8_t> &buffer) const
+{
+    if (version >= TLV_VERSION) {
+        return Encode(buffer);
+    }
+    std::string jsonStr = Marshall();
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(!jsonStr.empty(), false, PASTEBOARD_MODULE_SERVICE, "marshall event failed");
+    buffer.assign(jsonStr.begin(), jsonStr.end());
+    return true;
+}
+
+bool ClipPlugin::GlobalEvent::Deserialize(const std::vector<uint8_t> &buffer)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(!buffer.empty(), false, PASTEBOARD_MODULE_SERVICE, "event buffer is empty");
+    if (IsJsonFormat(buffer)) {
+        return Unmarshall(std::string(buffer.begin(), buffer.end()));
+    }
+    return Decode(buffer);
+}
+
+bool ClipPlugin::GlobalEvent::IsJsonFormat(const std::vector<uint8_t> &buffer)
+{
+    return !buffer.empty() && buffer.front() == JSON_OBJECT_BEGIN;
+}
+
 void ClipPlugin::ChangeStoreStatus(int32_t userId)
 {
     (void)userId;
@@ -65,11 +65,11 @@ void DevProfile::PostDelayReleaseProxy()
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "post delay task end");
 }
 
-void DevProfile::PutDeviceStatus(bool status)
+bool DevProfile::PutDeviceStatus(bool status)
 {
     std::string networkId = DMAdapter::GetInstance().GetLocalNetworkId();
     std::string udid = DMAdapter::GetInstance().GetUdidByNetworkId(networkId);
-    PASTEBOARD_CHECK_AND_RETURN_LOGE(!udid.empty(), PASTEBOARD_MODULE_SERVICE,
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(!udid.empty(), false, PASTEBOARD_MODULE_SERVICE,
         "get udid failed, netId=%{public}.5s", networkId.c_str());
 
     UpdateEnabledStatus(udid, status);
@@ -82,12 +82,13 @@ void DevProfile::PutDeviceStatus(bool status)
         proxy_ = std::make_shared<DeviceProfileProxy>();
     }
     auto adapter = proxy_->GetAdapter();
-    PASTEBOARD_CHECK_AND_RETURN_LOGE(adapter != nullptr, PASTEBOARD_MODULE_SERVICE, "adapter is null");
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(adapter != nullptr, false, PASTEBOARD_MODULE_SERVICE, "adapter is null");
     int32_t ret = adapter->PutDeviceStatus(udid, status);
-    PASTEBOARD_CHECK_AND_RETURN_LOGE(ret == static_cast<int32_t>(PasteboardError::E_OK), PASTEBOARD_MODULE_SERVICE,
-        "put dp status failed, ret=%{public}d", ret);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == static_cast<int32_t>(PasteboardError::E_OK), false,
+        PASTEBOARD_MODULE_SERVICE, "put dp status failed, ret=%{public}d", ret);
 
     Notify(status);
+    return true;
 }
 
 int32_t DevProfile::GetDeviceStatus(const std::string &networkId, bool &status)
@@ -13,6 +13,8 @@
  * limitations under the License.
  */
 
+#include <chrono>
+#include <cinttypes>
 #include <thread>
 
 #include "device/dm_adapter.h"
@@ -24,6 +26,12 @@ namespace OHOS::MiscServices {
 constexpr size_t DMAdapter::MAX_ID_LEN;
 constexpr const char *PKG_NAME = "pasteboard_service";
 
+static int64_t GetSteadyTimeMs()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+}
+
 DmStateObserver::DmStateObserver(const std::function<void(const DmDeviceInfo &)> online,
     const std::function<void(const DmDeviceInfo &)> onReady, const std::function<void(const DmDeviceInfo &)> offline)
     : online_(std::move(online)), onReady_(std::move(onReady)), offline_(std::move(offline))
@@ -91,10 +99,7 @@ void DmDeath::OnRemoteDied()
 
 DMAdapter::DMAdapter() {}
 
-DMAdapter::~DMAdapter()
-{
-    devices_.clear();
-}
+DMAdapter::~DMAdapter() {}
 
 DMAdapter &DMAdapter::GetInstance()
 {
@@ -107,21 +112,22 @@ bool DMAdapter::Initialize(const std::string &pkgName)
 #ifdef PB_DEVICE_MANAGER_ENABLE
     auto stateObserver = std::make_shared<DmStateObserver>(
         [this](const DmDeviceInfo &deviceInfo) {
+            SetDevices();
             observers_.ForEachCopies([&deviceInfo](auto &key, auto &value) {
-                DMAdapter::GetInstance().SetDevices();
                 value->Online(deviceInfo.networkId);
                 return false;
             });
         },
         [this](const DmDeviceInfo &deviceInfo) {
+            SetDevices();
             observers_.ForEachCopies([&deviceInfo](auto &key, auto &value) {
                 value->OnReady(deviceInfo.networkId);
                 return false;
             });
         },
         [this](const DmDeviceInfo &deviceInfo) {
+            SetDevices();
             observers_.ForEachCopies([&deviceInfo](auto &key, auto &value) {
-                DMAdapter::GetInstance().SetDevices();
                 value->Offline(deviceInfo.networkId);
                 return false;
             });
@@ -165,12 +171,13 @@ const std::string &DMAdapter::GetLocalDeviceUdid()
 std::string DMAdapter::GetDeviceName(const std::string &networkId)
 {
 #ifdef PB_DEVICE_MANAGER_ENABLE
-    auto devices = GetDevices();
-    for (auto &device : devices) {
-        if (device.networkId == networkId) {
-            return device.deviceName;
-        }
+    auto topology = LoadTopology();
+    auto it = topology->indexes.find(networkId);
+    if (it != topology->indexes.end()) {
+        cacheHits_.fetch_add(1, std::memory_order_relaxed);
+        return topology->devices[it->second].deviceName;
     }
+    cacheMisses_.fetch_add(1, std::memory_order_relaxed);
 #endif
     return DEVICE_INVALID_NAME;
 }
@@ -178,6 +185,12 @@ std::string DMAdapter::GetDeviceName(const std::string &networkId)
 const std::string DMAdapter::GetLocalNetworkId()
 {
 #ifdef PB_DEVICE_MANAGER_ENABLE
+    auto topology = LoadTopology();
+    if (!topology->localNetworkId.empty()) {
+        cacheHits_.fetch_add(1, std::memory_order_relaxed);
+        return topology->localNetworkId;
+    }
+    cacheMisses_.fetch_add(1, std::memory_order_relaxed);
     DmDeviceInfo info;
     int32_t ret = DeviceManager::GetInstance().GetLocalDeviceInfo(pkgName_, info);
     auto networkId = std::string(info.networkId);
@@ -192,13 +205,14 @@ const std::string DMAdapter::GetLocalNetworkId()
 int32_t DMAdapter::GetRemoteDeviceInfo(const std::string &networkId, DmDeviceInfo &remoteDevice)
 {
 #ifdef PB_DEVICE_MANAGER_ENABLE
-    auto devices = GetDevices();
-    for (auto &device : devices) {
-        if (device.networkId == networkId) {
-            remoteDevice = device;
-            return static_cast<int32_t>(PasteboardError::E_OK);
-        }
+    auto topology = LoadTopology();
+    auto it = topology->indexes.find(networkId);
+    if (it != topology->indexes.end()) {
+        cacheHits_.fetch_add(1, std::memory_order_relaxed);
+        remoteDevice = topology->devices[it->second];
+        return static_cast<int32_t>(PasteboardError::E_OK);
     }
+    cacheMisses_.fetch_add(1, std::memory_order_relaxed);
 #endif
     return static_cast<int32_t>(PasteboardError::NO_TRUST_DEVICE_ERROR);
 }
@@ -206,6 +220,13 @@ int32_t DMAdapter::GetRemoteDeviceInfo(const std::string &networkId, DmDeviceInf
 std::string DMAdapter::GetUdidByNetworkId(const std::string &networkId)
 {
 #ifdef PB_DEVICE_MANAGER_ENABLE
+    auto topology = LoadTopology();
+    auto it = topology->udids.find(networkId);
+    if (it != topology->udids.end()) {
+        cacheHits_.fetch_add(1, std::memory_order_relaxed);
+        return it->second;
+    }
+    cacheMisses_.fetch_add(1, std::memory_order_relaxed);
     std::string udid;
     int32_t ret = DeviceManager::GetInstance().GetUdidByNetworkId(pkgName_, networkId, udid);
     if (ret == 0 && !udid.empty()) {
@@ -225,17 +246,36 @@ void DMAdapter::Unregister(DMObserver *observer)
     observers_.Erase(observer);
 }
 
+DMAdapter::CacheStats DMAdapter::GetCacheStats() const
+{
+    CacheStats stats;
+#ifdef PB_DEVICE_MANAGER_ENABLE
+    stats.hits = cacheHits_.load(std::memory_order_relaxed);
+    stats.misses = cacheMisses_.load(std::memory_order_relaxed);
+    auto topology = LoadTopology();
+    stats.version = topology->version;
+    stats.deviceCount = topology->devices.size();
+    if (topology->version != 0) {
+        stats.ageMs = GetSteadyTimeMs() - topology->refreshTime;
+    }
+#endif
+    return stats;
+}
+
 std::vector<std::string> DMAdapter::GetNetworkIds()
 {
 #ifdef PB_DEVICE_MANAGER_ENABLE
-    auto devices = GetDevices();
-    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "devicesNums = %{public}zu.", devices.size());
-    if (devices.empty()) {
+    auto topology = LoadTopology();
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "devicesNums = %{public}zu.", topology->devices.size());
+    if (topology->devices.empty()) {
+        cacheMisses_.fetch_add(1, std::memory_order_relaxed);
         PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "no device online!");
         return {};
     }
+    cacheHits_.fetch_add(1, std::memory_order_relaxed);
     std::vector<std::string> networkIds;
-    for (auto &item : devices) {
+    networkIds.reserve(topology->devices.size());
+    for (auto &item : topology->devices) {
         networkIds.emplace_back(item.networkId);
     }
     return networkIds;
@@ -266,37 +306,83 @@ int32_t DMAdapter::GetLocalDeviceType()
 bool DMAdapter::IsSameAccount(const std::string &networkId)
 {
 #ifdef PB_DEVICE_MANAGER_ENABLE
-    auto devices = GetDevices();
-    for (auto &device : devices) {
-        if (device.networkId == networkId) {
-            return device.authForm == IDENTICAL_ACCOUNT;
-        }
+    auto topology = LoadTopology();
+    auto it = topology->indexes.find(networkId);
+    if (it != topology->indexes.end()) {
+        cacheHits_.fetch_add(1, std::memory_order_relaxed);
+        return topology->devices[it->second].authForm == IDENTICAL_ACCOUNT;
     }
+    cacheMisses_.fetch_add(1, std::memory_order_relaxed);
 #endif
     return false;
 }
 
 void DMAdapter::SetDevices()
 {
+    // the device state callbacks run on their own threads, a query and its publish are not interleaved with another
+    // refresh so an older device list never replaces a newer one
+    std::lock_guard<std::mutex> lock(topologyMutex_);
+    auto &deviceManager = DeviceManager::GetInstance();
     std::vector<DmDeviceInfo> devices;
-    int32_t ret = DeviceManager::GetInstance().GetTrustedDeviceList(PKG_NAME, "", devices);
+    int32_t ret = deviceManager.GetTrustedDeviceList(PKG_NAME, "", devices);
     if (ret != 0) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Get device list failed, errCode: %{public}d", ret);
         return;
     }
-    std::vector<DmDeviceInfo> networkIds;
+    auto topology = std::make_shared<Topology>();
     for (auto &item : devices) {
-        if (DeviceManager::GetInstance().IsSameAccount(item.networkId)) {
-            networkIds.emplace_back(item);
+        if (deviceManager.IsSameAccount(item.networkId)) {
+            topology->devices.emplace_back(item);
+        }
+    }
+    // resolve ids once per topology change, lookups on the copy and paste paths are then served from memory
+    for (auto &item : topology->devices) {
+        std::string udid;
+        ret = deviceManager.GetUdidByNetworkId(pkgName_, item.networkId, udid);
+        if (ret == 0 && !udid.empty()) {
+            topology->udids.emplace(item.networkId, std::move(udid));
+        }
+    }
+    DmDeviceInfo info;
+    ret = deviceManager.GetLocalDeviceInfo(pkgName_, info);
+    std::string localNetworkId = info.networkId;
+    if (ret == 0 && !localNetworkId.empty()) {
+        topology->localNetworkId = localNetworkId;
+        std::string udid;
+        ret = deviceManager.GetUdidByNetworkId(pkgName_, localNetworkId, udid);
+        if (ret == 0 && !udid.empty()) {
+            topology->udids.emplace(localNetworkId, std::move(udid));
         }
     }
-    std::unique_lock<std::shared_mutex> lock(dmMutex_);
-    devices_ = std::move(networkIds);
+    StoreTopology(std::move(topology));
 }
 
 std::vector<DmDeviceInfo> DMAdapter::GetDevices()
 {
-    std::shared_lock<std::shared_mutex> lock(dmMutex_);
-    return devices_;
+    return LoadTopology()->devices;
+}
+
+std::shared_ptr<const DMAdapter::Topology> DMAdapter::LoadTopology() const
+{
+    return std::atomic_load(&topology_);
+}
+
+void DMAdapter::PublishTopology(std::shared_ptr<Topology> topology)
+{
+    std::lock_guard<std::mutex> lock(topologyMutex_);
+    StoreTopology(std::move(topology));
+}
+
+void DMAdapter::StoreTopology(std::shared_ptr<Topology> topology)
+{
+    topology->version = LoadTopology()->version + 1;
+    topology->refreshTime = GetSteadyTimeMs();
+    topology->indexes.clear();
+    for (size_t i = 0; i < topology->devices.size(); ++i) {
+        topology->indexes.emplace(topology->devices[i].networkId, i);
+    }
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "topology version:%{public}" PRIu64 ", devices:%{public}zu",
+        topology->version, topology->devices.size());
+    std::atomic_store(&topology_, std::shared_ptr<const Topology>(std::move(topology)));
 }
 } // namespace OHOS::MiscServices
\ No newline at end of file
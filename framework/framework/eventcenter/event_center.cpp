@@ -14,11 +14,26 @@
  */
 
 #include "eventcenter/event_center.h"
+
+#include <algorithm>
+#include <chrono>
+
 #include "pasteboard_hilog.h"
 
 namespace OHOS::MiscServices {
+namespace {
+template <typename T>
+void UpdateMax(std::atomic<T> &max, T value)
+{
+    T current = max.load(std::memory_order_relaxed);
+    while (current < value && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+} // namespace
+
 thread_local EventCenter::AsyncQueue *EventCenter::asyncQueue_ = nullptr;
 constexpr int32_t EventCenter::AsyncQueue::MAX_CAPABILITY;
+constexpr int32_t EventCenter::AsyncQueue::MAX_DRAIN_ROUNDS;
 EventCenter &EventCenter::GetInstance()
 {
     static EventCenter eventCenter;
@@ -27,15 +42,32 @@ EventCenter &EventCenter::GetInstance()
 
 bool EventCenter::Subscribe(int32_t evtId, const std::function<void(const Event &)> &observer)
 {
-    return observers_.Compute(evtId, [&observer](const auto &id, auto &list) -> bool {
-        list.push_back(observer);
-        return true;
-    });
+    std::lock_guard<std::mutex> lock(subscribeMutex_);
+    auto table = std::make_shared<ObserverTable>(*std::atomic_load(&observers_));
+    auto &current = (*table)[evtId];
+    auto observers = current == nullptr ? std::make_shared<Observers>() : std::make_shared<Observers>(*current);
+    observers->push_back(observer);
+    current = std::move(observers);
+    std::atomic_store(&observers_, std::shared_ptr<const ObserverTable>(std::move(table)));
+    return true;
+}
+
+void EventCenter::SetReliable(int32_t evtId)
+{
+    GetChannel(evtId).reliable.store(true, std::memory_order_relaxed);
 }
 
 bool EventCenter::Unsubscribe(int32_t evtId)
 {
-    return observers_.Erase(evtId);
+    std::lock_guard<std::mutex> lock(subscribeMutex_);
+    auto current = std::atomic_load(&observers_);
+    if (current->find(evtId) == current->end()) {
+        return false;
+    }
+    auto table = std::make_shared<ObserverTable>(*current);
+    table->erase(evtId);
+    std::atomic_store(&observers_, std::shared_ptr<const ObserverTable>(std::move(table)));
+    return true;
 }
 
 int32_t EventCenter::PostEvent(std::unique_ptr<Event> evt) const
@@ -48,18 +80,64 @@ int32_t EventCenter::PostEvent(std::unique_ptr<Event> evt) const
         Dispatch(*evt);
         return CODE_SYNC;
     }
-    asyncQueue_->Post(std::move(evt));
-    return CODE_ASYNC;
+    return asyncQueue_->Post(std::move(evt)) ? CODE_ASYNC : CODE_QUEUE_FULL;
+}
+
+std::map<int32_t, EventCenter::EventStat> EventCenter::GetEventStats() const
+{
+    std::map<int32_t, EventStat> stats;
+    auto channels = std::atomic_load(&channels_);
+    for (const auto &[evtId, channel] : *channels) {
+        auto &stat = stats[evtId];
+        stat.count = channel->count.load(std::memory_order_relaxed);
+        stat.dropped = channel->dropped.load(std::memory_order_relaxed);
+        stat.overflowed = channel->overflowed.load(std::memory_order_relaxed);
+        stat.totalCostUs = channel->totalCostUs.load(std::memory_order_relaxed);
+        stat.maxCostUs = channel->maxCostUs.load(std::memory_order_relaxed);
+        stat.maxQueueDepth = channel->maxQueueDepth.load(std::memory_order_relaxed);
+    }
+    return stats;
 }
 
 void EventCenter::Dispatch(const Event &evt) const
 {
-    auto observers = observers_.Find(evt.GetEventId());
+    auto table = std::atomic_load(&observers_);
+    auto it = table->find(evt.GetEventId());
     PASTEBOARD_CHECK_AND_RETURN_LOGE(
-        observers.first, PASTEBOARD_MODULE_SERVICE, "event not find, id=%{public}d", evt.GetEventId());
-    for (const auto &observer : observers.second) {
-        observer(evt);
+        it != table->end(), PASTEBOARD_MODULE_SERVICE, "event not find, id=%{public}d", evt.GetEventId());
+    auto begin = std::chrono::steady_clock::now();
+    for (const auto &observer : *(it->second)) {
+        if (observer != nullptr) {
+            observer(evt);
+        }
+    }
+    auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+    auto costUs = static_cast<uint64_t>(cost.count());
+    auto &channel = GetChannel(evt.GetEventId());
+    channel.count.fetch_add(1, std::memory_order_relaxed);
+    channel.totalCostUs.fetch_add(costUs, std::memory_order_relaxed);
+    UpdateMax(channel.maxCostUs, costUs);
+}
+
+EventCenter::Channel &EventCenter::GetChannel(int32_t evtId) const
+{
+    auto channels = std::atomic_load(&channels_);
+    auto it = channels->find(evtId);
+    if (it != channels->end()) {
+        return *it->second;
+    }
+    // the first event of an id only, the channels are never removed so the reference stays valid
+    std::lock_guard<std::mutex> lock(subscribeMutex_);
+    channels = std::atomic_load(&channels_);
+    it = channels->find(evtId);
+    if (it != channels->end()) {
+        return *it->second;
     }
+    auto table = std::make_shared<ChannelTable>(*channels);
+    auto channel = std::make_shared<Channel>();
+    (*table)[evtId] = channel;
+    std::atomic_store(&channels_, std::shared_ptr<const ChannelTable>(std::move(table)));
+    return *channel;
 }
 
 EventCenter::Defer::Defer(std::function<void(const Event &)> handler, int32_t evtId)
@@ -95,8 +173,45 @@ EventCenter::AsyncQueue &EventCenter::AsyncQueue::operator--()
         return *this;
     }
     depth_ = 1;
-    for (int32_t count = 0; !events_.empty() && count < MAX_CAPABILITY; count++) {
-        auto &evt = events_.front();
+    // events posted by handlers while draining land in events_ and are picked up by the next round
+    for (int32_t round = 0; !events_.empty() && round < MAX_DRAIN_ROUNDS; round++) {
+        std::deque<std::unique_ptr<Event>> batch;
+        batch.swap(events_);
+        DrainBatch(batch);
+    }
+    // the queue goes away with the last defer, past the rounds only the reliable events still run
+    while (!events_.empty()) {
+        std::deque<std::unique_ptr<Event>> batch;
+        batch.swap(events_);
+        DropUnreliable(batch);
+        DrainBatch(batch);
+    }
+    depth_ = 0;
+    return *this;
+}
+
+void EventCenter::AsyncQueue::DropUnreliable(std::deque<std::unique_ptr<Event>> &batch)
+{
+    size_t dropped = 0;
+    auto it = std::remove_if(batch.begin(), batch.end(), [&dropped](const std::unique_ptr<Event> &evt) {
+        auto &channel = GetInstance().GetChannel(evt->GetEventId());
+        if (channel.reliable.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        channel.dropped.fetch_add(1, std::memory_order_relaxed);
+        dropped++;
+        return true;
+    });
+    batch.erase(it, batch.end());
+    if (dropped != 0) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "drain rounds exhausted, drop events=%{public}zu, "
+            "reliable=%{public}zu", dropped, batch.size());
+    }
+}
+
+void EventCenter::AsyncQueue::DrainBatch(std::deque<std::unique_ptr<Event>> &batch)
+{
+    for (auto &evt : batch) {
         // dispatch to resident handlers
         GetInstance().Dispatch(*evt);
 
@@ -105,10 +220,7 @@ EventCenter::AsyncQueue &EventCenter::AsyncQueue::operator--()
         if (handler != handlers_.end()) {
             handler->second(*evt);
         }
-        events_.pop_front();
     }
-    depth_ = 0;
-    return *this;
 }
 
 bool EventCenter::AsyncQueue::operator<=(int32_t depth) const
@@ -116,15 +228,31 @@ bool EventCenter::AsyncQueue::operator<=(int32_t depth) const
     return depth_ <= depth;
 }
 
-void EventCenter::AsyncQueue::Post(std::unique_ptr<Event> evt)
+bool EventCenter::AsyncQueue::Post(std::unique_ptr<Event> evt)
 {
+    auto evtId = evt->GetEventId();
+    // a duplicate of a queued event is already served, even when the queue is full
     for (auto &event : events_) {
-        if (event->GetEventId() != evt->GetEventId()) {
+        if (event->GetEventId() != evtId) {
             continue;
         }
-        PASTEBOARD_CHECK_AND_RETURN_LOGE(!event->Equals(*evt), PASTEBOARD_MODULE_SERVICE, "event not equal");
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGD(!event->Equals(*evt), true, PASTEBOARD_MODULE_SERVICE,
+            "event already queued, id=%{public}d", evtId);
+    }
+    auto &channel = GetInstance().GetChannel(evtId);
+    bool overflow = events_.size() >= static_cast<size_t>(MAX_CAPABILITY);
+    if (overflow && !channel.reliable.load(std::memory_order_relaxed)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "queue full, drop event, id=%{public}d", evtId);
+        channel.dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (overflow) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "queue full, keep reliable event, id=%{public}d", evtId);
+        channel.overflowed.fetch_add(1, std::memory_order_relaxed);
     }
     events_.push_back(std::move(evt));
+    UpdateMax(channel.maxQueueDepth, static_cast<uint32_t>(events_.size()));
+    return true;
 }
 
 void EventCenter::AsyncQueue::AddHandler(int32_t evtId, std::function<void(const Event &)> handler)
@@ -18,6 +18,8 @@
 #include <map>
 
 #include "serializable/serializable.h"
+#include "tlv_readable.h"
+#include "tlv_writeable.h"
 
 namespace OHOS::MiscServices {
 class API_EXPORT ClipPlugin {
@@ -25,7 +27,10 @@ public:
     enum EventStatus : uint32_t { EVT_UNKNOWN, EVT_INVALID, EVT_NORMAL, EVT_BUTT };
     enum ServiceStatus : uint32_t { UNKNOWN = 0, IDLE, CONNECT_SUCC };
 
-    struct GlobalEvent final : public DistributedData::Serializable {
+    struct GlobalEvent final : public DistributedData::Serializable, public TLVWriteable, public TLVReadable {
+        // events whose version is at least TLV_VERSION are exchanged in binary TLV, older ones in JSON
+        static constexpr uint8_t TLV_VERSION = 1;
+
         uint8_t version = 0;
         uint8_t frameNum = 0;
         uint16_t user = 0;
@@ -38,6 +43,8 @@ public:
         std::string deviceId;
         std::string account;
         std::vector<std::string> dataType;
+        // id of the paste reading the event, only for tracing, never exchanged in JSON
+        std::string pasteId;
 
         bool operator==(const GlobalEvent globalEvent)
         {
@@ -45,6 +52,12 @@ public:
         }
         bool Marshal(json &node) const override;
         bool Unmarshal(const json &node) override;
+        bool EncodeTLV(WriteOnlyBuffer &buffer) const override;
+        bool DecodeTLV(ReadOnlyBuffer &buffer) override;
+        size_t CountTLV() const override;
+        bool Serialize(std::vector<uint8_t> &buffer) const;
+        bool Deserialize(const std::vector<uint8_t> &buffer);
+        static bool IsJsonFormat(const std::vector<uint8_t> &buffer);
     };
 
     class Factory {
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DISTRIBUTED_DATA_PASTEBOARD_FRAMEWORK_COMMON_CHANGE_STATE_PAGE_H
+#define OHOS_DISTRIBUTED_DATA_PASTEBOARD_FRAMEWORK_COMMON_CHANGE_STATE_PAGE_H
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "common/constant.h"
+
+namespace OHOS::MiscServices {
+struct ChangeState {
+    uint32_t changeCount = 0;
+    uint32_t mimeTypes = 0; // ChangeStatePage::MimeType bits of the local clip
+    uint32_t flags = 0;     // ChangeStatePage::Flag bits
+};
+
+/*
+ * The change state of the pasteboard of a user, kept by the service in shared memory the clients of the user map
+ * read-only, so polling it costs no IPC. The service is the only writer, under a seqlock: the sequence is odd while
+ * a write is in progress and a reader retries when it changed during its read.
+ */
+class ChangeStatePage {
+public:
+    enum Flag : uint32_t {
+        // a local clip any caller of the user may read exists
+        HAS_DATA = 1 << 0,
+        // HasPasteData and HasDataType of the mime types in the bitmap are answered by the page alone, not set while
+        // a remote clip or the owner of the local clip decides the answer
+        LOCAL_ANSWER = 1 << 1,
+    };
+    enum MimeType : uint32_t {
+        PLAIN = 1 << 0,
+        HTML = 1 << 1,
+        URI = 1 << 2,
+        PIXELMAP = 1 << 3,
+        WANT = 1 << 4,
+    };
+    struct Layout {
+        std::atomic<uint32_t> sequence;
+        std::atomic<uint32_t> changeCount;
+        std::atomic<uint32_t> mimeTypes;
+        std::atomic<uint32_t> flags;
+    };
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "the page is shared between processes");
+    static constexpr uint32_t MAX_READ_RETRIES = 64;
+
+    // the bit of the mime type, 0 for the types outside the bitmap
+    static uint32_t GetMimeTypeBit(const std::string &mimeType)
+    {
+        if (mimeType == MIMETYPE_TEXT_PLAIN) {
+            return PLAIN;
+        }
+        if (mimeType == MIMETYPE_TEXT_HTML) {
+            return HTML;
+        }
+        if (mimeType == MIMETYPE_TEXT_URI) {
+            return URI;
+        }
+        if (mimeType == MIMETYPE_PIXELMAP) {
+            return PIXELMAP;
+        }
+        if (mimeType == MIMETYPE_TEXT_WANT) {
+            return WANT;
+        }
+        return 0;
+    }
+
+    // callers serialize the writes of a page
+    static void Write(Layout &page, const ChangeState &state)
+    {
+        uint32_t sequence = page.sequence.load(std::memory_order_relaxed);
+        page.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        page.changeCount.store(state.changeCount, std::memory_order_relaxed);
+        page.mimeTypes.store(state.mimeTypes, std::memory_order_relaxed);
+        page.flags.store(state.flags, std::memory_order_relaxed);
+        // skips 0 on wrap around, it tells the readers nothing was published yet
+        uint32_t next = sequence + 2 == 0 ? 2 : sequence + 2;
+        page.sequence.store(next, std::memory_order_release);
+    }
+
+    // false when nothing was published yet or the writer kept the page busy for all the retries
+    static bool Read(const Layout &page, ChangeState &state)
+    {
+        for (uint32_t i = 0; i < MAX_READ_RETRIES; ++i) {
+            uint32_t begin = page.sequence.load(std::memory_order_acquire);
+            if (begin == 0) {
+                return false;
+            }
+            if ((begin & 1) != 0) {
+                std::this_thread::yield();
+                continue;
+            }
+            state.changeCount = page.changeCount.load(std::memory_order_relaxed);
+            state.mimeTypes = page.mimeTypes.load(std::memory_order_relaxed);
+            state.flags = page.flags.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (page.sequence.load(std::memory_order_relaxed) == begin) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+} // namespace OHOS::MiscServices
+#endif // OHOS_DISTRIBUTED_DATA_PASTEBOARD_FRAMEWORK_COMMON_CHANGE_STATE_PAGE_H
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DISTRIBUTED_DATA_FRAMEWORKS_COMMON_CONCURRENT_SHARDED_MAP_H
+#define OHOS_DISTRIBUTED_DATA_FRAMEWORKS_COMMON_CONCURRENT_SHARDED_MAP_H
+#include <array>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace OHOS {
+/*
+ * Read-mostly variant of ConcurrentMap. Keys are spread over _ShardNum shards, each guarded by its own
+ * shared_mutex, so readers of different keys never contend and readers of the same key only share a lock.
+ * The locks are not recursive: actions must not access the same map again.
+ */
+template<typename _Key, typename _Tp, size_t _ShardNum = 8>
+class ConcurrentShardedMap {
+public:
+    static_assert(_ShardNum > 0, "shard number must be positive");
+    using key_type = typename std::unordered_map<_Key, _Tp>::key_type;
+    using mapped_type = typename std::unordered_map<_Key, _Tp>::mapped_type;
+    using value_type = typename std::unordered_map<_Key, _Tp>::value_type;
+    using size_type = typename std::unordered_map<_Key, _Tp>::size_type;
+
+    ConcurrentShardedMap() = default;
+    ~ConcurrentShardedMap() = default;
+    ConcurrentShardedMap(const ConcurrentShardedMap &other) = delete;
+    ConcurrentShardedMap &operator=(const ConcurrentShardedMap &other) = delete;
+
+    template<typename... _Args>
+    bool Emplace(const key_type &key, _Args &&... args) noexcept
+    {
+        auto &shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.entries.emplace(key, std::forward<_Args>(args)...);
+        return it.second;
+    }
+
+    std::pair<bool, mapped_type> Find(const key_type &key) const noexcept
+    {
+        const auto &shard = GetShard(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end()) {
+            return std::pair{ false, mapped_type() };
+        }
+        return std::pair{ true, it->second };
+    }
+
+    // Access the value in place under the shard read lock, no copy of the value is made.
+    bool FindRef(const key_type &key, const std::function<void(const mapped_type &)> &action) const
+    {
+        if (action == nullptr) {
+            return false;
+        }
+        const auto &shard = GetShard(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end()) {
+            return false;
+        }
+        action(it->second);
+        return true;
+    }
+
+    bool Contains(const key_type &key) const noexcept
+    {
+        const auto &shard = GetShard(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.entries.find(key) != shard.entries.end();
+    }
+
+    template<typename _Obj>
+    bool InsertOrAssign(const key_type &key, _Obj &&obj) noexcept
+    {
+        auto &shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.entries.insert_or_assign(key, std::forward<_Obj>(obj));
+        return it.second;
+    }
+
+    bool Insert(const key_type &key, const mapped_type &value) noexcept
+    {
+        auto &shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.entries.insert(value_type{ key, value });
+        return it.second;
+    }
+
+    size_type Erase(const key_type &key) noexcept
+    {
+        auto &shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.entries.erase(key);
+    }
+
+    void Clear() noexcept
+    {
+        for (auto &shard : shards_) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.entries.clear();
+        }
+    }
+
+    bool Empty() const noexcept
+    {
+        for (const auto &shard : shards_) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            if (!shard.entries.empty()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_type Size() const noexcept
+    {
+        size_type size = 0;
+        for (const auto &shard : shards_) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            size += shard.entries.size();
+        }
+        return size;
+    }
+
+    // The action`s return true mains meet the erase condition
+    // The action`s return false mains not meet the erase condition
+    size_type EraseIf(const std::function<bool(const key_type &key, mapped_type &value)> &action) noexcept
+    {
+        if (action == nullptr) {
+            return 0;
+        }
+        size_type count = 0;
+        for (auto &shard : shards_) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+                if (action(it->first, it->second)) {
+                    it = shard.entries.erase(it);
+                    ++count;
+                } else {
+                    ++it;
+                }
+            }
+        }
+        return count;
+    }
+
+    // Shards are visited one after another, the view is consistent per shard only.
+    void ForEach(const std::function<bool(const key_type &, mapped_type &)> &action)
+    {
+        if (action == nullptr) {
+            return;
+        }
+        for (auto &shard : shards_) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            for (auto &[key, value] : shard.entries) {
+                if (action(key, value)) {
+                    return;
+                }
+            }
+        }
+    }
+
+    void ForEachRef(const std::function<bool(const key_type &, const mapped_type &)> &action) const
+    {
+        if (action == nullptr) {
+            return;
+        }
+        for (const auto &shard : shards_) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            for (const auto &[key, value] : shard.entries) {
+                if (action(key, value)) {
+                    return;
+                }
+            }
+        }
+    }
+
+    // The action's return value mains that the element is keep in map or not; true mains keep, false mains remove.
+    bool Compute(const key_type &key, const std::function<bool(const key_type &, mapped_type &)> &action)
+    {
+        if (action == nullptr) {
+            return false;
+        }
+        auto &shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end()) {
+            auto result = shard.entries.emplace(key, mapped_type());
+            it = result.second ? result.first : shard.entries.end();
+        }
+        if (it == shard.entries.end()) {
+            return false;
+        }
+        if (!action(it->first, it->second)) {
+            shard.entries.erase(it);
+        }
+        return true;
+    }
+
+    // The action's return value mains that the element is keep in map or not; true mains keep, false mains remove.
+    bool ComputeIfPresent(const key_type &key, const std::function<bool(const key_type &, mapped_type &)> &action)
+    {
+        if (action == nullptr) {
+            return false;
+        }
+        auto &shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end()) {
+            return false;
+        }
+        if (!action(key, it->second)) {
+            shard.entries.erase(it);
+        }
+        return true;
+    }
+
+    bool ComputeIfAbsent(const key_type &key, const std::function<mapped_type(const key_type &)> &action)
+    {
+        if (action == nullptr) {
+            return false;
+        }
+        auto &shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it != shard.entries.end()) {
+            return false;
+        }
+        shard.entries.emplace(key, action(key));
+        return true;
+    }
+
+private:
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<_Key, _Tp> entries;
+    };
+
+    Shard &GetShard(const key_type &key) noexcept
+    {
+        return shards_[std::hash<_Key>{}(key) % _ShardNum];
+    }
+
+    const Shard &GetShard(const key_type &key) const noexcept
+    {
+        return shards_[std::hash<_Key>{}(key) % _ShardNum];
+    }
+
+    std::array<Shard, _ShardNum> shards_;
+};
+} // namespace OHOS
+#endif // OHOS_DISTRIBUTED_DATA_FRAMEWORKS_COMMON_CONCURRENT_SHARDED_MAP_H
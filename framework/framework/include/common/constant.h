@@ -21,5 +21,7 @@ static constexpr const char *MIMETYPE_TEXT_HTML = "text/html";
 static constexpr const char *MIMETYPE_TEXT_PLAIN = "text/plain";
 static constexpr const char *MIMETYPE_TEXT_URI = "text/uri";
 static constexpr const char *MIMETYPE_TEXT_WANT = "text/want";
+// asks GetRecordValueByType for a downscaled copy of the pixel map of a record, answered as its pixel map entry
+static constexpr const char *PIXELMAP_PREVIEW_UTDID = "openharmony.pixel-map.preview";
 } // namespace OHOS::MiscServices
 #endif // OHOS_DISTRIBUTED_DATA_PASTEBOARD_FRAMEWORK_COMMON_CONSTANT_H
\ No newline at end of file
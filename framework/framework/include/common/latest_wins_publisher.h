@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_DISTRIBUTED_DATA_FRAMEWORKS_COMMON_LATEST_WINS_PUBLISHER_H
+#define OHOS_DISTRIBUTED_DATA_FRAMEWORKS_COMMON_LATEST_WINS_PUBLISHER_H
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace OHOS {
+/*
+ * Single long-lived worker that publishes only the latest submitted value. A value submitted while another one
+ * is pending replaces it, and a value submitted while the task is running marks the running one as superseded so
+ * the task can give up early. The worker thread is started on the first submission. A value submitted while a task
+ * is running waits for the debounce before it runs, so a burst collapses to its last value. With a timeout, a task
+ * still running when it expires is left to finish on its own thread, seen as superseded, and the next value runs.
+ */
+template<typename _Tp>
+class LatestWinsPublisher {
+public:
+    struct Stats {
+        uint64_t submitted = 0;
+        uint64_t pending = 0;
+        uint64_t published = 0;
+        uint64_t skipped = 0;
+        uint64_t canceled = 0;
+        uint64_t failed = 0;
+        uint64_t timedOut = 0;
+        uint64_t lastLatencyUs = 0;
+        uint64_t maxLatencyUs = 0;
+    };
+    using IsSuperseded = std::function<bool()>;
+    // The task returns true when the value is published.
+    using Task = std::function<bool(_Tp &value, const IsSuperseded &isSuperseded)>;
+
+    // a timeout of 0 runs the tasks on the worker thread without a time bound
+    LatestWinsPublisher(Task task, uint32_t debounceMs, uint32_t timeoutMs = 0)
+        : task_(std::move(task)), debounce_(debounceMs), timeout_(timeoutMs)
+    {
+    }
+
+    ~LatestWinsPublisher()
+    {
+        Stop();
+    }
+
+    LatestWinsPublisher(const LatestWinsPublisher &other) = delete;
+    LatestWinsPublisher &operator=(const LatestWinsPublisher &other) = delete;
+
+    bool Submit(_Tp value)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_ || task_ == nullptr) {
+            return false;
+        }
+        if (pending_.has_value()) {
+            stats_.skipped++;
+        }
+        pending_ = std::move(value);
+        pendingTime_ = std::chrono::steady_clock::now();
+        generation_.fetch_add(1);
+        stats_.submitted++;
+        if (!worker_.joinable()) {
+            worker_ = std::thread(&LatestWinsPublisher::Run, this);
+        }
+        cv_.notify_one();
+        return true;
+    }
+
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+            pending_.reset();
+            generation_.fetch_add(1);
+        }
+        cv_.notify_all();
+        if (worker_.joinable() && worker_.get_id() != std::this_thread::get_id()) {
+            worker_.join();
+        }
+        std::vector<Runner> runners;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            runners.swap(runners_);
+        }
+        for (auto &runner : runners) {
+            runner.thread.join();
+        }
+    }
+
+    Stats GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stats stats = stats_;
+        stats.pending = pending_.has_value() ? 1 : 0;
+        return stats;
+    }
+
+private:
+    struct Execution {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool done = false;
+        bool ret = false;
+        std::atomic<bool> expired { false };
+    };
+    // a task left running after its timeout, joined once done
+    struct Runner {
+        std::shared_ptr<Execution> execution;
+        std::thread thread;
+    };
+
+    void Run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        bool settle = false;
+        while (true) {
+            cv_.wait(lock, [this] {
+                return stop_ || pending_.has_value();
+            });
+            // a value submitted while a task was running is likely part of a burst, let it settle and every value
+            // submitted meanwhile replaces the pending one
+            if (settle) {
+                cv_.wait_for(lock, debounce_, [this] {
+                    return stop_;
+                });
+            }
+            if (stop_) {
+                return;
+            }
+            if (!pending_.has_value()) {
+                continue;
+            }
+            _Tp value = std::move(*pending_);
+            pending_.reset();
+            auto submitTime = pendingTime_;
+            uint64_t generation = generation_.load();
+            auto execution = std::make_shared<Execution>();
+            ReapRunners();
+            lock.unlock();
+            IsSuperseded isSuperseded = [this, generation, execution] {
+                return execution->expired.load() || generation_.load() != generation;
+            };
+            std::optional<Runner> runner = Execute(std::move(value), isSuperseded, execution);
+            auto cost = std::chrono::steady_clock::now() - submitTime;
+            lock.lock();
+            if (runner.has_value()) {
+                stats_.timedOut++;
+                runners_.push_back(std::move(*runner));
+            } else {
+                Account(execution->ret, generation, cost);
+            }
+            settle = pending_.has_value();
+        }
+    }
+
+    // the runner of a task that timed out, none when the task is done
+    std::optional<Runner> Execute(_Tp value, const IsSuperseded &isSuperseded,
+        const std::shared_ptr<Execution> &execution)
+    {
+        if (timeout_.count() == 0) {
+            execution->ret = task_(value, isSuperseded);
+            return std::nullopt;
+        }
+        std::thread thread([this, value = std::move(value), isSuperseded, execution]() mutable {
+            bool ret = task_(value, isSuperseded);
+            std::lock_guard<std::mutex> lock(execution->mutex);
+            execution->ret = ret;
+            execution->done = true;
+            execution->cv.notify_all();
+        });
+        std::unique_lock<std::mutex> lock(execution->mutex);
+        if (execution->cv.wait_for(lock, timeout_, [&execution] {
+            return execution->done;
+        })) {
+            lock.unlock();
+            thread.join();
+            return std::nullopt;
+        }
+        execution->expired.store(true);
+        return Runner{ execution, std::move(thread) };
+    }
+
+    void ReapRunners()
+    {
+        for (auto it = runners_.begin(); it != runners_.end();) {
+            bool done = false;
+            {
+                std::lock_guard<std::mutex> lock(it->execution->mutex);
+                done = it->execution->done;
+            }
+            if (done) {
+                it->thread.join();
+                it = runners_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void Account(bool ret, uint64_t generation, std::chrono::steady_clock::duration cost)
+    {
+        if (ret) {
+            auto latency = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(cost).count());
+            stats_.published++;
+            stats_.lastLatencyUs = latency;
+            stats_.maxLatencyUs = std::max(stats_.maxLatencyUs, latency);
+        } else if (generation_.load() != generation) {
+            stats_.canceled++;
+        } else {
+            stats_.failed++;
+        }
+    }
+
+    Task task_;
+    std::chrono::milliseconds debounce_;
+    std::chrono::milliseconds timeout_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::optional<_Tp> pending_;
+    std::chrono::steady_clock::time_point pendingTime_;
+    std::atomic<uint64_t> generation_ = 0;
+    bool stop_ = false;
+    Stats stats_;
+    std::vector<Runner> runners_;
+    std::thread worker_;
+};
+} // namespace OHOS
+#endif // OHOS_DISTRIBUTED_DATA_FRAMEWORKS_COMMON_LATEST_WINS_PUBLISHER_H
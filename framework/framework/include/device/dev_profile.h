@@ -32,7 +32,7 @@ public:
     using Observer = std::function<void(bool isEnable)>;
     static DevProfile &GetInstance();
     int32_t GetDeviceStatus(const std::string &networkId, bool &status);
-    void PutDeviceStatus(bool status);
+    bool PutDeviceStatus(bool status);
     bool GetDeviceVersion(const std::string &networkId, uint32_t &deviceVersion);
     void SubscribeProfileEvent(const std::string &networkId);
     void UnSubscribeProfileEvent(const std::string &networkId);
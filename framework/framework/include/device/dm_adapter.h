@@ -15,7 +15,13 @@
 
 #ifndef OHOS_PASTEBOARD_SERVICES_DEVICE_DM_ADAPTER_H
 #define OHOS_PASTEBOARD_SERVICES_DEVICE_DM_ADAPTER_H
-#include <shared_mutex>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "api/visibility.h"
 #include "common/concurrent_map.h"
@@ -68,6 +74,13 @@ public:
         virtual void Offline(const std::string &device) = 0;
         virtual void OnReady(const std::string &device) = 0;
     };
+    struct CacheStats {
+        uint64_t version = 0;
+        int64_t ageMs = -1;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        size_t deviceCount = 0;
+    };
     static DMAdapter &GetInstance();
     bool Initialize(const std::string &pkgName);
     void DeInitialize();
@@ -86,6 +99,7 @@ public:
     std::string GetDeviceName(const std::string &networkId);
     void Register(DMObserver *observer);
     void Unregister(DMObserver *observer);
+    CacheStats GetCacheStats() const;
 
 private:
     static constexpr const char *NAME_EX = "dm_adapter";
@@ -103,8 +117,25 @@ private:
     std::string localDeviceUdid_{};
     ConcurrentMap<DMObserver *, DMObserver *> observers_;
 #ifdef PB_DEVICE_MANAGER_ENABLE
-    std::shared_mutex dmMutex_;
-    std::vector<DmDeviceInfo> devices_;
+    // Immutable view of the trusted devices, replaced as a whole on every topology change.
+    struct Topology {
+        uint64_t version = 0;
+        int64_t refreshTime = 0;
+        std::string localNetworkId;
+        std::vector<DmDeviceInfo> devices;
+        std::unordered_map<std::string, size_t> indexes;
+        std::unordered_map<std::string, std::string> udids;
+    };
+    std::shared_ptr<const Topology> LoadTopology() const;
+    void PublishTopology(std::shared_ptr<Topology> topology);
+    // with topologyMutex_ held
+    void StoreTopology(std::shared_ptr<Topology> topology);
+
+    // held from the device query of a refresh to its publish
+    std::mutex topologyMutex_;
+    std::shared_ptr<const Topology> topology_ = std::make_shared<const Topology>();
+    mutable std::atomic<uint64_t> cacheHits_ = 0;
+    mutable std::atomic<uint64_t> cacheMisses_ = 0;
     std::atomic<int32_t> deviceType_ = DmDeviceType::DEVICE_TYPE_UNKNOWN;
 #endif
 };
@@ -15,10 +15,15 @@
 
 #ifndef OHOS_DISTRIBUTED_DATA_PASTEBOARD_SERVICES_FRAMEWORK_EVENTCENTER_EVENT_CENTER_H
 #define OHOS_DISTRIBUTED_DATA_PASTEBOARD_SERVICES_FRAMEWORK_EVENTCENTER_EVENT_CENTER_H
-#include <list>
-#include <queue>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
-#include "common/concurrent_map.h"
 #include "eventcenter/event.h"
 
 namespace OHOS::MiscServices {
@@ -28,6 +33,16 @@ public:
         CODE_SYNC = 1,
         CODE_ASYNC,
         CODE_INVALID_ARGS,
+        CODE_QUEUE_FULL,
+    };
+
+    struct EventStat {
+        uint64_t count = 0;
+        uint64_t dropped = 0;
+        uint64_t overflowed = 0; // events of a reliable id queued beyond the capability
+        uint64_t totalCostUs = 0;
+        uint64_t maxCostUs = 0;
+        uint32_t maxQueueDepth = 0;
     };
 
     class Defer final {
@@ -42,25 +57,52 @@ public:
     API_EXPORT static EventCenter &GetInstance();
     API_EXPORT bool Subscribe(int32_t evtId, const std::function<void(const Event &)> &observer);
     API_EXPORT bool Unsubscribe(int32_t evtId);
+    // events of a reliable id are never dropped, they are queued beyond the capability when the queue is full
+    API_EXPORT void SetReliable(int32_t evtId);
     API_EXPORT int32_t PostEvent(std::unique_ptr<Event> evt) const;
+    API_EXPORT std::map<int32_t, EventStat> GetEventStats() const;
 
 private:
+    using Observers = std::vector<std::function<void(const Event &)>>;
+    using ObserverTable = std::unordered_map<int32_t, std::shared_ptr<const Observers>>;
+    // the counters of an event id, created once and kept for the life of the center
+    struct Channel {
+        std::atomic<bool> reliable{ false };
+        std::atomic<uint64_t> count{ 0 };
+        std::atomic<uint64_t> dropped{ 0 };
+        std::atomic<uint64_t> overflowed{ 0 };
+        std::atomic<uint64_t> totalCostUs{ 0 };
+        std::atomic<uint64_t> maxCostUs{ 0 };
+        std::atomic<uint32_t> maxQueueDepth{ 0 };
+    };
+    using ChannelTable = std::unordered_map<int32_t, std::shared_ptr<Channel>>;
+
     void Dispatch(const Event &evt) const;
+    Channel &GetChannel(int32_t evtId) const;
     class AsyncQueue final {
     public:
         static constexpr int32_t MAX_CAPABILITY = 100;
+        static constexpr int32_t MAX_DRAIN_ROUNDS = 10;
         AsyncQueue &operator++();
         AsyncQueue &operator--();
         bool operator<=(int32_t depth) const;
-        void Post(std::unique_ptr<Event> event);
+        bool Post(std::unique_ptr<Event> event);
         void AddHandler(int32_t evtId, std::function<void(const Event &)> handler);
 
     private:
+        void DrainBatch(std::deque<std::unique_ptr<Event>> &batch);
+        // counts the unreliable events of the batch as dropped and removes them
+        void DropUnreliable(std::deque<std::unique_ptr<Event>> &batch);
+
         std::unordered_map<int32_t, std::function<void(const Event &)>> handlers_;
         std::deque<std::unique_ptr<Event>> events_;
         int32_t depth_ = 0;
     };
-    ConcurrentMap<int32_t, std::list<std::function<void(const Event &)>>> observers_;
+    // observers are published as immutable snapshots: subscribing copies the table, dispatching only loads it
+    mutable std::mutex subscribeMutex_;
+    std::shared_ptr<const ObserverTable> observers_ = std::make_shared<const ObserverTable>();
+    // published the same way, so counting an event takes no lock
+    mutable std::shared_ptr<const ChannelTable> channels_ = std::make_shared<const ChannelTable>();
     static thread_local AsyncQueue *asyncQueue_;
 };
 } // namespace OHOS::MiscServices
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTE_CLIP_SUMMARY_H
+#define PASTE_CLIP_SUMMARY_H
+
+#include <string>
+#include <vector>
+
+#include "tlv_readable.h"
+#include "tlv_writeable.h"
+
+namespace OHOS {
+namespace MiscServices {
+/*
+ * Metadata of a clip kept in the clip history of the service, enough to render a history list without transferring
+ * the clip itself. A clip is made current again by its clipId.
+ */
+struct API_EXPORT PasteClipSummary : public TLVWriteable, public TLVReadable {
+    static constexpr size_t MAX_PREVIEW_LENGTH = 128;
+
+    uint32_t clipId = 0;
+    int64_t copyTime = 0; // wall clock of the latest copy of the content, in milliseconds
+    int64_t dataSize = 0; // size of the encoded clip
+    uint32_t recordCount = 0;
+    std::string bundleName;
+    std::vector<std::string> mimeTypes;
+    std::string textPreview; // at most MAX_PREVIEW_LENGTH bytes of the primary text
+
+    bool EncodeTLV(WriteOnlyBuffer &buffer) const override;
+    bool DecodeTLV(ReadOnlyBuffer &buffer) override;
+    size_t CountTLV() const override;
+
+    static bool EncodeList(const std::vector<PasteClipSummary> &summaries, std::vector<uint8_t> &buffer);
+    static bool DecodeList(const std::vector<uint8_t> &buffer, std::vector<PasteClipSummary> &summaries);
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // PASTE_CLIP_SUMMARY_H
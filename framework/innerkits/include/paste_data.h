@@ -135,6 +135,8 @@ public:
     static std::string CreatePasteId(const std::string &name, uint32_t sequence);
     static bool IsValidPasteId(const std::string &pasteId);
     static bool IsValidShareOption(int32_t shareOption);
+    // hash of the record payloads of an encoded PasteData, the properties and ids stamped on each copy are skipped
+    static uint64_t GetContentHash(const std::vector<uint8_t> &tlv);
     static std::string WEBVIEW_PASTEDATA_TAG;
     static constexpr const char *DISTRIBUTEDFILES_TAG = "distributedfiles";
     static constexpr const char *PATH_SHARE = "/data/storage/el2/share/r/";
@@ -16,6 +16,11 @@
 #ifndef PASTE_BOARD_ENTRY_H
 #define PASTE_BOARD_ENTRY_H
 
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
 #include "tlv_readable.h"
 #include "tlv_writeable.h"
 
@@ -35,6 +40,45 @@ private:
     std::map<std::string, std::vector<uint8_t>> itemData_;
 };
 
+/*
+ * Process-wide table interning MIME types and utd ids to small integer ids. The mime/utd mapping and the file uri
+ * classification of a type are resolved once when it is interned, later lookups are integer compares.
+ */
+class API_EXPORT TypeRegistry {
+public:
+    using TypeId = uint32_t;
+    static constexpr TypeId INVALID_TYPE_ID = 0;
+    static constexpr size_t MAX_TYPE_COUNT = 4096;
+
+    static TypeRegistry &GetInstance();
+    // return INVALID_TYPE_ID for an empty type or when the table is full, callers fall back to strings then
+    TypeId Intern(const std::string &type);
+    TypeId GetUtdId(TypeId typeId) const;
+    TypeId GetMimeType(TypeId typeId) const;
+    bool IsFileUri(TypeId typeId) const;
+    const std::string &GetName(TypeId typeId) const;
+    size_t Size() const;
+
+private:
+    struct TypeInfo {
+        std::string name;
+        TypeId utdId = INVALID_TYPE_ID;
+        TypeId mimeType = INVALID_TYPE_ID;
+        bool isFileUri = false;
+    };
+
+    TypeRegistry();
+    ~TypeRegistry() = default;
+    TypeRegistry(const TypeRegistry &) = delete;
+    TypeRegistry &operator=(const TypeRegistry &) = delete;
+    TypeId InternLocked(const std::string &type);
+    const TypeInfo *GetInfoLocked(TypeId typeId) const;
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, TypeId> ids_;
+    std::deque<TypeInfo> types_; // id n is at index n - 1, a deque keeps references stable across inserts
+};
+
 class API_EXPORT PasteDataEntry : public TLVWriteable, public TLVReadable {
 public:
     using UDType = UDMF::UDType;
@@ -55,6 +99,7 @@ public:
     EntryValue GetValue() const;
     void SetUtdId(const std::string &utdId);
     std::string GetUtdId() const;
+    TypeRegistry::TypeId GetUtdTypeId() const;
     void SetMimeType(const std::string &mimeType);
     std::string GetMimeType() const;
     void SetFileSize(int64_t fileSize);
@@ -70,6 +115,7 @@ public:
 
 private:
     std::string utdId_;
+    TypeRegistry::TypeId utdTypeId_ = TypeRegistry::INVALID_TYPE_ID;
     std::string mimeType_; // pasteboard mimeType
     EntryValue value_;
 };
@@ -38,6 +38,15 @@ struct RemoteRecordValue {
     std::vector<std::shared_ptr<PasteDataEntry>> entries_;
 };
 
+// Remote view of a record and its marshalled blobs, built once per record for a remote encode.
+struct RemoteEncodeValue {
+    std::shared_ptr<RemoteRecordValue> remoteValue;
+    RawMem want{};
+    RawMem uri{};
+    bool isPixelMapEncoded = false;
+    std::vector<uint8_t> pixelMap;
+};
+
 class API_EXPORT PasteDataRecord : public TLVWriteable, public TLVReadable {
 public:
     PasteDataRecord();
@@ -54,6 +63,8 @@ public:
     size_t CountTLVRemote() const;
     bool EncodeTLVLocal(WriteOnlyBuffer &buffer) const;
     bool EncodeTLVRemote(WriteOnlyBuffer &buffer) const;
+    // false for the tags the service stamps on every copy, such as the data id, which are not part of the content
+    static bool IsContentTag(uint16_t tag);
 
     static std::shared_ptr<PasteDataRecord> NewHtmlRecord(const std::string &htmlText);
     static std::shared_ptr<PasteDataRecord> NewWantRecord(std::shared_ptr<OHOS::AAFwk::Want> want);
@@ -147,6 +158,8 @@ private:
     bool DecodeItem2(uint16_t tag, ReadOnlyBuffer &buffer, TLVHead &head);
     std::shared_ptr<PasteDataEntry> Remote2Local() const;
     std::shared_ptr<RemoteRecordValue> Local2Remote() const;
+    std::shared_ptr<RemoteEncodeValue> GetRemoteEncodeValue() const;
+    std::shared_ptr<PasteDataEntry> GetEntry(TypeRegistry::TypeId typeId, const std::string &utdType);
 
     bool isDelay_ = false;
     bool hasGrantUriPermission_ = false;
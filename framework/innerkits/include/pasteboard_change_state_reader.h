@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTE_BOARD_CHANGE_STATE_READER_H
+#define PASTE_BOARD_CHANGE_STATE_READER_H
+
+#include <mutex>
+
+#include "common/change_state_page.h"
+#include "ipasteboard_service.h"
+
+namespace OHOS {
+namespace MiscServices {
+/*
+ * The change state page of the user of the process, mapped read-only on the first read and again once the service
+ * restarted, so the polling queries are answered without IPC.
+ */
+class ChangeStateReader {
+public:
+    ChangeStateReader() = default;
+    ~ChangeStateReader();
+    ChangeStateReader(const ChangeStateReader &) = delete;
+    ChangeStateReader &operator=(const ChangeStateReader &) = delete;
+
+    // false when the service publishes no page for the process, the caller asks the service instead
+    bool Read(const sptr<IPasteboardService> &service, ChangeState &state);
+
+private:
+    void Map(const sptr<IPasteboardService> &service);
+    void Unmap();
+
+    std::mutex mutex_;
+    sptr<IRemoteObject> remote_; // the service the page belongs to
+    const ChangeStatePage::Layout *page_ = nullptr;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // PASTE_BOARD_CHANGE_STATE_READER_H
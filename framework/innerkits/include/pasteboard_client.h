@@ -21,6 +21,8 @@
 
 #include "entity_recognition_observer.h"
 #include "message_parcel_warp.h"
+#include "pasteboard_change_state_reader.h"
+#include "paste_clip_summary.h"
 #include "pasteboard_delay_getter_client.h"
 #include "pasteboard_disposable_observer.h"
 #include "pasteboard_entry_getter_client.h"
@@ -217,6 +219,24 @@ public:
      */
     int32_t GetChangeCount(uint32_t &changeCount);
 
+    /**
+     * GetClipHistory
+     * @description get the summaries of the recent clips of the current user, the latest one first.
+     *     Only for system applications with the read pasteboard permission.
+     * @param summaries the summaries of the clips in the history.
+     * @return int32_t.
+     */
+    int32_t GetClipHistory(std::vector<PasteClipSummary> &summaries);
+
+    /**
+     * ActivateClip
+     * @description set a clip of the history as the current PasteData again.
+     *     Only for system applications with the read pasteboard permission.
+     * @param clipId the clipId of a summary returned by GetClipHistory.
+     * @return int32_t.
+     */
+    int32_t ActivateClip(uint32_t clipId);
+
     /**
      * SubscribeEntityObserver
      * @description Subscribe the EntityRecognitionObserver.
@@ -565,6 +585,7 @@ private:
     std::mutex observerSetMutex_;
     std::mutex saListenerMutex_;
     bool isSubscribeSa_ = false;
+    ChangeStateReader changeStateReader_;
 
     struct classcomp {
         bool operator()(const std::pair<PasteboardObserverType, sptr<PasteboardObserver>> &l,
@@ -40,12 +40,13 @@ private:
     std::vector<std::shared_ptr<PasteDataRecord>> SplitHtml2Records(const std::shared_ptr<std::string> &html,
         uint32_t recordId) noexcept;
     void MergeExtraUris2Html(PasteData &data);
-    std::vector<std::pair<std::string, uint32_t>> SplitHtmlWithImgLabel(
-        const std::shared_ptr<std::string> html) noexcept;
-    std::map<std::string, std::vector<uint8_t>> SplitHtmlWithImgSrcLabel(
-        const std::vector<std::pair<std::string, uint32_t>> &matchVec) noexcept;
+    // (offset, length) of each img tag in html
+    std::vector<std::pair<uint32_t, uint32_t>> SplitHtmlWithImgLabel(const std::string &html) noexcept;
+    // local src uri -> offsets of the uri in html
+    std::map<std::string, std::vector<uint32_t>> SplitHtmlWithImgSrcLabel(const std::string &html,
+        const std::vector<std::pair<uint32_t, uint32_t>> &imgTags) noexcept;
     std::vector<std::shared_ptr<PasteDataRecord>> BuildPasteDataRecords(const std::map<std::string,
-        std::vector<uint8_t>> &imgSrcMap, uint32_t recordId) noexcept;
+        std::vector<uint32_t>> &imgSrcMap, uint32_t recordId) noexcept;
 
     void RemoveAllRecord(std::shared_ptr<PasteData> pasteData) noexcept;
     void RemoveRecordById(PasteData &pasteData, uint32_t recordId) noexcept;
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paste_clip_summary.h"
+
+#include "pasteboard_hilog.h"
+
+namespace OHOS {
+namespace MiscServices {
+enum TAG_CLIP_SUMMARY : uint16_t {
+    TAG_CLIP_ID = TAG_BUFF + 1,
+    TAG_COPY_TIME,
+    TAG_DATA_SIZE,
+    TAG_RECORD_COUNT,
+    TAG_BUNDLE_NAME,
+    TAG_MIME_TYPES,
+    TAG_TEXT_PREVIEW,
+};
+
+enum TAG_CLIP_SUMMARY_LIST : uint16_t {
+    TAG_SUMMARIES = TAG_BUFF + 1,
+};
+
+namespace {
+class SummaryList : public TLVWriteable, public TLVReadable {
+public:
+    explicit SummaryList(std::vector<PasteClipSummary> &summaries) : summaries_(summaries) {}
+
+    bool EncodeTLV(WriteOnlyBuffer &buffer) const override
+    {
+        return buffer.Write(TAG_SUMMARIES, summaries_);
+    }
+
+    bool DecodeTLV(ReadOnlyBuffer &buffer) override
+    {
+        for (; buffer.IsEnough();) {
+            TLVHead head{};
+            bool ret = buffer.ReadHead(head);
+            PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret, false, PASTEBOARD_MODULE_COMMON, "read head failed");
+            if (head.tag == TAG_SUMMARIES) {
+                ret = buffer.ReadValue(summaries_, head);
+            } else {
+                ret = buffer.Skip(head.len);
+            }
+            PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret, false, PASTEBOARD_MODULE_COMMON,
+                "read value failed, tag=%{public}hu, len=%{public}u", head.tag, head.len);
+        }
+        return true;
+    }
+
+    size_t CountTLV() const override
+    {
+        return TLVCountable::Count(summaries_);
+    }
+
+private:
+    std::vector<PasteClipSummary> &summaries_;
+};
+} // namespace
+
+bool PasteClipSummary::EncodeTLV(WriteOnlyBuffer &buffer) const
+{
+    bool ret = buffer.Write(TAG_CLIP_ID, clipId);
+    ret = ret && buffer.Write(TAG_COPY_TIME, copyTime);
+    ret = ret && buffer.Write(TAG_DATA_SIZE, dataSize);
+    ret = ret && buffer.Write(TAG_RECORD_COUNT, recordCount);
+    ret = ret && buffer.Write(TAG_BUNDLE_NAME, bundleName);
+    ret = ret && buffer.Write(TAG_MIME_TYPES, mimeTypes);
+    ret = ret && buffer.Write(TAG_TEXT_PREVIEW, textPreview);
+    return ret;
+}
+
+bool PasteClipSummary::DecodeTLV(ReadOnlyBuffer &buffer)
+{
+    for (; buffer.IsEnough();) {
+        TLVHead head{};
+        bool ret = buffer.ReadHead(head);
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret, false, PASTEBOARD_MODULE_COMMON, "read head failed");
+        switch (head.tag) {
+            case TAG_CLIP_ID:
+                ret = buffer.ReadValue(clipId, head);
+                break;
+            case TAG_COPY_TIME:
+                ret = buffer.ReadValue(copyTime, head);
+                break;
+            case TAG_DATA_SIZE:
+                ret = buffer.ReadValue(dataSize, head);
+                break;
+            case TAG_RECORD_COUNT:
+                ret = buffer.ReadValue(recordCount, head);
+                break;
+            case TAG_BUNDLE_NAME:
+                ret = buffer.ReadValue(bundleName, head);
+                break;
+            case TAG_MIME_TYPES:
+                ret = buffer.ReadValue(mimeTypes, head);
+                break;
+            case TAG_TEXT_PREVIEW:
+                ret = buffer.ReadValue(textPreview, head);
+                break;
+            default:
+                ret = buffer.Skip(head.len);
+                break;
+        }
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret, false, PASTEBOARD_MODULE_COMMON,
+            "read value failed, tag=%{public}hu, len=%{public}u", head.tag, head.len);
+    }
+    return true;
+}
+
+size_t PasteClipSummary::CountTLV() const
+{
+    size_t expectedSize = 0;
+    expectedSize += TLVCountable::Count(clipId);
+    expectedSize += TLVCountable::Count(copyTime);
+    expectedSize += TLVCountable::Count(dataSize);
+    expectedSize += TLVCountable::Count(recordCount);
+    expectedSize += TLVCountable::Count(bundleName);
+    expectedSize += TLVCountable::Count(mimeTypes);
+    expectedSize += TLVCountable::Count(textPreview);
+    return expectedSize;
+}
+
+bool PasteClipSummary::EncodeList(const std::vector<PasteClipSummary> &summaries, std::vector<uint8_t> &buffer)
+{
+    auto items = summaries;
+    return SummaryList(items).Encode(buffer);
+}
+
+bool PasteClipSummary::DecodeList(const std::vector<uint8_t> &buffer, std::vector<PasteClipSummary> &summaries)
+{
+    summaries.clear();
+    return SummaryList(summaries).Decode(buffer);
+}
+} // namespace MiscServices
+} // namespace OHOS
@@ -61,6 +61,39 @@ const char *ORIGIN_INFO = "originInfo";
 constexpr int32_t SUB_PASTEID_NUM = 3;
 constexpr int32_t PASTEID_MAX_SIZE = 1024;
 constexpr int32_t PARCEL_MAX_CAPACITY = 500 * 1024;
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+namespace {
+uint64_t HashBytes(uint64_t hash, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; ++i) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+// calls visit(tag, value, len) for each item of a TLV sequence, false when the sequence is truncated
+template<typename Visitor>
+bool ForEachTLV(const uint8_t *data, size_t len, Visitor visit)
+{
+    size_t cursor = 0;
+    while (cursor < len) {
+        if (len - cursor < sizeof(TLVHead)) {
+            return false;
+        }
+        const auto *head = reinterpret_cast<const TLVHead *>(data + cursor);
+        uint16_t tag = NetToHost(head->tag);
+        uint32_t valueLen = NetToHost(head->len);
+        cursor += sizeof(TLVHead);
+        if (valueLen > len - cursor || !visit(tag, data + cursor, valueLen)) {
+            return false;
+        }
+        cursor += valueLen;
+    }
+    return true;
+}
+} // namespace
 
 PasteData::PasteData()
 { // LCOV_EXCL_START
@@ -814,6 +847,32 @@ bool PasteData::IsValidShareOption(int32_t shareOption)
     }
 } // LCOV_EXCL_STOP
 
+uint64_t PasteData::GetContentHash(const std::vector<uint8_t> &tlv)
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+    auto hashRecord = [&hash](uint16_t tag, const uint8_t *value, uint32_t len) {
+        if (tag != TAG_VECTOR_ITEM) {
+            return false;
+        }
+        // the record boundary is hashed too, so that moving a field between records changes the hash
+        hash = HashBytes(hash, reinterpret_cast<const uint8_t *>(&tag), sizeof(tag));
+        return ForEachTLV(value, len, [&hash](uint16_t itemTag, const uint8_t *itemValue, uint32_t itemLen) {
+            if (PasteDataRecord::IsContentTag(itemTag)) {
+                hash = HashBytes(hash, reinterpret_cast<const uint8_t *>(&itemTag), sizeof(itemTag));
+                hash = HashBytes(hash, reinterpret_cast<const uint8_t *>(&itemLen), sizeof(itemLen));
+                hash = HashBytes(hash, itemValue, itemLen);
+            }
+            return true;
+        });
+    };
+    bool ret = ForEachTLV(tlv.data(), tlv.size(), [&hashRecord](uint16_t tag, const uint8_t *value, uint32_t len) {
+        return tag != TAG_RECORDS || ForEachTLV(value, len, hashRecord);
+    });
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret, 0, PASTEBOARD_MODULE_COMMON, "invalid tlv, size=%{public}zu",
+        tlv.size());
+    return hash;
+}
+
 bool PasteData::IsValidPasteId(const std::string &pasteId)
 {
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(!pasteId.empty() && pasteId.size() < PASTEID_MAX_SIZE, false,
@@ -73,7 +73,8 @@ size_t MineCustomData::CountTLV() const
 }
 
 PasteDataEntry::PasteDataEntry(const PasteDataEntry &entry)
-    : rawDataSize_(entry.rawDataSize_), utdId_(entry.utdId_), mimeType_(entry.mimeType_), value_(entry.value_)
+    : rawDataSize_(entry.rawDataSize_), utdId_(entry.utdId_), utdTypeId_(entry.utdTypeId_), mimeType_(entry.mimeType_),
+      value_(entry.value_)
 { // LCOV_EXCL_START
 } // LCOV_EXCL_STOP
 
@@ -83,6 +84,7 @@ PasteDataEntry &PasteDataEntry::operator=(const PasteDataEntry &entry)
         return *this;
     }
     this->utdId_ = entry.GetUtdId();
+    this->utdTypeId_ = entry.utdTypeId_;
     this->mimeType_ = entry.GetMimeType();
     this->value_ = entry.GetValue();
     this->rawDataSize_ = entry.rawDataSize_;
@@ -91,17 +93,23 @@ PasteDataEntry &PasteDataEntry::operator=(const PasteDataEntry &entry)
 
 PasteDataEntry::PasteDataEntry(const std::string &utdId, const EntryValue &value) : utdId_(utdId), value_(value)
 { // LCOV_EXCL_START
-    mimeType_ = CommonUtils::Convert2MimeType(utdId_);
+    auto &registry = TypeRegistry::GetInstance();
+    utdTypeId_ = registry.Intern(utdId_);
+    auto mimeTypeId = registry.GetMimeType(utdTypeId_);
+    mimeType_ = mimeTypeId != TypeRegistry::INVALID_TYPE_ID ? registry.GetName(mimeTypeId) :
+        CommonUtils::Convert2MimeType(utdId_);
 } // LCOV_EXCL_STOP
 
 PasteDataEntry::PasteDataEntry(const std::string &utdId, const std::string &mimeType, const EntryValue &value)
-    : utdId_(utdId), mimeType_(std::move(mimeType)), value_(std::move(value))
+    : utdId_(utdId), utdTypeId_(TypeRegistry::GetInstance().Intern(utdId)), mimeType_(std::move(mimeType)),
+      value_(std::move(value))
 { // LCOV_EXCL_START
 } // LCOV_EXCL_STOP
 
 void PasteDataEntry::SetUtdId(const std::string &utdId)
 { // LCOV_EXCL_START
     utdId_ = utdId;
+    utdTypeId_ = TypeRegistry::GetInstance().Intern(utdId_);
 } // LCOV_EXCL_STOP
 
 std::string PasteDataEntry::GetUtdId() const
@@ -109,6 +117,11 @@ std::string PasteDataEntry::GetUtdId() const
     return utdId_;
 } // LCOV_EXCL_STOP
 
+TypeRegistry::TypeId PasteDataEntry::GetUtdTypeId() const
+{ // LCOV_EXCL_START
+    return utdTypeId_;
+} // LCOV_EXCL_STOP
+
 void PasteDataEntry::SetMimeType(const std::string &mimeType)
 { // LCOV_EXCL_START
     mimeType_ = mimeType;
@@ -146,6 +159,7 @@ bool PasteDataEntry::DecodeTLV(ReadOnlyBuffer &buffer)
         switch (head.tag) {
             case TAG_ENTRY_UTDID:
                 ret = buffer.ReadValue(utdId_, head);
+                utdTypeId_ = TypeRegistry::GetInstance().Intern(utdId_);
                 break;
             case TAG_ENTRY_MIMETYPE:
                 ret = buffer.ReadValue(mimeType_, head);
@@ -315,8 +329,12 @@ std::shared_ptr<MineCustomData> PasteDataEntry::ConvertToCustomData() const
 
 bool PasteDataEntry::HasContent(const std::string &utdId) const
 { // LCOV_EXCL_START
-    auto mimeType = CommonUtils::Convert2MimeType(utdId);
-    return HasContentByMimeType(mimeType);
+    auto &registry = TypeRegistry::GetInstance();
+    auto mimeTypeId = registry.GetMimeType(registry.Intern(utdId));
+    if (mimeTypeId == TypeRegistry::INVALID_TYPE_ID) {
+        return HasContentByMimeType(CommonUtils::Convert2MimeType(utdId));
+    }
+    return HasContentByMimeType(registry.GetName(mimeTypeId));
 } // LCOV_EXCL_STOP
 
 bool PasteDataEntry::HasContentByMimeType(const std::string &mimeType) const
@@ -481,5 +499,107 @@ bool CommonUtils::IsFileUri(const std::string &utdId)
            utdId == UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDType::FOLDER) ||
            utdId == UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDType::VIDEO);
 } // LCOV_EXCL_STOP
+
+TypeRegistry &TypeRegistry::GetInstance()
+{
+    static TypeRegistry instance;
+    return instance;
+}
+
+TypeRegistry::TypeRegistry()
+{
+    static const UDType BUILTIN_TYPES[] = { UDType::PLAIN_TEXT, UDType::HYPERLINK, UDType::HTML, UDType::FILE_URI,
+        UDType::FILE, UDType::IMAGE, UDType::VIDEO, UDType::AUDIO, UDType::FOLDER, UDType::SYSTEM_DEFINED_PIXEL_MAP,
+        UDType::OPENHARMONY_WANT };
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    for (auto type : BUILTIN_TYPES) {
+        InternLocked(UDMF::UtdUtils::GetUtdIdFromUtdEnum(type));
+    }
+}
+
+TypeRegistry::TypeId TypeRegistry::Intern(const std::string &type)
+{
+    if (type.empty()) {
+        return INVALID_TYPE_ID;
+    }
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(type);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(type);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGW(types_.size() < MAX_TYPE_COUNT, INVALID_TYPE_ID, PASTEBOARD_MODULE_COMMON,
+        "type registry is full, type=%{public}s", type.c_str());
+    return InternLocked(type);
+}
+
+TypeRegistry::TypeId TypeRegistry::InternLocked(const std::string &type)
+{
+    auto it = ids_.find(type);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    TypeId typeId = static_cast<TypeId>(types_.size() + 1);
+    types_.push_back({ type, typeId, typeId, CommonUtils::IsFileUri(type) });
+    ids_.emplace(type, typeId);
+    // converted names are builtin types or the type itself, so the recursion ends after one level
+    auto utdId = CommonUtils::Convert2UtdId(UDMF::UD_BUTT, type);
+    auto mimeType = CommonUtils::Convert2MimeType(type);
+    TypeId utdTypeId = utdId == type ? typeId : InternLocked(utdId);
+    TypeId mimeTypeId = mimeType == type ? typeId : InternLocked(mimeType);
+    types_[typeId - 1].utdId = utdTypeId;
+    types_[typeId - 1].mimeType = mimeTypeId;
+    return typeId;
+}
+
+const TypeRegistry::TypeInfo *TypeRegistry::GetInfoLocked(TypeId typeId) const
+{
+    if (typeId == INVALID_TYPE_ID || typeId > types_.size()) {
+        return nullptr;
+    }
+    return &types_[typeId - 1];
+}
+
+TypeRegistry::TypeId TypeRegistry::GetUtdId(TypeId typeId) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto info = GetInfoLocked(typeId);
+    return info == nullptr ? INVALID_TYPE_ID : info->utdId;
+}
+
+TypeRegistry::TypeId TypeRegistry::GetMimeType(TypeId typeId) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto info = GetInfoLocked(typeId);
+    return info == nullptr ? INVALID_TYPE_ID : info->mimeType;
+}
+
+bool TypeRegistry::IsFileUri(TypeId typeId) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto info = GetInfoLocked(typeId);
+    return info != nullptr && info->isFileUri;
+}
+
+const std::string &TypeRegistry::GetName(TypeId typeId) const
+{
+    static const std::string EMPTY_NAME;
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto info = GetInfoLocked(typeId);
+    // names never change once interned, the reference outlives the lock
+    return info == nullptr ? EMPTY_NAME : info->name;
+}
+
+size_t TypeRegistry::Size() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return types_.size();
+}
 } // namespace MiscServices
 } // namespace OHOS
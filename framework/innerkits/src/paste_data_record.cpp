@@ -491,15 +491,18 @@ bool PasteDataRecord::EncodeTLVRemote(WriteOnlyBuffer &buffer) const
 {
     bool ret = true;
 
-    auto remoteValue = Local2Remote();
+    auto encodeValue = GetRemoteEncodeValue();
+    auto remoteValue = encodeValue->remoteValue;
     if (remoteValue != nullptr) {
         ret = ret && buffer.Write(TAG_MIMETYPE, remoteValue->mimeType_);
         ret = ret && buffer.Write(TAG_UDC_UDTYPE, remoteValue->udType_);
         ret = ret && buffer.Write(TAG_HTMLTEXT, remoteValue->htmlText_);
         ret = ret && buffer.Write(TAG_PLAINTEXT, remoteValue->plainText_);
-        ret = ret && buffer.Write(TAG_PIXELMAP, remoteValue->pixelMap_);
-        ret = ret && buffer.Write(TAG_WANT, TLVUtils::Parcelable2Raw(remoteValue->want_.get()));
-        ret = ret && buffer.Write(TAG_URI, TLVUtils::Parcelable2Raw(remoteValue->uri_.get()));
+        if (remoteValue->pixelMap_ != nullptr) {
+            ret = ret && encodeValue->isPixelMapEncoded && buffer.Write(TAG_PIXELMAP, encodeValue->pixelMap);
+        }
+        ret = ret && buffer.Write(TAG_WANT, encodeValue->want);
+        ret = ret && buffer.Write(TAG_URI, encodeValue->uri);
         ret = ret && buffer.Write(TAG_UDC_UDMFVALUE, remoteValue->udmfValue_);
         ret = ret && buffer.Write(TAG_UDC_ENTRIES, remoteValue->entries_);
     }
@@ -522,6 +525,11 @@ bool PasteDataRecord::EncodeTLV(WriteOnlyBuffer &buffer) const
     return IsRemoteEncode() ? EncodeTLVRemote(buffer) : EncodeTLVLocal(buffer);
 }
 
+bool PasteDataRecord::IsContentTag(uint16_t tag)
+{
+    return tag != TAG_DATA_ID && tag != TAG_FROM;
+}
+
 bool PasteDataRecord::DecodeItem1(uint16_t tag, ReadOnlyBuffer &buffer, TLVHead &head)
 {
     switch (tag) {
@@ -628,15 +636,18 @@ size_t PasteDataRecord::CountTLVLocal() const
 size_t PasteDataRecord::CountTLVRemote() const
 {
     size_t expectedSize = 0;
-    auto remoteValue = Local2Remote();
+    auto encodeValue = GetRemoteEncodeValue();
+    auto remoteValue = encodeValue->remoteValue;
     if (remoteValue != nullptr) {
         expectedSize += TLVCountable::Count(remoteValue->mimeType_);
         expectedSize += TLVCountable::Count(remoteValue->udType_);
         expectedSize += TLVCountable::Count(remoteValue->htmlText_);
         expectedSize += TLVCountable::Count(remoteValue->plainText_);
-        expectedSize += TLVCountable::Count(remoteValue->pixelMap_);
-        expectedSize += TLVCountable::Count(TLVUtils::Parcelable2Raw(remoteValue->want_.get()));
-        expectedSize += TLVCountable::Count(TLVUtils::Parcelable2Raw(remoteValue->uri_.get()));
+        if (remoteValue->pixelMap_ != nullptr) {
+            expectedSize += sizeof(TLVHead) + TLVCountable::Count(encodeValue->pixelMap);
+        }
+        expectedSize += TLVCountable::Count(encodeValue->want);
+        expectedSize += TLVCountable::Count(encodeValue->uri);
         expectedSize += TLVCountable::Count(remoteValue->udmfValue_);
         expectedSize += TLVCountable::Count(remoteValue->entries_);
     }
@@ -751,6 +762,34 @@ std::shared_ptr<RemoteRecordValue> PasteDataRecord::Local2Remote() const
     return value;
 }
 
+std::shared_ptr<RemoteEncodeValue> PasteDataRecord::GetRemoteEncodeValue() const
+{
+    auto session = TLVEncodeSession::Current();
+    if (session != nullptr) {
+        auto cached = session->Find(this);
+        if (cached != nullptr) {
+            return std::static_pointer_cast<RemoteEncodeValue>(cached);
+        }
+    }
+    auto encodeValue = std::make_shared<RemoteEncodeValue>();
+    encodeValue->remoteValue = Local2Remote();
+    auto remoteValue = encodeValue->remoteValue;
+    if (remoteValue != nullptr) {
+        encodeValue->want = TLVUtils::Parcelable2Raw(remoteValue->want_.get());
+        encodeValue->uri = TLVUtils::Parcelable2Raw(remoteValue->uri_.get());
+        if (remoteValue->pixelMap_ != nullptr) {
+            encodeValue->isPixelMapEncoded = remoteValue->pixelMap_->EncodeTlv(encodeValue->pixelMap);
+            if (!encodeValue->isPixelMapEncoded) {
+                encodeValue->pixelMap.clear();
+            }
+        }
+    }
+    if (session != nullptr) {
+        session->Insert(this, encodeValue);
+    }
+    return encodeValue;
+}
+
 std::string PasteDataRecord::GetPassUri()
 { // LCOV_EXCL_START
     std::string tempUri;
@@ -936,8 +975,15 @@ void PasteDataRecord::AddEntry(const std::string &utdType, std::shared_ptr<Paste
 
 std::shared_ptr<PasteDataEntry> PasteDataRecord::GetEntryByMimeType(const std::string &mimeType)
 { // LCOV_EXCL_START
-    auto utdId = CommonUtils::Convert2UtdId(UDMF::UDType::UD_BUTT, mimeType);
-    std::shared_ptr<PasteDataEntry> entry = GetEntry(utdId);
+    auto &registry = TypeRegistry::GetInstance();
+    auto utdTypeId = registry.GetUtdId(registry.Intern(mimeType));
+    std::string unregisteredUtdId;
+    if (utdTypeId == TypeRegistry::INVALID_TYPE_ID) {
+        unregisteredUtdId = CommonUtils::Convert2UtdId(UDMF::UDType::UD_BUTT, mimeType);
+    }
+    const std::string &utdId = utdTypeId != TypeRegistry::INVALID_TYPE_ID ? registry.GetName(utdTypeId) :
+        unregisteredUtdId;
+    std::shared_ptr<PasteDataEntry> entry = GetEntry(utdTypeId, utdId);
     if (entry == nullptr && customData_ != nullptr) {
         const std::map<std::string, std::vector<uint8_t>> &itemData = customData_->GetItemData();
         for (const auto &[key, value] : itemData) {
@@ -948,27 +994,41 @@ std::shared_ptr<PasteDataEntry> PasteDataRecord::GetEntryByMimeType(const std::s
         }
     }
     if (entry == nullptr && mimeType == MIMETYPE_TEXT_PLAIN) {
-        utdId = CommonUtils::Convert2UtdId(UDMF::UDType::HYPERLINK, mimeType);
-        entry = GetEntry(utdId);
+        entry = GetEntry(CommonUtils::Convert2UtdId(UDMF::UDType::HYPERLINK, mimeType));
     }
     return entry;
 } // LCOV_EXCL_STOP
 
 std::shared_ptr<PasteDataEntry> PasteDataRecord::GetEntry(const std::string &utdType)
 { // LCOV_EXCL_START
+    return GetEntry(TypeRegistry::GetInstance().Intern(utdType), utdType);
+} // LCOV_EXCL_STOP
+
+std::shared_ptr<PasteDataEntry> PasteDataRecord::GetEntry(TypeRegistry::TypeId typeId, const std::string &utdType)
+{ // LCOV_EXCL_START
+    auto &registry = TypeRegistry::GetInstance();
+    bool isFileUri = typeId != TypeRegistry::INVALID_TYPE_ID ? registry.IsFileUri(typeId) :
+        CommonUtils::IsFileUri(utdType);
     for (auto const &entry : entries_) {
-        if (entry->GetUtdId() == utdType ||
-            (CommonUtils::IsFileUri(utdType) && CommonUtils::IsFileUri(entry->GetUtdId()))) {
-            if (isDelay_ && !entry->HasContent(utdType) && !PasteBoardCommon::IsPasteboardService()) {
-                PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "get delay entry value, dataId=%{public}u, "
-                    "recordId=%{public}u, type=%{public}s", dataId_, recordId_, utdType.c_str());
-                PasteboardServiceLoader::GetInstance().GetRecordValueByType(dataId_, recordId_, *entry);
-            }
-            if (CommonUtils::IsFileUri(utdType) && GetUriV0() != nullptr) {
-                return std::make_shared<PasteDataEntry>(utdType, GetUriV0()->ToString());
-            }
-            return entry;
+        auto entryTypeId = entry->GetUtdTypeId();
+        bool matched = false;
+        if (typeId != TypeRegistry::INVALID_TYPE_ID && entryTypeId != TypeRegistry::INVALID_TYPE_ID) {
+            matched = entryTypeId == typeId || (isFileUri && registry.IsFileUri(entryTypeId));
+        } else {
+            matched = entry->GetUtdId() == utdType || (isFileUri && CommonUtils::IsFileUri(entry->GetUtdId()));
+        }
+        if (!matched) {
+            continue;
         }
+        if (isDelay_ && !entry->HasContent(utdType) && !PasteBoardCommon::IsPasteboardService()) {
+            PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "get delay entry value, dataId=%{public}u, "
+                "recordId=%{public}u, type=%{public}s", dataId_, recordId_, utdType.c_str());
+            PasteboardServiceLoader::GetInstance().GetRecordValueByType(dataId_, recordId_, *entry);
+        }
+        if (isFileUri && GetUriV0() != nullptr) {
+            return std::make_shared<PasteDataEntry>(utdType, GetUriV0()->ToString());
+        }
+        return entry;
     }
     return nullptr;
 } // LCOV_EXCL_STOP
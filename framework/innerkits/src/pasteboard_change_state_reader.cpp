@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_change_state_reader.h"
+
+#include <cerrno>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "pasteboard_hilog.h"
+
+namespace OHOS {
+namespace MiscServices {
+ChangeStateReader::~ChangeStateReader()
+{
+    Unmap();
+}
+
+bool ChangeStateReader::Read(const sptr<IPasteboardService> &service, ChangeState &state)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(service != nullptr, false, PASTEBOARD_MODULE_CLIENT, "service is null");
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto remote = service->AsObject();
+    if (remote != remote_) {
+        // a page of a previous instance of the service is no longer written, a refusal is asked again
+        Unmap();
+        remote_ = remote;
+        Map(service);
+    }
+    return page_ != nullptr && ChangeStatePage::Read(*page_, state);
+}
+
+void ChangeStateReader::Map(const sptr<IPasteboardService> &service)
+{
+    int fd = -1;
+    int32_t ret = service->GetChangeStatePage(fd);
+    if (ret != ERR_OK || fd < 0) {
+        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "no change state page, ret=%{public}d", ret);
+        if (fd >= 0) {
+            close(fd);
+        }
+        return;
+    }
+    void *addr = mmap(nullptr, sizeof(ChangeStatePage::Layout), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    PASTEBOARD_CHECK_AND_RETURN_LOGE(addr != MAP_FAILED, PASTEBOARD_MODULE_CLIENT,
+        "mmap change state page failed, errno=%{public}d", errno);
+    page_ = static_cast<const ChangeStatePage::Layout *>(addr);
+}
+
+void ChangeStateReader::Unmap()
+{
+    if (page_ != nullptr) {
+        munmap(const_cast<ChangeStatePage::Layout *>(page_), sizeof(ChangeStatePage::Layout));
+        page_ = nullptr;
+    }
+}
+} // namespace MiscServices
+} // namespace OHOS
@@ -31,6 +31,7 @@
 #include "pasteboard_progress.h"
 #include "pasteboard_signal_callback.h"
 #include "pasteboard_time.h"
+#include "pasteboard_trace_span.h"
 #include "pasteboard_utils.h"
 #include "pasteboard_web_controller.h"
 #include "pasteboard_samgr_listener.h"
@@ -215,9 +216,42 @@ int32_t PasteboardClient::GetChangeCount(uint32_t &changeCount)
         changeCount = 0;
         return static_cast<int32_t>(PasteboardError::OBTAIN_SERVER_SA_ERROR);
     }
+    ChangeState state;
+    if (changeStateReader_.Read(proxyService, state)) {
+        changeCount = state.changeCount;
+        return static_cast<int32_t>(PasteboardError::E_OK);
+    }
     return ConvertErrCode(proxyService->GetChangeCount(changeCount));
 }
 
+int32_t PasteboardClient::GetClipHistory(std::vector<PasteClipSummary> &summaries)
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "GetClipHistory start.");
+    summaries.clear();
+    auto proxyService = GetPasteboardService();
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(proxyService != nullptr,
+        static_cast<int32_t>(PasteboardError::OBTAIN_SERVER_SA_ERROR), PASTEBOARD_MODULE_CLIENT,
+        "proxyService is nullptr");
+    std::vector<uint8_t> buffer;
+    int32_t ret = ConvertErrCode(proxyService->GetClipHistory(buffer));
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == static_cast<int32_t>(PasteboardError::E_OK), ret,
+        PASTEBOARD_MODULE_CLIENT, "get clip history failed, ret=%{public}d", ret);
+    bool decoded = PasteClipSummary::DecodeList(buffer, summaries);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(decoded, static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR),
+        PASTEBOARD_MODULE_CLIENT, "decode clip history failed, size=%{public}zu", buffer.size());
+    return ret;
+}
+
+int32_t PasteboardClient::ActivateClip(uint32_t clipId)
+{
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "ActivateClip start, clipId=%{public}u.", clipId);
+    auto proxyService = GetPasteboardService();
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(proxyService != nullptr,
+        static_cast<int32_t>(PasteboardError::OBTAIN_SERVER_SA_ERROR), PASTEBOARD_MODULE_CLIENT,
+        "proxyService is nullptr");
+    return ConvertErrCode(proxyService->ActivateClip(clipId));
+}
+
 int32_t PasteboardClient::SubscribeEntityObserver(
     EntityType entityType, uint32_t expectedDataLength, const sptr<EntityRecognitionObserver> &observer)
 {
@@ -279,6 +313,7 @@ int32_t PasteboardClient::GetPasteData(PasteData &pasteData)
     pid_t pid = getpid();
     std::string currentPid = std::to_string(pid);
     std::string currentId = PasteData::CreatePasteId("GetPasteData", getSequenceId_++);
+    PasteboardTraceSpan span(currentId, "PasteboardClient::GetPasteData");
     RADAR_REPORT(RadarReporter::DFX_GET_PASTEBOARD, RadarReporter::DFX_GET_BIZ_SCENE, RadarReporter::DFX_SUCCESS,
         RadarReporter::BIZ_STATE, RadarReporter::DFX_BEGIN, RadarReporter::CONCURRENT_ID, currentId,
         PACKAGE_NAME, currentPid);
@@ -295,10 +330,18 @@ int32_t PasteboardClient::GetPasteData(PasteData &pasteData)
     int fd = -1;
     int64_t rawDataSize = 0;
     std::vector<uint8_t> recvTLV;
-    int32_t ret = proxyService->GetPasteData(fd, rawDataSize, recvTLV, currentId, syncTime, realErrCode);
+    int32_t ret = static_cast<int32_t>(PasteboardError::E_OK);
+    {
+        PasteboardTraceSpan ipcSpan(currentId, "IPC GetPasteData");
+        ret = proxyService->GetPasteData(fd, rawDataSize, recvTLV, currentId, syncTime, realErrCode);
+    }
     int32_t bizStage = (syncTime == 0) ? RadarReporter::DFX_LOCAL_PASTE_END : RadarReporter::DFX_DISTRIBUTED_PASTE_END;
     ret = ConvertErrCode(realErrCode);
-    int32_t result = ProcessPasteData<PasteData>(pasteData, rawDataSize, fd, recvTLV);
+    int32_t result = static_cast<int32_t>(PasteboardError::E_OK);
+    {
+        PasteboardTraceSpan decodeSpan(currentId, "DecodePasteData");
+        result = ProcessPasteData<PasteData>(pasteData, rawDataSize, fd, recvTLV);
+    }
     PasteboardWebController::GetInstance().RetainUri(pasteData);
     PasteboardWebController::GetInstance().RebuildWebviewPasteData(pasteData);
     if (ret != static_cast<int32_t>(PasteboardError::E_OK)) {
@@ -452,10 +495,18 @@ int32_t PasteboardClient::GetPasteDataFromService(PasteData &pasteData,
     int64_t rawDataSize = 0;
     std::vector<uint8_t> recvTLV(0);
     std::string pasteId = pasteDataFromServiceInfo.currentId;
-    int32_t ret = proxyService->GetPasteData(fd, rawDataSize, recvTLV, pasteId, syncTime, realErrCode);
+    int32_t ret = static_cast<int32_t>(PasteboardError::E_OK);
+    {
+        PasteboardTraceSpan ipcSpan(pasteId, "IPC GetPasteData");
+        ret = proxyService->GetPasteData(fd, rawDataSize, recvTLV, pasteId, syncTime, realErrCode);
+    }
     int32_t bizStage = (syncTime == 0) ? RadarReporter::DFX_LOCAL_PASTE_END : RadarReporter::DFX_DISTRIBUTED_PASTE_END;
     ret = ConvertErrCode(realErrCode);
-    int32_t result = ProcessPasteData<PasteData>(pasteData, rawDataSize, fd, recvTLV);
+    int32_t result = static_cast<int32_t>(PasteboardError::E_OK);
+    {
+        PasteboardTraceSpan decodeSpan(pasteId, "DecodePasteData");
+        result = ProcessPasteData<PasteData>(pasteData, rawDataSize, fd, recvTLV);
+    }
     ProgressSmoothToTwentyPercent(pasteData, progressKey, params);
     PasteboardWebController::GetInstance().RetainUri(pasteData);
     if (ret != static_cast<int32_t>(PasteboardError::E_OK)) {
@@ -565,6 +616,7 @@ int32_t PasteboardClient::ProgressAfterTwentyPercent(PasteData &pasteData, std::
     int32_t ret = 0;
     bool hasUri = (pasteData.GetPrimaryUri() != nullptr);
     if (hasUri) {
+        PasteboardTraceSpan span(pasteData.GetPasteId(), "PasteBoardCopyFile");
         ret = PasteBoardCopyFile::GetInstance().CopyPasteData(pasteData, params);
     } else {
         ret = SetProgressWithoutFile(progressKey, params);
@@ -614,6 +666,7 @@ int32_t PasteboardClient::GetDataWithProgress(PasteData &pasteData, std::shared_
     }
     PasteDataFromServiceInfo pasteDataFromServiceInfo;
     ProgressRadarReport(pasteData, pasteDataFromServiceInfo);
+    PasteboardTraceSpan span(pasteDataFromServiceInfo.currentId, "PasteboardClient::GetDataWithProgress");
     StartAsyncTrace(HITRACE_TAG_MISC, "PasteboardClient::GetDataWithProgress", HITRACE_GETPASTEDATA);
     ret = GetPasteDataFromService(pasteData, pasteDataFromServiceInfo, progressKey, params);
     if (ret != static_cast<int32_t>(PasteboardError::E_OK)) {
@@ -675,6 +728,10 @@ bool PasteboardClient::HasPasteData()
     auto proxyService = GetPasteboardService();
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(proxyService != nullptr, false,
         PASTEBOARD_MODULE_CLIENT, "proxyService is nullptr");
+    ChangeState state;
+    if (changeStateReader_.Read(proxyService, state) && (state.flags & ChangeStatePage::LOCAL_ANSWER) != 0) {
+        return (state.flags & ChangeStatePage::HAS_DATA) != 0;
+    }
     bool ret = false;
     int32_t errCode = proxyService->HasPasteData(ret);
     if (errCode != ERR_OK) {
@@ -1078,6 +1135,12 @@ bool PasteboardClient::HasDataType(const std::string &mimeType)
         PASTEBOARD_MODULE_CLIENT, "proxyService is nullptr");
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(!mimeType.empty(), false, PASTEBOARD_MODULE_CLIENT, "parameter is invalid");
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_CLIENT, "type is %{public}s", mimeType.c_str());
+    uint32_t mimeTypeBit = ChangeStatePage::GetMimeTypeBit(mimeType);
+    ChangeState state;
+    if (mimeTypeBit != 0 && changeStateReader_.Read(proxyService, state) &&
+        (state.flags & ChangeStatePage::LOCAL_ANSWER) != 0) {
+        return (state.flags & ChangeStatePage::HAS_DATA) != 0 && (state.mimeTypes & mimeTypeBit) != 0;
+    }
     bool ret = false;
     int32_t retCode = proxyService->HasDataType(mimeType, ret);
     if (retCode != ERR_OK) {
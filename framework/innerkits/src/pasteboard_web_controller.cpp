@@ -15,7 +15,7 @@
 
 #include "pasteboard_web_controller.h"
 
-#include <regex>
+#include <string_view>
 
 #include "file_uri.h"
 #include "pasteboard_common.h"
@@ -24,9 +24,10 @@
 #include "ipc_skeleton.h"
 
 namespace {
-constexpr const char *IMG_TAG_PATTERN = "<img.*?>";
-constexpr const char *IMG_TAG_SRC_PATTERN = "src=(['\"])(.*?)\\1";
-constexpr const char *IMG_TAG_SRC_HEAD = "src=\"";
+constexpr std::string_view IMG_TAG_HEAD = "<img";
+constexpr std::string_view IMG_TAG_SRC_HEAD = "src=";
+constexpr std::string_view LINE_BREAKS = "\r\n";
+constexpr char IMG_TAG_TAIL = '>';
 constexpr const char *IMG_LOCAL_URI = "file:///";
 constexpr const char *IMG_LOCAL_PATH = "://";
 constexpr const char *FILE_SCHEME_PREFIX = "file://";
@@ -35,17 +36,82 @@ constexpr uint32_t FOUR_BYTES = 4;
 constexpr uint32_t EIGHT_BIT = 8;
 constexpr int32_t DOCS_LOCAL_PATH_SUBSTR_START_INDEX = 1;
 constexpr uid_t ANCO_SERVICE_BROKER_UID = 5557;
-
-struct Cmp {
-    bool operator()(const uint32_t &lhs, const uint32_t &rhs) const
-    {
-        return lhs > rhs;
-    }
-};
 } // namespace
 
 namespace OHOS {
 namespace MiscServices {
+namespace {
+// offset in html -> (new uri, old uri)
+using ReplaceUris = std::map<uint32_t, std::pair<std::string, std::string>>;
+
+// The split uri records carry their offsets in MineCustomData as packed little-endian uint32 values, the format
+// is shared with other devices and versions so it is kept on the wire and only converted here.
+std::vector<uint8_t> EncodeOffsets(const std::vector<uint32_t> &offsets)
+{
+    std::vector<uint8_t> bytes;
+    bytes.reserve(offsets.size() * FOUR_BYTES);
+    for (uint32_t offset : offsets) {
+        for (uint32_t i = 0; i < FOUR_BYTES; i++) {
+            bytes.emplace_back((offset >> (EIGHT_BIT * i)) & 0xff);
+        }
+    }
+    return bytes;
+}
+
+std::vector<uint32_t> DecodeOffsets(const std::vector<uint8_t> &bytes)
+{
+    std::vector<uint32_t> offsets;
+    offsets.reserve(bytes.size() / FOUR_BYTES);
+    for (size_t i = 0; i + FOUR_BYTES <= bytes.size(); i += FOUR_BYTES) {
+        uint32_t offset = 0;
+        for (uint32_t j = 0; j < FOUR_BYTES; j++) {
+            offset |= static_cast<uint32_t>(bytes[i + j]) << (EIGHT_BIT * j);
+        }
+        offsets.emplace_back(offset);
+    }
+    return offsets;
+}
+
+void CollectReplaceUris(const std::shared_ptr<PasteDataRecord> &record, ReplaceUris &replaceUris)
+{
+    std::shared_ptr<OHOS::Uri> uri = record->GetUriV0();
+    std::shared_ptr<MineCustomData> customData = record->GetCustomData();
+    if (uri == nullptr || customData == nullptr) {
+        return;
+    }
+    std::string newUri = uri->ToString();
+    for (const auto &[oldUri, bytes] : customData->GetItemData()) {
+        for (uint32_t offset : DecodeOffsets(bytes)) {
+            replaceUris[offset] = std::make_pair(newUri, oldUri);
+        }
+    }
+}
+
+// Assemble the rewritten html in one pass over the spans in offset order instead of replacing in place.
+std::string ApplyReplaceUris(const std::string &html, const ReplaceUris &replaceUris)
+{
+    size_t newSize = html.size();
+    for (const auto &[offset, uris] : replaceUris) {
+        newSize += uris.first.size();
+    }
+    std::string result;
+    result.reserve(newSize);
+    size_t cursor = 0;
+    for (const auto &[offset, uris] : replaceUris) {
+        size_t length = uris.second.size();
+        if (offset < cursor || offset > html.size() || length > html.size() - offset) {
+            PASTEBOARD_HILOGW(PASTEBOARD_MODULE_COMMON, "skip invalid span, offset=%{public}u, len=%{public}zu, "
+                "size=%{public}zu", offset, length, html.size());
+            continue;
+        }
+        result.append(html, cursor, offset - cursor);
+        result.append(uris.first);
+        cursor = offset + length;
+    }
+    result.append(html, cursor, std::string::npos);
+    return result;
+}
+} // namespace
 
 // static
 PasteboardWebController &PasteboardWebController::GetInstance()
@@ -255,12 +321,13 @@ void PasteboardWebController::RebuildWebviewPasteData(PasteData &pasteData, cons
 std::vector<std::shared_ptr<PasteDataRecord>> PasteboardWebController::SplitHtml2Records(
     const std::shared_ptr<std::string> &html, uint32_t recordId) noexcept
 {
-    std::vector<std::pair<std::string, uint32_t>> matchVec = SplitHtmlWithImgLabel(html);
-    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_COMMON, "matchVec size: %{public}zu", matchVec.size());
-    if (matchVec.empty()) {
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(html != nullptr, {}, PASTEBOARD_MODULE_COMMON, "html is null");
+    std::vector<std::pair<uint32_t, uint32_t>> imgTags = SplitHtmlWithImgLabel(*html);
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_COMMON, "imgTags size: %{public}zu", imgTags.size());
+    if (imgTags.empty()) {
         return {};
     }
-    std::map<std::string, std::vector<uint8_t>> imgSrcMap = SplitHtmlWithImgSrcLabel(matchVec);
+    std::map<std::string, std::vector<uint32_t>> imgSrcMap = SplitHtmlWithImgSrcLabel(*html, imgTags);
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_COMMON, "imgSrcMap size: %{public}zu", imgSrcMap.size());
     return BuildPasteDataRecords(imgSrcMap, recordId);
 }
@@ -280,7 +347,7 @@ std::shared_ptr<std::string> PasteboardWebController::RebuildHtml(std::shared_pt
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(pasteData != nullptr, nullptr, PASTEBOARD_MODULE_COMMON, "pasteData is null");
     std::vector<std::shared_ptr<PasteDataRecord>> pasteDataRecords = pasteData->AllRecords();
     std::shared_ptr<std::string> htmlData;
-    std::map<uint32_t, std::pair<std::string, std::string>, Cmp> replaceUris;
+    ReplaceUris replaceUris;
 
     for (const auto &item : pasteDataRecords) {
         PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(item != nullptr, nullptr,
@@ -289,80 +356,76 @@ std::shared_ptr<std::string> PasteboardWebController::RebuildHtml(std::shared_pt
         if (html != nullptr) {
             htmlData = html;
         }
-        std::shared_ptr<OHOS::Uri> uri = item->GetUriV0();
-        std::shared_ptr<MiscServices::MineCustomData> customData = item->GetCustomData();
-        if (uri == nullptr || customData == nullptr) {
-            continue;
-        }
-        std::map<std::string, std::vector<uint8_t>> customItemData = customData->GetItemData();
-        for (const auto &itemData : customItemData) {
-            for (uint32_t i = 0; i < itemData.second.size(); i += FOUR_BYTES) {
-                uint32_t offset = static_cast<uint32_t>(itemData.second[i]) |
-                                  static_cast<uint32_t>(itemData.second[i + 1] << 8) |
-                                  static_cast<uint32_t>(itemData.second[i + 2] << 16) |
-                                  static_cast<uint32_t>(itemData.second[i + 3] << 24);
-                replaceUris[offset] = std::make_pair(uri->ToString(), itemData.first);
-            }
-        }
+        CollectReplaceUris(item, replaceUris);
     }
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(htmlData != nullptr, nullptr, PASTEBOARD_MODULE_COMMON, "html is null");
 
     RemoveAllRecord(pasteData);
-    for (auto &replaceUri : replaceUris) {
-        htmlData->replace(replaceUri.first, replaceUri.second.second.size(), replaceUri.second.first);
+    if (!replaceUris.empty()) {
+        *htmlData = ApplyReplaceUris(*htmlData, replaceUris);
     }
     pasteData->AddHtmlRecord(*htmlData);
     return htmlData;
 }
 
-std::vector<std::pair<std::string, uint32_t>> PasteboardWebController::SplitHtmlWithImgLabel(
-    const std::shared_ptr<std::string> html) noexcept
+std::vector<std::pair<uint32_t, uint32_t>> PasteboardWebController::SplitHtmlWithImgLabel(
+    const std::string &html) noexcept
 {
-    std::smatch results;
-    std::string pattern(IMG_TAG_PATTERN);
-    std::regex reg(pattern);
-    std::string::const_iterator iterStart = html->begin();
-    std::string::const_iterator iterEnd = html->end();
-    std::vector<std::pair<std::string, uint32_t>> matchVec;
-
-    while (std::regex_search(iterStart, iterEnd, results, reg)) {
-        std::string tmp = results[0];
-        iterStart = results[0].second;
-        uint32_t offset = static_cast<uint32_t>(results[0].first - html->begin());
-        matchVec.emplace_back(tmp, offset);
-    }
-    return matchVec;
+    // same matches as the regex "<img.*?>": the shortest run up to '>' that does not cross a line break
+    std::string_view view(html);
+    std::vector<std::pair<uint32_t, uint32_t>> imgTags;
+    size_t tail = std::string_view::npos;
+    size_t pos = view.find(IMG_TAG_HEAD);
+    while (pos != std::string_view::npos) {
+        if (tail == std::string_view::npos || tail < pos + IMG_TAG_HEAD.size()) {
+            tail = view.find(IMG_TAG_TAIL, pos + IMG_TAG_HEAD.size());
+        }
+        if (tail == std::string_view::npos) {
+            break;
+        }
+        size_t lineBreak = view.substr(pos, tail - pos).find_first_of(LINE_BREAKS);
+        if (lineBreak != std::string_view::npos) {
+            pos = view.find(IMG_TAG_HEAD, pos + lineBreak + 1);
+            continue;
+        }
+        imgTags.emplace_back(static_cast<uint32_t>(pos), static_cast<uint32_t>(tail + 1 - pos));
+        pos = view.find(IMG_TAG_HEAD, tail + 1);
+    }
+    return imgTags;
 }
 
-std::map<std::string, std::vector<uint8_t>> PasteboardWebController::SplitHtmlWithImgSrcLabel(
-    const std::vector<std::pair<std::string, uint32_t>> &matchVec) noexcept
+std::map<std::string, std::vector<uint32_t>> PasteboardWebController::SplitHtmlWithImgSrcLabel(
+    const std::string &html, const std::vector<std::pair<uint32_t, uint32_t>> &imgTags) noexcept
 {
-    std::map<std::string, std::vector<uint8_t>> res;
-    std::smatch match;
-    std::regex re(IMG_TAG_SRC_PATTERN);
-    for (const auto &node : matchVec) {
-        std::string::const_iterator iterStart = node.first.begin();
-        std::string::const_iterator iterEnd = node.first.end();
-
-        while (std::regex_search(iterStart, iterEnd, match, re)) {
-            std::string tmp = match[0];
-            iterStart = match[0].second;
-            uint32_t offset = static_cast<uint32_t>(match[0].first - node.first.begin());
-            tmp = tmp.substr(strlen(IMG_TAG_SRC_HEAD));
-            tmp.pop_back();
-            if (!IsLocalURI(tmp)) {
+    // same matches as the regex "src=(['\"])(.*?)\1" inside each img tag
+    std::map<std::string, std::vector<uint32_t>> res;
+    for (const auto &[tagOffset, tagLength] : imgTags) {
+        std::string_view tag = std::string_view(html).substr(tagOffset, tagLength);
+        size_t pos = tag.find(IMG_TAG_SRC_HEAD);
+        while (pos != std::string_view::npos) {
+            size_t quotePos = pos + IMG_TAG_SRC_HEAD.size();
+            if (quotePos >= tag.size() || (tag[quotePos] != '\'' && tag[quotePos] != '"')) {
+                pos = tag.find(IMG_TAG_SRC_HEAD, pos + 1);
+                continue;
+            }
+            size_t closePos = tag.find(tag[quotePos], quotePos + 1);
+            if (closePos == std::string_view::npos) {
+                pos = tag.find(IMG_TAG_SRC_HEAD, pos + 1);
                 continue;
             }
-            offset += strlen(IMG_TAG_SRC_HEAD) + node.second;
-            for (uint32_t i = 0; i < FOUR_BYTES; i++) {
-                res[tmp].emplace_back((offset >> (EIGHT_BIT * i)) & 0xff);
+            std::string uri(tag.substr(quotePos + 1, closePos - quotePos - 1));
+            pos = tag.find(IMG_TAG_SRC_HEAD, closePos + 1);
+            if (!IsLocalURI(uri)) {
+                continue;
             }
+            res[uri].emplace_back(static_cast<uint32_t>(tagOffset + quotePos + 1));
         }
     }
     return res;
 }
 
 std::vector<std::shared_ptr<PasteDataRecord>> PasteboardWebController::BuildPasteDataRecords(
-    const std::map<std::string, std::vector<uint8_t>> &imgSrcMap, uint32_t recordId) noexcept
+    const std::map<std::string, std::vector<uint32_t>> &imgSrcMap, uint32_t recordId) noexcept
 {
     std::vector<std::shared_ptr<PasteDataRecord>> records;
     for (const auto &item : imgSrcMap) {
@@ -370,7 +433,7 @@ std::vector<std::shared_ptr<PasteDataRecord>> PasteboardWebController::BuildPast
         auto uri = std::make_shared<OHOS::Uri>(item.first);
         builder.SetUri(uri);
         auto customData = std::make_shared<MiscServices::MineCustomData>();
-        customData->AddItemData(item.first, item.second);
+        customData->AddItemData(item.first, EncodeOffsets(item.second));
         builder.SetCustomData(customData);
         auto record = builder.Build();
         record->SetFrom(recordId);
@@ -443,7 +506,7 @@ void PasteboardWebController::ReplaceHtmlRecordContentByExtraUris(
 {
     std::shared_ptr<PasteDataRecord> htmlRecord = nullptr;
     std::shared_ptr<std::string> htmlData;
-    std::map<uint32_t, std::pair<std::string, std::string>, Cmp> replaceUris;
+    ReplaceUris replaceUris;
     for (const auto &item : records) {
         auto htmlEntry = item->GetEntryByMimeType(MIMETYPE_TEXT_HTML);
         if (htmlEntry != nullptr) {
@@ -454,29 +517,15 @@ void PasteboardWebController::ReplaceHtmlRecordContentByExtraUris(
                 continue;
             }
         }
-        std::shared_ptr<OHOS::Uri> uri = item->GetUriV0();
-        std::shared_ptr<MiscServices::MineCustomData> customData = item->GetCustomData();
-        if (!uri || !customData) {
-            continue;
-        }
-        std::map<std::string, std::vector<uint8_t>> customItemData = customData->GetItemData();
-        for (auto &itemData : customItemData) {
-            for (uint32_t i = 0; i < itemData.second.size(); i += FOUR_BYTES) {
-                uint32_t offset = static_cast<uint32_t>(itemData.second[i]) |
-                                  static_cast<uint32_t>(itemData.second[i + 1] << 8) |
-                                  static_cast<uint32_t>(itemData.second[i + 2] << 16) |
-                                  static_cast<uint32_t>(itemData.second[i + 3] << 24);
-                replaceUris[offset] = std::make_pair(uri->ToString(), itemData.first);
-            }
-        }
+        CollectReplaceUris(item, replaceUris);
     }
     if (htmlData == nullptr) {
         PASTEBOARD_HILOGW(PASTEBOARD_MODULE_COMMON, "htmlData is nullptr");
         return;
     }
 
-    for (const auto &replaceUri : replaceUris) {
-        htmlData->replace(replaceUri.first, replaceUri.second.second.size(), replaceUri.second.first);
+    if (!replaceUris.empty()) {
+        *htmlData = ApplyReplaceUris(*htmlData, replaceUris);
     }
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_COMMON, "replace uri count: %{public}zu", replaceUris.size());
     if (htmlRecord != nullptr) {
@@ -21,6 +21,27 @@
 
 namespace OHOS::MiscServices {
 using namespace testing::ext;
+namespace {
+ClipPlugin::GlobalEvent CreateTestEvent(uint8_t version)
+{
+    ClipPlugin::GlobalEvent event;
+    event.version = version;
+    event.frameNum = 1;
+    event.user = 100;
+    event.seqId = 0xFFFE;
+    event.status = ClipPlugin::EVT_NORMAL;
+    event.syncTime = 12;
+    event.dataId = 0x12345678;
+    event.expiration = 0x1122334455667788;
+    event.isDelay = true;
+    event.deviceId = "networkId0123456789abcdef";
+    event.account = "account";
+    event.dataType = { "text/plain", "text/html", "text/uri", "pixelMap" };
+    event.pasteId = "GetPasteData_1234_5";
+    return event;
+}
+} // namespace
+
 class ClipPluginTest : public testing::Test {
 public:
     static void SetUpTestCase(void);
@@ -230,4 +251,95 @@ HWTEST_F(ClipPluginTest, NeedSyncTopEventTest, TestSize.Level0)
     clipPlugin.RegisterPreSyncMonitorCallback(preSyncMonitorCB);
     clipPlugin.SendPreSyncEvent(0);
 }
+
+/**
+ * @tc.name: GlobalEventTLVTest001
+ * @tc.desc: GlobalEvent encoded in TLV decodes to the same event.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(ClipPluginTest, GlobalEventTLVTest001, TestSize.Level0)
+{
+    ClipPlugin::GlobalEvent event = CreateTestEvent(ClipPlugin::GlobalEvent::TLV_VERSION);
+    std::vector<uint8_t> buffer;
+    ASSERT_TRUE(event.Serialize(buffer));
+    EXPECT_FALSE(ClipPlugin::GlobalEvent::IsJsonFormat(buffer));
+    EXPECT_EQ(buffer.size(), event.CountTLV());
+
+    ClipPlugin::GlobalEvent decoded;
+    ASSERT_TRUE(decoded.Deserialize(buffer));
+    EXPECT_EQ(decoded.version, event.version);
+    EXPECT_EQ(decoded.frameNum, event.frameNum);
+    EXPECT_EQ(decoded.user, event.user);
+    EXPECT_EQ(decoded.seqId, event.seqId);
+    EXPECT_EQ(decoded.status, event.status);
+    EXPECT_EQ(decoded.syncTime, event.syncTime);
+    EXPECT_EQ(decoded.dataId, event.dataId);
+    EXPECT_EQ(decoded.expiration, event.expiration);
+    EXPECT_EQ(decoded.isDelay, event.isDelay);
+    EXPECT_EQ(decoded.deviceId, event.deviceId);
+    EXPECT_EQ(decoded.account, event.account);
+    EXPECT_EQ(decoded.dataType, event.dataType);
+    EXPECT_EQ(decoded.pasteId, event.pasteId);
+}
+
+/**
+ * @tc.name: GlobalEventTLVTest002
+ * @tc.desc: GlobalEvent of an old version stays JSON and both formats are accepted on decode.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(ClipPluginTest, GlobalEventTLVTest002, TestSize.Level0)
+{
+    ClipPlugin::GlobalEvent event = CreateTestEvent(0);
+    std::vector<uint8_t> buffer;
+    ASSERT_TRUE(event.Serialize(buffer));
+    ASSERT_TRUE(ClipPlugin::GlobalEvent::IsJsonFormat(buffer));
+
+    std::string jsonStr(buffer.begin(), buffer.end());
+    ClipPlugin::GlobalEvent fromJson;
+    ASSERT_TRUE(fromJson.Unmarshall(jsonStr));
+    ClipPlugin::GlobalEvent decoded;
+    ASSERT_TRUE(decoded.Deserialize(buffer));
+    EXPECT_EQ(decoded.seqId, fromJson.seqId);
+    EXPECT_EQ(decoded.expiration, fromJson.expiration);
+    EXPECT_EQ(decoded.deviceId, fromJson.deviceId);
+    EXPECT_EQ(decoded.dataType, fromJson.dataType);
+
+    std::vector<uint8_t> empty;
+    EXPECT_FALSE(decoded.Deserialize(empty));
+    std::vector<uint8_t> broken = { 0x01, 0x01, 0x00 };
+    EXPECT_FALSE(decoded.Deserialize(broken));
+}
+
+/**
+ * @tc.name: GlobalEventTLVTest003
+ * @tc.desc: GlobalEvent TLV is smaller than its JSON and skips the tags of newer peers.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(ClipPluginTest, GlobalEventTLVTest003, TestSize.Level0)
+{
+    constexpr uint16_t newerTag = TAG_BUFF + 0x0F00;
+    ClipPlugin::GlobalEvent jsonEvent = CreateTestEvent(0);
+    ClipPlugin::GlobalEvent tlvEvent = CreateTestEvent(ClipPlugin::GlobalEvent::TLV_VERSION);
+    std::vector<uint8_t> jsonBuffer;
+    std::vector<uint8_t> tlvBuffer;
+    ASSERT_TRUE(jsonEvent.Serialize(jsonBuffer));
+    ASSERT_TRUE(tlvEvent.Serialize(tlvBuffer));
+    EXPECT_LT(tlvBuffer.size(), jsonBuffer.size());
+
+    std::vector<uint8_t> newer = tlvBuffer;
+    WriteOnlyBuffer extra(sizeof(TLVHead) + sizeof(int32_t));
+    ASSERT_TRUE(extra.Write(newerTag, int32_t(1)));
+    newer.insert(newer.end(), extra.data_.begin(), extra.data_.end());
+    ClipPlugin::GlobalEvent decoded;
+    ASSERT_TRUE(decoded.Deserialize(newer));
+    EXPECT_EQ(decoded.seqId, tlvEvent.seqId);
+    EXPECT_EQ(decoded.dataType, tlvEvent.dataType);
+    EXPECT_EQ(decoded.pasteId, tlvEvent.pasteId);
+}
 } // namespace OHOS::MiscServices
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+
+#include "common/concurrent_map.h"
+#include "common/concurrent_sharded_map.h"
+#include "pasteboard_hilog.h"
+
+namespace OHOS::MiscServices {
+using namespace testing::ext;
+namespace {
+constexpr int32_t CONTENTION_THREADS = 8;
+constexpr int32_t CONTENTION_LOOPS = 20000;
+constexpr int32_t CONTENTION_KEYS = 4;
+constexpr int32_t WRITE_RATIO = 16;
+
+template<typename Map>
+int64_t RunContention(Map &map)
+{
+    for (int32_t key = 0; key < CONTENTION_KEYS; ++key) {
+        map.InsertOrAssign(key, std::make_shared<std::string>(std::to_string(key)));
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int32_t i = 0; i < CONTENTION_THREADS; ++i) {
+        threads.emplace_back([&map, i]() {
+            for (int32_t loop = 0; loop < CONTENTION_LOOPS; ++loop) {
+                int32_t key = (loop + i) % CONTENTION_KEYS;
+                if (loop % WRITE_RATIO == 0) {
+                    map.InsertOrAssign(key, std::make_shared<std::string>(std::to_string(loop)));
+                    continue;
+                }
+                auto [found, value] = map.Find(key);
+                (void)found;
+                (void)value;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    auto cost = std::chrono::steady_clock::now() - start;
+    return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(cost).count());
+}
+} // namespace
+
+class ConcurrentShardedMapTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void ConcurrentShardedMapTest::SetUpTestCase(void) {}
+
+void ConcurrentShardedMapTest::TearDownTestCase(void) {}
+
+void ConcurrentShardedMapTest::SetUp(void) {}
+
+void ConcurrentShardedMapTest::TearDown(void) {}
+
+/**
+ * @tc.name: InsertFindEraseTest
+ * @tc.desc: Test basic insert, find and erase
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ConcurrentShardedMapTest, InsertFindEraseTest, TestSize.Level0)
+{
+    ConcurrentShardedMap<int32_t, std::string> map;
+    EXPECT_TRUE(map.Empty());
+    EXPECT_TRUE(map.Insert(1, "one"));
+    EXPECT_FALSE(map.Insert(1, "uno"));
+    EXPECT_TRUE(map.Emplace(2, "two"));
+    EXPECT_FALSE(map.InsertOrAssign(2, "deux"));
+    EXPECT_EQ(map.Size(), 2);
+
+    auto [found, value] = map.Find(2);
+    EXPECT_TRUE(found);
+    EXPECT_EQ(value, "deux");
+    EXPECT_FALSE(map.Find(3).first);
+    EXPECT_TRUE(map.Contains(1));
+
+    EXPECT_EQ(map.Erase(1), 1);
+    EXPECT_FALSE(map.Contains(1));
+    map.Clear();
+    EXPECT_TRUE(map.Empty());
+}
+
+/**
+ * @tc.name: FindRefTest
+ * @tc.desc: Test FindRef gives in place access without copy
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ConcurrentShardedMapTest, FindRefTest, TestSize.Level0)
+{
+    ConcurrentShardedMap<int32_t, std::shared_ptr<std::string>> map;
+    auto origin = std::make_shared<std::string>("value");
+    map.InsertOrAssign(1, origin);
+    long useCount = 0;
+    bool found = map.FindRef(1, [&useCount, &origin](const std::shared_ptr<std::string> &value) {
+        EXPECT_EQ(value.get(), origin.get());
+        useCount = value.use_count();
+    });
+    EXPECT_TRUE(found);
+    EXPECT_EQ(useCount, origin.use_count());
+    EXPECT_FALSE(map.FindRef(2, [](const auto &value) {}));
+    EXPECT_FALSE(map.FindRef(1, nullptr));
+}
+
+/**
+ * @tc.name: ComputeTest
+ * @tc.desc: Test Compute, ComputeIfPresent, ComputeIfAbsent and EraseIf
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ConcurrentShardedMapTest, ComputeTest, TestSize.Level0)
+{
+    ConcurrentShardedMap<int32_t, uint32_t> map;
+    EXPECT_TRUE(map.Compute(1, [](auto, uint32_t &value) {
+        value++;
+        return true;
+    }));
+    EXPECT_EQ(map.Find(1).second, 1);
+    EXPECT_TRUE(map.ComputeIfPresent(1, [](auto, uint32_t &value) {
+        return false;
+    }));
+    EXPECT_FALSE(map.Contains(1));
+    EXPECT_FALSE(map.ComputeIfPresent(1, [](auto, uint32_t &value) {
+        return true;
+    }));
+    EXPECT_TRUE(map.ComputeIfAbsent(2, [](auto) {
+        return 2u;
+    }));
+    EXPECT_FALSE(map.ComputeIfAbsent(2, [](auto) {
+        return 3u;
+    }));
+    EXPECT_EQ(map.Find(2).second, 2);
+
+    for (int32_t key = 0; key < 100; ++key) {
+        map.InsertOrAssign(key, static_cast<uint32_t>(key));
+    }
+    auto count = map.EraseIf([](auto, uint32_t &value) {
+        return value % 2 == 0;
+    });
+    EXPECT_EQ(count, 50);
+    uint32_t visited = 0;
+    map.ForEachRef([&visited](auto, const uint32_t &value) {
+        EXPECT_EQ(value % 2, 1);
+        visited++;
+        return false;
+    });
+    EXPECT_EQ(visited, 50);
+}
+
+/**
+ * @tc.name: ContentionBenchmarkTest
+ * @tc.desc: Compare read-mostly contention of ConcurrentMap and ConcurrentShardedMap
+ * @tc.type: PERF
+ * @tc.require:
+ */
+HWTEST_F(ConcurrentShardedMapTest, ContentionBenchmarkTest, TestSize.Level1)
+{
+    ConcurrentMap<int32_t, std::shared_ptr<std::string>> plainMap;
+    ConcurrentShardedMap<int32_t, std::shared_ptr<std::string>> shardedMap;
+    int64_t plainCost = RunContention(plainMap);
+    int64_t shardedCost = RunContention(shardedMap);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE,
+        "%{public}d threads x %{public}d ops, ConcurrentMap: %{public}" PRId64 "us, "
+        "ConcurrentShardedMap: %{public}" PRId64 "us", CONTENTION_THREADS, CONTENTION_LOOPS, plainCost, shardedCost);
+    EXPECT_EQ(shardedMap.Size(), CONTENTION_KEYS);
+    EXPECT_EQ(plainMap.Size(), CONTENTION_KEYS);
+}
+} // namespace OHOS::MiscServices
@@ -27,6 +27,19 @@ using namespace testing::ext;
 namespace OHOS {
 namespace MiscServices {
 
+static void AddTrustedDevice(const DmDeviceInfo &info)
+{
+    auto topology = std::make_shared<DMAdapter::Topology>();
+    topology->devices = DMAdapter::GetInstance().GetDevices();
+    topology->devices.emplace_back(info);
+    DMAdapter::GetInstance().PublishTopology(std::move(topology));
+}
+
+static void ClearTrustedDevices()
+{
+    DMAdapter::GetInstance().PublishTopology(std::make_shared<DMAdapter::Topology>());
+}
+
 void DistributedModuleConfigMockTest::SetUpTestCase(void)
 {
     DistributedHardware::PasteDeviceManager::pasteDeviceManager = deviceManagerMock_;
@@ -58,7 +71,7 @@ HWTEST_F(DistributedModuleConfigMockTest, GetEnabledStatusTest001, TestSize.Leve
     NiceMock<DistributedDeviceProfile::DeviceProfileClientMock> dpMock;
     EXPECT_CALL(dpMock, GetCharacteristicProfile)
         .WillRepeatedly(testing::Return(static_cast<int32_t>(PasteboardError::NO_TRUST_DEVICE_ERROR)));
-    DMAdapter::GetInstance().devices_.clear();
+    ClearTrustedDevices();
     DevProfile::GetInstance().enabledStatusCache_.Clear();
     EXPECT_CALL(*deviceManagerMock_, GetUdidByNetworkId(testing::_, testing::_, testing::_))
         .WillRepeatedly([](auto, auto, std::string &udid) {
@@ -91,7 +104,7 @@ HWTEST_F(DistributedModuleConfigMockTest, GetEnabledStatusTest002, TestSize.Leve
             characteristicProfile.characteristicValue_ = "0";
             return DistributedDeviceProfile::DP_SUCCESS;
         });
-    DMAdapter::GetInstance().devices_.clear();
+    ClearTrustedDevices();
     DevProfile::GetInstance().enabledStatusCache_.Clear();
     EXPECT_CALL(*deviceManagerMock_, GetUdidByNetworkId(testing::_, testing::_, testing::_))
         .Times(2)
@@ -110,11 +123,11 @@ HWTEST_F(DistributedModuleConfigMockTest, GetEnabledStatusTest002, TestSize.Leve
     info.authForm = IDENTICAL_ACCOUNT;
     std::copy(networkId.begin(), networkId.end(), info.networkId);
     std::copy(testName.begin(), testName.end(), info.deviceName);
-    DMAdapter::GetInstance().devices_.emplace_back(info);
+    AddTrustedDevice(info);
     DistributedModuleConfig config;
     int32_t ret = config.GetEnabledStatus();
     ASSERT_EQ(static_cast<int32_t>(PasteboardError::NO_TRUST_DEVICE_ERROR), ret);
-    DMAdapter::GetInstance().devices_.clear();
+    ClearTrustedDevices();
 }
 
 /**
@@ -132,7 +145,7 @@ HWTEST_F(DistributedModuleConfigMockTest, GetEnabledStatusTest003, TestSize.Leve
             characteristicProfile.characteristicValue_ = "1";
             return DistributedDeviceProfile::DP_SUCCESS;
         });
-    DMAdapter::GetInstance().devices_.clear();
+    ClearTrustedDevices();
     DevProfile::GetInstance().enabledStatusCache_.Clear();
     EXPECT_CALL(*deviceManagerMock_, GetUdidByNetworkId(testing::_, testing::_, testing::_))
         .Times(2)
@@ -147,11 +160,11 @@ HWTEST_F(DistributedModuleConfigMockTest, GetEnabledStatusTest003, TestSize.Leve
     info.authForm = IDENTICAL_ACCOUNT;
     std::copy(networkId.begin(), networkId.end(), info.networkId);
     std::copy(testName.begin(), testName.end(), info.deviceName);
-    DMAdapter::GetInstance().devices_.emplace_back(info);
+    AddTrustedDevice(info);
     DistributedModuleConfig config;
     int32_t ret = config.GetEnabledStatus();
     ASSERT_EQ(static_cast<int32_t>(PasteboardError::E_OK), ret);
-    DMAdapter::GetInstance().devices_.clear();
+    ClearTrustedDevices();
 }
 
 /**
@@ -169,7 +182,7 @@ HWTEST_F(DistributedModuleConfigMockTest, Notify001, TestSize.Level0)
             characteristicProfile.characteristicValue_ = "1";
             return DistributedDeviceProfile::DP_SUCCESS;
         });
-    DMAdapter::GetInstance().devices_.clear();
+    ClearTrustedDevices();
     DevProfile::GetInstance().enabledStatusCache_.Clear();
     EXPECT_CALL(*deviceManagerMock_, GetUdidByNetworkId(testing::_, testing::_, testing::_))
         .WillRepeatedly([](auto, auto, std::string &udid) {
@@ -183,12 +196,12 @@ HWTEST_F(DistributedModuleConfigMockTest, Notify001, TestSize.Level0)
     info.authForm = IDENTICAL_ACCOUNT;
     std::copy(networkId.begin(), networkId.end(), info.networkId);
     std::copy(testName.begin(), testName.end(), info.deviceName);
-    DMAdapter::GetInstance().devices_.emplace_back(info);
+    AddTrustedDevice(info);
     DistributedModuleConfig config;
     config.status_ = false;
     config.Notify();
     ASSERT_TRUE(true);
-    DMAdapter::GetInstance().devices_.clear();
+    ClearTrustedDevices();
 }
 
 /**
@@ -206,7 +219,7 @@ HWTEST_F(DistributedModuleConfigMockTest, Notify002, TestSize.Level0)
             characteristicProfile.characteristicValue_ = "1";
             return DistributedDeviceProfile::DP_SUCCESS;
         });
-    DMAdapter::GetInstance().devices_.clear();
+    ClearTrustedDevices();
     DevProfile::GetInstance().enabledStatusCache_.Clear();
     EXPECT_CALL(*deviceManagerMock_, GetUdidByNetworkId(testing::_, testing::_, testing::_))
         .WillRepeatedly([](auto, auto, std::string &udid) {
@@ -220,7 +233,7 @@ HWTEST_F(DistributedModuleConfigMockTest, Notify002, TestSize.Level0)
     info.authForm = IDENTICAL_ACCOUNT;
     std::copy(networkId.begin(), networkId.end(), info.networkId);
     std::copy(testName.begin(), testName.end(), info.deviceName);
-    DMAdapter::GetInstance().devices_.emplace_back(info);
+    AddTrustedDevice(info);
     DistributedModuleConfig config;
     config.status_ = false;
     std::function<void(bool isOn)> func = [](bool isOn) {
@@ -229,7 +242,7 @@ HWTEST_F(DistributedModuleConfigMockTest, Notify002, TestSize.Level0)
     config.observer_ = func;
     config.Notify();
     ASSERT_TRUE(true);
-    DMAdapter::GetInstance().devices_.clear();
+    ClearTrustedDevices();
 }
 
 /**
@@ -247,7 +260,7 @@ HWTEST_F(DistributedModuleConfigMockTest, GetRemoteDeviceMinVersion001, TestSize
             characteristicProfile.characteristicValue_ = "0";
             return static_cast<int32_t>(PasteboardError::NO_TRUST_DEVICE_ERROR);
         });
-    DMAdapter::GetInstance().devices_.clear();
+    ClearTrustedDevices();
     DevProfile::GetInstance().enabledStatusCache_.Clear();
     EXPECT_CALL(*deviceManagerMock_, GetUdidByNetworkId(testing::_, testing::_, testing::_))
         .WillRepeatedly([](auto, auto, std::string &udid) {
@@ -261,11 +274,11 @@ HWTEST_F(DistributedModuleConfigMockTest, GetRemoteDeviceMinVersion001, TestSize
     info.authForm = IDENTICAL_ACCOUNT;
     std::copy(networkId.begin(), networkId.end(), info.networkId);
     std::copy(testName.begin(), testName.end(), info.deviceName);
-    DMAdapter::GetInstance().devices_.emplace_back(info);
+    AddTrustedDevice(info);
     DistributedModuleConfig config;
     uint32_t minVersion = config.GetRemoteDeviceMinVersion();
     ASSERT_EQ(UINT_MAX, minVersion);
-    DMAdapter::GetInstance().devices_.clear();
+    ClearTrustedDevices();
 }
 
 /**
@@ -283,7 +296,7 @@ HWTEST_F(DistributedModuleConfigMockTest, GetRemoteDeviceMinVersion002, TestSize
             characteristicProfile.characteristicValue_ = "0";
             return static_cast<int32_t>(DistributedDeviceProfile::DP_SUCCESS);
         });
-    DMAdapter::GetInstance().devices_.clear();
+    ClearTrustedDevices();
     DevProfile::GetInstance().enabledStatusCache_.Clear();
     EXPECT_CALL(*deviceManagerMock_, GetUdidByNetworkId(testing::_, testing::_, testing::_))
         .WillRepeatedly([](auto, auto, std::string &udid) {
@@ -297,11 +310,11 @@ HWTEST_F(DistributedModuleConfigMockTest, GetRemoteDeviceMinVersion002, TestSize
     info.authForm = IDENTICAL_ACCOUNT;
     std::copy(networkId.begin(), networkId.end(), info.networkId);
     std::copy(testName.begin(), testName.end(), info.deviceName);
-    DMAdapter::GetInstance().devices_.emplace_back(info);
+    AddTrustedDevice(info);
     DistributedModuleConfig config;
     uint32_t minVersion = config.GetRemoteDeviceMinVersion();
     ASSERT_EQ(UINT_MAX, minVersion);
-    DMAdapter::GetInstance().devices_.clear();
+    ClearTrustedDevices();
 }
 
 /**
@@ -319,7 +332,7 @@ HWTEST_F(DistributedModuleConfigMockTest, GetRemoteDeviceMinVersion003, TestSize
             characteristicProfile.characteristicValue_ = "1";
             return static_cast<int32_t>(PasteboardError::NO_TRUST_DEVICE_ERROR);
         });
-    DMAdapter::GetInstance().devices_.clear();
+    ClearTrustedDevices();
     DevProfile::GetInstance().enabledStatusCache_.Clear();
     EXPECT_CALL(*deviceManagerMock_, GetUdidByNetworkId(testing::_, testing::_, testing::_))
         .WillRepeatedly([](auto, auto, std::string &udid) {
@@ -333,11 +346,11 @@ HWTEST_F(DistributedModuleConfigMockTest, GetRemoteDeviceMinVersion003, TestSize
     info.authForm = IDENTICAL_ACCOUNT;
     std::copy(networkId.begin(), networkId.end(), info.networkId);
     std::copy(testName.begin(), testName.end(), info.deviceName);
-    DMAdapter::GetInstance().devices_.emplace_back(info);
+    AddTrustedDevice(info);
     DistributedModuleConfig config;
     uint32_t minVersion = config.GetRemoteDeviceMinVersion();
     ASSERT_EQ(UINT_MAX, minVersion);
-    DMAdapter::GetInstance().devices_.clear();
+    ClearTrustedDevices();
 }
 
 /**
@@ -355,7 +368,7 @@ HWTEST_F(DistributedModuleConfigMockTest, GetRemoteDeviceMinVersion004, TestSize
             characteristicProfile.characteristicValue_ = "1";
             return static_cast<int32_t>(DistributedDeviceProfile::DP_SUCCESS);
         });
-    DMAdapter::GetInstance().devices_.clear();
+    ClearTrustedDevices();
     DevProfile::GetInstance().enabledStatusCache_.Clear();
     EXPECT_CALL(*deviceManagerMock_, GetUdidByNetworkId(testing::_, testing::_, testing::_))
         .WillRepeatedly([](auto, auto, std::string &udid) {
@@ -369,11 +382,11 @@ HWTEST_F(DistributedModuleConfigMockTest, GetRemoteDeviceMinVersion004, TestSize
     info.authForm = IDENTICAL_ACCOUNT;
     std::copy(networkId.begin(), networkId.end(), info.networkId);
     std::copy(testName.begin(), testName.end(), info.deviceName);
-    DMAdapter::GetInstance().devices_.emplace_back(info);
+    AddTrustedDevice(info);
     DistributedModuleConfig config;
     uint32_t minVersion = config.GetRemoteDeviceMinVersion();
     ASSERT_EQ(UINT_MAX, minVersion);
-    DMAdapter::GetInstance().devices_.clear();
+    ClearTrustedDevices();
 }
 
 } // namespace MiscServices
@@ -16,10 +16,20 @@
 #include <gtest/gtest.h>
 
 #include "device/distributed_module_config.h"
+#include "device/dm_adapter.h"
 #include "pasteboard_error.h"
 
 namespace OHOS::MiscServices {
 using namespace testing::ext;
+
+static void AddTrustedDevice(const DmDeviceInfo &info)
+{
+    auto topology = std::make_shared<DMAdapter::Topology>();
+    topology->devices = DMAdapter::GetInstance().GetDevices();
+    topology->devices.emplace_back(info);
+    DMAdapter::GetInstance().PublishTopology(std::move(topology));
+}
+
 class DistributedModuleConfigTest : public testing::Test {
 public:
     static void SetUpTestCase(void);
@@ -86,7 +96,7 @@ HWTEST_F(DistributedModuleConfigTest, IsOnTest003, TestSize.Level0)
     info.authForm = IDENTICAL_ACCOUNT;
     std::copy(networkId.begin(), networkId.end(), info.networkId);
     std::copy(testName.begin(), testName.end(), info.deviceName);
-    DMAdapter::GetInstance().devices_.emplace_back(info);
+    AddTrustedDevice(info);
 
     DistributedModuleConfig config;
     bool result = config.IsOn();
@@ -24,6 +24,11 @@ using namespace testing::ext;
 namespace OHOS {
 namespace MiscServices {
 
+static void ClearTrustedDevices()
+{
+    DMAdapter::GetInstance().PublishTopology(std::make_shared<DMAdapter::Topology>());
+}
+
 void DMAdapterMockTest::SetUpTestCase(void)
 {
     DistributedHardware::PasteDeviceManager::pasteDeviceManager = deviceManagerMock_;
@@ -297,7 +302,7 @@ HWTEST_F(DMAdapterMockTest, SetDevices001, TestSize.Level0)
     EXPECT_CALL(*deviceManagerMock_, IsSameAccount(testing::_)).Times(0);
     DMAdapter::GetInstance().SetDevices();
     ASSERT_TRUE(true);
-    DMAdapter::GetInstance().devices_.clear();
+    ClearTrustedDevices();
 #else
     ASSERT_TRUE(true);
 #endif
@@ -325,7 +330,7 @@ HWTEST_F(DMAdapterMockTest, SetDevices002, TestSize.Level0)
     EXPECT_CALL(*deviceManagerMock_, IsSameAccount(testing::_)).Times(1).WillRepeatedly(testing::Return(false));
     DMAdapter::GetInstance().SetDevices();
     ASSERT_TRUE(true);
-    DMAdapter::GetInstance().devices_.clear();
+    ClearTrustedDevices();
 #else
     ASSERT_TRUE(true);
 #endif
@@ -353,7 +358,7 @@ HWTEST_F(DMAdapterMockTest, SetDevices003, TestSize.Level0)
     EXPECT_CALL(*deviceManagerMock_, IsSameAccount(testing::_)).Times(1).WillRepeatedly(testing::Return(true));
     DMAdapter::GetInstance().SetDevices();
     ASSERT_TRUE(true);
-    DMAdapter::GetInstance().devices_.clear();
+    ClearTrustedDevices();
 #else
     ASSERT_TRUE(true);
 #endif
@@ -24,6 +24,15 @@
 namespace OHOS::MiscServices {
 using namespace testing::ext;
 constexpr uint32_t SLEEP_MS = 10;
+
+static void AddTrustedDevice(const DmDeviceInfo &info)
+{
+    auto topology = std::make_shared<DMAdapter::Topology>();
+    topology->devices = DMAdapter::GetInstance().GetDevices();
+    topology->devices.emplace_back(info);
+    DMAdapter::GetInstance().PublishTopology(std::move(topology));
+}
+
 class DMAdapterTest : public testing::Test {
 public:
     static void SetUpTestCase(void);
@@ -346,7 +355,7 @@ HWTEST_F(DMAdapterTest, GetNetworkIds001, TestSize.Level0)
     info.authForm = IDENTICAL_ACCOUNT;
     std::copy(networkId.begin(), networkId.end(), info.networkId);
     std::copy(testName.begin(), testName.end(), info.deviceName);
-    DMAdapter::GetInstance().devices_.emplace_back(info);
+    AddTrustedDevice(info);
     auto ids = DMAdapter::GetInstance().GetNetworkIds();
     ASSERT_NE(0, ids.size());
 #else
@@ -498,7 +507,7 @@ HWTEST_F(DMAdapterTest, GetRemoteDeviceInfo002, TestSize.Level0)
     info.authForm = IDENTICAL_ACCOUNT;
     std::copy(networkId.begin(), networkId.end(), info.networkId);
     std::copy(testName.begin(), testName.end(), info.deviceName);
-    DMAdapter::GetInstance().devices_.emplace_back(info);
+    AddTrustedDevice(info);
     DmDeviceInfo remoteDevice;
     int32_t result = DMAdapter::GetInstance().GetRemoteDeviceInfo(networkId, remoteDevice);
     ASSERT_EQ(static_cast<int32_t>(PasteboardError::E_OK), result);
@@ -525,7 +534,7 @@ HWTEST_F(DMAdapterTest, GetRemoteDeviceInfo003, TestSize.Level0)
     info.authForm = IDENTICAL_ACCOUNT;
     std::copy(networkId.begin(), networkId.end(), info.networkId);
     std::copy(testName.begin(), testName.end(), info.deviceName);
-    DMAdapter::GetInstance().devices_.emplace_back(info);
+    AddTrustedDevice(info);
     DmDeviceInfo remoteDevice;
     int32_t result = DMAdapter::GetInstance().GetRemoteDeviceInfo("testNetworkId", remoteDevice);
     ASSERT_EQ(static_cast<int32_t>(PasteboardError::NO_TRUST_DEVICE_ERROR), result);
@@ -577,7 +586,7 @@ HWTEST_F(DMAdapterTest, IsSameAccount002, TestSize.Level0)
     info.authForm = IDENTICAL_ACCOUNT;
     std::copy(networkId.begin(), networkId.end(), info.networkId);
     std::copy(testName.begin(), testName.end(), info.deviceName);
-    DMAdapter::GetInstance().devices_.emplace_back(info);
+    AddTrustedDevice(info);
     bool ret = DMAdapter::GetInstance().IsSameAccount(networkId);
     ASSERT_TRUE(ret);
 #else
@@ -603,7 +612,7 @@ HWTEST_F(DMAdapterTest, IsSameAccount003, TestSize.Level0)
     info.authForm = IDENTICAL_ACCOUNT;
     std::copy(networkId.begin(), networkId.end(), info.networkId);
     std::copy(testName.begin(), testName.end(), info.deviceName);
-    DMAdapter::GetInstance().devices_.emplace_back(info);
+    AddTrustedDevice(info);
     bool ret = DMAdapter::GetInstance().IsSameAccount("testNetworkId");
     ASSERT_FALSE(ret);
 #else
@@ -693,7 +702,7 @@ HWTEST_F(DMAdapterTest, GetDeviceName003, TestSize.Level0)
     info.authForm = IDENTICAL_ACCOUNT;
     std::copy(networkId.begin(), networkId.end(), info.networkId);
     std::copy(expectedDeviceName.begin(), expectedDeviceName.end(), info.deviceName);
-    DMAdapter::GetInstance().devices_.emplace_back(info);
+    AddTrustedDevice(info);
     std::string actualDeviceName = DMAdapter::GetInstance().GetDeviceName(networkId);
     EXPECT_EQ(expectedDeviceName, actualDeviceName);
 #else
@@ -719,7 +728,7 @@ HWTEST_F(DMAdapterTest, GetDeviceName004, TestSize.Level0)
     info.authForm = IDENTICAL_ACCOUNT;
     std::copy(networkId.begin(), networkId.end(), info.networkId);
     std::copy(testName.begin(), testName.end(), info.deviceName);
-    DMAdapter::GetInstance().devices_.emplace_back(info);
+    AddTrustedDevice(info);
     std::string actualDeviceName = DMAdapter::GetInstance().GetDeviceName("testNetworkId");
     EXPECT_EQ("unknown", actualDeviceName);
 #else
@@ -727,6 +736,59 @@ HWTEST_F(DMAdapterTest, GetDeviceName004, TestSize.Level0)
 #endif
 }
 
+/**
+ * @tc.name: TopologyCacheTest001
+ * @tc.desc: lookups are served from the published topology and counted as cache hits, unknown ids as misses
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(DMAdapterTest, TopologyCacheTest001, TestSize.Level0)
+{
+#ifdef PB_DEVICE_MANAGER_ENABLE
+    std::string networkId = "cacheNetworkId";
+    std::string testName = "cacheDeviceName";
+    DmDeviceInfo info;
+    info.authForm = IDENTICAL_ACCOUNT;
+    std::copy(networkId.begin(), networkId.end(), info.networkId);
+    std::copy(testName.begin(), testName.end(), info.deviceName);
+    auto &adapter = DMAdapter::GetInstance();
+    auto before = adapter.GetCacheStats();
+    auto topology = std::make_shared<DMAdapter::Topology>();
+    topology->devices.emplace_back(info);
+    topology->udids.emplace(networkId, "cacheUdid");
+    topology->localNetworkId = "cacheLocalNetworkId";
+    adapter.PublishTopology(std::move(topology));
+
+    auto stats = adapter.GetCacheStats();
+    EXPECT_EQ(stats.version, before.version + 1);
+    EXPECT_EQ(stats.deviceCount, 1);
+    EXPECT_GE(stats.ageMs, 0);
+    EXPECT_EQ(adapter.GetUdidByNetworkId(networkId), "cacheUdid");
+    EXPECT_EQ(adapter.GetLocalNetworkId(), "cacheLocalNetworkId");
+    EXPECT_EQ(adapter.GetDeviceName(networkId), testName);
+    EXPECT_TRUE(adapter.IsSameAccount(networkId));
+    DmDeviceInfo remoteDevice;
+    EXPECT_EQ(adapter.GetRemoteDeviceInfo(networkId, remoteDevice), static_cast<int32_t>(PasteboardError::E_OK));
+    EXPECT_EQ(adapter.GetNetworkIds().size(), 1);
+    stats = adapter.GetCacheStats();
+    EXPECT_EQ(stats.hits, before.hits + 6);
+    EXPECT_EQ(stats.misses, before.misses);
+
+    EXPECT_EQ(adapter.GetDeviceName("unknownNetworkId"), "unknown");
+    EXPECT_FALSE(adapter.IsSameAccount("unknownNetworkId"));
+    stats = adapter.GetCacheStats();
+    EXPECT_EQ(stats.hits, before.hits + 6);
+    EXPECT_EQ(stats.misses, before.misses + 2);
+
+    adapter.PublishTopology(std::make_shared<DMAdapter::Topology>());
+    EXPECT_TRUE(adapter.GetNetworkIds().empty());
+    EXPECT_EQ(adapter.GetCacheStats().version, before.version + 2);
+#else
+    ASSERT_TRUE(true);
+#endif
+}
+
 /**
  * @tc.name: DeInitialize
  * @tc.desc: De Initialize
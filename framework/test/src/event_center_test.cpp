@@ -28,6 +28,8 @@ public:
         TEST_EVT_BEGIN = Event::EVT_REMOTE_CHANGE + 1,
         TEST_EVT_MIDDLE,
         TEST_EVT_END,
+        TEST_EVT_RELIABLE,
+        TEST_EVT_DUPLICATE,
     };
     class TestBegin : public Event {
     public:
@@ -41,6 +43,14 @@ public:
     public:
         TestEnd() : Event(TEST_EVT_END) {};
     };
+    class TestDuplicate : public Event {
+    public:
+        TestDuplicate() : Event(TEST_EVT_DUPLICATE) {};
+        bool Equals(const Event &evt) const override
+        {
+            return evt.GetEventId() == GetEventId();
+        }
+    };
     static void SetUpTestCase(void) { }
     static void TearDownTestCase(void) { }
     void SetUp()
@@ -192,4 +202,165 @@ HWTEST_F(EventCenterTest, UnsubscribeTest, TestSize.Level2)
     bool result = EventCenter::GetInstance().Unsubscribe(evtId);
     EXPECT_FALSE(result);
 }
-} // namespace OHOS::MiscServices
\ No newline at end of file
+
+/**
+ * @tc.name: QueueFullTest
+ * @tc.desc: the deferred queue is bounded, extra events are rejected and counted.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(EventCenterTest, QueueFullTest, TestSize.Level2)
+{
+    int32_t dispatched = 0;
+    EventCenter::GetInstance().Subscribe(TEST_EVT_UNKNOWN, [&dispatched](const Event &evt) {
+        dispatched++;
+    });
+    int32_t rejected = 0;
+    {
+        EventCenter::Defer defer;
+        for (int32_t i = 0; i <= EventCenter::AsyncQueue::MAX_CAPABILITY; ++i) {
+            auto ret = EventCenter::GetInstance().PostEvent(std::make_unique<Event>(TEST_EVT_UNKNOWN));
+            rejected += (ret == EventCenter::CODE_QUEUE_FULL) ? 1 : 0;
+        }
+    }
+    EventCenter::GetInstance().Unsubscribe(TEST_EVT_UNKNOWN);
+    EXPECT_EQ(rejected, 1);
+    EXPECT_EQ(dispatched, EventCenter::AsyncQueue::MAX_CAPABILITY);
+    auto stats = EventCenter::GetInstance().GetEventStats();
+    ASSERT_NE(stats.find(TEST_EVT_UNKNOWN), stats.end());
+    EXPECT_GE(stats[TEST_EVT_UNKNOWN].dropped, 1);
+    EXPECT_EQ(stats[TEST_EVT_UNKNOWN].maxQueueDepth, EventCenter::AsyncQueue::MAX_CAPABILITY);
+    EXPECT_GE(stats[TEST_EVT_UNKNOWN].count, EventCenter::AsyncQueue::MAX_CAPABILITY);
+}
+
+/**
+ * @tc.name: ReliableQueueFullTest
+ * @tc.desc: events of a reliable id are queued beyond the capability and all dispatched.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(EventCenterTest, ReliableQueueFullTest, TestSize.Level2)
+{
+    int32_t dispatched = 0;
+    EventCenter::GetInstance().SetReliable(TEST_EVT_RELIABLE);
+    EventCenter::GetInstance().Subscribe(TEST_EVT_RELIABLE, [&dispatched](const Event &evt) {
+        dispatched++;
+    });
+    constexpr int32_t extra = 5;
+    int32_t rejected = 0;
+    {
+        EventCenter::Defer defer;
+        for (int32_t i = 0; i < EventCenter::AsyncQueue::MAX_CAPABILITY + extra; ++i) {
+            auto ret = EventCenter::GetInstance().PostEvent(std::make_unique<Event>(TEST_EVT_RELIABLE));
+            rejected += (ret == EventCenter::CODE_QUEUE_FULL) ? 1 : 0;
+        }
+    }
+    EventCenter::GetInstance().Unsubscribe(TEST_EVT_RELIABLE);
+    EXPECT_EQ(rejected, 0);
+    EXPECT_EQ(dispatched, EventCenter::AsyncQueue::MAX_CAPABILITY + extra);
+    auto stats = EventCenter::GetInstance().GetEventStats();
+    ASSERT_NE(stats.find(TEST_EVT_RELIABLE), stats.end());
+    EXPECT_EQ(stats[TEST_EVT_RELIABLE].dropped, 0);
+    EXPECT_EQ(stats[TEST_EVT_RELIABLE].overflowed, extra);
+    EXPECT_EQ(stats[TEST_EVT_RELIABLE].maxQueueDepth, EventCenter::AsyncQueue::MAX_CAPABILITY + extra);
+}
+
+/**
+ * @tc.name: DrainRoundsExhaustedTest
+ * @tc.desc: past the drain rounds the reliable events still run and the others are counted as dropped.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(EventCenterTest, DrainRoundsExhaustedTest, TestSize.Level2)
+{
+    constexpr int32_t maxPosts = EventCenter::AsyncQueue::MAX_DRAIN_ROUNDS * 2;
+    int32_t unreliable = 0;
+    int32_t reliable = 0;
+    EventCenter::GetInstance().SetReliable(TEST_EVT_RELIABLE);
+    EventCenter::GetInstance().Subscribe(TEST_EVT_UNKNOWN, [&unreliable](const Event &evt) {
+        // each event posts the next ones, more than the drain rounds take
+        if (++unreliable < maxPosts) {
+            EventCenter::GetInstance().PostEvent(std::make_unique<Event>(TEST_EVT_UNKNOWN));
+            EventCenter::GetInstance().PostEvent(std::make_unique<Event>(TEST_EVT_RELIABLE));
+        }
+    });
+    EventCenter::GetInstance().Subscribe(TEST_EVT_RELIABLE, [&reliable](const Event &evt) {
+        reliable++;
+    });
+    auto before = EventCenter::GetInstance().GetEventStats();
+    {
+        EventCenter::Defer defer;
+        EventCenter::GetInstance().PostEvent(std::make_unique<Event>(TEST_EVT_UNKNOWN));
+    }
+    EventCenter::GetInstance().Unsubscribe(TEST_EVT_UNKNOWN);
+    EventCenter::GetInstance().Unsubscribe(TEST_EVT_RELIABLE);
+    EXPECT_EQ(unreliable, EventCenter::AsyncQueue::MAX_DRAIN_ROUNDS);
+    EXPECT_EQ(reliable, unreliable);
+    auto after = EventCenter::GetInstance().GetEventStats();
+    EXPECT_EQ(after[TEST_EVT_UNKNOWN].dropped, before[TEST_EVT_UNKNOWN].dropped + 1);
+    EXPECT_EQ(after[TEST_EVT_RELIABLE].dropped, before[TEST_EVT_RELIABLE].dropped);
+}
+
+/**
+ * @tc.name: DuplicateQueueFullTest
+ * @tc.desc: a duplicate of a queued event posted to a full queue is accepted and not counted as dropped.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(EventCenterTest, DuplicateQueueFullTest, TestSize.Level2)
+{
+    int32_t duplicates = 0;
+    EventCenter::GetInstance().Subscribe(TEST_EVT_DUPLICATE, [&duplicates](const Event &evt) {
+        duplicates++;
+    });
+    EventCenter::GetInstance().Subscribe(TEST_EVT_UNKNOWN, [](const Event &evt) {});
+    auto before = EventCenter::GetInstance().GetEventStats();
+    int32_t ret = EventCenter::CODE_INVALID_ARGS;
+    {
+        EventCenter::Defer defer;
+        EventCenter::GetInstance().PostEvent(std::make_unique<TestDuplicate>());
+        for (int32_t i = 1; i < EventCenter::AsyncQueue::MAX_CAPABILITY; ++i) {
+            EventCenter::GetInstance().PostEvent(std::make_unique<Event>(TEST_EVT_UNKNOWN));
+        }
+        ret = EventCenter::GetInstance().PostEvent(std::make_unique<TestDuplicate>());
+    }
+    EventCenter::GetInstance().Unsubscribe(TEST_EVT_DUPLICATE);
+    EventCenter::GetInstance().Unsubscribe(TEST_EVT_UNKNOWN);
+    EXPECT_EQ(ret, EventCenter::CODE_ASYNC);
+    EXPECT_EQ(duplicates, 1);
+    auto after = EventCenter::GetInstance().GetEventStats();
+    EXPECT_EQ(after[TEST_EVT_DUPLICATE].dropped, before[TEST_EVT_DUPLICATE].dropped);
+    EXPECT_EQ(after[TEST_EVT_UNKNOWN].dropped, before[TEST_EVT_UNKNOWN].dropped);
+}
+
+/**
+ * @tc.name: SubscribeDuringDispatchTest
+ * @tc.desc: observers subscribed while dispatching take effect from the next event.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(EventCenterTest, SubscribeDuringDispatchTest, TestSize.Level2)
+{
+    int32_t first = 0;
+    int32_t second = 0;
+    EventCenter::GetInstance().Subscribe(TEST_EVT_UNKNOWN, [&first, &second](const Event &evt) {
+        if (first++ == 0) {
+            EventCenter::GetInstance().Subscribe(TEST_EVT_UNKNOWN, [&second](const Event &evt) {
+                second++;
+            });
+        }
+    });
+    EventCenter::GetInstance().PostEvent(std::make_unique<Event>(TEST_EVT_UNKNOWN));
+    EXPECT_EQ(first, 1);
+    EXPECT_EQ(second, 0);
+    EventCenter::GetInstance().PostEvent(std::make_unique<Event>(TEST_EVT_UNKNOWN));
+    EXPECT_EQ(first, 2);
+    EXPECT_EQ(second, 1);
+    EXPECT_TRUE(EventCenter::GetInstance().Unsubscribe(TEST_EVT_UNKNOWN));
+}
+} // namespace OHOS::MiscServices
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "common/block_object.h"
+#include "common/latest_wins_publisher.h"
+
+namespace OHOS::MiscServices {
+using namespace testing::ext;
+namespace {
+constexpr uint32_t DEBOUNCE_MS = 20;
+constexpr uint32_t WAIT_MS = 1000;
+constexpr int32_t BURST_SIZE = 100;
+constexpr uint32_t LONG_DEBOUNCE_MS = 60000;
+constexpr uint32_t TIMEOUT_MS = 50;
+} // namespace
+
+class LatestWinsPublisherTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void LatestWinsPublisherTest::SetUpTestCase(void) {}
+
+void LatestWinsPublisherTest::TearDownTestCase(void) {}
+
+void LatestWinsPublisherTest::SetUp(void) {}
+
+void LatestWinsPublisherTest::TearDown(void) {}
+
+/**
+ * @tc.name: BurstTest
+ * @tc.desc: a burst of submissions publishes the latest value only
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LatestWinsPublisherTest, BurstTest, TestSize.Level0)
+{
+    std::vector<int32_t> published;
+    auto block = std::make_shared<BlockObject<bool>>(WAIT_MS, false);
+    LatestWinsPublisher<int32_t> publisher(
+        [&published, block](int32_t &value, const auto &isSuperseded) {
+            published.push_back(value);
+            if (value == BURST_SIZE - 1) {
+                block->SetValue(true);
+            }
+            return true;
+        },
+        DEBOUNCE_MS);
+    for (int32_t i = 0; i < BURST_SIZE; ++i) {
+        EXPECT_TRUE(publisher.Submit(i));
+    }
+    ASSERT_TRUE(block->GetValue());
+    publisher.Stop();
+    ASSERT_FALSE(published.empty());
+    EXPECT_EQ(published.back(), BURST_SIZE - 1);
+    auto stats = publisher.GetStats();
+    EXPECT_EQ(stats.submitted, BURST_SIZE);
+    EXPECT_EQ(stats.published, published.size());
+    EXPECT_EQ(stats.skipped + stats.published, BURST_SIZE);
+    EXPECT_FALSE(publisher.Submit(BURST_SIZE));
+}
+
+/**
+ * @tc.name: SupersededTest
+ * @tc.desc: a running task sees itself superseded by a newer submission
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LatestWinsPublisherTest, SupersededTest, TestSize.Level0)
+{
+    auto started = std::make_shared<BlockObject<bool>>(WAIT_MS, false);
+    auto resume = std::make_shared<BlockObject<bool>>(WAIT_MS, false);
+    auto done = std::make_shared<BlockObject<bool>>(WAIT_MS, false);
+    LatestWinsPublisher<int32_t> publisher(
+        [started, resume, done](int32_t &value, const auto &isSuperseded) {
+            if (value == 0) {
+                started->SetValue(true);
+                resume->GetValue();
+                return !isSuperseded();
+            }
+            done->SetValue(true);
+            return true;
+        },
+        0);
+    EXPECT_TRUE(publisher.Submit(0));
+    ASSERT_TRUE(started->GetValue());
+    EXPECT_TRUE(publisher.Submit(1));
+    resume->SetValue(true);
+    ASSERT_TRUE(done->GetValue());
+    publisher.Stop();
+    auto stats = publisher.GetStats();
+    EXPECT_EQ(stats.canceled, 1);
+    EXPECT_EQ(stats.published, 1);
+}
+
+/**
+ * @tc.name: IdleTest
+ * @tc.desc: a value submitted while no task is running is published without the debounce
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LatestWinsPublisherTest, IdleTest, TestSize.Level0)
+{
+    auto done = std::make_shared<BlockObject<bool>>(WAIT_MS, false);
+    LatestWinsPublisher<int32_t> publisher(
+        [done](int32_t &value, const auto &isSuperseded) {
+            done->SetValue(true);
+            return true;
+        },
+        LONG_DEBOUNCE_MS);
+    EXPECT_TRUE(publisher.Submit(0));
+    ASSERT_TRUE(done->GetValue());
+    publisher.Stop();
+    EXPECT_EQ(publisher.GetStats().published, 1);
+}
+
+/**
+ * @tc.name: TimeoutTest
+ * @tc.desc: a task running past the timeout is left superseded and the next value is published meanwhile
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LatestWinsPublisherTest, TimeoutTest, TestSize.Level0)
+{
+    auto started = std::make_shared<BlockObject<bool>>(WAIT_MS, false);
+    auto resume = std::make_shared<BlockObject<bool>>(WAIT_MS, false);
+    auto done = std::make_shared<BlockObject<bool>>(WAIT_MS, false);
+    auto expired = std::make_shared<BlockObject<bool>>(WAIT_MS, false);
+    LatestWinsPublisher<int32_t> publisher(
+        [started, resume, done, expired](int32_t &value, const auto &isSuperseded) {
+            if (value == 0) {
+                started->SetValue(true);
+                resume->GetValue();
+                expired->SetValue(isSuperseded());
+                return true;
+            }
+            done->SetValue(true);
+            return true;
+        },
+        0, TIMEOUT_MS);
+    EXPECT_TRUE(publisher.Submit(0));
+    ASSERT_TRUE(started->GetValue());
+    EXPECT_TRUE(publisher.Submit(1));
+    ASSERT_TRUE(done->GetValue());
+    resume->SetValue(true);
+    EXPECT_TRUE(expired->GetValue());
+    publisher.Stop();
+    auto stats = publisher.GetStats();
+    EXPECT_EQ(stats.timedOut, 1);
+    EXPECT_EQ(stats.published, 1);
+}
+} // namespace OHOS::MiscServices
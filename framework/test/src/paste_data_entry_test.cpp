@@ -523,4 +523,66 @@ HWTEST_F(PasteDataEntryTest, EntryTest003, TestSize.Level0)
     mimeType = "test";
     EXPECT_EQ(utils.Convert(uDType, mimeType), UDMF::APPLICATION_DEFINED_RECORD);
 }
-} // namespace OHOS::MiscServices
\ No newline at end of file
+/**
+ * @tc.name: TypeRegistryTest001
+ * @tc.desc: interned ids carry the precomputed mime/utd mapping and file uri classification
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteDataEntryTest, TypeRegistryTest001, TestSize.Level0)
+{
+    auto &registry = TypeRegistry::GetInstance();
+    auto plainMimeId = registry.Intern(MIMETYPE_TEXT_PLAIN);
+    auto plainUtdId = registry.Intern(UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDMF::PLAIN_TEXT));
+    ASSERT_NE(plainMimeId, TypeRegistry::INVALID_TYPE_ID);
+    EXPECT_EQ(registry.Intern(MIMETYPE_TEXT_PLAIN), plainMimeId);
+    EXPECT_EQ(registry.GetUtdId(plainMimeId), plainUtdId);
+    EXPECT_EQ(registry.GetMimeType(plainUtdId), plainMimeId);
+    EXPECT_EQ(registry.GetName(plainUtdId), UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDMF::PLAIN_TEXT));
+
+    auto hyperlinkId = registry.Intern(UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDMF::HYPERLINK));
+    EXPECT_EQ(registry.GetMimeType(hyperlinkId), plainMimeId);
+
+    auto imageId = registry.Intern(UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDMF::IMAGE));
+    EXPECT_TRUE(registry.IsFileUri(imageId));
+    EXPECT_EQ(registry.GetName(registry.GetMimeType(imageId)), MIMETYPE_TEXT_URI);
+    EXPECT_FALSE(registry.IsFileUri(plainUtdId));
+
+    auto customId = registry.Intern("TypeRegistryTest001.custom");
+    EXPECT_EQ(registry.GetUtdId(customId), customId);
+    EXPECT_EQ(registry.GetMimeType(customId), customId);
+
+    EXPECT_EQ(registry.Intern(""), TypeRegistry::INVALID_TYPE_ID);
+    EXPECT_EQ(registry.GetUtdId(TypeRegistry::INVALID_TYPE_ID), TypeRegistry::INVALID_TYPE_ID);
+    EXPECT_TRUE(registry.GetName(TypeRegistry::INVALID_TYPE_ID).empty());
+}
+
+/**
+ * @tc.name: TypeRegistryTest002
+ * @tc.desc: entries keep their type id in sync with the utd id and records look entries up by id
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteDataEntryTest, TypeRegistryTest002, TestSize.Level0)
+{
+    auto &registry = TypeRegistry::GetInstance();
+    auto entry = std::make_shared<PasteDataEntry>(InitPlainTextEntry());
+    EXPECT_EQ(entry->GetUtdTypeId(), registry.Intern(entry->GetUtdId()));
+
+    auto imageUtdId = UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDMF::IMAGE);
+    auto imageEntry = std::make_shared<PasteDataEntry>();
+    imageEntry->SetUtdId(imageUtdId);
+    imageEntry->SetMimeType(MIMETYPE_TEXT_URI);
+    EXPECT_EQ(imageEntry->GetUtdTypeId(), registry.Intern(imageUtdId));
+
+    PasteDataEntry copied = *imageEntry;
+    EXPECT_EQ(copied.GetUtdTypeId(), imageEntry->GetUtdTypeId());
+
+    PasteDataRecord record;
+    record.AddEntry(entry->GetUtdId(), entry);
+    record.AddEntry(imageUtdId, imageEntry);
+    EXPECT_EQ(record.GetEntryByMimeType(MIMETYPE_TEXT_PLAIN), entry);
+    EXPECT_EQ(record.GetEntry(UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDMF::FILE_URI)), imageEntry);
+    EXPECT_EQ(record.GetEntryByMimeType(MIMETYPE_TEXT_HTML), nullptr);
+}
+} // namespace OHOS::MiscServices
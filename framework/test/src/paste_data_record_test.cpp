@@ -13,10 +13,13 @@
  * limitations under the License.
  */
 
+#include <chrono>
+#include <cinttypes>
 #include <gtest/gtest.h>
 
 #include "entry_getter.h"
 #include "paste_data_record.h"
+#include "pasteboard_hilog.h"
 #include "unified_meta.h"
 
 namespace OHOS::MiscServices {
@@ -1439,4 +1442,75 @@ HWTEST_F(PasteDataRecordTest, DecodeTLVTest001, TestSize.Level2)
 
     EXPECT_EQ(ret, true);
 }
+
+/**
+ * @tc.name: RemoteEncodeSessionTest001
+ * @tc.desc: count and write phases of one remote encode share a single remote conversion
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteDataRecordTest, RemoteEncodeSessionTest001, TestSize.Level0)
+{
+    PasteDataRecord record;
+    AddHtmlUdsEntry(record);
+    AddPlainUdsEntry(record);
+    auto first = record.GetRemoteEncodeValue();
+    auto second = record.GetRemoteEncodeValue();
+    EXPECT_NE(first, second);
+    {
+        TLVEncodeSession session;
+        first = record.GetRemoteEncodeValue();
+        second = record.GetRemoteEncodeValue();
+        EXPECT_EQ(first, second);
+    }
+    EXPECT_EQ(TLVEncodeSession::Current(), nullptr);
+
+    std::vector<uint8_t> remoteBuffer;
+    ASSERT_TRUE(record.Encode(remoteBuffer, true));
+    size_t len = record.CountTLVRemote();
+    WriteOnlyBuffer buffer(len);
+    ASSERT_TRUE(record.EncodeTLVRemote(buffer));
+    EXPECT_EQ(remoteBuffer, buffer.data_);
+}
+
+/**
+ * @tc.name: RemoteEncodeBenchmark001
+ * @tc.desc: remote encode of a 100 record clip with and without the encode session
+ * @tc.type: PERF
+ * @tc.require:
+ */
+HWTEST_F(PasteDataRecordTest, RemoteEncodeBenchmark001, TestSize.Level1)
+{
+    constexpr int32_t recordCount = 100;
+    std::vector<std::shared_ptr<PasteDataRecord>> records;
+    for (int32_t i = 0; i < recordCount; ++i) {
+        auto record = std::make_shared<PasteDataRecord>();
+        AddHtmlUdsEntry(*record);
+        AddPlainUdsEntry(*record);
+        AddFileUriUdsEntry(*record);
+        records.emplace_back(record);
+    }
+    auto encodeAll = [&records]() {
+        bool ret = true;
+        for (const auto &record : records) {
+            WriteOnlyBuffer buffer(record->CountTLVRemote());
+            ret = ret && record->EncodeTLVRemote(buffer);
+        }
+        return ret;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(encodeAll());
+    auto uncachedCost = std::chrono::steady_clock::now() - start;
+    start = std::chrono::steady_clock::now();
+    {
+        TLVEncodeSession session;
+        EXPECT_TRUE(encodeAll());
+    }
+    auto cachedCost = std::chrono::steady_clock::now() - start;
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_COMMON, "%{public}d records, uncached:%{public}" PRId64 "us, "
+        "cached:%{public}" PRId64 "us", recordCount,
+        static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(uncachedCost).count()),
+        static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(cachedCost).count()));
+}
 } // namespace OHOS::MiscServices
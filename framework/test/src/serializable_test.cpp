@@ -488,4 +488,28 @@ HWTEST_F(SerializableTest, GlobalEventTest001, TestSize.Level0)
     }
     ASSERT_TRUE(event == event1);
 }
+
+/**
+ * @tc.name: GlobalEventTest002
+ * @tc.desc: test the JSON of GlobalEvent for older peers leaves out the paste id.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(SerializableTest, GlobalEventTest002, TestSize.Level0)
+{
+    ClipPlugin::GlobalEvent event;
+    event.deviceId = "deviceId";
+    event.seqId = 1;
+    event.pasteId = "pasteId";
+    auto node = ToJson(event.Marshall());
+    ASSERT_NE(node, nullptr);
+    EXPECT_FALSE(cJSON_HasObjectItem(node, GET_NAME(pasteId)));
+    cJSON_Delete(node);
+
+    ClipPlugin::GlobalEvent event1;
+    ASSERT_TRUE(event1.Unmarshall(event.Marshall()));
+    EXPECT_TRUE(event == event1);
+    EXPECT_TRUE(event1.pasteId.empty());
+}
 } // namespace OHOS::DistributedData
\ No newline at end of file
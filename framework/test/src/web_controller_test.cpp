@@ -1005,4 +1005,41 @@ HWTEST_F(WebControllerTest, GetNeedCheckUrisTest_003, TestSize.Level1)
     EXPECT_EQ(uriCount, 1);
 
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "end");
-}
\ No newline at end of file
+}
+/**
+ * @tc.name: RebuildHtmlTest_011.
+ * @tc.desc: Test split and rebuild of html with many local images and a tag broken by a line break.
+ * @tc.type: FUNC.
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(WebControllerTest, RebuildHtmlTest_011, TestSize.Level1)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "start");
+    const int32_t imageCount = 500;
+    const std::string newUri = "file:///data/storage/el2/distributedfiles/temp.png";
+    std::string html = "<img\nsrc='file:///broken.jpg'>";
+    std::string expectHtml = html;
+    for (int32_t i = 0; i < imageCount; ++i) {
+        std::string src = "file:///image" + std::to_string(i % (imageCount / 2)) + ".jpg";
+        html += "<p>text</p><img data-ohos='clipboard' src='" + src + "'>";
+        expectHtml += "<p>text</p><img data-ohos='clipboard' src='" + newUri + "'>";
+    }
+    auto webClipboardController = PasteboardWebController::GetInstance();
+    auto records = webClipboardController.SplitHtml2Records(std::make_shared<std::string>(html), 1);
+    ASSERT_EQ(records.size(), imageCount / 2);
+
+    auto newPasteData = std::make_shared<PasteData>();
+    newPasteData->AddHtmlRecord(html);
+    for (const auto &item : records) {
+        PasteDataRecord::Builder builder(MIMETYPE_TEXT_URI);
+        builder.SetUri(std::make_shared<OHOS::Uri>(newUri));
+        builder.SetCustomData(item->GetCustomData());
+        newPasteData->AddRecord(builder.Build());
+    }
+    std::shared_ptr<std::string> newHtml = webClipboardController.RebuildHtml(newPasteData);
+    ASSERT_NE(newHtml, nullptr);
+    EXPECT_EQ(*newHtml, expectHtml);
+    EXPECT_EQ(newPasteData->GetRecordCount(), 1);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_CLIENT, "end");
+}
@@ -33,7 +33,7 @@ public:
     API_EXPORT bool Decode(const std::vector<uint8_t> &buffer);
 };
 
-class ReadOnlyBuffer : public TLVBuffer {
+class API_EXPORT ReadOnlyBuffer : public TLVBuffer {
 public:
     explicit ReadOnlyBuffer(const std::vector<uint8_t> &data) : TLVBuffer(data.size()), data_(data)
     {
@@ -26,9 +26,38 @@ bool IsRemoteEncode()
     return g_isRemoteEncode;
 }
 
+thread_local TLVEncodeSession *g_encodeSession = nullptr;
+
+TLVEncodeSession::TLVEncodeSession() : prev_(g_encodeSession)
+{
+    g_encodeSession = this;
+}
+
+TLVEncodeSession::~TLVEncodeSession()
+{
+    g_encodeSession = prev_;
+}
+
+TLVEncodeSession *TLVEncodeSession::Current()
+{
+    return g_encodeSession;
+}
+
+std::shared_ptr<void> TLVEncodeSession::Find(const void *key) const
+{
+    auto it = cache_.find(key);
+    return it == cache_.end() ? nullptr : it->second;
+}
+
+void TLVEncodeSession::Insert(const void *key, std::shared_ptr<void> value)
+{
+    cache_.insert_or_assign(key, std::move(value));
+}
+
 bool TLVWriteable::Encode(std::vector<uint8_t> &buffer, bool isRemote) const
 {
     g_isRemoteEncode = isRemote;
+    std::unique_ptr<TLVEncodeSession> session = isRemote ? std::make_unique<TLVEncodeSession>() : nullptr;
     size_t len = CountTLV();
     WriteOnlyBuffer buff(len);
     bool ret = EncodeTLV(buff);
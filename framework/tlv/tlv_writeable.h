@@ -16,6 +16,9 @@
 #ifndef DISTRIBUTEDDATAMGR_PASTEBOARD_TLV_WRITEABLE_H
 #define DISTRIBUTEDDATAMGR_PASTEBOARD_TLV_WRITEABLE_H
 
+#include <memory>
+#include <unordered_map>
+
 #include "endian_converter.h"
 #include "tlv_countable.h"
 
@@ -23,6 +26,26 @@ namespace OHOS::MiscServices {
 
 bool IsRemoteEncode();
 
+/*
+ * Scratch cache that lives for exactly one remote Encode call on the current thread, so that values derived
+ * while counting can be reused while writing. Keys are the addresses of the objects being encoded.
+ */
+class TLVEncodeSession {
+public:
+    TLVEncodeSession();
+    ~TLVEncodeSession();
+    TLVEncodeSession(const TLVEncodeSession &other) = delete;
+    TLVEncodeSession &operator=(const TLVEncodeSession &other) = delete;
+
+    static TLVEncodeSession *Current();
+    std::shared_ptr<void> Find(const void *key) const;
+    void Insert(const void *key, std::shared_ptr<void> value);
+
+private:
+    TLVEncodeSession *prev_ = nullptr;
+    std::unordered_map<const void *, std::shared_ptr<void>> cache_;
+};
+
 class WriteOnlyBuffer;
 
 class TLVWriteable : public TLVCountable {
@@ -34,7 +57,7 @@ public:
     API_EXPORT bool Encode(std::vector<uint8_t> &buffer, bool isRemote = false) const;
 };
 
-class WriteOnlyBuffer : public TLVBuffer {
+class API_EXPORT WriteOnlyBuffer : public TLVBuffer {
 public:
     explicit WriteOnlyBuffer(size_t len) : TLVBuffer(len), data_(len)
     {
@@ -237,6 +237,8 @@ typedef struct {
 const std::map<MiscServices::PasteboardError, std::pair<MiscServices::JSErrorCode, std::string>> ErrorCodeMap = {
     {MiscServices::PasteboardError::TASK_PROCESSING,
      {MiscServices::JSErrorCode::OTHER_COPY_OR_PASTE_IN_PROCESSING, "Another copy or paste operation is in progress."}},
+    {MiscServices::PasteboardError::SERVICE_BUSY,
+     {MiscServices::JSErrorCode::OTHER_COPY_OR_PASTE_IN_PROCESSING, "Too many calls, try again later."}},
     {MiscServices::PasteboardError::COPY_FILE_ERROR,
      {MiscServices::JSErrorCode::ERR_COPY_FILE_ERROR, "Invalid destUri or file system error."}},
     {MiscServices::PasteboardError::PROGRESS_START_ERROR,
@@ -25,7 +25,9 @@ const std::map<PasteboardError, std::pair<JSErrorCode, std::string>> errInfoMap
     {PasteboardError::PERMISSION_VERIFICATION_ERROR,
         {JSErrorCode::NO_PERMISSION, "Permission verification failed. A non-permission application calls a API."}},
     {PasteboardError::TASK_PROCESSING,
-        {JSErrorCode::OTHER_COPY_OR_PASTE_IN_PROCESSING, "Another calling is being processed."}}
+        {JSErrorCode::OTHER_COPY_OR_PASTE_IN_PROCESSING, "Another calling is being processed."}},
+    {PasteboardError::SERVICE_BUSY,
+        {JSErrorCode::OTHER_COPY_OR_PASTE_IN_PROCESSING, "Too many calls, try again later."}}
 };
 
 std::pair<JSErrorCode, std::string> NapiDataUtils::GetErrInfo(PasteboardError retCode)
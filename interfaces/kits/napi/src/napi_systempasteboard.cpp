@@ -368,6 +368,8 @@ napi_value SystemPasteboardNapi::GetData(napi_env env, napi_callback_info info)
         int32_t ret = PasteboardClient::GetInstance()->GetPasteData(*context->pasteData);
         if (ret == static_cast<int32_t>(PasteboardError::TASK_PROCESSING)) {
             context->SetErrInfo(ret, "Another getData is being processed");
+        } else if (ret == static_cast<int32_t>(PasteboardError::SERVICE_BUSY)) {
+            context->SetErrInfo(ret, "Too many calls, try again later");
         } else {
             context->status = napi_ok;
         }
@@ -514,6 +516,8 @@ napi_value SystemPasteboardNapi::GetUnifiedData(napi_env env, napi_callback_info
         int32_t ret = PasteboardClient::GetInstance()->GetUnifiedData(*context->unifiedData);
         if (ret == static_cast<int32_t>(PasteboardError::TASK_PROCESSING)) {
             context->SetErrInfo(ret, "Another getData is being processed");
+        } else if (ret == static_cast<int32_t>(PasteboardError::SERVICE_BUSY)) {
+            context->SetErrInfo(ret, "Too many calls, try again later");
         } else {
             context->status = napi_ok;
         }
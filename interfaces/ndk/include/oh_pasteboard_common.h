@@ -29,6 +29,7 @@ const std::unordered_map<PasteboardError, PASTEBOARD_ErrCode> errCodeMap = {
     { PasteboardError::PERMISSION_VERIFICATION_ERROR, ERR_PERMISSION_ERROR },
     { PasteboardError::INVALID_PARAM_ERROR, ERR_INVALID_PARAMETER },
     { PasteboardError::TASK_PROCESSING, ERR_BUSY },
+    { PasteboardError::SERVICE_BUSY, ERR_BUSY },
     { PasteboardError::COPY_FILE_ERROR, ERR_PASTEBOARD_COPY_FILE_ERROR },
     { PasteboardError::PROGRESS_START_ERROR, ERR_PASTEBOARD_PROGRESS_START_ERROR },
     { PasteboardError::PROGRESS_ABNORMAL, ERR_PASTEBOARD_PROGRESS_ABNORMAL },
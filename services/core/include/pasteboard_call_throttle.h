@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_CALL_THROTTLE_H
+#define PASTEBOARD_CALL_THROTTLE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <sys/types.h>
+#include <vector>
+
+namespace OHOS {
+namespace MiscServices {
+/*
+ * Admission of the heavy paste calls. Each caller, a token and a pid, has a bucket of calls and a bucket of payload
+ * bytes; a call is refused while either is empty. The payload is only known when the call is done, so it is charged
+ * afterwards and may leave the byte bucket in debt until it refills. The admitted calls beyond the limits of calls in
+ * flight wait for a bounded time, the waiting callers taking the freed slots in turn.
+ */
+class CallThrottle {
+public:
+    // a limit of 0 is no limit
+    struct Config {
+        bool enabled = false;
+        uint32_t callsPerSecond = 0;
+        uint32_t callBurst = 0;
+        uint64_t bytesPerSecond = 0;
+        uint64_t byteBurst = 0;
+        uint32_t maxConcurrent = 0;       // calls in flight of all callers
+        uint32_t maxCallerConcurrent = 0; // calls in flight of a caller
+        uint32_t maxWaiting = 0;          // calls of all callers waiting for a slot, each holding an IPC thread
+        uint32_t maxCallerWaiting = 0;    // calls of a caller waiting for a slot
+        uint32_t maxWaitMs = 0;
+    };
+    struct Caller {
+        uint32_t tokenId = 0;
+        pid_t pid = 0;
+        bool operator<(const Caller &other) const
+        {
+            return tokenId != other.tokenId ? tokenId < other.tokenId : pid < other.pid;
+        }
+        bool operator==(const Caller &other) const
+        {
+            return tokenId == other.tokenId && pid == other.pid;
+        }
+    };
+    struct Stats {
+        uint64_t admitted = 0;
+        uint64_t queued = 0;      // admitted after waiting for a slot
+        uint64_t callLimited = 0; // refused, no call left in the bucket
+        uint64_t byteLimited = 0; // refused, the byte bucket in debt
+        uint64_t busy = 0;        // refused, no slot in time or too many calls waiting
+        uint64_t waitLimited = 0; // refused as busy, the calls of all callers waiting at the limit
+        uint64_t bytes = 0;
+        uint32_t inFlight = 0;
+        uint32_t waiting = 0;
+        size_t callers = 0;
+    };
+    struct CallerStats {
+        Caller caller;
+        uint64_t admitted = 0;
+        uint64_t refused = 0;
+        uint64_t bytes = 0;
+        uint32_t inFlight = 0;
+        uint32_t waiting = 0;
+    };
+
+    // an admitted call, left when it goes out of scope
+    class Admission {
+    public:
+        Admission(CallThrottle &throttle, const Caller &caller);
+        ~Admission();
+        Admission(const Admission &) = delete;
+        Admission &operator=(const Admission &) = delete;
+        // E_OK or SERVICE_BUSY
+        int32_t GetResult() const;
+        void Charge(uint64_t bytes);
+
+    private:
+        CallThrottle &throttle_;
+        Caller caller_;
+        int32_t result_;
+    };
+
+    CallThrottle();
+    explicit CallThrottle(Config config);
+
+    void SetConfig(const Config &config);
+    Config GetConfig() const;
+    // E_OK when the call may run, after waiting for a slot at most maxWaitMs, SERVICE_BUSY otherwise
+    int32_t Enter(const Caller &caller, uint64_t nowMs);
+    // the end of a call admitted by Enter
+    void Exit(const Caller &caller, uint64_t nowMs);
+    void Charge(const Caller &caller, uint64_t bytes, uint64_t nowMs);
+    Stats GetStats() const;
+    // the callers with the most refused calls first
+    std::vector<CallerStats> GetCallerStats(size_t maxCount) const;
+
+    static uint64_t GetNowMs();
+
+private:
+    static constexpr uint64_t IDLE_MS = 60000;
+    static constexpr uint64_t PRUNE_INTERVAL_MS = 10000;
+
+    struct Waiter {
+        bool granted = false;
+    };
+    struct CallerState {
+        double calls = 0;
+        double bytes = 0;
+        uint64_t refillMs = 0;
+        uint64_t lastMs = 0;
+        uint32_t inFlight = 0;
+        std::deque<Waiter *> waiters;
+        uint64_t admitted = 0;
+        uint64_t refused = 0;
+        uint64_t chargedBytes = 0;
+    };
+
+    CallerState &GetCaller(const Caller &caller, uint64_t nowMs);
+    void Refill(CallerState &state, uint64_t nowMs) const;
+    bool HasCallLimit() const;
+    void TakeCall(CallerState &state);
+    // a call that waited for a slot in vain
+    void ReturnCall(CallerState &state);
+    bool HasSlot() const;
+    bool HasCallerSlot(const CallerState &state) const;
+    void Admit(CallerState &state);
+    void Dispatch();
+    void Prune(uint64_t nowMs);
+
+    mutable std::mutex mutex_;
+    std::condition_variable granted_;
+    Config config_;
+    std::map<Caller, CallerState> callers_;
+    // the callers with waiting calls, in the order of their turns
+    std::deque<Caller> turns_;
+    uint32_t inFlight_ = 0;
+    uint32_t waiting_ = 0;
+    uint64_t prunedMs_ = 0;
+    Stats stats_;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // PASTEBOARD_CALL_THROTTLE_H
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_CHANGE_STATE_PUBLISHER_H
+#define PASTEBOARD_CHANGE_STATE_PUBLISHER_H
+
+#include <functional>
+#include <map>
+#include <mutex>
+
+#include "common/change_state_page.h"
+
+namespace OHOS {
+namespace MiscServices {
+/*
+ * The change state pages of the users, in ashmem the service maps read-write and hands out read-only. A page is
+ * created on the first request of a client of the user, later changes are written to the existing pages only.
+ */
+class ChangeStatePublisher {
+public:
+    using GetState = std::function<ChangeState(int32_t userId)>;
+
+    explicit ChangeStatePublisher(GetState getState);
+    ~ChangeStatePublisher();
+    ChangeStatePublisher(const ChangeStatePublisher &) = delete;
+    ChangeStatePublisher &operator=(const ChangeStatePublisher &) = delete;
+
+    // a read-only descriptor of the page of the user, owned by the caller
+    int32_t GetFd(int32_t userId, int &fd);
+    // rewrites the page of the user with its current state, the state is taken under the lock of the pages so a
+    // late writer can not overwrite a newer state
+    void Publish(int32_t userId);
+    void PublishAll();
+    void Clear();
+    size_t GetPageCount() const;
+
+private:
+    struct Page {
+        int fd = -1;
+        ChangeStatePage::Layout *layout = nullptr;
+    };
+
+    static bool CreatePage(Page &page);
+    static void ReleasePage(Page &page);
+
+    GetState getState_;
+    mutable std::mutex mutex_;
+    std::map<int32_t, Page> pages_;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // PASTEBOARD_CHANGE_STATE_PUBLISHER_H
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_CLIP_HISTORY_H
+#define PASTEBOARD_CLIP_HISTORY_H
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "paste_clip_summary.h"
+#include "paste_data.h"
+
+namespace OHOS {
+namespace MiscServices {
+/*
+ * The recent clips of each user, kept as encoded PasteData so an entry is immutable and its size is exact.
+ * A copy of content already in the history replaces that entry and moves it to the front instead of adding a new one.
+ * Past the memory budget the largest entries are spilled to files in the user's el2 directory of the service and
+ * read back on activation, past the disk budget the oldest spilled entries are dropped. The files are written and
+ * read outside the lock of the history.
+ */
+class ClipHistory {
+public:
+    struct Config {
+        size_t maxClips = 20;                          // per user
+        size_t memoryBudget = 16 * 1024 * 1024;        // resident bytes of all users
+        size_t spillThreshold = 256 * 1024;            // smaller entries are never spilled
+        size_t diskBudget = 128 * 1024 * 1024;         // spilled bytes of all users
+        // the files of a user are in spillRoot/userId/spillDir, nothing is spilled when either is empty
+        std::string spillRoot = "/data/service/el2";
+        std::string spillDir = "pasteboard/history";
+    };
+    // a clip encoded for the history, made without the lock of the history
+    struct Clip {
+        PasteClipSummary summary;
+        uint64_t hash = 0;
+        std::vector<uint8_t> tlv;
+    };
+    struct Stats {
+        uint64_t added = 0;
+        uint64_t deduplicated = 0;
+        uint64_t skipped = 0;
+        uint64_t evicted = 0;
+        uint64_t spilled = 0;
+        uint64_t spillFailed = 0;
+        uint64_t reloaded = 0;
+        size_t clips = 0;
+        size_t residentBytes = 0;
+        size_t spilledBytes = 0;
+    };
+
+    ClipHistory();
+    explicit ClipHistory(Config config);
+    ~ClipHistory();
+    ClipHistory(const ClipHistory &) = delete;
+    ClipHistory &operator=(const ClipHistory &) = delete;
+
+    // returns the clipId of the entry holding the data, 0 when the data is not kept
+    uint32_t Add(int32_t userId, PasteData &data);
+    // false when the data is not kept in the history
+    bool Encode(PasteData &data, Clip &clip) const;
+    // the clip is dropped when the history of the user was removed since the generation was read
+    uint32_t Add(int32_t userId, Clip clip, uint64_t generation);
+    uint64_t GetGeneration(int32_t userId) const;
+    std::vector<PasteClipSummary> GetSummaries(int32_t userId) const;
+    std::shared_ptr<PasteData> Get(int32_t userId, uint32_t clipId) const;
+    void RemoveUser(int32_t userId);
+    void Clear();
+    Stats GetStats() const;
+    std::string Dump() const;
+
+    // the spill files of the service, shared with the spill of the current clips
+    static bool WriteFile(const std::string &path, const std::vector<uint8_t> &data);
+    static bool ReadFile(const std::string &path, size_t size, std::vector<uint8_t> &data);
+    static void RemoveFiles(const std::string &path);
+    static void RemoveFiles(const std::vector<std::string> &files);
+    // creates root/userId/subDir below root/userId, which is only there once the el2 storage of the user is
+    // unlocked, returns the directory or an empty string
+    static std::string MakeUserDir(const std::string &root, int32_t userId, const std::string &subDir);
+
+private:
+    struct Entry {
+        PasteClipSummary summary;
+        uint64_t hash = 0;
+        std::shared_ptr<const std::vector<uint8_t>> tlv; // null once spilled
+        std::string spillPath;
+        bool spilling = false;
+    };
+    using EntryList = std::list<Entry>; // the latest first
+    struct SpillJob {
+        int32_t userId = 0;
+        uint32_t clipId = 0;
+        std::shared_ptr<const std::vector<uint8_t>> tlv;
+        std::string path;
+        bool written = false;
+    };
+
+    static bool IsRecordable(PasteData &data);
+    static PasteClipSummary MakeSummary(PasteData &data, size_t dataSize);
+    // with mutex_ held, the files to remove are appended to files and removed after the lock is released
+    uint64_t CurrentGeneration(int32_t userId) const;
+    void Trim(EntryList &entries, std::vector<std::string> &files);
+    std::vector<SpillJob> SelectSpills(std::vector<std::string> &files);
+    void FinishSpills(const std::vector<SpillJob> &jobs, std::vector<std::string> &files);
+    void Erase(EntryList &entries, EntryList::iterator it, std::vector<std::string> &files);
+    void PrepareSpillDir(int32_t userId);
+    bool FindLargestResident(int32_t &userId, EntryList::iterator &found);
+    bool FindOldest(bool spilled, EntryList *&entries, EntryList::iterator &found);
+
+    const Config config_;
+    mutable std::mutex mutex_;
+    std::map<int32_t, EntryList> users_;
+    // removals of the history of each user, and of all users, so an encoded clip does not outlive a clear
+    std::map<int32_t, uint64_t> removals_;
+    uint64_t clears_ = 0;
+    // the spill directories made and emptied of the files of a previous instance, only their users spill
+    std::mutex spillDirMutex_;
+    std::map<int32_t, std::string> spillDirs_;
+    uint32_t nextClipId_ = 1;
+    uint64_t nextSpillId_ = 0;
+    size_t residentBytes_ = 0;
+    size_t spillingBytes_ = 0;
+    size_t spilledBytes_ = 0;
+    mutable Stats stats_;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // PASTEBOARD_CLIP_HISTORY_H
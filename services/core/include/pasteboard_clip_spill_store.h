@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_CLIP_SPILL_STORE_H
+#define PASTEBOARD_CLIP_SPILL_STORE_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "paste_data.h"
+
+namespace OHOS {
+namespace MiscServices {
+/*
+ * The current clips of the users moved out of memory. A spilled clip is written to a file of the service as encoded
+ * PasteData and replaced by a shell keeping its properties, its small records and the mime types of the others, so
+ * checks on the clip are still answered from memory. The clip is read back on the next access to its content.
+ * The files are kept in the el2 directory of the user, so a clip is only spilled once that storage is unlocked.
+ */
+class ClipSpillStore {
+public:
+    struct Config {
+        size_t residentBudget = 32 * 1024 * 1024;      // resident bytes of the clips of all users
+        size_t spillThreshold = 256 * 1024;            // smaller clips are never spilled
+        size_t residentRecordSize = 4 * 1024;          // smaller records stay in the shell
+        uint64_t idleTime = 60 * 1000;                 // ms since the last copy or paste
+        // the files of a user are in spillRoot/userId/spillDir, nothing is spilled when either is empty
+        std::string spillRoot = "/data/service/el2";
+        std::string spillDir = "pasteboard/clips";
+    };
+    struct Clip {
+        int32_t userId = 0;
+        size_t size = 0;
+        bool spillable = false;
+    };
+    struct Stats {
+        uint64_t spilled = 0;
+        uint64_t spillFailed = 0;
+        uint64_t restored = 0;
+        uint64_t restoreFailed = 0;
+        size_t clips = 0;
+        size_t spilledBytes = 0;
+    };
+
+    ClipSpillStore();
+    explicit ClipSpillStore(Config config);
+    ~ClipSpillStore();
+    ClipSpillStore(const ClipSpillStore &) = delete;
+    ClipSpillStore &operator=(const ClipSpillStore &) = delete;
+
+    void SetResidentBudget(size_t budget);
+    size_t GetResidentBudget() const;
+    void Touch(int32_t userId, uint64_t nowMs);
+    // the users whose clips to spill, the least recently used first, until the resident clips fit the budget
+    std::vector<int32_t> SelectSpill(const std::vector<Clip> &clips, uint64_t nowMs, bool underPressure) const;
+    // returns the shell replacing the data, null when the data is not spilled
+    std::shared_ptr<PasteData> Spill(int32_t userId, PasteData &data);
+    bool IsSpilled(int32_t userId, const std::shared_ptr<PasteData> &shell) const;
+    // returns the data behind the shell and forgets it, null when it can not be read
+    std::shared_ptr<PasteData> Restore(int32_t userId, const std::shared_ptr<PasteData> &shell);
+    void Remove(int32_t userId);
+    void Clear();
+    Stats GetStats() const;
+
+private:
+    struct Entry {
+        std::weak_ptr<PasteData> shell;
+        std::string path;
+        size_t size = 0;
+    };
+
+    std::shared_ptr<PasteData> MakeShell(PasteData &data) const;
+    // with mutex_ held, empty when the directory of the user can not be made
+    std::string GetSpillDir(int32_t userId);
+    void Erase(std::map<int32_t, Entry>::iterator it);
+
+    Config config_;
+    mutable std::mutex mutex_;
+    std::map<int32_t, Entry> entries_;
+    std::map<int32_t, uint64_t> accessTimes_;
+    // the spill directories made and emptied of the files of a previous instance
+    std::map<int32_t, std::string> spillDirs_;
+    size_t spilledBytes_ = 0;
+    Stats stats_;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // PASTEBOARD_CLIP_SPILL_STORE_H
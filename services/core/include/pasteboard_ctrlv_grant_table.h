@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_CTRLV_GRANT_TABLE_H
+#define PASTEBOARD_CTRLV_GRANT_TABLE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+namespace OHOS {
+namespace MiscServices {
+/*
+ * Pastes granted by Ctrl+V key events, one per window pid. A paste check consumes the grant of its pid, or the
+ * latest grant when the caller owns the focused window, and never waits unless a Ctrl key is down, in which case
+ * the Ctrl+V event may still be on its way and the check waits for it for a short time. Times are boot time in
+ * milliseconds and are passed in by the caller.
+ */
+class CtrlVGrantTable {
+public:
+    static constexpr uint64_t GRANT_WINDOW_MS = 2000;
+    static constexpr size_t MAX_GRANTS = 16;
+
+    struct Stats {
+        uint64_t recorded = 0;
+        uint64_t granted = 0;
+        uint64_t denied = 0;
+        uint64_t waited = 0;
+        uint64_t pruned = 0;
+        size_t grants = 0;
+    };
+
+    void Record(int32_t pid, int32_t windowId, uint64_t nowMs);
+    void MarkInFlight(uint64_t nowMs);
+    void ClearInFlight();
+    bool Consume(int32_t pid, bool isFocused, uint64_t nowMs, uint32_t waitMs);
+    size_t Prune(uint64_t nowMs);
+    bool IsEmpty() const;
+    void Clear();
+    Stats GetStats() const;
+
+private:
+    struct Grant {
+        int32_t pid = -1;
+        int32_t windowId = -1;
+        uint64_t time = 0;
+    };
+    using GrantList = std::deque<Grant>; // the latest last
+
+    GrantList::iterator Find(int32_t pid, bool isFocused, uint64_t nowMs, uint64_t latestMs);
+    bool IsInFlight(uint64_t nowMs) const;
+
+    mutable std::mutex mutex_;
+    std::condition_variable recorded_;
+    GrantList grants_;
+    uint64_t inFlightUntil_ = 0;
+    Stats stats_;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // PASTEBOARD_CTRLV_GRANT_TABLE_H
@@ -39,6 +39,7 @@ public:
 
 private:
     static uint8_t GetEntryPriority(const std::string &utdId);
+    static uint8_t GetEntryPriority(TypeRegistry::TypeId utdTypeId);
     static void SortEntryInfo(std::vector<DelayEntryInfo> &entryInfos);
 };
 } // namespace MiscServices
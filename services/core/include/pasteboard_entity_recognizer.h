@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_ENTITY_RECOGNIZER_H
+#define PASTEBOARD_ENTITY_RECOGNIZER_H
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "common/latest_wins_publisher.h"
+#include "i_paste_data_processor.h"
+#include "pasteboard_lib_guard.h"
+
+namespace OHOS {
+namespace MiscServices {
+/*
+ * Recognizes entities in copied text on a single long-lived worker. The NLU engine stays loaded while the
+ * recognizer is resident, a newer copy cancels the recognition of an older one and the results of the last
+ * copies are cached by data id.
+ */
+class EntityRecognizer {
+public:
+    struct Engine {
+        std::shared_ptr<LibGuard> lib; // keeps the library of the processor loaded
+        IPasteDataProcessor *processor = nullptr;
+    };
+    struct Stats {
+        uint64_t submitted = 0;
+        uint64_t pending = 0;
+        uint64_t notified = 0;
+        uint64_t cacheHits = 0;
+        uint64_t skipped = 0;
+        uint64_t canceled = 0;
+        uint64_t failed = 0;
+        uint64_t engineLoads = 0;
+        uint64_t loadUs = 0;
+        uint64_t lastProcessUs = 0;
+        uint64_t maxProcessUs = 0;
+        uint64_t lastExtractUs = 0;
+        uint64_t lastNotifyUs = 0;
+        uint64_t lastLatencyUs = 0;
+        uint64_t maxLatencyUs = 0;
+    };
+    using EngineLoader = std::function<Engine()>;
+    using Extractor = std::function<int32_t(const std::string &entity, std::string &location)>;
+    using Notifier = std::function<void(std::string &location, uint32_t dataLength)>;
+
+    EntityRecognizer(Extractor extractor, Notifier notifier, EngineLoader loader = nullptr);
+    ~EntityRecognizer();
+    EntityRecognizer(const EntityRecognizer &) = delete;
+    EntityRecognizer &operator=(const EntityRecognizer &) = delete;
+
+    bool Recognize(uint32_t dataId, std::string text);
+    // the engine is loaded lazily while resident and unloaded as soon as it is not
+    void SetResident(bool resident);
+    bool IsEngineLoaded() const;
+    Stats GetStats() const;
+    void Stop();
+
+private:
+    struct Task {
+        uint32_t dataId = 0;
+        std::string text;
+    };
+    struct CacheItem {
+        uint32_t dataId = 0;
+        uint32_t dataLength = 0;
+        std::string location;
+    };
+    static constexpr size_t MAX_CACHE_SIZE = 4;
+
+    static Engine LoadNluEngine();
+    bool Run(Task &task, const std::function<bool()> &isSuperseded);
+    bool FindCache(uint32_t dataId, CacheItem &item);
+    void AddCache(CacheItem item);
+    int32_t Process(const std::string &text, std::string &entity);
+    void Notify(std::string &location, uint32_t dataLength);
+
+    Extractor extractor_;
+    Notifier notifier_;
+    EngineLoader loader_;
+    mutable std::mutex engineMutex_;
+    bool resident_ = false;
+    Engine engine_;
+    mutable std::mutex mutex_;
+    std::deque<CacheItem> cache_;
+    Stats stats_;
+    // declared last so the worker is joined before anything it touches is destroyed
+    LatestWinsPublisher<Task> worker_;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // PASTEBOARD_ENTITY_RECOGNIZER_H
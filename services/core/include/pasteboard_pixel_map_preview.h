@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_PIXEL_MAP_PREVIEW_H
+#define PASTEBOARD_PIXEL_MAP_PREVIEW_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "pixel_map.h"
+
+namespace OHOS {
+namespace MiscServices {
+/*
+ * Downscaled copies of the pixel maps of the current clips, served to the callers asking for the preview type so
+ * a preview does not cost the full image. A preview is built on the first request and kept until the clip of the
+ * user changes.
+ */
+class PixelMapPreviewCache {
+public:
+    struct Config {
+        int32_t maxEdge = 256;   // px of the longer edge of a preview
+        size_t maxRecords = 16;  // previews kept per clip, the others are built on every request
+    };
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t built = 0;
+        uint64_t failed = 0;
+        size_t previews = 0;
+        size_t bytes = 0;
+    };
+
+    PixelMapPreviewCache();
+    explicit PixelMapPreviewCache(Config config);
+
+    // whether the pixel map is larger than its preview
+    bool NeedPreview(const Media::PixelMap &pixelMap) const;
+    // the preview of the record of the current clip of the user, the source itself when it is small enough
+    std::shared_ptr<Media::PixelMap> Get(int32_t userId, uint32_t dataId, uint32_t recordId,
+        const std::shared_ptr<Media::PixelMap> &source);
+    void Remove(int32_t userId);
+    void Clear();
+    Stats GetStats() const;
+
+private:
+    struct Previews {
+        uint32_t dataId = 0;
+        std::map<uint32_t, std::shared_ptr<Media::PixelMap>> records;
+    };
+
+    std::shared_ptr<Media::PixelMap> MakePreview(Media::PixelMap &source) const;
+
+    Config config_;
+    mutable std::mutex mutex_;
+    std::map<int32_t, Previews> previews_;
+    Stats stats_;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // PASTEBOARD_PIXEL_MAP_PREVIEW_H
@@ -16,22 +16,32 @@
 #ifndef PASTE_BOARD_SERVICE_H
 #define PASTE_BOARD_SERVICE_H
 
+#include <chrono>
 #include <system_ability_definition.h>
 
+#include "app_state_subscriber.h"
 #include "bundle_mgr_proxy.h"
 #include "clip/clip_plugin.h"
 #include "common/block_object.h"
+#include "common/concurrent_sharded_map.h"
+#include "common/latest_wins_publisher.h"
 #include "device/distributed_module_config.h"
 #include "eventcenter/event_center.h"
 #include "ffrt/ffrt_utils.h"
-#include "i_paste_data_processor.h"
 #include "ientity_recognition_observer.h"
 #include "input_manager.h"
 #include "loader.h"
 #include "pasteboard_account_state_subscriber.h"
+#include "pasteboard_call_throttle.h"
+#include "pasteboard_change_state_publisher.h"
+#include "pasteboard_clip_history.h"
+#include "pasteboard_clip_spill_store.h"
 #include "pasteboard_common_event_subscriber.h"
+#include "pasteboard_ctrlv_grant_table.h"
 #include "pasteboard_dump_helper.h"
+#include "pasteboard_entity_recognizer.h"
 #include "pasteboard_event_common.h"
+#include "pasteboard_pixel_map_preview.h"
 #include "pasteboard_service_stub.h"
 #include "pasteboard_switch.h"
 #include "privacy_kit.h"
@@ -98,14 +108,13 @@ public:
     void OnKeyInputEventForPaste(std::shared_ptr<MMI::KeyEvent> keyEvent) const;
     bool IsCtrlVProcess(uint32_t callingPid, bool isFocused);
     void Clear();
+    CtrlVGrantTable::Stats GetGrantStats() const;
 
 private:
     static constexpr uint32_t WAIT_TIME_OUT = 100;
-    mutable int32_t windowPid_ = -1;
-    mutable uint64_t actionTime_ = 0;
-    mutable std::shared_mutex inputEventMutex_;
-    mutable std::shared_mutex blockMapMutex_;
-    mutable std::map<uint32_t, std::shared_ptr<BlockObject<int32_t>>> blockMap_;
+    static void SchedulePrune(std::weak_ptr<CtrlVGrantTable> weakGrants);
+
+    std::shared_ptr<CtrlVGrantTable> grants_ = std::make_shared<CtrlVGrantTable>();
     int32_t inputType_ = INPUTTYPE_PASTE;
     PasteboardService *pasteboardService_ = nullptr;
 };
@@ -172,6 +181,12 @@ public:
     void NotifyDelayGetterDied(int32_t userId);
     void NotifyEntryGetterDied(int32_t userId);
     virtual int32_t GetChangeCount(uint32_t &changeCount) override;
+    int32_t GetChangeStatePage(int &fd) override;
+    void PublishChangeStates();
+    int32_t GetClipHistory(std::vector<uint8_t> &buffer) override;
+    int32_t ActivateClip(uint32_t clipId) override;
+    void AddClipHistory(int32_t userId, std::shared_ptr<PasteData> clip);
+    void RemoveClipHistory(int32_t userId);
     void CloseDistributedStore(int32_t user, bool isNeedClear);
     void ChangeStoreStatus(int32_t userId);
     void PreSyncRemotePasteboardData();
@@ -185,8 +200,14 @@ public:
 private:
     std::atomic<bool> isCritical_ = false;
     std::mutex saMutex_;
+    struct StartupPhase {
+        std::string name;
+        bool deferred = false; // run on the service handler after the publish
+        uint64_t costUs = 0;
+    };
+    std::mutex startupMutex_;
+    std::vector<StartupPhase> startupPhases_;
     using Event = ClipPlugin::GlobalEvent;
-    using GetProcessorFunc = IPasteDataProcessor& (*)();
     static constexpr const int32_t LISTENING_SERVICE[] = { DISTRIBUTED_HARDWARE_DEVICEMANAGER_SA_ID,
         WINDOW_MANAGER_SERVICE_ID, MEMORY_MANAGER_SA_ID, DISTRIBUTED_DEVICE_PROFILE_SA_ID };
     static constexpr const char *PLUGIN_NAME = "distributed_clip";
@@ -196,6 +217,7 @@ private:
     static constexpr uint32_t URI_INDEX = 2;
     static constexpr uint32_t WANT_INDEX = 3;
     static constexpr uint32_t PIXELMAP_INDEX = 4;
+    static constexpr uint32_t MAX_RECOGNITION_LENGTH = 1000;
     static constexpr uint32_t MAX_INDEX_LENGTH = 8;
     static constexpr const pid_t EDM_UID = 3057;
     static constexpr const pid_t ROOT_UID = 0;
@@ -203,7 +225,8 @@ private:
     static constexpr int MIN_TRANMISSION_TIME = 30 * 1000; // ms
     static constexpr int PRESYNC_MONITOR_TIME = 2 * 60 * 1000; // ms
     static constexpr int PRE_ESTABLISH_P2P_LINK_TIME = 2 * 60 * 1000; // ms
-    static constexpr uint32_t SET_DISTRIBUTED_DATA_INTERVAL = 40 * 1000; // 40 seconds
+    static constexpr uint32_t DISTRIBUTED_PUBLISH_DEBOUNCE = 20; // ms
+    static constexpr uint32_t DISTRIBUTED_PUBLISH_TIMEOUT = 40 * 1000; // ms
     static constexpr int32_t ONE_HOUR_MINUTES = 60;
     static constexpr int32_t MAX_AGED_TIME = 24 * 60; // minute
     static constexpr int32_t MIN_AGED_TIME = 1; // minute
@@ -218,6 +241,7 @@ private:
     std::atomic<int32_t> agedTime_ = ONE_HOUR_MINUTES * MINUTES_TO_MILLISECONDS; // 1 hour
     bool SetPasteboardHistory(HistoryInfo &info);
     bool IsFocusedApp(uint32_t tokenId);
+    bool IsUIExtensionFocused(uint32_t tokenId);
     void InitBundles(Loader &loader);
     void SetInputMethodPid(int32_t userId, pid_t callPid);
     void ClearInputMethodPidByPid(int32_t userId, pid_t callPid);
@@ -259,6 +283,7 @@ private:
         void Notify(const Event &event, std::shared_ptr<PasteDateTime> data);
         void ClearRemoteDataTask(const Event &event);
         std::shared_ptr<PasteDateTime> WaitRemoteData(const Event &event);
+        size_t GetTaskCount();
 
     private:
         std::atomic<uint32_t> mapKey_ = 0;
@@ -288,15 +313,29 @@ private:
     void AddSysAbilityListener();
     int32_t Init();
     void InitScreenStatus();
+    void DeferredStart();
+    void RegisterDumpCommands();
+    void AddStartupPhase(const std::string &name, bool deferred, std::chrono::steady_clock::time_point begin);
+    std::string DumpStartup();
     static ScreenEvent GetCurrentScreenStatus();
     std::string DumpHistory() const;
     std::string DumpData();
+    std::string DumpDeviceCache() const;
+    std::string DumpPublishStats() const;
+    std::string DumpEntityRecognition() const;
+    std::string DumpPerf();
+    std::string DumpClipHistory() const;
+    std::string DumpThrottle() const;
     void ThawInputMethod(pid_t imePid);
     bool IsNeedThaw(void);
     int32_t ExtractEntity(const std::string &entity, std::string &location);
     int32_t GetAllEntryPlainText(uint32_t dataId, uint32_t recordId,
-        std::vector<std::shared_ptr<PasteDataEntry>> &entries, std::string &primaryText);
+        std::vector<std::shared_ptr<PasteDataEntry>> &entries, std::string &primaryText,
+        uint32_t maxLength = MAX_RECOGNITION_LENGTH);
     std::string GetAllPrimaryText(const PasteData &pasteData);
+    std::string GetAllPrimaryText(const PasteData &pasteData, uint32_t maxLength);
+    uint32_t GetMaxExpectedDataLength(EntityType entityType);
+    void UpdateEntityRecognizerResident();
     void NotifyEntityObservers(std::string &entity, EntityType entityType, uint32_t dataLength);
     void UnsubscribeAllEntityObserver();
     void NotifyObservers(std::string bundleName, int32_t userId, PasteboardEventStatus status);
@@ -305,16 +344,18 @@ private:
     std::mutex imeMutex_;
     ConcurrentMap<int32_t, pid_t> imeMap_;
 
-    struct DistributedMemory {
-        std::mutex mutex;
-        bool isRunning = false;
-        std::shared_ptr<PasteData> data;
+    struct DistributedPublishTask {
         Event event;
+        PasteData data;
     };
-    DistributedMemory setDistributedMemory_;
 
     int32_t SaveData(PasteData &pasteData, int64_t dataSize, const sptr<IPasteboardDelayGetter> delayGetter = nullptr,
-        const sptr<IPasteboardEntryGetter> entryGetter = nullptr);
+        const sptr<IPasteboardEntryGetter> entryGetter = nullptr, uint64_t contentHash = 0);
+    bool RefreshDuplicateClip(const AppInfo &appInfo, PasteData &pasteData, uint64_t contentHash);
+    // makes a clip of the history the current one as it was saved
+    int32_t PublishHistoryClip(int32_t userId, std::shared_ptr<PasteData> clip);
+    // whether the top event of the peers is still the unexpired one this device published last
+    bool IsPublishedEventCurrent(int32_t userId);
     void SetPasteDataInfo(PasteData &pasteData, const AppInfo &appInfo);
     void HandleDelayDataAndRecord(PasteData &pasteData, const sptr<IPasteboardDelayGetter> delayGetter,
         const sptr<IPasteboardEntryGetter> entryGetter, const AppInfo &appInfo);
@@ -378,16 +419,20 @@ private:
     int32_t ProcessRemoteDelayHtmlInner(const std::string &remoteDeviceId, const AppInfo &appInfo,
         PasteData &tmpData, PasteData &data, PasteDataEntry &entry);
     int32_t GetLocalEntryValue(int32_t userId, PasteData &data, PasteDataRecord &record, PasteDataEntry &entry);
+    int32_t GetPreviewEntryValue(int32_t userId, PasteData &data, PasteDataRecord &record, PasteDataEntry &entry);
+    int32_t GetRemotePreviewValue(int32_t userId, PasteDataRecord &record, PasteDataEntry &entry);
+    bool DeferRemotePixelMaps(PasteData &data);
     int32_t GetFullDelayPasteData(int32_t userId, PasteData &data);
     bool IsDisallowDistributed();
     bool SetDistributedData(int32_t user, PasteData &data);
     bool SetCurrentDistributedData(PasteData &data, Event event);
-    bool SetCurrentData(Event event, PasteData &data);
+    bool SetCurrentData(Event event, PasteData &data, const std::function<bool()> &isSuperseded = nullptr);
     void CleanDistributedData(int32_t user);
     void OnConfigChange(bool isOn);
     void OnConfigChangeInner(bool isOn);
     std::shared_ptr<ClipPlugin> GetClipPlugin();
     void IncreaseChangeCount(int32_t userId);
+    ChangeState GetChangeState(int32_t userId);
 
     static std::string GetTime();
     bool IsDataAged();
@@ -397,17 +442,25 @@ private:
     static std::string GetAppBundleName(const AppInfo &appInfo);
     static void SetLocalPasteFlag(bool isCrossPaste, uint32_t tokenId, PasteData &pasteData);
     void RecognizePasteData(PasteData &pasteData);
-    void OnRecognizePasteData(const std::string &primaryText);
     void ShowHintToast(uint32_t tokenId, uint32_t pid);
     void OnAddSystemAbility(int32_t systemAbilityId, const std::string &deviceId) override;
     void OnRemoveSystemAbility(int32_t systemAbilityId, const std::string &deviceId) override;
     void UpdateAgedTime();
+    void UpdateClipResidentBudget();
+    void UpdateCallThrottle(Loader &loader);
+    void ScheduleClipTrim();
+    void TrimClips(bool underPressure);
+    void RestoreSpilledClip(int32_t userId);
+    // every read of the content of a clip goes through here, a spilled clip is only a shell of its properties
+    std::pair<bool, std::shared_ptr<PasteData>> FindClip(int32_t userId);
     void CancelCriticalTimer();
     void SetCriticalTimer();
     void OnAddDeviceManager();
     void OnAddMemoryManager();
     void OnAddDeviceProfile();
     void OnRemoveDeviceProfile();
+    void OnAddWindowManager();
+    void OnRemoveWindowManager();
     void ReportUeCopyEvent(PasteData &pasteData, int64_t dataSize, int32_t result);
     bool HasDataType(const std::string &mimeType);
     bool HasPasteData();
@@ -417,8 +470,8 @@ private:
         const PasteDataEntry &entryValue);
     int32_t DealData(int &fd, int64_t &size, std::vector<uint8_t> &rawData, PasteData &data);
     bool WriteRawData(const void *data, int64_t size, int &serFd);
-    int32_t WritePasteData(
-        int fd, int64_t rawDataSize, const std::vector<uint8_t> &buffer, PasteData &pasteData, bool &hasData);
+    int32_t WritePasteData(int fd, int64_t rawDataSize, const std::vector<uint8_t> &buffer, PasteData &pasteData,
+        bool &hasData, uint64_t *contentHash = nullptr);
     void CloseSharedMemFd(int fd);
     void ClearAgedData(int32_t userId);
     void SetDataExpirationTimer(int32_t userId);
@@ -442,12 +495,14 @@ private:
     ObserverMap observerEventMap_;
     ClipPlugin::GlobalEvent currentEvent_;
     ClipPlugin::GlobalEvent remoteEvent_;
-    ConcurrentMap<int32_t, std::shared_ptr<PasteData>> clips_;
-    ConcurrentMap<int32_t, uint32_t> clipChangeCount_;
-    ConcurrentMap<pid_t, std::vector<EntityObserverInfo>> entityObserverMap_;
+    ConcurrentShardedMap<int32_t, std::shared_ptr<PasteData>> clips_;
+    ConcurrentShardedMap<int32_t, uint32_t> clipChangeCount_;
+    ConcurrentShardedMap<pid_t, std::vector<EntityObserverInfo>> entityObserverMap_;
     ConcurrentMap<int32_t, std::pair<sptr<IPasteboardEntryGetter>, sptr<EntryGetterDeathRecipient>>> entryGetters_;
     ConcurrentMap<int32_t, std::pair<sptr<IPasteboardDelayGetter>, sptr<DelayGetterDeathRecipient>>> delayGetters_;
-    ConcurrentMap<int32_t, uint64_t> copyTime_;
+    ConcurrentShardedMap<int32_t, uint64_t> copyTime_;
+    ConcurrentShardedMap<int32_t, std::pair<uint64_t, uint32_t>> clipHashes_; // content hash and dataId of the clip
+    std::atomic<uint64_t> clipDedupHits_ = 0;
     std::set<std::pair<std::string, int32_t>> readBundles_;
     std::shared_ptr<PasteBoardCommonEventSubscriber> commonEventSubscriber_ = nullptr;
     std::shared_ptr<PasteBoardAccountStateSubscriber> accountStateSubscriber_ = nullptr;
@@ -464,6 +519,16 @@ private:
     static std::vector<std::string> dataHistory_;
     static std::shared_ptr<Command> copyHistory;
     static std::shared_ptr<Command> copyData;
+    static std::shared_ptr<Command> deviceCache;
+    static std::shared_ptr<Command> publishStats;
+    static std::shared_ptr<Command> entityRecognition;
+    static std::shared_ptr<Command> latency;
+    static std::shared_ptr<Command> ipcStats;
+    static std::shared_ptr<Command> slowOps;
+    static std::shared_ptr<Command> perf;
+    static std::shared_ptr<Command> clipHistory;
+    static std::shared_ptr<Command> startup;
+    static std::shared_ptr<Command> throttle;
     std::atomic<bool> setting_ = false;
     std::map<std::string, int> typeMap_ = {
         {MIMETYPE_TEXT_PLAIN, PLAIN_INDEX   },
@@ -493,7 +558,7 @@ private:
         ShareOption shareOption;
     };
 
-    ConcurrentMap<uint32_t, GlobalShareOption> globalShareOptions_;
+    ConcurrentShardedMap<uint32_t, GlobalShareOption> globalShareOptions_;
 
     bool AddObserver(int32_t userId, const sptr<IPasteboardChangedObserver> &observer, ObserverMap &observerMap);
     void RemoveSingleObserver(
@@ -537,6 +602,38 @@ private:
     static constexpr pid_t INVALID_PID = -1;
     static constexpr uint32_t INVALID_TOKEN = 0;
     static constexpr uint32_t MAX_OBSERVER_COUNT = 10;
+    ClipHistory clipHistory_;
+    // adds the copies to clipHistory_ in order, destroyed first so no task outlives the history
+    FFRTQueue historyQueue_ { "pasteboard_history" };
+    class MemoryLevelSubscriber final : public Memory::AppStateSubscriber {
+    public:
+        explicit MemoryLevelSubscriber(PasteboardService &service);
+        void OnTrim(Memory::SystemMemoryLevel level) override;
+
+    private:
+        PasteboardService &service_;
+    };
+    std::shared_ptr<MemoryLevelSubscriber> memoryLevelSubscriber_;
+    std::mutex clipSpillMutex_; // a clip is swapped for its shell and back under it
+    ClipSpillStore clipSpill_;
+    PixelMapPreviewCache pixelMapPreviews_;
+    CallThrottle callThrottle_;
+    ChangeStatePublisher changeStates_{ [this](int32_t userId) {
+        return GetChangeState(userId);
+    } };
+    EntityRecognizer entityRecognizer_{
+        [this](const std::string &entity, std::string &location) {
+            return ExtractEntity(entity, location);
+        },
+        [this](std::string &location, uint32_t dataLength) {
+            NotifyEntityObservers(location, EntityType::ADDRESS, dataLength);
+        } };
+    // declared last so the worker is joined before anything it touches is destroyed
+    LatestWinsPublisher<DistributedPublishTask> distributedPublisher_{
+        [this](DistributedPublishTask &task, const std::function<bool()> &isSuperseded) {
+            return SetCurrentData(task.event, task.data, isSuperseded);
+        },
+        DISTRIBUTED_PUBLISH_DEBOUNCE, DISTRIBUTED_PUBLISH_TIMEOUT };
 };
 } // namespace MiscServices
 } // namespace OHOS
@@ -18,11 +18,40 @@
 
 #include <cstdint>
 
+#include "iremote_object.h"
+
 namespace OHOS {
 namespace MiscServices {
+struct FocusWindowInfo {
+    int32_t pid = -1;
+    int32_t windowId = 0;
+    sptr<IRemoteObject> abilityToken = nullptr;
+};
+
+/*
+ * The focused window, kept from the focus change notifications of the window manager once subscribed so a check
+ * costs no IPC. Before the subscription, or after the window manager died, every call queries the window manager.
+ */
 class WindowManager {
 public:
+    struct FocusStats {
+        bool subscribed = false;
+        uint64_t events = 0;
+        uint64_t hits = 0;
+        uint64_t queries = 0;
+    };
+
     static int32_t GetFocusWindowId();
+    static FocusWindowInfo GetFocusWindowInfo();
+    // changes with every focus change, 0 while not subscribed so nothing derived from the focus can be cached
+    static uint64_t GetFocusGeneration();
+    static bool SubscribeFocusChange();
+    static void UnsubscribeFocusChange();
+    static void UpdateFocus(const FocusWindowInfo &info, bool focused);
+    static FocusStats GetFocusStats();
+
+private:
+    static FocusWindowInfo QueryFocusWindowInfo();
 };
 } // namespace MiscServices
 } // namespace OHOS
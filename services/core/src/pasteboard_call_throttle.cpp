@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_call_throttle.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "pasteboard_error.h"
+#include "pasteboard_hilog.h"
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr double MS_PER_SECOND = 1000.0;
+} // namespace
+
+CallThrottle::Admission::Admission(CallThrottle &throttle, const Caller &caller)
+    : throttle_(throttle), caller_(caller), result_(throttle.Enter(caller, GetNowMs()))
+{
+}
+
+CallThrottle::Admission::~Admission()
+{
+    if (result_ == static_cast<int32_t>(PasteboardError::E_OK)) {
+        throttle_.Exit(caller_, GetNowMs());
+    }
+}
+
+int32_t CallThrottle::Admission::GetResult() const
+{
+    return result_;
+}
+
+void CallThrottle::Admission::Charge(uint64_t bytes)
+{
+    if (result_ == static_cast<int32_t>(PasteboardError::E_OK)) {
+        throttle_.Charge(caller_, bytes, GetNowMs());
+    }
+}
+
+CallThrottle::CallThrottle() : CallThrottle(Config()) {}
+
+CallThrottle::CallThrottle(Config config) : config_(config) {}
+
+void CallThrottle::SetConfig(const Config &config)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+    // raised limits let the waiting calls run
+    Dispatch();
+}
+
+CallThrottle::Config CallThrottle::GetConfig() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+int32_t CallThrottle::Enter(const Caller &caller, uint64_t nowMs)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    Prune(nowMs);
+    auto &state = GetCaller(caller, nowMs);
+    if (!config_.enabled) {
+        Admit(state);
+        return static_cast<int32_t>(PasteboardError::E_OK);
+    }
+    Refill(state, nowMs);
+    // the call is only taken from the bucket once admitted or waiting, a refused call costs nothing
+    if (HasCallLimit() && state.calls < 1) {
+        state.refused++;
+        stats_.callLimited++;
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "call limited, pid=%{public}d", caller.pid);
+        return static_cast<int32_t>(PasteboardError::SERVICE_BUSY);
+    }
+    if (config_.bytesPerSecond != 0 && config_.byteBurst != 0 && state.bytes < 0) {
+        state.refused++;
+        stats_.byteLimited++;
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "byte limited, pid=%{public}d", caller.pid);
+        return static_cast<int32_t>(PasteboardError::SERVICE_BUSY);
+    }
+    // a waiting call that fits the free slots was given one on the exit that freed it, so a free slot is not owed
+    if (HasSlot() && HasCallerSlot(state)) {
+        TakeCall(state);
+        Admit(state);
+        return static_cast<int32_t>(PasteboardError::E_OK);
+    }
+    if (config_.maxWaitMs == 0 ||
+        (config_.maxCallerWaiting != 0 && state.waiters.size() >= config_.maxCallerWaiting)) {
+        state.refused++;
+        stats_.busy++;
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "busy, pid=%{public}d, waiting=%{public}zu", caller.pid,
+            state.waiters.size());
+        return static_cast<int32_t>(PasteboardError::SERVICE_BUSY);
+    }
+    // a waiting call blocks its IPC thread, the calls of other callers and the other interfaces need the rest
+    if (config_.maxWaiting != 0 && waiting_ >= config_.maxWaiting) {
+        state.refused++;
+        stats_.busy++;
+        stats_.waitLimited++;
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "busy, pid=%{public}d, all waiting=%{public}u", caller.pid,
+            waiting_);
+        return static_cast<int32_t>(PasteboardError::SERVICE_BUSY);
+    }
+    TakeCall(state);
+    Waiter waiter;
+    state.waiters.push_back(&waiter);
+    if (state.waiters.size() == 1) {
+        turns_.push_back(caller);
+    }
+    waiting_++;
+    bool granted = granted_.wait_for(lock, std::chrono::milliseconds(config_.maxWaitMs),
+        [&waiter]() { return waiter.granted; });
+    waiting_--;
+    if (granted) {
+        stats_.queued++;
+        return static_cast<int32_t>(PasteboardError::E_OK);
+    }
+    state.waiters.erase(std::find(state.waiters.begin(), state.waiters.end(), &waiter));
+    if (state.waiters.empty()) {
+        turns_.erase(std::find(turns_.begin(), turns_.end(), caller));
+    }
+    ReturnCall(state);
+    state.refused++;
+    stats_.busy++;
+    PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "no slot in %{public}u ms, pid=%{public}d", config_.maxWaitMs,
+        caller.pid);
+    return static_cast<int32_t>(PasteboardError::SERVICE_BUSY);
+}
+
+void CallThrottle::Exit(const Caller &caller, uint64_t nowMs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (inFlight_ > 0) {
+        inFlight_--;
+    }
+    auto it = callers_.find(caller);
+    if (it != callers_.end()) {
+        it->second.lastMs = nowMs;
+        if (it->second.inFlight > 0) {
+            it->second.inFlight--;
+        }
+    }
+    Dispatch();
+}
+
+void CallThrottle::Charge(const Caller &caller, uint64_t bytes, uint64_t nowMs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = callers_.find(caller);
+    if (it == callers_.end()) {
+        return;
+    }
+    auto &state = it->second;
+    Refill(state, nowMs);
+    state.bytes -= static_cast<double>(bytes);
+    state.chargedBytes += bytes;
+    stats_.bytes += bytes;
+}
+
+CallThrottle::Stats CallThrottle::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    stats.inFlight = inFlight_;
+    stats.waiting = waiting_;
+    stats.callers = callers_.size();
+    return stats;
+}
+
+std::vector<CallThrottle::CallerStats> CallThrottle::GetCallerStats(size_t maxCount) const
+{
+    std::vector<CallerStats> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        result.reserve(callers_.size());
+        for (const auto &[caller, state] : callers_) {
+            CallerStats stats;
+            stats.caller = caller;
+            stats.admitted = state.admitted;
+            stats.refused = state.refused;
+            stats.bytes = state.chargedBytes;
+            stats.inFlight = state.inFlight;
+            stats.waiting = static_cast<uint32_t>(state.waiters.size());
+            result.push_back(stats);
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const CallerStats &left, const CallerStats &right) {
+        return left.refused != right.refused ? left.refused > right.refused : left.admitted > right.admitted;
+    });
+    if (result.size() > maxCount) {
+        result.resize(maxCount);
+    }
+    return result;
+}
+
+uint64_t CallThrottle::GetNowMs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+CallThrottle::CallerState &CallThrottle::GetCaller(const Caller &caller, uint64_t nowMs)
+{
+    auto [it, inserted] = callers_.try_emplace(caller);
+    auto &state = it->second;
+    if (inserted) {
+        state.calls = config_.callBurst;
+        state.bytes = static_cast<double>(config_.byteBurst);
+        state.refillMs = nowMs;
+    }
+    state.lastMs = nowMs;
+    return state;
+}
+
+void CallThrottle::Refill(CallerState &state, uint64_t nowMs) const
+{
+    if (nowMs <= state.refillMs) {
+        return;
+    }
+    double seconds = static_cast<double>(nowMs - state.refillMs) / MS_PER_SECOND;
+    state.refillMs = nowMs;
+    state.calls = std::min<double>(state.calls + seconds * config_.callsPerSecond, config_.callBurst);
+    state.bytes = std::min<double>(state.bytes + seconds * static_cast<double>(config_.bytesPerSecond),
+        static_cast<double>(config_.byteBurst));
+}
+
+bool CallThrottle::HasCallLimit() const
+{
+    return config_.callsPerSecond != 0 && config_.callBurst != 0;
+}
+
+void CallThrottle::TakeCall(CallerState &state)
+{
+    if (HasCallLimit()) {
+        state.calls -= 1;
+    }
+}
+
+void CallThrottle::ReturnCall(CallerState &state)
+{
+    if (HasCallLimit()) {
+        state.calls = std::min<double>(state.calls + 1, config_.callBurst);
+    }
+}
+
+bool CallThrottle::HasSlot() const
+{
+    return !config_.enabled || config_.maxConcurrent == 0 || inFlight_ < config_.maxConcurrent;
+}
+
+bool CallThrottle::HasCallerSlot(const CallerState &state) const
+{
+    return !config_.enabled || config_.maxCallerConcurrent == 0 || state.inFlight < config_.maxCallerConcurrent;
+}
+
+void CallThrottle::Admit(CallerState &state)
+{
+    inFlight_++;
+    state.inFlight++;
+    state.admitted++;
+    stats_.admitted++;
+}
+
+void CallThrottle::Dispatch()
+{
+    bool granted = false;
+    bool progress = true;
+    // a round gives each waiting caller at most one slot, the callers granted one go to the back of the turns
+    while (progress && HasSlot() && !turns_.empty()) {
+        progress = false;
+        for (size_t count = turns_.size(); count > 0 && HasSlot(); --count) {
+            Caller caller = turns_.front();
+            turns_.pop_front();
+            auto &state = callers_[caller];
+            if (state.waiters.empty()) {
+                continue;
+            }
+            if (HasCallerSlot(state)) {
+                state.waiters.front()->granted = true;
+                state.waiters.pop_front();
+                Admit(state);
+                granted = true;
+                progress = true;
+            }
+            if (!state.waiters.empty()) {
+                turns_.push_back(caller);
+            }
+        }
+    }
+    if (granted) {
+        granted_.notify_all();
+    }
+}
+
+void CallThrottle::Prune(uint64_t nowMs)
+{
+    if (nowMs < prunedMs_ + PRUNE_INTERVAL_MS) {
+        return;
+    }
+    prunedMs_ = nowMs;
+    // a byte debt left by a caller idle this long is paid off at any sane refill rate
+    for (auto it = callers_.begin(); it != callers_.end();) {
+        const auto &state = it->second;
+        if (state.inFlight == 0 && state.waiters.empty() && nowMs > state.lastMs + IDLE_MS) {
+            it = callers_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+} // namespace OHOS::MiscServices
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_change_state_publisher.h"
+
+#include <cerrno>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "ashmem.h"
+#include "pasteboard_error.h"
+#include "pasteboard_hilog.h"
+
+namespace OHOS::MiscServices {
+ChangeStatePublisher::ChangeStatePublisher(GetState getState) : getState_(std::move(getState)) {}
+
+ChangeStatePublisher::~ChangeStatePublisher()
+{
+    Clear();
+}
+
+int32_t ChangeStatePublisher::GetFd(int32_t userId, int &fd)
+{
+    fd = -1;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = pages_.find(userId);
+    if (it == pages_.end()) {
+        Page page;
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(CreatePage(page), static_cast<int32_t>(PasteboardError::MALLOC_FAILED),
+            PASTEBOARD_MODULE_SERVICE, "create change state page failed, userId=%{public}d", userId);
+        it = pages_.emplace(userId, page).first;
+        ChangeStatePage::Write(*page.layout, getState_ ? getState_(userId) : ChangeState());
+        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "change state page created, userId=%{public}d", userId);
+    }
+    fd = dup(it->second.fd);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(fd >= 0, static_cast<int32_t>(PasteboardError::OTHER_ERROR),
+        PASTEBOARD_MODULE_SERVICE, "dup change state page failed, errno=%{public}d", errno);
+    return static_cast<int32_t>(PasteboardError::E_OK);
+}
+
+void ChangeStatePublisher::Publish(int32_t userId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = pages_.find(userId);
+    if (it == pages_.end() || !getState_) {
+        return;
+    }
+    ChangeStatePage::Write(*it->second.layout, getState_(userId));
+}
+
+void ChangeStatePublisher::PublishAll()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!getState_) {
+        return;
+    }
+    for (auto &[userId, page] : pages_) {
+        ChangeStatePage::Write(*page.layout, getState_(userId));
+    }
+}
+
+void ChangeStatePublisher::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &[userId, page] : pages_) {
+        ReleasePage(page);
+    }
+    pages_.clear();
+}
+
+size_t ChangeStatePublisher::GetPageCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pages_.size();
+}
+
+bool ChangeStatePublisher::CreatePage(Page &page)
+{
+    page.fd = AshmemCreate("PasteboardChangeState", sizeof(ChangeStatePage::Layout));
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(page.fd >= 0, false, PASTEBOARD_MODULE_SERVICE, "ashmem create failed");
+    void *addr = mmap(nullptr, sizeof(ChangeStatePage::Layout), PROT_READ | PROT_WRITE, MAP_SHARED, page.fd, 0);
+    if (addr == MAP_FAILED) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "mmap change state page failed, errno=%{public}d", errno);
+        ReleasePage(page);
+        return false;
+    }
+    page.layout = new (addr) ChangeStatePage::Layout{};
+    // the mapping above stays writable, the clients can only map the page read-only
+    if (AshmemSetProt(page.fd, PROT_READ) < 0) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "ashmem set prot failed");
+        ReleasePage(page);
+        return false;
+    }
+    return true;
+}
+
+void ChangeStatePublisher::ReleasePage(Page &page)
+{
+    if (page.layout != nullptr) {
+        munmap(page.layout, sizeof(ChangeStatePage::Layout));
+        page.layout = nullptr;
+    }
+    if (page.fd >= 0) {
+        close(page.fd);
+        page.fd = -1;
+    }
+}
+} // namespace OHOS::MiscServices
@@ -0,0 +1,538 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_clip_history.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "pasteboard_hilog.h"
+#include "pasteboard_time.h"
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr mode_t SPILL_DIR_MODE = 0700;
+constexpr mode_t SPILL_FILE_MODE = 0600;
+constexpr uint8_t UTF8_CONTINUATION_MASK = 0xC0;
+constexpr uint8_t UTF8_CONTINUATION = 0x80;
+
+std::string TruncateUtf8(const std::string &text, size_t maxLength)
+{
+    if (text.size() <= maxLength) {
+        return text;
+    }
+    size_t length = maxLength;
+    while (length > 0 && (static_cast<uint8_t>(text[length]) & UTF8_CONTINUATION_MASK) == UTF8_CONTINUATION) {
+        --length;
+    }
+    return text.substr(0, length);
+}
+} // namespace
+
+ClipHistory::ClipHistory() : ClipHistory(Config()) {}
+
+ClipHistory::ClipHistory(Config config) : config_(std::move(config)) {}
+
+ClipHistory::~ClipHistory()
+{
+    Clear();
+}
+
+uint32_t ClipHistory::Add(int32_t userId, PasteData &data)
+{
+    uint64_t generation = GetGeneration(userId);
+    Clip clip;
+    if (!Encode(data, clip)) {
+        return 0;
+    }
+    return Add(userId, std::move(clip), generation);
+}
+
+bool ClipHistory::Encode(PasteData &data, Clip &clip) const
+{
+    if (!IsRecordable(data)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.skipped++;
+        return false;
+    }
+    bool encoded = data.Encode(clip.tlv);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(encoded, false, PASTEBOARD_MODULE_SERVICE, "encode clip failed");
+    clip.hash = PasteData::GetContentHash(clip.tlv);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(clip.hash != 0, false, PASTEBOARD_MODULE_SERVICE, "hash clip failed");
+    clip.summary = MakeSummary(data, clip.tlv.size());
+    return true;
+}
+
+uint32_t ClipHistory::Add(int32_t userId, Clip clip, uint64_t generation)
+{
+    PrepareSpillDir(userId);
+    auto tlv = std::make_shared<const std::vector<uint8_t>>(std::move(clip.tlv));
+    std::vector<std::string> files;
+    std::vector<SpillJob> jobs;
+    uint32_t clipId = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (CurrentGeneration(userId) != generation) {
+            stats_.skipped++;
+            return 0;
+        }
+        if (tlv->size() > std::max(config_.memoryBudget, config_.diskBudget)) {
+            stats_.skipped++;
+            return 0;
+        }
+        auto &entries = users_[userId];
+        auto it = std::find_if(entries.begin(), entries.end(), [&clip](const Entry &entry) {
+            return entry.hash == clip.hash && entry.summary.dataSize == clip.summary.dataSize;
+        });
+        if (it != entries.end()) {
+            // the same content copied again, the newer copy decides the owner and the share option of the entry
+            clipId = it->summary.clipId;
+            Erase(entries, it, files);
+            stats_.deduplicated++;
+        } else {
+            clipId = nextClipId_++;
+            if (nextClipId_ == 0) {
+                nextClipId_ = 1;
+            }
+            stats_.added++;
+        }
+        clip.summary.clipId = clipId;
+        residentBytes_ += tlv->size();
+        entries.push_front(Entry{ std::move(clip.summary), clip.hash, tlv, "", false });
+        Trim(entries, files);
+        jobs = SelectSpills(files);
+    }
+    for (auto &job : jobs) {
+        job.written = WriteFile(job.path, *job.tlv);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        FinishSpills(jobs, files);
+        auto user = users_.find(userId);
+        if (user == users_.end() || user->second.empty() || user->second.front().summary.clipId != clipId) {
+            clipId = 0;
+        }
+    }
+    RemoveFiles(files);
+    return clipId;
+}
+
+uint64_t ClipHistory::GetGeneration(int32_t userId) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return CurrentGeneration(userId);
+}
+
+std::vector<PasteClipSummary> ClipHistory::GetSummaries(int32_t userId) const
+{
+    std::vector<PasteClipSummary> summaries;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto user = users_.find(userId);
+    if (user == users_.end()) {
+        return summaries;
+    }
+    summaries.reserve(user->second.size());
+    for (const auto &entry : user->second) {
+        summaries.push_back(entry.summary);
+    }
+    return summaries;
+}
+
+std::shared_ptr<PasteData> ClipHistory::Get(int32_t userId, uint32_t clipId) const
+{
+    std::shared_ptr<const std::vector<uint8_t>> tlv;
+    std::string spillPath;
+    size_t size = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto user = users_.find(userId);
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGD(user != users_.end(), nullptr, PASTEBOARD_MODULE_SERVICE,
+            "no history of user %{public}d", userId);
+        auto entry = std::find_if(user->second.begin(), user->second.end(), [clipId](const Entry &item) {
+            return item.summary.clipId == clipId;
+        });
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGD(entry != user->second.end(), nullptr, PASTEBOARD_MODULE_SERVICE,
+            "no clip %{public}u of user %{public}d", clipId, userId);
+        tlv = entry->tlv;
+        spillPath = entry->spillPath;
+        size = static_cast<size_t>(entry->summary.dataSize);
+    }
+    if (tlv == nullptr) {
+        // the entry may be dropped meanwhile, its file is then gone and the read fails
+        auto buffer = std::make_shared<std::vector<uint8_t>>();
+        bool ret = ReadFile(spillPath, size, *buffer);
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret, nullptr, PASTEBOARD_MODULE_SERVICE,
+            "read spilled clip %{public}u failed", clipId);
+        tlv = std::move(buffer);
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.reloaded++;
+    }
+    auto data = std::make_shared<PasteData>();
+    bool decoded = data->Decode(*tlv);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(decoded, nullptr, PASTEBOARD_MODULE_SERVICE, "decode clip failed");
+    return data;
+}
+
+void ClipHistory::RemoveUser(int32_t userId)
+{
+    std::vector<std::string> files;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        removals_[userId]++;
+        auto user = users_.find(userId);
+        if (user == users_.end()) {
+            return;
+        }
+        while (!user->second.empty()) {
+            Erase(user->second, user->second.begin(), files);
+        }
+        users_.erase(user);
+    }
+    RemoveFiles(files);
+}
+
+void ClipHistory::Clear()
+{
+    std::vector<std::string> files;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        clears_++;
+        for (auto &[userId, entries] : users_) {
+            while (!entries.empty()) {
+                Erase(entries, entries.begin(), files);
+            }
+        }
+        users_.clear();
+    }
+    RemoveFiles(files);
+}
+
+ClipHistory::Stats ClipHistory::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    stats.clips = 0;
+    for (const auto &[userId, entries] : users_) {
+        stats.clips += entries.size();
+    }
+    stats.residentBytes = residentBytes_;
+    stats.spilledBytes = spilledBytes_;
+    return stats;
+}
+
+std::string ClipHistory::Dump() const
+{
+    auto stats = GetStats();
+    std::string result;
+    result.append("clips: ").append(std::to_string(stats.clips))
+        .append(", resident ").append(std::to_string(stats.residentBytes))
+        .append("/").append(std::to_string(config_.memoryBudget))
+        .append(" bytes, spilled ").append(std::to_string(stats.spilledBytes))
+        .append("/").append(std::to_string(config_.diskBudget)).append(" bytes\n")
+        .append("added ").append(std::to_string(stats.added))
+        .append(", deduplicated ").append(std::to_string(stats.deduplicated))
+        .append(", skipped ").append(std::to_string(stats.skipped))
+        .append(", evicted ").append(std::to_string(stats.evicted))
+        .append(", spilled ").append(std::to_string(stats.spilled))
+        .append(", spill failed ").append(std::to_string(stats.spillFailed))
+        .append(", reloaded ").append(std::to_string(stats.reloaded)).append("\n");
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto &[userId, entries] : users_) {
+        result.append("user ").append(std::to_string(userId)).append(":\n");
+        for (const auto &entry : entries) {
+            const auto &summary = entry.summary;
+            result.append("  ").append(std::to_string(summary.clipId))
+                .append(" time=").append(std::to_string(summary.copyTime))
+                .append(" size=").append(std::to_string(summary.dataSize))
+                .append(" records=").append(std::to_string(summary.recordCount))
+                .append(" bundle=").append(summary.bundleName)
+                .append(entry.spillPath.empty() ? "" : " spilled").append("\n");
+        }
+    }
+    return result;
+}
+
+bool ClipHistory::IsRecordable(PasteData &data)
+{
+    // in-app data must not outlive the copy, remote and delayed data are not held by this device
+    return data.GetRecordCount() > 0 && !data.IsDelayData() && !data.IsDelayRecord() && !data.IsRemote() &&
+        data.GetShareOption() != ShareOption::InApp;
+}
+
+PasteClipSummary ClipHistory::MakeSummary(PasteData &data, size_t dataSize)
+{
+    PasteClipSummary summary;
+    summary.copyTime = PasteBoardTime::GetWallTimeMs();
+    summary.dataSize = static_cast<int64_t>(dataSize);
+    summary.recordCount = static_cast<uint32_t>(data.GetRecordCount());
+    summary.bundleName = data.GetBundleName();
+    summary.mimeTypes = data.GetMimeTypes();
+    auto text = data.GetPrimaryText();
+    if (text != nullptr) {
+        summary.textPreview = TruncateUtf8(*text, PasteClipSummary::MAX_PREVIEW_LENGTH);
+    }
+    return summary;
+}
+
+bool ClipHistory::WriteFile(const std::string &path, const std::vector<uint8_t> &data)
+{
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, SPILL_FILE_MODE);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(fd >= 0, false, PASTEBOARD_MODULE_SERVICE,
+        "open spill file failed, errno=%{public}d", errno);
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t ret = write(fd, data.data() + written, data.size() - written);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "write spill file failed, errno=%{public}d", errno);
+            break;
+        }
+        written += static_cast<size_t>(ret);
+    }
+    close(fd);
+    if (written != data.size()) {
+        unlink(path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ClipHistory::ReadFile(const std::string &path, size_t size, std::vector<uint8_t> &data)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(fd >= 0, false, PASTEBOARD_MODULE_SERVICE,
+        "open spill file failed, errno=%{public}d", errno);
+    data.resize(size);
+    size_t total = 0;
+    while (total < size) {
+        ssize_t ret = read(fd, data.data() + total, size - total);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            break;
+        }
+        total += static_cast<size_t>(ret);
+    }
+    close(fd);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(total == size, false, PASTEBOARD_MODULE_SERVICE,
+        "spill file truncated, read %{public}zu of %{public}zu", total, size);
+    return true;
+}
+
+void ClipHistory::RemoveFiles(const std::string &path)
+{
+    DIR *dir = opendir(path.c_str());
+    PASTEBOARD_CHECK_AND_RETURN_LOGW(dir != nullptr, PASTEBOARD_MODULE_SERVICE, "open spill dir failed");
+    uint32_t removed = 0;
+    for (struct dirent *item = readdir(dir); item != nullptr; item = readdir(dir)) {
+        if (item->d_type != DT_REG) {
+            continue;
+        }
+        std::string file = path + "/" + item->d_name;
+        if (unlink(file.c_str()) == 0) {
+            removed++;
+        }
+    }
+    closedir(dir);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "removed %{public}u stale spill files", removed);
+}
+
+void ClipHistory::RemoveFiles(const std::vector<std::string> &files)
+{
+    for (const auto &file : files) {
+        unlink(file.c_str());
+    }
+}
+
+std::string ClipHistory::MakeUserDir(const std::string &root, int32_t userId, const std::string &subDir)
+{
+    std::string dir = root + "/" + std::to_string(userId);
+    struct stat info = {};
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGW(stat(dir.c_str(), &info) == 0 && S_ISDIR(info.st_mode), "",
+        PASTEBOARD_MODULE_SERVICE, "no storage of user %{public}d", userId);
+    size_t begin = 0;
+    while (begin < subDir.size()) {
+        size_t end = subDir.find('/', begin);
+        end = end == std::string::npos ? subDir.size() : end;
+        if (end > begin) {
+            dir.append("/").append(subDir, begin, end - begin);
+            PASTEBOARD_CHECK_AND_RETURN_RET_LOGW(mkdir(dir.c_str(), SPILL_DIR_MODE) == 0 || errno == EEXIST, "",
+                PASTEBOARD_MODULE_SERVICE, "create spill dir failed, errno=%{public}d", errno);
+        }
+        begin = end + 1;
+    }
+    return dir;
+}
+
+void ClipHistory::PrepareSpillDir(int32_t userId)
+{
+    if (config_.spillRoot.empty() || config_.spillDir.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> prepareLock(spillDirMutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (spillDirs_.find(userId) != spillDirs_.end()) {
+            return;
+        }
+    }
+    std::string dir = MakeUserDir(config_.spillRoot, userId, config_.spillDir);
+    if (dir.empty()) {
+        return;
+    }
+    // the index of the files spilled by a previous instance is gone with it
+    RemoveFiles(dir);
+    std::lock_guard<std::mutex> lock(mutex_);
+    spillDirs_[userId] = std::move(dir);
+}
+
+uint64_t ClipHistory::CurrentGeneration(int32_t userId) const
+{
+    auto it = removals_.find(userId);
+    return clears_ + (it == removals_.end() ? 0 : it->second);
+}
+
+void ClipHistory::Trim(EntryList &entries, std::vector<std::string> &files)
+{
+    while (entries.size() > config_.maxClips) {
+        Erase(entries, std::prev(entries.end()), files);
+        stats_.evicted++;
+    }
+}
+
+std::vector<ClipHistory::SpillJob> ClipHistory::SelectSpills(std::vector<std::string> &files)
+{
+    std::vector<SpillJob> jobs;
+    EntryList *entries = nullptr;
+    EntryList::iterator it;
+    // the entries being written still count as resident until their files are done
+    while (residentBytes_ - spillingBytes_ > config_.memoryBudget) {
+        int32_t userId = 0;
+        if (FindLargestResident(userId, it)) {
+            it->spilling = true;
+            spillingBytes_ += it->tlv->size();
+            std::string path = spillDirs_[userId] + "/" + std::to_string(it->summary.clipId) + "_" +
+                std::to_string(nextSpillId_++);
+            jobs.push_back(SpillJob{ userId, it->summary.clipId, it->tlv, std::move(path), false });
+            continue;
+        }
+        if (!FindOldest(false, entries, it)) {
+            break;
+        }
+        stats_.evicted++;
+        Erase(*entries, it, files);
+    }
+    return jobs;
+}
+
+void ClipHistory::FinishSpills(const std::vector<SpillJob> &jobs, std::vector<std::string> &files)
+{
+    for (const auto &job : jobs) {
+        auto user = users_.find(job.userId);
+        EntryList::iterator it;
+        bool found = false;
+        if (user != users_.end()) {
+            it = std::find_if(user->second.begin(), user->second.end(), [&job](const Entry &entry) {
+                return entry.spilling && entry.tlv == job.tlv;
+            });
+            found = it != user->second.end();
+        }
+        // an entry dropped while its file was written leaves the file behind
+        if (!found) {
+            if (job.written) {
+                files.push_back(job.path);
+            }
+            continue;
+        }
+        it->spilling = false;
+        spillingBytes_ -= job.tlv->size();
+        if (!job.written) {
+            stats_.spillFailed++;
+            stats_.evicted++;
+            Erase(user->second, it, files);
+            continue;
+        }
+        residentBytes_ -= job.tlv->size();
+        spilledBytes_ += job.tlv->size();
+        it->tlv = nullptr;
+        it->spillPath = job.path;
+        stats_.spilled++;
+    }
+    EntryList *entries = nullptr;
+    EntryList::iterator it;
+    while (spilledBytes_ > config_.diskBudget && FindOldest(true, entries, it)) {
+        stats_.evicted++;
+        Erase(*entries, it, files);
+    }
+}
+
+void ClipHistory::Erase(EntryList &entries, EntryList::iterator it, std::vector<std::string> &files)
+{
+    if (it->tlv != nullptr) {
+        residentBytes_ -= it->tlv->size();
+        spillingBytes_ -= it->spilling ? it->tlv->size() : 0;
+    } else {
+        spilledBytes_ -= static_cast<size_t>(it->summary.dataSize);
+        files.push_back(it->spillPath);
+    }
+    entries.erase(it);
+}
+
+bool ClipHistory::FindLargestResident(int32_t &userId, EntryList::iterator &found)
+{
+    size_t largest = 0;
+    bool exist = false;
+    for (auto &[user, entries] : users_) {
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            // on a tie the later, older entry is spilled first
+            if (it->tlv != nullptr && !it->spilling && it->tlv->size() >= config_.spillThreshold &&
+                it->tlv->size() >= largest && spillDirs_.find(user) != spillDirs_.end()) {
+                largest = it->tlv->size();
+                userId = user;
+                found = it;
+                exist = true;
+            }
+        }
+    }
+    return exist;
+}
+
+bool ClipHistory::FindOldest(bool spilled, EntryList *&entries, EntryList::iterator &found)
+{
+    bool exist = false;
+    for (auto &[user, items] : users_) {
+        // the entries of a user are ordered, the last match is the oldest one of the user
+        for (auto it = items.rbegin(); it != items.rend(); ++it) {
+            if (it->spilling || (it->tlv == nullptr) != spilled) {
+                continue;
+            }
+            if (!exist || it->summary.copyTime < found->summary.copyTime) {
+                exist = true;
+                entries = &items;
+                found = std::prev(it.base());
+            }
+            break;
+        }
+    }
+    return exist;
+}
+} // namespace OHOS::MiscServices
@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_clip_spill_store.h"
+
+#include <algorithm>
+#include <unistd.h>
+
+#include "pasteboard_clip_history.h"
+#include "pasteboard_hilog.h"
+
+namespace OHOS::MiscServices {
+ClipSpillStore::ClipSpillStore() : ClipSpillStore(Config()) {}
+
+ClipSpillStore::ClipSpillStore(Config config) : config_(std::move(config)) {}
+
+ClipSpillStore::~ClipSpillStore()
+{
+    Clear();
+}
+
+void ClipSpillStore::SetResidentBudget(size_t budget)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_.residentBudget = budget;
+}
+
+size_t ClipSpillStore::GetResidentBudget() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_.residentBudget;
+}
+
+void ClipSpillStore::Touch(int32_t userId, uint64_t nowMs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    accessTimes_[userId] = nowMs;
+}
+
+std::vector<int32_t> ClipSpillStore::SelectSpill(const std::vector<Clip> &clips, uint64_t nowMs,
+    bool underPressure) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t resident = 0;
+    std::vector<std::pair<uint64_t, const Clip *>> candidates;
+    for (const auto &clip : clips) {
+        resident += clip.size;
+        if (!clip.spillable || clip.size < config_.spillThreshold) {
+            continue;
+        }
+        auto it = accessTimes_.find(clip.userId);
+        uint64_t accessTime = it == accessTimes_.end() ? 0 : it->second;
+        if (accessTime + config_.idleTime > nowMs) {
+            continue;
+        }
+        candidates.emplace_back(accessTime, &clip);
+    }
+    // under memory pressure every idle clip goes, whatever the budget
+    size_t budget = underPressure ? 0 : config_.residentBudget;
+    std::sort(candidates.begin(), candidates.end(), [](const auto &left, const auto &right) {
+        return left.first < right.first;
+    });
+    std::vector<int32_t> users;
+    for (const auto &[accessTime, clip] : candidates) {
+        if (resident <= budget) {
+            break;
+        }
+        users.push_back(clip->userId);
+        resident -= clip->size;
+    }
+    return users;
+}
+
+std::shared_ptr<PasteData> ClipSpillStore::Spill(int32_t userId, PasteData &data)
+{
+    std::vector<uint8_t> tlv;
+    bool encoded = data.Encode(tlv);
+    auto shell = encoded ? MakeShell(data) : nullptr;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(userId);
+    if (it != entries_.end()) {
+        Erase(it);
+    }
+    std::string dir = shell == nullptr ? "" : GetSpillDir(userId);
+    if (dir.empty()) {
+        stats_.spillFailed++;
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "spill clip failed, encoded=%{public}d", encoded);
+        return nullptr;
+    }
+    std::string path = dir + "/" + std::to_string(data.GetDataId());
+    if (!ClipHistory::WriteFile(path, tlv)) {
+        stats_.spillFailed++;
+        return nullptr;
+    }
+    entries_[userId] = Entry{ shell, path, tlv.size() };
+    spilledBytes_ += tlv.size();
+    stats_.spilled++;
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "spilled clip, userId=%{public}d, dataId=%{public}u, "
+        "size=%{public}zu", userId, data.GetDataId(), tlv.size());
+    return shell;
+}
+
+bool ClipSpillStore::IsSpilled(int32_t userId, const std::shared_ptr<PasteData> &shell) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(userId);
+    return shell != nullptr && it != entries_.end() && it->second.shell.lock() == shell;
+}
+
+std::shared_ptr<PasteData> ClipSpillStore::Restore(int32_t userId, const std::shared_ptr<PasteData> &shell)
+{
+    std::vector<uint8_t> tlv;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(userId);
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGD(it != entries_.end() && it->second.shell.lock() == shell, nullptr,
+            PASTEBOARD_MODULE_SERVICE, "clip of user %{public}d not spilled", userId);
+        bool ret = ClipHistory::ReadFile(it->second.path, it->second.size, tlv);
+        Erase(it);
+        if (!ret) {
+            stats_.restoreFailed++;
+            return nullptr;
+        }
+    }
+    auto data = std::make_shared<PasteData>();
+    bool decoded = data->Decode(tlv);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!decoded) {
+        stats_.restoreFailed++;
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "decode spilled clip failed, userId=%{public}d", userId);
+        return nullptr;
+    }
+    stats_.restored++;
+    return data;
+}
+
+void ClipSpillStore::Remove(int32_t userId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    accessTimes_.erase(userId);
+    auto it = entries_.find(userId);
+    if (it != entries_.end()) {
+        Erase(it);
+    }
+}
+
+void ClipSpillStore::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (!entries_.empty()) {
+        Erase(entries_.begin());
+    }
+    accessTimes_.clear();
+}
+
+ClipSpillStore::Stats ClipSpillStore::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    stats.clips = entries_.size();
+    stats.spilledBytes = spilledBytes_;
+    return stats;
+}
+
+std::shared_ptr<PasteData> ClipSpillStore::MakeShell(PasteData &data) const
+{
+    std::vector<std::shared_ptr<PasteDataRecord>> records;
+    std::vector<uint32_t> recordIds;
+    for (const auto &record : data.AllRecords()) {
+        if (record == nullptr) {
+            continue;
+        }
+        std::shared_ptr<PasteDataRecord> item;
+        if (record->CountTLV() <= config_.residentRecordSize) {
+            item = std::make_shared<PasteDataRecord>(*record);
+        } else {
+            // entries without a value, enough to tell the mime types of the record
+            auto mimeTypes = record->GetMimeTypes();
+            item = PasteDataRecord::NewMultiTypeDelayRecord(
+                std::vector<std::string>(mimeTypes.begin(), mimeTypes.end()), nullptr);
+            item->SetFrom(record->GetFrom());
+            item->SetDataId(record->GetDataId());
+        }
+        records.push_back(item);
+        recordIds.push_back(record->GetRecordId());
+    }
+    auto shell = std::make_shared<PasteData>(records);
+    // the constructor numbers the records again
+    for (size_t i = 0; i < records.size(); ++i) {
+        records[i]->SetRecordId(recordIds[i]);
+    }
+    shell->SetProperty(data.GetProperty());
+    shell->SetDataId(data.GetDataId());
+    shell->SetPasteId(data.GetPasteId());
+    shell->SetOriginAuthority(data.GetOriginAuthority());
+    shell->SetDraggedDataFlag(data.IsDraggedData());
+    shell->SetLocalPasteFlag(data.IsLocalPaste());
+    shell->rawDataSize_ = data.rawDataSize_;
+    shell->deviceId_ = data.deviceId_;
+    return shell;
+}
+
+std::string ClipSpillStore::GetSpillDir(int32_t userId)
+{
+    if (config_.spillRoot.empty() || config_.spillDir.empty()) {
+        return "";
+    }
+    auto it = spillDirs_.find(userId);
+    if (it != spillDirs_.end()) {
+        return it->second;
+    }
+    std::string dir = ClipHistory::MakeUserDir(config_.spillRoot, userId, config_.spillDir);
+    if (dir.empty()) {
+        return "";
+    }
+    // the clips spilled by a previous instance are gone with it
+    ClipHistory::RemoveFiles(dir);
+    spillDirs_[userId] = dir;
+    return dir;
+}
+
+void ClipSpillStore::Erase(std::map<int32_t, Entry>::iterator it)
+{
+    spilledBytes_ -= it->second.size;
+    unlink(it->second.path.c_str());
+    entries_.erase(it);
+}
+} // namespace OHOS::MiscServices
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_ctrlv_grant_table.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <iterator>
+
+#include "pasteboard_hilog.h"
+
+namespace OHOS {
+namespace MiscServices {
+void CtrlVGrantTable::Record(int32_t pid, int32_t windowId, uint64_t nowMs)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = std::find_if(grants_.begin(), grants_.end(), [pid](const Grant &grant) {
+            return grant.pid == pid;
+        });
+        if (it != grants_.end()) {
+            grants_.erase(it);
+        }
+        if (grants_.size() >= MAX_GRANTS) {
+            grants_.pop_front();
+            ++stats_.pruned;
+        }
+        grants_.push_back({ pid, windowId, nowMs });
+        inFlightUntil_ = 0;
+        ++stats_.recorded;
+    }
+    recorded_.notify_all();
+}
+
+void CtrlVGrantTable::MarkInFlight(uint64_t nowMs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    inFlightUntil_ = nowMs + GRANT_WINDOW_MS;
+}
+
+void CtrlVGrantTable::ClearInFlight()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        inFlightUntil_ = 0;
+    }
+    recorded_.notify_all();
+}
+
+bool CtrlVGrantTable::Consume(int32_t pid, bool isFocused, uint64_t nowMs, uint32_t waitMs)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = Find(pid, isFocused, nowMs, nowMs);
+    if (it == grants_.end() && waitMs > 0 && IsInFlight(nowMs)) {
+        // a grant recorded while waiting is at most waitMs later than the check itself
+        ++stats_.waited;
+        recorded_.wait_for(lock, std::chrono::milliseconds(waitMs), [this, &it, pid, isFocused, nowMs, waitMs] {
+            it = Find(pid, isFocused, nowMs, nowMs + waitMs);
+            return it != grants_.end() || !IsInFlight(nowMs);
+        });
+    }
+    if (it == grants_.end()) {
+        ++stats_.denied;
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE,
+            "no grant, pid=%{public}d, isFocused=%{public}d, grants=%{public}zu, now=%{public}" PRIu64, pid,
+            isFocused, grants_.size(), nowMs);
+        return false;
+    }
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE,
+        "granted, pid=%{public}d, windowPid=%{public}d, windowId=%{public}d, isFocused=%{public}d", pid, it->pid,
+        it->windowId, isFocused);
+    grants_.erase(it);
+    ++stats_.granted;
+    return true;
+}
+
+size_t CtrlVGrantTable::Prune(uint64_t nowMs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = 0;
+    while (!grants_.empty() && grants_.front().time + GRANT_WINDOW_MS <= nowMs) {
+        grants_.pop_front();
+        ++count;
+    }
+    stats_.pruned += count;
+    return count;
+}
+
+bool CtrlVGrantTable::IsEmpty() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return grants_.empty();
+}
+
+void CtrlVGrantTable::Clear()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        grants_.clear();
+        inFlightUntil_ = 0;
+    }
+    recorded_.notify_all();
+}
+
+CtrlVGrantTable::Stats CtrlVGrantTable::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    stats.grants = grants_.size();
+    return stats;
+}
+
+CtrlVGrantTable::GrantList::iterator CtrlVGrantTable::Find(int32_t pid, bool isFocused, uint64_t nowMs,
+    uint64_t latestMs)
+{
+    for (auto it = grants_.rbegin(); it != grants_.rend(); ++it) {
+        if (it->time > latestMs) {
+            continue;
+        }
+        if (it->time + GRANT_WINDOW_MS <= nowMs) {
+            break;
+        }
+        if (isFocused || it->pid == pid) {
+            return std::next(it).base();
+        }
+    }
+    return grants_.end();
+}
+
+bool CtrlVGrantTable::IsInFlight(uint64_t nowMs) const
+{
+    return nowMs < inFlightUntil_;
+}
+} // namespace MiscServices
+} // namespace OHOS
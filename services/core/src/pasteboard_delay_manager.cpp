@@ -32,19 +32,20 @@ enum EntryPriority : uint8_t {
 
 uint8_t DelayManager::GetEntryPriority(const std::string &utdId)
 {
-    static std::string UTDID_PLAIN_TEXT = UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDMF::PLAIN_TEXT);
-    static std::string UTDID_HYPERLINK = UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDMF::HYPERLINK);
-    static std::string UTDID_HTML = UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDMF::HTML);
-    static std::string UTDID_FILE_URI = UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDMF::FILE_URI);
-    static std::string UTDID_PIXEL_MAP = UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDMF::SYSTEM_DEFINED_PIXEL_MAP);
-    static std::unordered_map<std::string, uint8_t> table = {
-        {UTDID_PLAIN_TEXT, PRIORITY_PLAIN_TEXT},
-        {UTDID_HYPERLINK, PRIORITY_HYPERLINK},
-        {UTDID_HTML, PRIORITY_HTML},
-        {UTDID_FILE_URI, PRIORITY_FILE_URI},
-        {UTDID_PIXEL_MAP, PRIORITY_PIXEL_MAP},
+    return GetEntryPriority(TypeRegistry::GetInstance().Intern(utdId));
+}
+
+uint8_t DelayManager::GetEntryPriority(TypeRegistry::TypeId utdTypeId)
+{
+    auto &registry = TypeRegistry::GetInstance();
+    static const std::unordered_map<TypeRegistry::TypeId, uint8_t> table = {
+        {registry.Intern(UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDMF::PLAIN_TEXT)), PRIORITY_PLAIN_TEXT},
+        {registry.Intern(UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDMF::HYPERLINK)), PRIORITY_HYPERLINK},
+        {registry.Intern(UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDMF::HTML)), PRIORITY_HTML},
+        {registry.Intern(UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDMF::FILE_URI)), PRIORITY_FILE_URI},
+        {registry.Intern(UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDMF::SYSTEM_DEFINED_PIXEL_MAP)), PRIORITY_PIXEL_MAP},
     };
-    auto iter = table.find(utdId);
+    auto iter = table.find(utdTypeId);
     if (iter != table.end()) {
         return iter->second;
     }
@@ -67,7 +68,7 @@ std::vector<DelayEntryInfo> DelayManager::GetAllDelayEntryInfo(const PasteData &
         }
         for (const auto &entry : record->GetEntries()) {
             if (entry != nullptr && std::holds_alternative<std::monostate>(entry->GetValue())) {
-                delayEntryInfos.emplace_back(GetEntryPriority(entry->GetUtdId()), record->GetRecordId(), entry);
+                delayEntryInfos.emplace_back(GetEntryPriority(entry->GetUtdTypeId()), record->GetRecordId(), entry);
             }
         }
     }
@@ -89,7 +90,7 @@ std::vector<DelayEntryInfo> DelayManager::GetPrimaryDelayEntryInfo(const PasteDa
         }
         auto entry = entries[0];
         if (entry != nullptr && std::holds_alternative<std::monostate>(entry->GetValue())) {
-            delayEntryInfos.emplace_back(GetEntryPriority(entry->GetUtdId()), record->GetRecordId(), entry);
+            delayEntryInfos.emplace_back(GetEntryPriority(entry->GetUtdTypeId()), record->GetRecordId(), entry);
         }
     }
     SortEntryInfo(delayEntryInfos);
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_entity_recognizer.h"
+
+#include <dlfcn.h>
+#include <pthread.h>
+
+#include "errors.h"
+#include "pasteboard_error.h"
+#include "pasteboard_hilog.h"
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr const char *NLU_SO_PATH = "libai_nlu_innerapi.z.so";
+constexpr const char *GET_PASTE_DATA_PROCESSOR = "GetPasteDataProcessor";
+constexpr uint32_t RECOGNIZE_DEBOUNCE = 0;
+using GetProcessorFunc = IPasteDataProcessor &(*)();
+
+uint64_t ElapsedUs(std::chrono::steady_clock::time_point start)
+{
+    auto cost = std::chrono::steady_clock::now() - start;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(cost).count());
+}
+} // namespace
+
+EntityRecognizer::EntityRecognizer(Extractor extractor, Notifier notifier, EngineLoader loader)
+    : extractor_(std::move(extractor)), notifier_(std::move(notifier)),
+      loader_(loader != nullptr ? std::move(loader) : EngineLoader(LoadNluEngine)),
+      worker_([this](Task &task, const std::function<bool()> &isSuperseded) {
+          return Run(task, isSuperseded);
+      }, RECOGNIZE_DEBOUNCE)
+{
+}
+
+EntityRecognizer::~EntityRecognizer()
+{
+    Stop();
+}
+
+EntityRecognizer::Engine EntityRecognizer::LoadNluEngine()
+{
+    auto lib = std::make_shared<LibGuard>(NLU_SO_PATH);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(lib->Ready(), {}, PASTEBOARD_MODULE_SERVICE, "Can not get AIEngine handle");
+    auto getProcessor = reinterpret_cast<GetProcessorFunc>(dlsym(lib->GetLibHandle(), GET_PASTE_DATA_PROCESSOR));
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(getProcessor != nullptr, {}, PASTEBOARD_MODULE_SERVICE,
+        "Can not get ProcessorFunc");
+    return Engine{ lib, &getProcessor() };
+}
+
+bool EntityRecognizer::Recognize(uint32_t dataId, std::string text)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGD(!text.empty(), false, PASTEBOARD_MODULE_SERVICE, "text is empty");
+    return worker_.Submit(Task{ dataId, std::move(text) });
+}
+
+void EntityRecognizer::SetResident(bool resident)
+{
+    std::lock_guard<std::mutex> lock(engineMutex_);
+    resident_ = resident;
+    if (!resident_ && engine_.processor != nullptr) {
+        engine_ = {};
+        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "NLU engine unloaded");
+    }
+}
+
+bool EntityRecognizer::IsEngineLoaded() const
+{
+    std::lock_guard<std::mutex> lock(engineMutex_);
+    return engine_.processor != nullptr;
+}
+
+EntityRecognizer::Stats EntityRecognizer::GetStats() const
+{
+    auto workerStats = worker_.GetStats();
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    stats.submitted = workerStats.submitted;
+    stats.pending = workerStats.pending;
+    stats.skipped = workerStats.skipped;
+    stats.canceled = workerStats.canceled;
+    stats.failed = workerStats.failed;
+    stats.lastLatencyUs = workerStats.lastLatencyUs;
+    stats.maxLatencyUs = workerStats.maxLatencyUs;
+    return stats;
+}
+
+void EntityRecognizer::Stop()
+{
+    worker_.Stop();
+    SetResident(false);
+}
+
+bool EntityRecognizer::Run(Task &task, const std::function<bool()> &isSuperseded)
+{
+    pthread_setname_np(pthread_self(), "PasteDataRecognize");
+    auto textLength = static_cast<uint32_t>(task.text.size());
+    CacheItem item;
+    if (FindCache(task.dataId, item)) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "cache hit, dataId=%{public}u", task.dataId);
+        if (item.location.empty()) {
+            return true;
+        }
+        Notify(item.location, item.dataLength);
+        return true;
+    }
+    std::string entity;
+    int32_t result = Process(task.text, entity);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(result == ERR_OK, false, PASTEBOARD_MODULE_SERVICE,
+        "AI Process failed, result=%{public}d", result);
+    // a newer copy arrived while the engine was busy, its recognition replaces this one
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGI(!isSuperseded(), false, PASTEBOARD_MODULE_SERVICE,
+        "recognition canceled, dataId=%{public}u", task.dataId);
+
+    std::string location;
+    auto start = std::chrono::steady_clock::now();
+    int32_t ret = extractor_ == nullptr ? static_cast<int32_t>(PasteboardError::INVALID_DATA_ERROR) :
+        extractor_(entity, location);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.lastExtractUs = ElapsedUs(start);
+    }
+    if (ret == static_cast<int32_t>(PasteboardError::E_OK) ||
+        ret == static_cast<int32_t>(PasteboardError::NO_DATA_ERROR)) {
+        AddCache(CacheItem{ task.dataId, textLength, location });
+    }
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == static_cast<int32_t>(PasteboardError::E_OK),
+        ret == static_cast<int32_t>(PasteboardError::NO_DATA_ERROR), PASTEBOARD_MODULE_SERVICE,
+        "ExtractEntity failed, ret=%{public}d", ret);
+    Notify(location, textLength);
+    return true;
+}
+
+int32_t EntityRecognizer::Process(const std::string &text, std::string &entity)
+{
+    std::lock_guard<std::mutex> lock(engineMutex_);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGW(resident_, static_cast<int32_t>(PasteboardError::INVALID_OPERATION_ERROR),
+        PASTEBOARD_MODULE_SERVICE, "recognizer is not resident");
+    if (engine_.processor == nullptr) {
+        auto start = std::chrono::steady_clock::now();
+        engine_ = loader_();
+        auto cost = ElapsedUs(start);
+        PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(engine_.processor != nullptr,
+            static_cast<int32_t>(PasteboardError::INVALID_OPERATION_ERROR), PASTEBOARD_MODULE_SERVICE,
+            "load NLU engine failed");
+        std::lock_guard<std::mutex> statsLock(mutex_);
+        stats_.engineLoads++;
+        stats_.loadUs = cost;
+    }
+    auto start = std::chrono::steady_clock::now();
+    int32_t result = engine_.processor->Process(text, entity);
+    auto cost = ElapsedUs(start);
+    std::lock_guard<std::mutex> statsLock(mutex_);
+    stats_.lastProcessUs = cost;
+    stats_.maxProcessUs = std::max(stats_.maxProcessUs, cost);
+    return result;
+}
+
+void EntityRecognizer::Notify(std::string &location, uint32_t dataLength)
+{
+    auto start = std::chrono::steady_clock::now();
+    if (notifier_ != nullptr) {
+        notifier_(location, dataLength);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.notified++;
+    stats_.lastNotifyUs = ElapsedUs(start);
+}
+
+bool EntityRecognizer::FindCache(uint32_t dataId, CacheItem &item)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto &cached : cache_) {
+        if (cached.dataId == dataId) {
+            item = cached;
+            stats_.cacheHits++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void EntityRecognizer::AddCache(CacheItem item)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cache_.size() >= MAX_CACHE_SIZE) {
+        cache_.pop_front();
+    }
+    cache_.push_back(std::move(item));
+}
+} // namespace OHOS::MiscServices
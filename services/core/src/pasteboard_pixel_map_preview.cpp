@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_pixel_map_preview.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+#include "pasteboard_hilog.h"
+
+namespace OHOS::MiscServices {
+PixelMapPreviewCache::PixelMapPreviewCache() : PixelMapPreviewCache(Config()) {}
+
+PixelMapPreviewCache::PixelMapPreviewCache(Config config) : config_(config) {}
+
+bool PixelMapPreviewCache::NeedPreview(const Media::PixelMap &pixelMap) const
+{
+    return std::max(pixelMap.GetWidth(), pixelMap.GetHeight()) > config_.maxEdge;
+}
+
+std::shared_ptr<Media::PixelMap> PixelMapPreviewCache::Get(int32_t userId, uint32_t dataId, uint32_t recordId,
+    const std::shared_ptr<Media::PixelMap> &source)
+{
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(source != nullptr, nullptr, PASTEBOARD_MODULE_SERVICE, "source is null");
+    if (!NeedPreview(*source)) {
+        return source;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto &previews = previews_[userId];
+        if (previews.dataId != dataId) {
+            previews.dataId = dataId;
+            previews.records.clear();
+        }
+        auto it = previews.records.find(recordId);
+        if (it != previews.records.end()) {
+            stats_.hits++;
+            return it->second;
+        }
+    }
+    // scaled outside the lock, a concurrent request for the same record builds its own and one of them is kept
+    auto preview = MakePreview(*source);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (preview == nullptr) {
+        stats_.failed++;
+        return nullptr;
+    }
+    stats_.built++;
+    auto &previews = previews_[userId];
+    if (previews.dataId == dataId && previews.records.size() < config_.maxRecords) {
+        return previews.records.emplace(recordId, preview).first->second;
+    }
+    return preview;
+}
+
+void PixelMapPreviewCache::Remove(int32_t userId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    previews_.erase(userId);
+}
+
+void PixelMapPreviewCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    previews_.clear();
+}
+
+PixelMapPreviewCache::Stats PixelMapPreviewCache::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    for (const auto &[userId, previews] : previews_) {
+        for (const auto &[recordId, preview] : previews.records) {
+            stats.previews++;
+            stats.bytes += static_cast<size_t>(std::max(preview->GetByteCount(), 0));
+        }
+    }
+    return stats;
+}
+
+std::shared_ptr<Media::PixelMap> PixelMapPreviewCache::MakePreview(Media::PixelMap &source) const
+{
+    int64_t width = source.GetWidth();
+    int64_t height = source.GetHeight();
+    int64_t longer = std::max(width, height);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(longer > 0, nullptr, PASTEBOARD_MODULE_SERVICE, "empty pixel map");
+    Media::InitializationOptions opts;
+    opts.size.width = static_cast<int32_t>(std::max<int64_t>(width * config_.maxEdge / longer, 1));
+    opts.size.height = static_cast<int32_t>(std::max<int64_t>(height * config_.maxEdge / longer, 1));
+    opts.pixelFormat = Media::PixelFormat::RGBA_8888;
+    opts.scaleMode = Media::ScaleMode::FIT_TARGET_SIZE;
+    std::unique_ptr<Media::PixelMap> preview = Media::PixelMap::Create(source, opts);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(preview != nullptr, nullptr, PASTEBOARD_MODULE_SERVICE,
+        "scale pixel map failed, width=%{public}" PRId64 ", height=%{public}" PRId64, width, height);
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "preview %{public}" PRId64 "x%{public}" PRId64 " to "
+        "%{public}dx%{public}d", width, height, opts.size.width, opts.size.height);
+    return std::shared_ptr<Media::PixelMap>(std::move(preview));
+}
+} // namespace OHOS::MiscServices
@@ -14,7 +14,7 @@
  */
 #include "pasteboard_service.h"
 
-#include <dlfcn.h>
+#include <chrono>
 #include <sys/mman.h>
 
 #include "ashmem.h"
@@ -47,9 +47,12 @@
 #include "pasteboard_event_dfx.h"
 #include "pasteboard_event_ue.h"
 #include "pasteboard_pattern.h"
+#include "pasteboard_perf_stat.h"
 #include "pasteboard_time.h"
 #include "pasteboard_trace.h"
+#include "pasteboard_trace_span.h"
 #include "pasteboard_web_controller.h"
+#include "pasteboard_window_manager.h"
 #include "permission/permission_utils.h"
 #include "remote_file_share.h"
 #include "res_sched_client.h"
@@ -61,15 +64,9 @@
 #endif // PB_SCREENLOCK_MGR_ENABLE
 #include "tokenid_kit.h"
 #include "uri_permission_manager_client.h"
-#ifdef SCENE_BOARD_ENABLE
-#include "window_manager_lite.h"
-#else
-#include "window_manager.h"
-#endif // SCENE_BOARD_ENABLE
 
 namespace OHOS {
 namespace MiscServices {
-using namespace Rosen;
 using namespace std::chrono;
 using namespace Storage::DistributedFile;
 using namespace RadarReporter;
@@ -78,10 +75,10 @@ namespace {
 constexpr int32_t COMMON_USERID = 0;
 constexpr int32_t INIT_INTERVAL = 10000L;
 constexpr uint32_t MAX_IPC_THREAD_NUM = 32;
+// the calls waiting in the call throttle hold IPC threads, a quarter of them at most
+constexpr uint32_t MAX_THROTTLE_WAITING = MAX_IPC_THREAD_NUM / 4;
 constexpr const char *PASTEBOARD_SERVICE_SA_NAME = "pasteboard_service";
 constexpr const char *PASTEBOARD_SERVICE_NAME = "PasteboardService";
-constexpr const char *NLU_SO_PATH = "libai_nlu_innerapi.z.so";
-constexpr const char *GET_PASTE_DATA_PROCESSOR = "GetPasteDataProcessor";
 constexpr const char *FAIL_TO_GET_TIME_STAMP = "FAIL_TO_GET_TIME_STAMP";
 constexpr const char *SECURE_PASTE_PERMISSION = "ohos.permission.SECURE_PASTE";
 constexpr const char *READ_PASTEBOARD_PERMISSION = "ohos.permission.READ_PASTEBOARD";
@@ -93,17 +90,22 @@ constexpr const char *NETWORK_DEV_NUM = "NETWORK_DEV_NUM";
 constexpr const char *COVER_DELAY_DATA = "COVER_DELAY_DATA";
 constexpr const char *UE_COPY = "DISTRIBUTED_PASTEBOARD_COPY";
 constexpr const char *UE_PASTE = "DISTRIBUTED_PASTEBOARD_PASTE";
+constexpr const char *CTRLV_GRANT_PRUNE_ID = "ctrlv_grant_prune";
+constexpr const char *CLIP_TRIM_ID = "clip_trim";
+constexpr const char *CLIP_PRESSURE_TRIM_ID = "clip_pressure_trim";
+constexpr const char *CLIP_RESIDENT_BUDGET_KEY = "const.pasteboard.clip_resident_budget_kb";
 
 constexpr int32_t INVALID_VERSION = -1;
 constexpr int32_t ADD_PERMISSION_CHECK_SDK_VERSION = 12;
 constexpr int32_t CTRLV_EVENT_SIZE = 2;
 constexpr int32_t CONTROL_TYPE_ALLOW_SEND_RECEIVE = 1;
-constexpr uint32_t EVENT_TIME_OUT = 2000;
-constexpr uint32_t MAX_RECOGNITION_LENGTH = 1000;
 constexpr int32_t DEVICE_COLLABORATION_UID = 5521;
 constexpr uint64_t SYSTEM_APP_MASK = (static_cast<uint64_t>(1) << 32);
 constexpr uint32_t MAX_BUNDLE_NAME_LENGTH = 127;
 constexpr int64_t MIN_ASHMEM_DATA_SIZE = 32 * 1024;
+constexpr int32_t MAX_CLIP_RESIDENT_BUDGET_KB = 1024 * 1024;
+constexpr size_t BYTES_PER_KB = 1024;
+constexpr size_t MAX_THROTTLE_DUMP_CALLERS = 10;
 constexpr int32_t E_OK_OPERATION = 0;
 constexpr int32_t SET_VALUE_SUCCESS = 1;
 constexpr uid_t ANCO_SERVICE_BROKER_UID = 5557;
@@ -117,6 +119,16 @@ std::shared_mutex PasteboardService::pasteDataMutex_;
 std::vector<std::string> PasteboardService::dataHistory_;
 std::shared_ptr<Command> PasteboardService::copyHistory;
 std::shared_ptr<Command> PasteboardService::copyData;
+std::shared_ptr<Command> PasteboardService::deviceCache;
+std::shared_ptr<Command> PasteboardService::publishStats;
+std::shared_ptr<Command> PasteboardService::entityRecognition;
+std::shared_ptr<Command> PasteboardService::latency;
+std::shared_ptr<Command> PasteboardService::ipcStats;
+std::shared_ptr<Command> PasteboardService::slowOps;
+std::shared_ptr<Command> PasteboardService::perf;
+std::shared_ptr<Command> PasteboardService::clipHistory;
+std::shared_ptr<Command> PasteboardService::startup;
+std::shared_ptr<Command> PasteboardService::throttle;
 int32_t PasteboardService::currentUserId_ = ERROR_USERID;
 ScreenEvent PasteboardService::currentScreenStatus = ScreenEvent::Default;
 const std::string PasteboardService::REGISTER_PRESYNC_MONITOR = "RegisterPresyncMonitor";
@@ -172,30 +184,79 @@ void PasteboardService::OnStart()
     std::lock_guard<std::mutex> lock(saMutex_);
     PASTEBOARD_CHECK_AND_RETURN_LOGE(PasteboardService::state_ != ServiceRunningState::STATE_RUNNING,
         PASTEBOARD_MODULE_SERVICE, "PasteboardService is already running.");
+    {
+        std::lock_guard<std::mutex> startupLock(startupMutex_);
+        startupPhases_.clear();
+    }
+    // only what local copy and paste need runs before the publish, the rest follows on the service handler
+    auto begin = std::chrono::steady_clock::now();
     IPCSkeleton::SetMaxWorkThreadNum(MAX_IPC_THREAD_NUM);
     InitServiceHandler();
-    auto appInfo = GetAppInfo(IPCSkeleton::GetCallingTokenID());
     Loader loader;
     uid_ = loader.LoadUid();
-    moduleConfig_.Init();
-    auto status = DATASL_OnStart();
-    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "datasl on start ret:%{public}d", status);
-    moduleConfig_.Watch(std::bind(&PasteboardService::OnConfigChange, this, std::placeholders::_1));
+    UpdateCallThrottle(loader);
     ffrtTimer_ = FFRTPool::GetTimer("pasteboard_service");
     UpdateAgedTime();
-    AddSysAbilityListener();
-    if (Init() != ERR_OK && serviceHandler_ != nullptr) {
+    UpdateClipResidentBudget();
+    AddStartupPhase("handler", false, begin);
+
+    begin = std::chrono::steady_clock::now();
+    RegisterDumpCommands();
+    AddStartupPhase("dump", false, begin);
+
+    begin = std::chrono::steady_clock::now();
+    auto ret = Init();
+    AddStartupPhase("publish", false, begin);
+    if (ret != ERR_OK && serviceHandler_ != nullptr) {
         auto callback = [this]() {
-            Init();
+            if (Init() == ERR_OK) {
+                DeferredStart();
+            }
         };
         serviceHandler_->PostTask(callback, INIT_INTERVAL);
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Init failed. Try again 10s later.");
         return;
     }
-    auto callback = [this]() {
-        switch_.Init(GetCurrentAccountId());
-    };
-    serviceHandler_->PostTask(callback);
+    if (serviceHandler_ != nullptr) {
+        serviceHandler_->PostTask([this]() {
+            DeferredStart();
+        });
+    }
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "Start PasteboardService success.");
+}
+
+void PasteboardService::DeferredStart()
+{
+    std::lock_guard<std::mutex> lock(saMutex_);
+    PASTEBOARD_CHECK_AND_RETURN_LOGW(PasteboardService::state_ == ServiceRunningState::STATE_RUNNING,
+        PASTEBOARD_MODULE_SERVICE, "service stopped before the deferred start");
+    auto begin = std::chrono::steady_clock::now();
+    CommonEventSubscriber();
+    AccountStateSubscriber();
+    PasteboardEventSubscriber();
+    EventCenter::GetInstance().Subscribe(OHOS::MiscServices::Event::EVT_REMOTE_CHANGE, RemotePasteboardChange());
+    AddStartupPhase("subscribers", true, begin);
+
+    begin = std::chrono::steady_clock::now();
+    moduleConfig_.Init();
+    auto status = DATASL_OnStart();
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "datasl on start ret:%{public}d", status);
+    moduleConfig_.Watch(std::bind(&PasteboardService::OnConfigChange, this, std::placeholders::_1));
+    AddStartupPhase("distributed", true, begin);
+
+    begin = std::chrono::steady_clock::now();
+    switch_.Init(GetCurrentAccountId());
+    AddStartupPhase("switch", true, begin);
+
+    begin = std::chrono::steady_clock::now();
+    AddSysAbilityListener();
+    HiViewAdapter::StartTimerThread();
+    AddStartupPhase("listeners", true, begin);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "deferred start done.");
+}
+
+void PasteboardService::RegisterDumpCommands()
+{
     copyHistory = std::make_shared<Command>(std::vector<std::string>{ "--copy-history" },
         "Dump access history last ten times.",
         [this](const std::vector<std::string> &input, std::string &output) -> bool {
@@ -207,15 +268,113 @@ void PasteboardService::OnStart()
             output = DumpData();
             return true;
         });
+    deviceCache = std::make_shared<Command>(std::vector<std::string>{ "--device-cache" },
+        "Show trusted device cache version, age and hit rate.",
+        [this](const std::vector<std::string> &input, std::string &output) -> bool {
+            output = DumpDeviceCache();
+            return true;
+        });
+    publishStats = std::make_shared<Command>(std::vector<std::string>{ "--publish-stats" },
+        "Show distributed publish latency and skipped clips.",
+        [this](const std::vector<std::string> &input, std::string &output) -> bool {
+            output = DumpPublishStats();
+            return true;
+        });
     PasteboardDumpHelper::GetInstance().RegisterCommand(copyHistory);
     PasteboardDumpHelper::GetInstance().RegisterCommand(copyData);
-    CommonEventSubscriber();
-    AccountStateSubscriber();
-    PasteboardEventSubscriber();
-    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "Start PasteboardService success.");
-    EventCenter::GetInstance().Subscribe(OHOS::MiscServices::Event::EVT_REMOTE_CHANGE, RemotePasteboardChange());
-    HiViewAdapter::StartTimerThread();
-    return;
+    PasteboardDumpHelper::GetInstance().RegisterCommand(deviceCache);
+    entityRecognition = std::make_shared<Command>(std::vector<std::string>{ "--entity-recognition" },
+        "Show entity recognition stage latency, cache hits and canceled recognitions.",
+        [this](const std::vector<std::string> &input, std::string &output) -> bool {
+            output = DumpEntityRecognition();
+            return true;
+        });
+    latency = std::make_shared<Command>(std::vector<std::string>{ "--latency" },
+        "Show p50/p90/p99/max latency in microseconds of each pasteboard operation by data size.",
+        [](const std::vector<std::string> &input, std::string &output) -> bool {
+            output = HiViewAdapter::DumpTimeConsumingStatistic();
+            return true;
+        });
+    PasteboardDumpHelper::GetInstance().RegisterCommand(publishStats);
+    PasteboardDumpHelper::GetInstance().RegisterCommand(entityRecognition);
+    PasteboardDumpHelper::GetInstance().RegisterCommand(latency);
+    ipcStats = std::make_shared<Command>(std::vector<std::string>{ "--ipc-stats" },
+        "Show call count, failures and p50/p90/p99/max latency in microseconds of each IPC command.",
+        [](const std::vector<std::string> &input, std::string &output) -> bool {
+            output = PasteboardPerfStat::GetInstance().DumpCallStats();
+            return true;
+        });
+    slowOps = std::make_shared<Command>(std::vector<std::string>{ "--slow-ops" },
+        "Show the slowest IPC calls with the time spent in each stage.",
+        [](const std::vector<std::string> &input, std::string &output) -> bool {
+            output = PasteboardPerfStat::GetInstance().DumpSlowOps();
+            return true;
+        });
+    perf = std::make_shared<Command>(std::vector<std::string>{ "--perf" },
+        "Show queue depths, cache hit rates and memory held by the clip of each user.",
+        [this](const std::vector<std::string> &input, std::string &output) -> bool {
+            output = DumpPerf();
+            return true;
+        });
+    PasteboardDumpHelper::GetInstance().RegisterCommand(ipcStats);
+    PasteboardDumpHelper::GetInstance().RegisterCommand(slowOps);
+    clipHistory = std::make_shared<Command>(std::vector<std::string>{ "--clip-history" },
+        "Show the clips kept in the history of each user and the memory and disk they hold.",
+        [this](const std::vector<std::string> &input, std::string &output) -> bool {
+            output = DumpClipHistory();
+            return true;
+        });
+    PasteboardDumpHelper::GetInstance().RegisterCommand(perf);
+    PasteboardDumpHelper::GetInstance().RegisterCommand(clipHistory);
+    startup = std::make_shared<Command>(std::vector<std::string>{ "--startup" },
+        "Show the time spent in each phase of the latest service start.",
+        [this](const std::vector<std::string> &input, std::string &output) -> bool {
+            output = DumpStartup();
+            return true;
+        });
+    PasteboardDumpHelper::GetInstance().RegisterCommand(startup);
+    throttle = std::make_shared<Command>(std::vector<std::string>{ "--throttle" },
+        "Show the budgets of the heavy paste calls and the callers refused the most.",
+        [this](const std::vector<std::string> &input, std::string &output) -> bool {
+            output = DumpThrottle();
+            return true;
+        });
+    PasteboardDumpHelper::GetInstance().RegisterCommand(throttle);
+}
+
+void PasteboardService::AddStartupPhase(const std::string &name, bool deferred,
+    std::chrono::steady_clock::time_point begin)
+{
+    auto cost = std::chrono::steady_clock::now() - begin;
+    auto costUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(cost).count());
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "startup phase %{public}s cost %{public}" PRIu64 "us",
+        name.c_str(), costUs);
+    std::lock_guard<std::mutex> lock(startupMutex_);
+    startupPhases_.push_back({ name, deferred, costUs });
+}
+
+std::string PasteboardService::DumpStartup()
+{
+    std::lock_guard<std::mutex> lock(startupMutex_);
+    uint64_t criticalUs = 0;
+    uint64_t deferredUs = 0;
+    std::string result;
+    for (const auto &phase : startupPhases_) {
+        (phase.deferred ? deferredUs : criticalUs) += phase.costUs;
+        result.append("|")
+            .append(phase.deferred ? "deferred " : "critical ")
+            .append(phase.name)
+            .append(":  ")
+            .append(std::to_string(phase.costUs))
+            .append("us\n");
+    }
+    result.append("|critical total:  ")
+        .append(std::to_string(criticalUs))
+        .append("us\n")
+        .append("|deferred total:  ")
+        .append(std::to_string(deferredUs))
+        .append("us\n");
+    return result;
 }
 
 void PasteboardService::OnStop()
@@ -233,10 +392,15 @@ void PasteboardService::OnStop()
     }
     moduleConfig_.DeInit();
     switch_.DeInit();
+    WindowManager::UnsubscribeFocusChange();
     DATASL_OnStop();
     EventCenter::GetInstance().Unsubscribe(PasteboardEvent::DISCONNECT);
     EventCenter::GetInstance().Unsubscribe(OHOS::MiscServices::Event::EVT_REMOTE_CHANGE);
     CancelCriticalTimer();
+    if (memoryLevelSubscriber_ != nullptr) {
+        Memory::MemMgrClient::GetInstance().UnsubscribeAppState(*memoryLevelSubscriber_);
+        memoryLevelSubscriber_ = nullptr;
+    }
     Memory::MemMgrClient::GetInstance().NotifyProcessStatus(getpid(), 1, 0, PASTEBOARD_SERVICE_ID);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "OnStop End.");
 }
@@ -271,6 +435,9 @@ void PasteboardService::OnAddSystemAbility(int32_t systemAbilityId, const std::s
         case DISTRIBUTED_DEVICE_PROFILE_SA_ID:
             OnAddDeviceProfile();
             break;
+        case WINDOW_MANAGER_SERVICE_ID:
+            OnAddWindowManager();
+            break;
         default:
             break;
     }
@@ -285,6 +452,9 @@ void PasteboardService::OnRemoveSystemAbility(int32_t systemAbilityId, const std
         case DISTRIBUTED_DEVICE_PROFILE_SA_ID:
             OnRemoveDeviceProfile();
             break;
+        case WINDOW_MANAGER_SERVICE_ID:
+            OnRemoveWindowManager();
+            break;
         default:
             break;
     }
@@ -381,6 +551,148 @@ void PasteboardService::OnAddMemoryManager()
 {
     Memory::MemMgrClient::GetInstance().NotifyProcessStatus(getpid(), 1, 1, PASTEBOARD_SERVICE_ID);
     SetCriticalTimer();
+    if (memoryLevelSubscriber_ == nullptr) {
+        memoryLevelSubscriber_ = std::make_shared<MemoryLevelSubscriber>(*this);
+    }
+    int32_t ret = Memory::MemMgrClient::GetInstance().SubscribeAppState(*memoryLevelSubscriber_);
+    PASTEBOARD_CHECK_AND_RETURN_LOGE(ret == ERR_OK, PASTEBOARD_MODULE_SERVICE,
+        "subscribe memory level failed, ret=%{public}d", ret);
+}
+
+PasteboardService::MemoryLevelSubscriber::MemoryLevelSubscriber(PasteboardService &service) : service_(service) {}
+
+void PasteboardService::MemoryLevelSubscriber::OnTrim(Memory::SystemMemoryLevel level)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "memory level=%{public}d", static_cast<int32_t>(level));
+    PASTEBOARD_CHECK_AND_RETURN_LOGE(service_.ffrtTimer_ != nullptr, PASTEBOARD_MODULE_SERVICE, "ffrtTimer_ is null");
+    bool underPressure = level == Memory::SystemMemoryLevel::MEMORY_LEVEL_LOW ||
+        level == Memory::SystemMemoryLevel::MEMORY_LEVEL_CRITICAL;
+    FFRTTask task = [service = &service_, underPressure] {
+        service->TrimClips(underPressure);
+    };
+    service_.ffrtTimer_->SetTimer(CLIP_PRESSURE_TRIM_ID, task);
+}
+
+void PasteboardService::UpdateClipResidentBudget()
+{
+    int32_t budget = system::GetIntParameter(CLIP_RESIDENT_BUDGET_KEY,
+        static_cast<int32_t>(ClipSpillStore::Config().residentBudget / BYTES_PER_KB), 0, MAX_CLIP_RESIDENT_BUDGET_KB);
+    clipSpill_.SetResidentBudget(static_cast<size_t>(budget) * BYTES_PER_KB);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "clip resident budget: %{public}d KB", budget);
+}
+
+void PasteboardService::UpdateCallThrottle(Loader &loader)
+{
+    auto budgets = loader.LoadThrottle();
+    CallThrottle::Config config;
+    config.enabled = budgets.enabled;
+    config.callsPerSecond = budgets.callsPerSecond;
+    config.callBurst = budgets.callBurst;
+    config.bytesPerSecond = budgets.bytesPerSecond;
+    config.byteBurst = budgets.byteBurst;
+    config.maxConcurrent = budgets.maxConcurrent;
+    config.maxCallerConcurrent = budgets.maxCallerConcurrent;
+    config.maxWaiting = budgets.maxWaiting == 0 ? MAX_THROTTLE_WAITING :
+        std::min(budgets.maxWaiting, MAX_THROTTLE_WAITING);
+    config.maxCallerWaiting = budgets.maxCallerWaiting;
+    config.maxWaitMs = budgets.maxWaitMs;
+    callThrottle_.SetConfig(config);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "call throttle enabled:%{public}d, calls:%{public}u/s, "
+        "bytes:%{public}" PRIu64 "/s, concurrent:%{public}u", config.enabled, config.callsPerSecond,
+        config.bytesPerSecond, config.maxConcurrent);
+}
+
+void PasteboardService::ScheduleClipTrim()
+{
+    PASTEBOARD_CHECK_AND_RETURN_LOGE(ffrtTimer_ != nullptr, PASTEBOARD_MODULE_SERVICE, "ffrtTimer_ is null");
+    FFRTTask task = [this] {
+        TrimClips(false);
+    };
+    // a clip copied or pasted now is idle by then
+    ffrtTimer_->SetTimer(CLIP_TRIM_ID, task, static_cast<uint32_t>(ClipSpillStore::Config().idleTime));
+}
+
+void PasteboardService::TrimClips(bool underPressure)
+{
+    std::lock_guard<std::mutex> lock(clipSpillMutex_);
+    if (underPressure) {
+        pixelMapPreviews_.Clear();
+    }
+    std::vector<std::pair<int32_t, std::shared_ptr<PasteData>>> clips;
+    clips_.ForEachRef([&clips](const int32_t &userId, const std::shared_ptr<PasteData> &data) -> bool {
+        if (data != nullptr) {
+            clips.emplace_back(userId, data);
+        }
+        return false;
+    });
+    std::vector<ClipSpillStore::Clip> candidates;
+    for (const auto &[userId, data] : clips) {
+        if (clipSpill_.IsSpilled(userId, data)) {
+            continue;
+        }
+        ClipSpillStore::Clip clip;
+        clip.userId = userId;
+        clip.size = data->rawDataSize_ > 0 ? static_cast<size_t>(data->rawDataSize_) : 0;
+        // delayed and remote data are completed in place by their getters and peers, dragged data is never pasted
+        clip.spillable = data->IsValid() && !data->IsDraggedData() && !data->IsDelayData() &&
+            !data->IsDelayRecord() && !data->IsRemote();
+        candidates.push_back(clip);
+    }
+    auto nowMs = static_cast<uint64_t>(PasteBoardTime::GetBootTimeMs());
+    for (int32_t userId : clipSpill_.SelectSpill(candidates, nowMs, underPressure)) {
+        auto it = std::find_if(clips.begin(), clips.end(), [userId](const auto &clip) {
+            return clip.first == userId;
+        });
+        if (it == clips.end()) {
+            continue;
+        }
+        std::shared_ptr<PasteData> shell;
+        {
+            std::shared_lock<std::shared_mutex> read(pasteDataMutex_);
+            shell = clipSpill_.Spill(userId, *it->second);
+        }
+        if (shell == nullptr) {
+            continue;
+        }
+        bool replaced = false;
+        clips_.ComputeIfPresent(userId, [&it, &shell, &replaced](auto, auto &value) {
+            if (value == it->second) {
+                value = shell;
+                replaced = true;
+            }
+            return true;
+        });
+        if (!replaced) {
+            clipSpill_.Remove(userId);
+        }
+    }
+}
+
+void PasteboardService::RestoreSpilledClip(int32_t userId)
+{
+    std::lock_guard<std::mutex> lock(clipSpillMutex_);
+    clipSpill_.Touch(userId, static_cast<uint64_t>(PasteBoardTime::GetBootTimeMs()));
+    auto [hasData, shell] = clips_.Find(userId);
+    if (!hasData || !clipSpill_.IsSpilled(userId, shell)) {
+        return;
+    }
+    auto data = clipSpill_.Restore(userId, shell);
+    // a clip that can not be read back is lost, its shell must not be pasted
+    clips_.ComputeIfPresent(userId, [&shell, &data](auto, auto &value) {
+        if (value != shell) {
+            return true;
+        }
+        value = data;
+        return data != nullptr;
+    });
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "restored clip, userId=%{public}d, ret=%{public}d", userId,
+        data != nullptr);
+}
+
+std::pair<bool, std::shared_ptr<PasteData>> PasteboardService::FindClip(int32_t userId)
+{
+    RestoreSpilledClip(userId);
+    return clips_.Find(userId);
 }
 
 void PasteboardService::OnAddDeviceProfile()
@@ -393,6 +705,18 @@ void PasteboardService::OnRemoveDeviceProfile()
     DevProfile::GetInstance().ClearDeviceProfileService();
 }
 
+void PasteboardService::OnAddWindowManager()
+{
+    if (!WindowManager::SubscribeFocusChange()) {
+        PASTEBOARD_HILOGW(PASTEBOARD_MODULE_SERVICE, "subscribe focus change failed, focus is queried per check");
+    }
+}
+
+void PasteboardService::OnRemoveWindowManager()
+{
+    WindowManager::UnsubscribeFocusChange();
+}
+
 void PasteboardService::ReportUeCopyEvent(PasteData &pasteData, int64_t dataSize, int32_t result)
 {
     auto appInfo = GetAppInfo(IPCSkeleton::GetCallingTokenID());
@@ -430,6 +754,10 @@ int32_t PasteboardService::Clear()
     }
     RADAR_REPORT(DFX_CLEAR_PASTEBOARD, DFX_MANUAL_CLEAR, DFX_SUCCESS);
     auto it = clips_.Find(userId);
+    clipSpill_.Remove(userId);
+    pixelMapPreviews_.Remove(userId);
+    clipHashes_.Erase(userId);
+    clipHistory_.RemoveUser(userId);
     if (it.first) {
         clips_.Erase(userId);
         delayDataId_ = 0;
@@ -439,6 +767,7 @@ int32_t PasteboardService::Clear()
     }
     CleanDistributedData(userId);
     CancelCriticalTimer();
+    changeStates_.Publish(userId);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "leave, clips_.Size=%{public}zu, appInfo.userId = %{public}d",
         clips_.Size(), userId);
     return ERR_OK;
@@ -449,11 +778,10 @@ int32_t PasteboardService::GetChangeCount(uint32_t &changeCount)
     auto tokenId = IPCSkeleton::GetCallingTokenID();
     auto appInfo = GetAppInfo(tokenId);
     changeCount = 0;
-    clipChangeCount_.ComputeIfPresent(appInfo.userId, [&changeCount](auto, auto &value) {
+    clipChangeCount_.FindRef(appInfo.userId, [&changeCount](const auto &value) {
         changeCount = value;
         PASTEBOARD_HILOGI(
             PASTEBOARD_MODULE_SERVICE, "Find changeCount succeed, changeCount is %{public}u", changeCount);
-        return true;
     });
     return ERR_OK;
 }
@@ -468,13 +796,57 @@ void PasteboardService::IncreaseChangeCount(int32_t userId)
     });
 }
 
+int32_t PasteboardService::GetChangeStatePage(int &fd)
+{
+    fd = -1;
+    auto appInfo = GetAppInfo(IPCSkeleton::GetCallingTokenID());
+    // the user of a native caller follows the foreground user, its page would change under it
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGD(appInfo.tokenType == ATokenTypeEnum::TOKEN_HAP,
+        static_cast<int32_t>(PasteboardError::NOT_SUPPORT), PASTEBOARD_MODULE_SERVICE, "caller is not application");
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(appInfo.userId != ERROR_USERID,
+        static_cast<int32_t>(PasteboardError::INVALID_USERID_ERROR), PASTEBOARD_MODULE_SERVICE, "userId invalid");
+    int32_t ret = changeStates_.GetFd(appInfo.userId, fd);
+    return ret == static_cast<int32_t>(PasteboardError::E_OK) ? ERR_OK : ret;
+}
+
+void PasteboardService::PublishChangeStates()
+{
+    changeStates_.PublishAll();
+}
+
+ChangeState PasteboardService::GetChangeState(int32_t userId)
+{
+    ChangeState state;
+    state.changeCount = clipChangeCount_.Find(userId).second;
+    auto screenStatus = GetCurrentScreenStatus();
+    // HasPasteData and HasDataType ask the peers of the foreground user while the screen is unlocked
+    bool localAnswer = userId == GetCurrentAccountId() &&
+        (screenStatus != ScreenEvent::ScreenUnlocked || !moduleConfig_.IsOn());
+    auto [hasClip, clip] = clips_.Find(userId);
+    if (hasClip && clip != nullptr) {
+        if (clip->GetShareOption() == ShareOption::InApp) {
+            localAnswer = false;
+        } else if (PasteData::IsValidShareOption(clip->GetShareOption()) && !clip->IsDraggedData() &&
+            clip->IsValid() && copyTime_.Contains(userId) && clip->GetScreenStatus() <= screenStatus) {
+            state.flags |= ChangeStatePage::HAS_DATA;
+            for (const auto &mimeType : clip->GetMimeTypes()) {
+                state.mimeTypes |= ChangeStatePage::GetMimeTypeBit(mimeType);
+            }
+        }
+    }
+    if (localAnswer) {
+        state.flags |= ChangeStatePage::LOCAL_ANSWER;
+    }
+    return state;
+}
+
 void PasteboardService::NotifyEntityObservers(std::string &entity, EntityType entityType, uint32_t dataLength)
 {
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "entityType=%{public}u, dataLength=%{public}u",
         static_cast<uint32_t>(entityType), dataLength);
-    entityObserverMap_.ForEach([this, &entity, entityType, dataLength](const auto &key, auto &value) {
+    entityObserverMap_.ForEachRef([this, &entity, entityType, dataLength](const auto &key, const auto &value) {
         PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "pid=%{public}u, listSize=%{public}zu", key, value.size());
-        for (auto entityObserver : value) {
+        for (const auto &entityObserver : value) {
             if (entityType == entityObserver.entityType && dataLength <= entityObserver.expectedDataLength &&
                 VerifyPermission(entityObserver.tokenId)) {
                 entityObserver.observer->OnRecognitionEvent(entityType, entity);
@@ -485,10 +857,10 @@ void PasteboardService::NotifyEntityObservers(std::string &entity, EntityType en
 }
 
 int32_t PasteboardService::GetAllEntryPlainText(uint32_t dataId, uint32_t recordId,
-    std::vector<std::shared_ptr<PasteDataEntry>> &entries, std::string &primaryText)
+    std::vector<std::shared_ptr<PasteDataEntry>> &entries, std::string &primaryText, uint32_t maxLength)
 {
     for (auto &entry : entries) {
-        if (primaryText.size() > MAX_RECOGNITION_LENGTH) {
+        if (primaryText.size() > maxLength) {
             return static_cast<int32_t>(PasteboardError::EXCEEDING_LIMIT_EXCEPTION);
         }
         int32_t result = static_cast<int32_t>(PasteboardError::E_OK);
@@ -508,12 +880,17 @@ int32_t PasteboardService::GetAllEntryPlainText(uint32_t dataId, uint32_t record
 }
 
 std::string PasteboardService::GetAllPrimaryText(const PasteData &pasteData)
+{
+    return GetAllPrimaryText(pasteData, MAX_RECOGNITION_LENGTH);
+}
+
+std::string PasteboardService::GetAllPrimaryText(const PasteData &pasteData, uint32_t maxLength)
 {
     std::string primaryText = "";
     std::vector<std::shared_ptr<PasteDataRecord>> records = pasteData.AllRecords();
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "size of records=%{public}zu", records.size());
     for (const auto &record : records) {
-        if (primaryText.size() > MAX_RECOGNITION_LENGTH) {
+        if (primaryText.size() > maxLength) {
             primaryText = "";
             break;
         }
@@ -526,7 +903,7 @@ std::string PasteboardService::GetAllPrimaryText(const PasteData &pasteData)
         auto dataId = pasteData.GetDataId();
         auto recordId = record->GetRecordId();
         std::vector<std::shared_ptr<PasteDataEntry>> entries = record->GetEntries();
-        int32_t result = GetAllEntryPlainText(dataId, recordId, entries, primaryText);
+        int32_t result = GetAllEntryPlainText(dataId, recordId, entries, primaryText, maxLength);
         if (result != static_cast<int32_t>(PasteboardError::E_OK)) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "primaryText exceeded size, result=%{public}d", result);
             primaryText = "";
@@ -566,34 +943,18 @@ int32_t PasteboardService::ExtractEntity(const std::string &entity, std::string
     return static_cast<int32_t>(PasteboardError::NO_DATA_ERROR);
 }
 
-void PasteboardService::OnRecognizePasteData(const std::string &primaryText)
+uint32_t PasteboardService::GetMaxExpectedDataLength(EntityType entityType)
 {
-    pthread_setname_np(pthread_self(), "PasteDataRecognize");
-    auto handle = dlopen(NLU_SO_PATH, RTLD_NOW);
-    PASTEBOARD_CHECK_AND_RETURN_LOGE(handle != nullptr, PASTEBOARD_MODULE_SERVICE, "Can not get AIEngine handle");
-    GetProcessorFunc GetProcessor = reinterpret_cast<GetProcessorFunc>(dlsym(handle, GET_PASTE_DATA_PROCESSOR));
-    if (GetProcessor == nullptr) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Can not get ProcessorFunc");
-        dlclose(handle);
-        return;
-    }
-    IPasteDataProcessor &processor = GetProcessor();
-    std::string entity = "";
-    int32_t result = processor.Process(primaryText, entity);
-    if (result != ERR_OK) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "AI Process failed, result=%{public}d", result);
-        dlclose(handle);
-        return;
-    }
-    std::string location = "";
-    int32_t ret = ExtractEntity(entity, location);
-    if (ret != static_cast<int32_t>(PasteboardError::E_OK)) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "ExtractEntity failed, ret=%{public}d", ret);
-        dlclose(handle);
-        return;
-    }
-    NotifyEntityObservers(location, EntityType::ADDRESS, static_cast<uint32_t>(primaryText.size()));
-    dlclose(handle);
+    uint32_t maxLength = 0;
+    entityObserverMap_.ForEachRef([entityType, &maxLength](const auto &key, const auto &value) {
+        for (const auto &entityObserver : value) {
+            if (entityObserver.entityType == entityType) {
+                maxLength = std::max(maxLength, entityObserver.expectedDataLength);
+            }
+        }
+        return false;
+    });
+    return maxLength;
 }
 
 void PasteboardService::RecognizePasteData(PasteData &pasteData)
@@ -602,19 +963,23 @@ void PasteboardService::RecognizePasteData(PasteData &pasteData)
         PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "shareOption is InApp, recognition not allowed");
         return;
     }
-    std::string primaryText = GetAllPrimaryText(pasteData);
-    if (primaryText.empty()) {
+    // observers are only notified of text no longer than they expect, longer text is not worth recognizing
+    uint32_t maxLength = GetMaxExpectedDataLength(EntityType::ADDRESS);
+    PASTEBOARD_CHECK_AND_RETURN_LOGD(maxLength > 0, PASTEBOARD_MODULE_SERVICE, "no address observer");
+    std::string primaryText = GetAllPrimaryText(pasteData, maxLength);
+    if (primaryText.empty() || primaryText.size() > maxLength) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "skip recognition, len=%{public}zu, max=%{public}u",
+            primaryText.size(), maxLength);
         return;
     }
-    FFRTTask task = [this, primaryText]() {
-        std::thread thread([=]() {
-            PASTEBOARD_CHECK_AND_RETURN_LOGE(PasteboardService::state_ == ServiceRunningState::STATE_RUNNING,
-                PASTEBOARD_MODULE_SERVICE, "PasteboardService is not running.");
-            OnRecognizePasteData(primaryText);
-        });
-        thread.detach();
-    };
-    FFRTUtils::SubmitTask(task);
+    PASTEBOARD_CHECK_AND_RETURN_LOGE(PasteboardService::state_ == ServiceRunningState::STATE_RUNNING,
+        PASTEBOARD_MODULE_SERVICE, "PasteboardService is not running.");
+    entityRecognizer_.Recognize(pasteData.GetDataId(), std::move(primaryText));
+}
+
+void PasteboardService::UpdateEntityRecognizerResident()
+{
+    entityRecognizer_.SetResident(!entityObserverMap_.Empty());
 }
 
 int32_t PasteboardService::SubscribeEntityObserver(
@@ -655,6 +1020,7 @@ int32_t PasteboardService::SubscribeEntityObserver(
         observerList.emplace_back(entityType, expectedDataLength, tokenId, observer);
         entityObserverMap_.Emplace(callingPid, observerList);
     }
+    UpdateEntityRecognizerResident();
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "subscribe entityObserver finished");
     return ERR_OK;
 }
@@ -690,17 +1056,24 @@ int32_t PasteboardService::UnsubscribeEntityObserver(
             }
             return true;
         });
+    UpdateEntityRecognizerResident();
     return ERR_OK;
 }
 
 void PasteboardService::UnsubscribeAllEntityObserver()
 {
     entityObserverMap_.Clear();
+    UpdateEntityRecognizerResident();
 }
 
 int32_t PasteboardService::GetRecordValueByType(uint32_t dataId, uint32_t recordId, int64_t &rawDataSize,
     std::vector<uint8_t> &buffer, int &fd)
 {
+    CallThrottle::Admission admission(callThrottle_,
+        { IPCSkeleton::GetCallingTokenID(), IPCSkeleton::GetCallingPid() });
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(admission.GetResult() == static_cast<int32_t>(PasteboardError::E_OK),
+        admission.GetResult(), PASTEBOARD_MODULE_SERVICE, "get record value throttled");
+    CalculateTimeConsuming timeC(StatisticPasteboardState::SPS_GET_ENTRY_STATE);
     MessageParcelWarp messageReply;
     if (rawDataSize <= 0 || rawDataSize > messageReply.GetRawDataSize()) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "invalid raw data size:%{public}" PRId64, rawDataSize);
@@ -738,20 +1111,30 @@ int32_t PasteboardService::GetRecordValueByType(uint32_t dataId, uint32_t record
     rawDataSize = 0;
     std::vector<uint8_t>().swap(buffer);
     fd = -1;
-    return GetRecordValueByType(rawDataSize, buffer, fd, entryValue);
+    result = GetRecordValueByType(rawDataSize, buffer, fd, entryValue);
+    if (result == ERR_OK) {
+        timeC.Finish(rawDataSize);
+        admission.Charge(static_cast<uint64_t>(rawDataSize));
+    }
+    return result;
 }
 
 int32_t PasteboardService::GetRecordValueByType(int64_t &rawDataSize,
     std::vector<uint8_t> &buffer, int32_t &fd, const PasteDataEntry &entryValue)
 {
     std::vector<uint8_t> entryValueTLV(0);
-    bool ret = entryValue.Encode(entryValueTLV);
+    bool ret = false;
+    {
+        PerfStageTimer stage(PasteboardPerfStat::ENCODE);
+        ret = entryValue.Encode(entryValueTLV);
+    }
     if (!ret) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "fail encode entry value");
         return static_cast<int32_t>(PasteboardError::INVALID_DATA_ERROR);
     }
     rawDataSize = static_cast<int64_t>(entryValueTLV.size());
     if (rawDataSize > MIN_ASHMEM_DATA_SIZE) {
+        PerfStageTimer stage(PasteboardPerfStat::ASHMEM_WRITE);
         if (!WriteRawData(entryValueTLV.data(), rawDataSize, fd)) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to WriteRawData");
             return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
@@ -777,7 +1160,7 @@ int32_t PasteboardService::GetRecordValueByType(uint32_t dataId, uint32_t record
         PASTEBOARD_MODULE_SERVICE, "check permission failed, calling pid is %{public}d", callPid);
 
     auto appInfo = GetAppInfo(tokenId);
-    auto [hasData, data] = clips_.Find(appInfo.userId);
+    auto [hasData, data] = FindClip(appInfo.userId);
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(hasData && data, static_cast<int32_t>(PasteboardError::NO_DATA_ERROR),
         PASTEBOARD_MODULE_SERVICE, "data not find, userId=%{public}u", appInfo.userId);
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(dataId == data->GetDataId(),
@@ -789,6 +1172,9 @@ int32_t PasteboardService::GetRecordValueByType(uint32_t dataId, uint32_t record
         PASTEBOARD_MODULE_SERVICE, "recordId=%{public}u invalid, max=%{public}zu", recordId, data->GetRecordCount());
 
     std::string utdId = value.GetUtdId();
+    if (utdId == PIXELMAP_PREVIEW_UTDID) {
+        return GetPreviewEntryValue(appInfo.userId, *data, *record, value);
+    }
     auto entry = record->GetEntry(utdId);
     bool isRemoteData = data->IsRemote();
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(entry != nullptr, static_cast<int32_t>(PasteboardError::INVALID_MIMETYPE),
@@ -900,7 +1286,6 @@ bool PasteboardService::VerifyPermission(uint32_t tokenId)
     bool isCtrlVAction = false;
     if (inputEventCallback_ != nullptr) {
         isCtrlVAction = inputEventCallback_->IsCtrlVProcess(callPid, IsFocusedApp(tokenId));
-        inputEventCallback_->Clear();
     }
     auto isGrant = isReadGrant || isSecureGrant || isAllowTokenAccess || isCtrlVAction;
     if (!isGrant && version >= ADD_PERMISSION_CHECK_SDK_VERSION) {
@@ -975,11 +1360,7 @@ bool PasteboardService::IsDataAged()
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "userId invalid.");
         return true;
     }
-    auto it = copyTime_.Find(userId);
-    if (!it.first) {
-        return true;
-    }
-    return false;
+    return !copyTime_.Contains(userId);
 }
 
 AppInfo PasteboardService::GetAppInfo(uint32_t tokenId)
@@ -1156,8 +1537,17 @@ int32_t PasteboardService::GetPasteData(int &fd, int64_t &size, std::vector<uint
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(PasteData::IsValidPasteId(pasteId),
         static_cast<int32_t>(PasteboardError::INVALID_PARAM_ERROR), PASTEBOARD_MODULE_SERVICE,
         "Parameter error. invalid pasteId=%{public}s", pasteId.c_str());
+    CallThrottle::Admission admission(callThrottle_,
+        { IPCSkeleton::GetCallingTokenID(), IPCSkeleton::GetCallingPid() });
+    if (admission.GetResult() != static_cast<int32_t>(PasteboardError::E_OK)) {
+        // the reply still carries an fd
+        fd = AshmemCreate("GetPasteData Ashmem", 1);
+        realErrCode = admission.GetResult();
+        return 0;
+    }
     UeReportInfo ueReportInfo;
     int32_t ret = GetPasteDataInner(fd, size, rawData, pasteId, syncTime, ueReportInfo);
+    admission.Charge(static_cast<uint64_t>(std::max<int64_t>(size, 0)));
     if (fd == -1) {
         fd = AshmemCreate("GetPasteData Ashmem", 1);
     }
@@ -1177,6 +1567,8 @@ int32_t PasteboardService::GetPasteDataInner(int &fd, int64_t &size, std::vector
     const std::string &pasteId, int32_t &syncTime, UeReportInfo &ueReportInfo)
 {
     PasteboardTrace tracer("PasteboardService GetPasteData");
+    PasteboardTraceSpan span(pasteId, "PasteboardService::GetPasteData");
+    CalculateTimeConsuming timeC(StatisticPasteboardState::SPS_PASTE_STATE);
     PasteData data{};
     data.SetPasteId(pasteId);
     auto tokenId = IPCSkeleton::GetCallingTokenID();
@@ -1184,7 +1576,12 @@ int32_t PasteboardService::GetPasteDataInner(int &fd, int64_t &size, std::vector
     auto appInfo = GetAppInfo(tokenId);
     bool developerMode = OHOS::system::GetBoolParameter("const.security.developermode.state", false);
     bool isTestServerSetPasteData = developerMode && setPasteDataUId_ == TEST_SERVER_UID;
-    if (!VerifyPermission(tokenId) && !isTestServerSetPasteData) {
+    bool isPermitted = false;
+    {
+        PerfStageTimer stage(PasteboardPerfStat::PERMISSION);
+        isPermitted = VerifyPermission(tokenId) || isTestServerSetPasteData;
+    }
+    if (!isPermitted) {
         RADAR_REPORT(DFX_GET_PASTEBOARD, DFX_CHECK_GET_AUTHORITY, DFX_SUCCESS, GET_DATA_APP, appInfo.bundleName,
             RadarReporter::CONCURRENT_ID, data.GetPasteId());
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "check permission failed, callingPid is %{public}d", callPid);
@@ -1214,13 +1611,20 @@ int32_t PasteboardService::GetPasteDataInner(int &fd, int64_t &size, std::vector
     ret = DealData(fd, size, rawData, data);
     radarReportInfo.commonInfo = GetCommonState(size);
     PASTE_RADAR_REPORT(DFX_GET_PASTEBOARD, DFX_GET_DATA_INFO, radarReportInfo);
+    if (ret == ERR_OK) {
+        timeC.SetPasteboardState(data.IsRemote() ? StatisticPasteboardState::SPS_REMOTE_PASTE_STATE :
+            StatisticPasteboardState::SPS_PASTE_STATE);
+        timeC.Finish(size);
+    }
     return ret;
 }
 
 int32_t PasteboardService::DealData(int &fd, int64_t &size, std::vector<uint8_t> &rawData, PasteData &data)
 {
+    PasteboardTraceSpan span(data.GetPasteId(), "DealData");
     std::vector<uint8_t> pasteDataTlv(0);
     {
+        PerfStageTimer stage(PasteboardPerfStat::ENCODE);
         std::shared_lock<std::shared_mutex> read(pasteDataMutex_);
         if (!data.Encode(pasteDataTlv)) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to encode pastedata in TLV");
@@ -1231,6 +1635,7 @@ int32_t PasteboardService::DealData(int &fd, int64_t &size, std::vector<uint8_t>
     int64_t tlvSize = static_cast<int64_t>(pasteDataTlv.size());
     int serviceFd = -1;
     if (tlvSize > MIN_ASHMEM_DATA_SIZE) {
+        PerfStageTimer stage(PasteboardPerfStat::ASHMEM_WRITE);
         bool res = WriteRawData(pasteDataTlv.data(), tlvSize, serviceFd);
         if (!res) {
             PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "Failed to WriteRawData:%{public}" PRId64, tlvSize);
@@ -1278,17 +1683,24 @@ void PasteboardService::AddPermissionRecord(uint32_t tokenId, bool isReadGrant,
 int32_t PasteboardService::CheckAndGrantRemoteUri(PasteData &data, const AppInfo &appInfo,
     const std::string &pasteId, const std::string &deviceId, std::shared_ptr<BlockObject<int32_t>> pasteBlock)
 {
+    PasteboardTraceSpan span(pasteId, "CheckAndGrantRemoteUri");
     int64_t fileSize = data.GetFileSize();
     bool isRemoteData = data.IsRemote();
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "pasteId=%{public}s, isRemote=%{public}s, fileSize=%{public}" PRId64,
         pasteId.c_str(), isRemoteData ? "true" : "false", fileSize);
     GetPasteDataDot(data, appInfo.bundleName, appInfo.userId);
-    std::vector<Uri> grantUris = CheckUriPermission(data, std::make_pair(appInfo.bundleName, appInfo.appIndex));
+    std::vector<Uri> grantUris;
+    {
+        PerfStageTimer stage(PasteboardPerfStat::URI_GRANT);
+        grantUris = CheckUriPermission(data, std::make_pair(appInfo.bundleName, appInfo.appIndex));
+    }
     if (isRemoteData) {
         data.SetPasteId(pasteId);
         data.deviceId_ = deviceId;
         if (pasteBlock) {
             if (!grantUris.empty()) {
+                PerfStageTimer stage(PasteboardPerfStat::REMOTE_WAIT);
+                PasteboardTraceSpan waitSpan(pasteId, "WaitP2PEstablish");
                 pasteBlock->GetValue();
                 PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "wait P2PEstablish finish");
             } else {
@@ -1297,13 +1709,13 @@ int32_t PasteboardService::CheckAndGrantRemoteUri(PasteData &data, const AppInfo
         }
     }
     ClearP2PEstablishTaskInfo();
+    PerfStageTimer stage(PasteboardPerfStat::URI_GRANT);
     return GrantUriPermission(grantUris, appInfo.bundleName, isRemoteData, appInfo.appIndex);
 }
 
 int32_t PasteboardService::GetData(uint32_t tokenId, PasteData &data, int32_t &syncTime, bool &isPeerOnline,
     std::string &peerNetId, std::string &peerUdid)
 {
-    CalculateTimeConsuming::SetBeginTime();
     auto appInfo = GetAppInfo(tokenId);
     int32_t result = static_cast<int32_t>(PasteboardError::E_OK);
     std::string pasteId = data.GetPasteId();
@@ -1312,12 +1724,17 @@ int32_t PasteboardService::GetData(uint32_t tokenId, PasteData &data, int32_t &s
     pasteBlock = EstablishP2PLinkTask(pasteId, distEvt);
     if (distRet != static_cast<int32_t>(PasteboardError::E_OK) ||
         GetCurrentScreenStatus() != ScreenEvent::ScreenUnlocked) {
+        PerfStageTimer stage(PasteboardPerfStat::GET_DATA);
+        PasteboardTraceSpan span(pasteId, "GetLocalData");
         result = GetLocalData(appInfo, data);
         if (distRet == static_cast<int32_t>(PasteboardError::GET_SAME_REMOTE_DATA)) {
             peerNetId = currentEvent_.deviceId;
             peerUdid = DMAdapter::GetInstance().GetUdidByNetworkId(peerNetId);
         }
     } else {
+        PerfStageTimer stage(PasteboardPerfStat::REMOTE_WAIT);
+        PasteboardTraceSpan span(pasteId, "GetRemoteData");
+        distEvt.pasteId = pasteId;
         result = GetRemoteData(appInfo.userId, distEvt, data, syncTime);
         peerNetId = distEvt.deviceId;
         peerUdid = DMAdapter::GetInstance().GetUdidByNetworkId(peerNetId);
@@ -1407,6 +1824,12 @@ std::shared_ptr<PasteDateTime> PasteboardService::RemoteDataTaskManager::WaitRem
     return task->data_;
 }
 
+size_t PasteboardService::RemoteDataTaskManager::GetTaskCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dataTasks_.size();
+}
+
 void PasteboardService::RemoteDataTaskManager::ClearRemoteDataTask(const Event &event)
 {
     auto key = event.deviceId + std::to_string(event.seqId);
@@ -1436,7 +1859,7 @@ int32_t PasteboardService::GetRemoteData(int32_t userId, const Event &event, Pas
     if (distRet != static_cast<int32_t>(PasteboardError::E_OK) || !(distEvt == event)) {
         int32_t ret = distRet == static_cast<int32_t>(PasteboardError::E_OK) ?
             static_cast<int32_t>(PasteboardError::INVALID_EVENT_ERROR) : distRet;
-        auto it = clips_.Find(userId);
+        auto it = FindClip(userId);
         if (it.first) {
             data = *it.second;
             ret = static_cast<int32_t>(PasteboardError::E_OK);
@@ -1459,11 +1882,14 @@ int32_t PasteboardService::GetRemotePasteData(int32_t userId, const Event &event
             result.first->SetRemote(true);
             if (distEvt == event) {
                 clips_.InsertOrAssign(userId, result.first);
+                clipSpill_.Remove(userId);
+                clipHashes_.Erase(userId);
                 IncreaseChangeCount(userId);
                 auto curTime =
                     static_cast<uint64_t>(PasteBoardTime::GetBootTimeMs());
                 copyTime_.InsertOrAssign(userId, curTime);
                 SetDataExpirationTimer(userId);
+                changeStates_.Publish(userId);
             }
             pasteDataTime->syncTime = result.second.syncTime;
             pasteDataTime->data = result.first;
@@ -1492,7 +1918,8 @@ int32_t PasteboardService::GetRemotePasteData(int32_t userId, const Event &event
 int32_t PasteboardService::GetLocalData(const AppInfo &appInfo, PasteData &data)
 {
     std::string pasteId = data.GetPasteId();
-    auto it = clips_.Find(appInfo.userId);
+    auto it = FindClip(appInfo.userId);
+    ScheduleClipTrim();
     auto tempTime = copyTime_.Find(appInfo.userId);
     if (!it.first || !tempTime.first) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "no data userId is %{public}d.", appInfo.userId);
@@ -2001,8 +2428,107 @@ int32_t PasteboardService::GetDataTokenId(PasteData &pasteData)
     return originTokenId;
 }
 
+int32_t PasteboardService::GetClipHistory(std::vector<uint8_t> &buffer)
+{
+    buffer.clear();
+    auto tokenId = IPCSkeleton::GetCallingTokenID();
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(IsSystemAppByFullTokenID(IPCSkeleton::GetCallingFullTokenID()) &&
+        PermissionUtils::IsPermissionGranted(READ_PASTEBOARD_PERMISSION, tokenId),
+        static_cast<int32_t>(PasteboardError::PERMISSION_VERIFICATION_ERROR), PASTEBOARD_MODULE_SERVICE,
+        "no permission, tokenId=0x%{public}x", tokenId);
+    auto userId = GetCurrentAccountId();
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(userId != ERROR_USERID,
+        static_cast<int32_t>(PasteboardError::INVALID_USERID_ERROR), PASTEBOARD_MODULE_SERVICE, "userId invalid");
+    auto summaries = clipHistory_.GetSummaries(userId);
+    bool encoded = PasteClipSummary::EncodeList(summaries, buffer);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(encoded, static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR),
+        PASTEBOARD_MODULE_SERVICE, "encode clip history failed");
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "user %{public}d, %{public}zu clips", userId, summaries.size());
+    return ERR_OK;
+}
+
+int32_t PasteboardService::ActivateClip(uint32_t clipId)
+{
+    auto tokenId = IPCSkeleton::GetCallingTokenID();
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(IsSystemAppByFullTokenID(IPCSkeleton::GetCallingFullTokenID()) &&
+        PermissionUtils::IsPermissionGranted(READ_PASTEBOARD_PERMISSION, tokenId),
+        static_cast<int32_t>(PasteboardError::PERMISSION_VERIFICATION_ERROR), PASTEBOARD_MODULE_SERVICE,
+        "no permission, tokenId=0x%{public}x", tokenId);
+    auto userId = GetCurrentAccountId();
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(userId != ERROR_USERID,
+        static_cast<int32_t>(PasteboardError::INVALID_USERID_ERROR), PASTEBOARD_MODULE_SERVICE, "userId invalid");
+    auto data = clipHistory_.Get(userId, clipId);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(data != nullptr, static_cast<int32_t>(PasteboardError::NO_DATA_ERROR),
+        PASTEBOARD_MODULE_SERVICE, "no clip %{public}u", clipId);
+    int32_t ret = PublishHistoryClip(userId, std::move(data));
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == static_cast<int32_t>(PasteboardError::E_OK), ret,
+        PASTEBOARD_MODULE_SERVICE, "activate clip %{public}u failed, ret=%{public}d", clipId, ret);
+    return ERR_OK;
+}
+
+int32_t PasteboardService::PublishHistoryClip(int32_t userId, std::shared_ptr<PasteData> clip)
+{
+    // the clip stays the copy of the app that made it: its owner, share option, webview rewrites and uri grants were
+    // checked on that copy, the caller only brings it back and has no access to the uris of the owner
+    if (setting_.exchange(true)) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "is setting.");
+        return static_cast<int32_t>(PasteboardError::TASK_PROCESSING);
+    }
+    AppInfo appInfo;
+    appInfo.userId = userId;
+    RemovePasteData(appInfo);
+    clip->SetTime(GetTime());
+    clip->SetScreenStatus(GetCurrentScreenStatus());
+    auto dataId = ++dataId_;
+    clip->SetDataId(dataId);
+    for (auto &record : clip->AllRecords()) {
+        record->SetDataId(dataId);
+    }
+    clips_.InsertOrAssign(userId, clip);
+    clipHashes_.Erase(userId);
+    clipSpill_.Remove(userId);
+    auto curTime = static_cast<uint64_t>(PasteBoardTime::GetBootTimeMs());
+    clipSpill_.Touch(userId, curTime);
+    ScheduleClipTrim();
+    AddClipHistory(userId, clip);
+    IncreaseChangeCount(userId);
+    copyTime_.InsertOrAssign(userId, curTime);
+    SetDataExpirationTimer(userId);
+    changeStates_.Publish(userId);
+    SetDistributedData(userId, *clip);
+    NotifyObservers(clip->GetBundleName(), userId, PasteboardEventStatus::PASTEBOARD_WRITE);
+    SetPasteDataDot(*clip, userId);
+    setting_.store(false);
+    SubscribeKeyboardEvent();
+    return static_cast<int32_t>(PasteboardError::E_OK);
+}
+
+void PasteboardService::AddClipHistory(int32_t userId, std::shared_ptr<PasteData> clip)
+{
+    // encoding a large clip and writing its spill file must not hold up the copy, a clear of the history made
+    // meanwhile drops the clip
+    uint64_t generation = clipHistory_.GetGeneration(userId);
+    FFRTTask task = [this, userId, clip = std::move(clip), generation]() {
+        ClipHistory::Clip entry;
+        {
+            std::shared_lock<std::shared_mutex> read(pasteDataMutex_);
+            if (!clipHistory_.Encode(*clip, entry)) {
+                return;
+            }
+        }
+        clipHistory_.Add(userId, std::move(entry), generation);
+    };
+    FFRTUtils::SubmitQueueTasks({ task }, historyQueue_);
+}
+
+void PasteboardService::RemoveClipHistory(int32_t userId)
+{
+    clipHistory_.RemoveUser(userId);
+}
+
 int32_t PasteboardService::SaveData(PasteData &pasteData, int64_t dataSize,
-    const sptr<IPasteboardDelayGetter> delayGetter, const sptr<IPasteboardEntryGetter> entryGetter)
+    const sptr<IPasteboardDelayGetter> delayGetter, const sptr<IPasteboardEntryGetter> entryGetter,
+    uint64_t contentHash)
 {
     PasteboardTrace tracer("PasteboardService, SetPasteData");
     auto tokenId = pasteData.GetTokenId();
@@ -2014,7 +2540,7 @@ int32_t PasteboardService::SaveData(PasteData &pasteData, int64_t dataSize,
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "is setting.");
         return static_cast<int32_t>(PasteboardError::TASK_PROCESSING);
     }
-    CalculateTimeConsuming::SetBeginTime();
+    CalculateTimeConsuming timeC(StatisticPasteboardState::SPS_COPY_STATE);
     auto appInfo = GetAppInfo(tokenId);
     if (appInfo.userId == ERROR_USERID) {
         setting_.store(false);
@@ -2022,12 +2548,28 @@ int32_t PasteboardService::SaveData(PasteData &pasteData, int64_t dataSize,
         return static_cast<int32_t>(PasteboardError::INVALID_USERID_ERROR);
     }
     setPasteDataUId_ = IPCSkeleton::GetCallingUid();
+    if (contentHash != 0 && delayGetter == nullptr && entryGetter == nullptr &&
+        RefreshDuplicateClip(appInfo, pasteData, contentHash)) {
+        setting_.store(false);
+        timeC.Finish(dataSize);
+        return static_cast<int32_t>(PasteboardError::E_OK);
+    }
     RemovePasteData(appInfo);
     SetPasteDataInfo(pasteData, appInfo);
     PasteboardWebController::GetInstance().SetWebviewPasteData(pasteData,
         std::make_pair(appInfo.bundleName, appInfo.appIndex));
     PasteboardWebController::GetInstance().CheckAppUriPermission(pasteData);
-    clips_.InsertOrAssign(appInfo.userId, std::make_shared<PasteData>(pasteData));
+    auto clip = std::make_shared<PasteData>(pasteData);
+    clips_.InsertOrAssign(appInfo.userId, clip);
+    if (contentHash != 0) {
+        clipHashes_.InsertOrAssign(appInfo.userId, std::make_pair(contentHash, pasteData.GetDataId()));
+    } else {
+        clipHashes_.Erase(appInfo.userId);
+    }
+    clipSpill_.Remove(appInfo.userId);
+    clipSpill_.Touch(appInfo.userId, static_cast<uint64_t>(PasteBoardTime::GetBootTimeMs()));
+    ScheduleClipTrim();
+    AddClipHistory(appInfo.userId, std::move(clip));
     IncreaseChangeCount(appInfo.userId);
     RadarReportInfo radarReportInfo;
     radarReportInfo.stageRes = static_cast<int32_t>(pasteData.IsDelayData());
@@ -2039,6 +2581,7 @@ int32_t PasteboardService::SaveData(PasteData &pasteData, int64_t dataSize,
     auto curTime = static_cast<uint64_t>(PasteBoardTime::GetBootTimeMs());
     copyTime_.InsertOrAssign(appInfo.userId, curTime);
     SetDataExpirationTimer(appInfo.userId);
+    changeStates_.Publish(appInfo.userId);
     if (!(pasteData.IsDelayData())) {
         SetDistributedData(appInfo.userId, pasteData);
         NotifyObservers(appInfo.bundleName, appInfo.userId, PasteboardEventStatus::PASTEBOARD_WRITE);
@@ -2046,18 +2589,84 @@ int32_t PasteboardService::SaveData(PasteData &pasteData, int64_t dataSize,
     SetPasteDataDot(pasteData, appInfo.userId);
     setting_.store(false);
     SubscribeKeyboardEvent();
+    timeC.Finish(dataSize);
     return static_cast<int32_t>(PasteboardError::E_OK);
 }
 
+bool PasteboardService::RefreshDuplicateClip(const AppInfo &appInfo, PasteData &pasteData, uint64_t contentHash)
+{
+    auto [hasHash, clipHash] = clipHashes_.Find(appInfo.userId);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGD(hasHash && clipHash.first == contentHash, false, PASTEBOARD_MODULE_SERVICE,
+        "content changed, userId=%{public}d", appInfo.userId);
+    auto tokenId = pasteData.GetTokenId();
+    auto shareOption = pasteData.GetShareOption();
+    auto tag = pasteData.GetTag();
+    auto localOnly = pasteData.GetLocalOnly();
+    auto time = GetTime();
+    std::shared_ptr<PasteData> refreshed;
+    clips_.ComputeIfPresent(appInfo.userId, [&](auto, auto &value) {
+        // the owner decides the uri grants and the webview rewrites of the clip, a copy by another one is saved again
+        if (value == nullptr || value->GetDataId() != clipHash.second || value->IsRemote() ||
+            value->GetTokenId() != tokenId || value->GetShareOption() != shareOption || value->GetTag() != tag ||
+            value->GetLocalOnly() != localOnly || value->IsDraggedData() != pasteData.IsDraggedData() ||
+            value->rawDataSize_ != pasteData.rawDataSize_ || value->IsDelayData() || value->IsDelayRecord() ||
+            clipSpill_.IsSpilled(appInfo.userId, value)) {
+            return true;
+        }
+        // readers may hold the clip, the refreshed one replaces it
+        auto clip = std::make_shared<PasteData>(*value);
+        clip->SetTime(time);
+        value = clip;
+        refreshed = clip;
+        return true;
+    });
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGD(refreshed != nullptr, false, PASTEBOARD_MODULE_SERVICE,
+        "clip not refreshable, userId=%{public}d", appInfo.userId);
+
+    // a repeated copy still counts as a change, the content observers already have is not sent again; the peers get
+    // it again only once the top event they see is no longer the unexpired one of this device
+    clipDedupHits_++;
+    IncreaseChangeCount(appInfo.userId);
+    auto curTime = static_cast<uint64_t>(PasteBoardTime::GetBootTimeMs());
+    clipSpill_.Touch(appInfo.userId, curTime);
+    copyTime_.InsertOrAssign(appInfo.userId, curTime);
+    SetDataExpirationTimer(appInfo.userId);
+    changeStates_.Publish(appInfo.userId);
+    bool republish = !IsPublishedEventCurrent(appInfo.userId);
+    if (republish) {
+        SetDistributedData(appInfo.userId, *refreshed);
+    }
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "duplicate clip refreshed, userId=%{public}d, dataId=%{public}u, "
+        "republish=%{public}d", appInfo.userId, clipHash.second, republish);
+    return true;
+}
+
+bool PasteboardService::IsPublishedEventCurrent(int32_t userId)
+{
+    auto plugin = GetClipPlugin();
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGD(plugin != nullptr, false, PASTEBOARD_MODULE_SERVICE, "plugin is null");
+    auto events = plugin->GetTopEvents(1, userId);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGD(!events.empty(), false, PASTEBOARD_MODULE_SERVICE, "no event published");
+    // a peer may have published since, or the event of this device expired
+    const auto &evt = events[0];
+    auto curTime = static_cast<uint64_t>(PasteBoardTime::GetBootTimeMs());
+    return evt.deviceId == DMAdapter::GetInstance().GetLocalNetworkId() && evt.deviceId == currentEvent_.deviceId &&
+        evt.seqId == currentEvent_.seqId && evt.expiration == currentEvent_.expiration && curTime < evt.expiration;
+}
+
 void PasteboardService::ClearAgedData(int32_t userId)
 {
     auto data = clips_.Find(userId);
+    clipSpill_.Remove(userId);
+    pixelMapPreviews_.Remove(userId);
+    clipHashes_.Erase(userId);
     if (data.first) {
         clips_.Erase(userId);
         delayDataId_ = 0;
         delayTokenId_ = 0;
     }
     copyTime_.Erase(userId);
+    changeStates_.Publish(userId);
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "data is out of the time");
     RADAR_REPORT(DFX_CLEAR_PASTEBOARD, DFX_AUTO_CLEAR, DFX_SUCCESS);
 }
@@ -2171,6 +2780,11 @@ bool PasteboardService::HasDataType(const std::string &mimeType)
 int32_t PasteboardService::DetectPatterns(const std::vector<Pattern> &patternsToCheck,
     std::vector<Pattern> &funcResult)
 {
+    CallThrottle::Admission admission(callThrottle_,
+        { IPCSkeleton::GetCallingTokenID(), IPCSkeleton::GetCallingPid() });
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(admission.GetResult() == static_cast<int32_t>(PasteboardError::E_OK),
+        admission.GetResult(), PASTEBOARD_MODULE_SERVICE, "detect patterns throttled");
+    CalculateTimeConsuming timeC(StatisticPasteboardState::SPS_DETECT_PATTERNS_STATE);
     bool hasPlain = HasLocalDataType(MIMETYPE_TEXT_PLAIN);
     bool hasHTML = HasLocalDataType(MIMETYPE_TEXT_HTML);
     if (!hasHTML && !hasPlain) {
@@ -2179,7 +2793,7 @@ int32_t PasteboardService::DetectPatterns(const std::vector<Pattern> &patternsTo
         return static_cast<int32_t>(PasteboardError::NO_DATA_ERROR);
     }
     int32_t userId = GetCurrentAccountId();
-    auto it = clips_.Find(userId);
+    auto it = FindClip(userId);
     if (!it.first) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "error, no PasteData!");
         std::vector<Pattern>().swap(funcResult);
@@ -2190,6 +2804,15 @@ int32_t PasteboardService::DetectPatterns(const std::vector<Pattern> &patternsTo
     std::set<Pattern> result = {};
     result = OHOS::MiscServices::PatternDetection::Detect(patterns, *pasteData, hasHTML, hasPlain);
     funcResult.assign(result.begin(), result.end());
+    int64_t textSize = 0;
+    for (const auto &record : pasteData->AllRecords()) {
+        auto plainText = hasPlain ? record->GetPlainTextV0() : nullptr;
+        auto htmlText = hasHTML ? record->GetHtmlTextV0() : nullptr;
+        textSize += static_cast<int64_t>((plainText != nullptr ? plainText->size() : 0) +
+            (htmlText != nullptr ? htmlText->size() : 0));
+    }
+    timeC.Finish(textSize);
+    admission.Charge(static_cast<uint64_t>(textSize));
     return ERR_OK;
 }
 
@@ -2266,36 +2889,38 @@ std::vector<std::string> PasteboardService::GetLocalMimeTypes()
 bool PasteboardService::HasLocalDataType(const std::string &mimeType)
 {
     auto userId = GetCurrentAccountId();
-    auto it = clips_.Find(userId);
-    if (!it.first) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "can not find data. userId: %{public}d, mimeType: %{public}s",
-            userId, mimeType.c_str());
-        return false;
-    }
-    if (it.second == nullptr) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "data is nullptr. userId: %{public}d, mimeType: %{public}s",
-            userId, mimeType.c_str());
-        return false;
-    }
     auto tokenId = IPCSkeleton::GetCallingTokenID();
-    auto ret = IsDataValid(*(it.second), tokenId);
-    if (ret != static_cast<int32_t>(PasteboardError::E_OK)) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE,
-            "pasteData is invalid, tokenId is %{public}d, userId: %{public}d,"
-            "mimeType: %{public}s, ret is %{public}d",
-            tokenId, userId, mimeType.c_str(), ret);
-        return false;
-    }
     auto screenStatus = GetCurrentScreenStatus();
-    if (it.second->GetScreenStatus() > screenStatus) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE,
-            "current screen is %{public}d, set data screen is %{public}d."
-            "userId: %{public}d, mimeType: %{public}s",
-            screenStatus, it.second->GetScreenStatus(), userId, mimeType.c_str());
-        return false;
+    bool isExistType = false;
+    bool hasData = clips_.FindRef(userId, [this, &mimeType, &isExistType, userId, tokenId, screenStatus](
+        const std::shared_ptr<PasteData> &data) {
+        if (data == nullptr) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "data is nullptr. userId: %{public}d, mimeType: %{public}s",
+                userId, mimeType.c_str());
+            return;
+        }
+        auto ret = IsDataValid(*data, tokenId);
+        if (ret != static_cast<int32_t>(PasteboardError::E_OK)) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE,
+                "pasteData is invalid, tokenId is %{public}d, userId: %{public}d,"
+                "mimeType: %{public}s, ret is %{public}d",
+                tokenId, userId, mimeType.c_str(), ret);
+            return;
+        }
+        if (data->GetScreenStatus() > screenStatus) {
+            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE,
+                "current screen is %{public}d, set data screen is %{public}d."
+                "userId: %{public}d, mimeType: %{public}s",
+                screenStatus, data->GetScreenStatus(), userId, mimeType.c_str());
+            return;
+        }
+        std::vector<std::string> mimeTypes = data->GetMimeTypes();
+        isExistType = std::find(mimeTypes.begin(), mimeTypes.end(), mimeType) != mimeTypes.end();
+    });
+    if (!hasData) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "can not find data. userId: %{public}d, mimeType: %{public}s",
+            userId, mimeType.c_str());
     }
-    std::vector<std::string> mimeTypes = it.second->GetMimeTypes();
-    auto isExistType = std::find(mimeTypes.begin(), mimeTypes.end(), mimeType) != mimeTypes.end();
     return isExistType;
 }
 
@@ -2351,8 +2976,8 @@ void PasteboardService::CloseSharedMemFd(int fd)
     }
 }
 
-int32_t PasteboardService::WritePasteData(
-    int fd, int64_t rawDataSize, const std::vector<uint8_t> &buffer, PasteData &pasteData, bool &hasData)
+int32_t PasteboardService::WritePasteData(int fd, int64_t rawDataSize, const std::vector<uint8_t> &buffer,
+    PasteData &pasteData, bool &hasData, uint64_t *contentHash)
 {
     if (rawDataSize > MIN_ASHMEM_DATA_SIZE) {
         auto actualSize = AshmemGetSize(fd);
@@ -2374,9 +2999,15 @@ int32_t PasteboardService::WritePasteData(
         }
         std::vector<uint8_t> pasteDataTlv(rawData, rawData + rawDataSize);
         hasData = pasteData.Decode(pasteDataTlv);
+        if (hasData && contentHash != nullptr) {
+            *contentHash = PasteData::GetContentHash(pasteDataTlv);
+        }
         ::munmap(ptr, rawDataSize);
     } else {
         hasData = pasteData.Decode(buffer);
+        if (hasData && contentHash != nullptr) {
+            *contentHash = PasteData::GetContentHash(buffer);
+        }
     }
     CloseSharedMemFd(fd);
     pasteData.rawDataSize_ = rawDataSize;
@@ -2417,7 +3048,8 @@ int32_t PasteboardService::SetPasteData(int fd, int64_t rawDataSize, const std::
     }
     PasteData pasteData{};
     bool result = false;
-    auto ret = WritePasteData(fd, rawDataSize, buffer, pasteData, result);
+    uint64_t contentHash = 0;
+    auto ret = WritePasteData(fd, rawDataSize, buffer, pasteData, result, &contentHash);
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == static_cast<int32_t>(PasteboardError::E_OK),
         static_cast<int32_t>(PasteboardError::INVALID_DATA_ERROR), PASTEBOARD_MODULE_SERVICE,
         "Failed to write paste data");
@@ -2431,7 +3063,7 @@ int32_t PasteboardService::SetPasteData(int fd, int64_t rawDataSize, const std::
         return ERR_OK;
     }
     PasteboardWebController::GetInstance().SplitWebviewPasteData(pasteData);
-    ret = SaveData(pasteData, rawDataSize, delayGetter, entryGetter);
+    ret = SaveData(pasteData, rawDataSize, delayGetter, entryGetter, contentHash);
     if (entityObserverMap_.Size() != 0 && pasteData.HasMimeType(MIMETYPE_TEXT_PLAIN)) {
         RecognizePasteData(pasteData);
     }
@@ -2766,7 +3398,7 @@ int32_t PasteboardService::GetGlobalShareOption(const std::vector<uint32_t> &tok
     }
     std::map<uint32_t, ShareOption> result;
     if (tokenIds.empty()) {
-        globalShareOptions_.ForEach([&result](const uint32_t &key, GlobalShareOption &value) {
+        globalShareOptions_.ForEachRef([&result](const uint32_t &key, const GlobalShareOption &value) {
             result[key] = value.shareOption;
             return false;
         });
@@ -2776,9 +3408,8 @@ int32_t PasteboardService::GetGlobalShareOption(const std::vector<uint32_t> &tok
         return ERR_OK;
     }
     for (const uint32_t &tokenId : tokenIds) {
-        globalShareOptions_.ComputeIfPresent(tokenId, [&result](const uint32_t &key, GlobalShareOption &value) {
-            result[key] = value.shareOption;
-            return true;
+        globalShareOptions_.FindRef(tokenId, [&result, tokenId](const GlobalShareOption &value) {
+            result[tokenId] = value.shareOption;
         });
     }
     for (const auto &pair : result) {
@@ -2859,23 +3490,17 @@ int32_t PasteboardService::RemoveAppShareOptions()
 
 void PasteboardService::UpdateShareOption(PasteData &pasteData)
 {
-    globalShareOptions_.ComputeIfPresent(
-        pasteData.GetTokenId(), [&pasteData](const uint32_t &tokenId, GlobalShareOption &option) {
-            pasteData.SetShareOption(option.shareOption);
-            return true;
-        });
+    globalShareOptions_.FindRef(pasteData.GetTokenId(), [&pasteData](const GlobalShareOption &option) {
+        pasteData.SetShareOption(option.shareOption);
+    });
 }
 
 bool PasteboardService::CheckMdmShareOption(PasteData &pasteData)
 {
     bool result = false;
-    globalShareOptions_.ComputeIfPresent(
-        pasteData.GetTokenId(), [&result](const uint32_t &tokenId, GlobalShareOption &option) {
-            if (option.source == MDM) {
-                result = true;
-            }
-            return true;
-        });
+    globalShareOptions_.FindRef(pasteData.GetTokenId(), [&result](const GlobalShareOption &option) {
+        result = option.source == MDM;
+    });
     return result;
 }
 
@@ -3041,6 +3666,322 @@ std::string PasteboardService::DumpHistory() const
     return result;
 }
 
+std::string PasteboardService::DumpDeviceCache() const
+{
+    auto stats = DMAdapter::GetInstance().GetCacheStats();
+    uint64_t lookups = stats.hits + stats.misses;
+    uint64_t hitRate = lookups == 0 ? 0 : stats.hits * 100 / lookups; // 100: percent
+    std::string result;
+    result.append("|Version     :  ")
+        .append(std::to_string(stats.version))
+        .append("\n")
+        .append("|Age(ms)     :  ")
+        .append(std::to_string(stats.ageMs))
+        .append("\n")
+        .append("|Devices     :  ")
+        .append(std::to_string(stats.deviceCount))
+        .append("\n")
+        .append("|Hits        :  ")
+        .append(std::to_string(stats.hits))
+        .append("\n")
+        .append("|Misses      :  ")
+        .append(std::to_string(stats.misses))
+        .append("\n")
+        .append("|Hit rate    :  ")
+        .append(std::to_string(hitRate))
+        .append("%\n");
+    return result;
+}
+
+std::string PasteboardService::DumpPublishStats() const
+{
+    auto stats = distributedPublisher_.GetStats();
+    std::string result;
+    result.append("|Submitted   :  ")
+        .append(std::to_string(stats.submitted))
+        .append("\n")
+        .append("|Published   :  ")
+        .append(std::to_string(stats.published))
+        .append("\n")
+        .append("|Skipped     :  ")
+        .append(std::to_string(stats.skipped))
+        .append("\n")
+        .append("|Canceled    :  ")
+        .append(std::to_string(stats.canceled))
+        .append("\n")
+        .append("|Failed      :  ")
+        .append(std::to_string(stats.failed))
+        .append("\n")
+        .append("|Timed out   :  ")
+        .append(std::to_string(stats.timedOut))
+        .append("\n")
+        .append("|Latency(us) :  last ")
+        .append(std::to_string(stats.lastLatencyUs))
+        .append(", max ")
+        .append(std::to_string(stats.maxLatencyUs))
+        .append("\n");
+    return result;
+}
+
+std::string PasteboardService::DumpEntityRecognition() const
+{
+    auto stats = entityRecognizer_.GetStats();
+    std::string result;
+    result.append("|Engine      :  ")
+        .append(entityRecognizer_.IsEngineLoaded() ? "loaded" : "unloaded")
+        .append(", loads ")
+        .append(std::to_string(stats.engineLoads))
+        .append(", last load(us) ")
+        .append(std::to_string(stats.loadUs))
+        .append("\n")
+        .append("|Submitted   :  ")
+        .append(std::to_string(stats.submitted))
+        .append("\n")
+        .append("|Notified    :  ")
+        .append(std::to_string(stats.notified))
+        .append("\n")
+        .append("|Cache hits  :  ")
+        .append(std::to_string(stats.cacheHits))
+        .append("\n")
+        .append("|Skipped     :  ")
+        .append(std::to_string(stats.skipped))
+        .append("\n")
+        .append("|Canceled    :  ")
+        .append(std::to_string(stats.canceled))
+        .append("\n")
+        .append("|Failed      :  ")
+        .append(std::to_string(stats.failed))
+        .append("\n")
+        .append("|Process(us) :  last ")
+        .append(std::to_string(stats.lastProcessUs))
+        .append(", max ")
+        .append(std::to_string(stats.maxProcessUs))
+        .append("\n")
+        .append("|Extract(us) :  ")
+        .append(std::to_string(stats.lastExtractUs))
+        .append("\n")
+        .append("|Notify(us)  :  ")
+        .append(std::to_string(stats.lastNotifyUs))
+        .append("\n")
+        .append("|Latency(us) :  last ")
+        .append(std::to_string(stats.lastLatencyUs))
+        .append(", max ")
+        .append(std::to_string(stats.maxLatencyUs))
+        .append("\n");
+    return result;
+}
+
+std::string PasteboardService::DumpPerf()
+{
+    auto publishStats = distributedPublisher_.GetStats();
+    auto recognitionStats = entityRecognizer_.GetStats();
+    auto historyStats = clipHistory_.GetStats();
+    auto cacheStats = DMAdapter::GetInstance().GetCacheStats();
+    uint64_t lookups = cacheStats.hits + cacheStats.misses;
+    uint64_t hitRate = lookups == 0 ? 0 : cacheStats.hits * 100 / lookups; // 100: percent
+    std::string result;
+    result.append("|Remote tasks:  ")
+        .append(std::to_string(taskMgr_.GetTaskCount()))
+        .append("\n")
+        .append("|P2P links   :  ")
+        .append(std::to_string(p2pMap_.Size()))
+        .append("\n")
+        .append("|Publish     :  pending ")
+        .append(std::to_string(publishStats.pending))
+        .append(", skipped ")
+        .append(std::to_string(publishStats.skipped))
+        .append("\n")
+        .append("|Recognize   :  pending ")
+        .append(std::to_string(recognitionStats.pending))
+        .append(", skipped ")
+        .append(std::to_string(recognitionStats.skipped))
+        .append("\n")
+        .append("|Device cache:  hit rate ")
+        .append(std::to_string(hitRate))
+        .append("% (")
+        .append(std::to_string(cacheStats.hits))
+        .append("/")
+        .append(std::to_string(lookups))
+        .append(")\n")
+        .append("|Entity cache:  hits ")
+        .append(std::to_string(recognitionStats.cacheHits))
+        .append(" of ")
+        .append(std::to_string(recognitionStats.submitted))
+        .append(" recognitions\n")
+        .append("|Clip history:  ")
+        .append(std::to_string(historyStats.clips))
+        .append(" clips, resident ")
+        .append(std::to_string(historyStats.residentBytes))
+        .append(" bytes, spilled ")
+        .append(std::to_string(historyStats.spilledBytes))
+        .append(" bytes\n");
+    auto spillStats = clipSpill_.GetStats();
+    result.append("|Clip spill  :  ")
+        .append(std::to_string(spillStats.clips))
+        .append(" clips, ")
+        .append(std::to_string(spillStats.spilledBytes))
+        .append(" bytes, budget ")
+        .append(std::to_string(clipSpill_.GetResidentBudget()))
+        .append(" bytes, spilled ")
+        .append(std::to_string(spillStats.spilled))
+        .append(", restored ")
+        .append(std::to_string(spillStats.restored))
+        .append(", failed ")
+        .append(std::to_string(spillStats.spillFailed + spillStats.restoreFailed))
+        .append("\n");
+    result.append("|Copy dedup  :  ")
+        .append(std::to_string(clipDedupHits_.load()))
+        .append(" hits\n");
+    auto previewStats = pixelMapPreviews_.GetStats();
+    result.append("|Previews    :  ")
+        .append(std::to_string(previewStats.previews))
+        .append(" pixel maps, ")
+        .append(std::to_string(previewStats.bytes))
+        .append(" bytes, hits ")
+        .append(std::to_string(previewStats.hits))
+        .append(", built ")
+        .append(std::to_string(previewStats.built))
+        .append(", failed ")
+        .append(std::to_string(previewStats.failed))
+        .append("\n");
+    auto focusStats = WindowManager::GetFocusStats();
+    result.append("|Focus cache :  ")
+        .append(focusStats.subscribed ? "subscribed" : "not subscribed")
+        .append(", hits ")
+        .append(std::to_string(focusStats.hits))
+        .append(", queries ")
+        .append(std::to_string(focusStats.queries))
+        .append(", events ")
+        .append(std::to_string(focusStats.events))
+        .append("\n");
+    if (inputEventCallback_ != nullptr) {
+        auto grantStats = inputEventCallback_->GetGrantStats();
+        result.append("|Ctrl+V grant:  granted ")
+            .append(std::to_string(grantStats.granted))
+            .append(", denied ")
+            .append(std::to_string(grantStats.denied))
+            .append(", waited ")
+            .append(std::to_string(grantStats.waited))
+            .append(", pending ")
+            .append(std::to_string(grantStats.grants))
+            .append("\n");
+    }
+    auto throttleStats = callThrottle_.GetStats();
+    result.append("|Throttle    :  admitted ")
+        .append(std::to_string(throttleStats.admitted))
+        .append(", refused ")
+        .append(std::to_string(throttleStats.callLimited + throttleStats.byteLimited + throttleStats.busy))
+        .append(", in flight ")
+        .append(std::to_string(throttleStats.inFlight))
+        .append(", waiting ")
+        .append(std::to_string(throttleStats.waiting))
+        .append("\n");
+
+    // the clips are read outside the shard locks and sized by the bytes recorded when they were saved, so a dump
+    // neither encodes a clip nor holds pasteDataMutex_ longer than reading two fields of each
+    std::vector<std::pair<int32_t, std::shared_ptr<PasteData>>> clips;
+    clips_.ForEachRef([&clips](const int32_t &userId, const std::shared_ptr<PasteData> &data) -> bool {
+        clips.emplace_back(userId, data);
+        return false;
+    });
+    struct ClipSize {
+        int32_t userId = 0;
+        size_t records = 0;
+        int64_t bytes = 0;
+    };
+    std::vector<ClipSize> sizes;
+    sizes.reserve(clips.size());
+    {
+        std::shared_lock<std::shared_mutex> read(pasteDataMutex_);
+        for (const auto &[userId, data] : clips) {
+            if (data != nullptr) {
+                sizes.push_back({ userId, data->GetRecordCount(), data->rawDataSize_ });
+            }
+        }
+    }
+    for (const auto &size : sizes) {
+        result.append("|User ")
+            .append(std::to_string(size.userId))
+            .append(" clip:  ")
+            .append(std::to_string(size.records))
+            .append(" records, ")
+            .append(std::to_string(size.bytes))
+            .append(" bytes\n");
+    }
+    return result;
+}
+
+std::string PasteboardService::DumpClipHistory() const
+{
+    return clipHistory_.Dump();
+}
+
+std::string PasteboardService::DumpThrottle() const
+{
+    auto config = callThrottle_.GetConfig();
+    auto stats = callThrottle_.GetStats();
+    std::string result;
+    result.append("|Budgets     :  ")
+        .append(config.enabled ? "" : "disabled, ")
+        .append(std::to_string(config.callsPerSecond))
+        .append(" calls/s burst ")
+        .append(std::to_string(config.callBurst))
+        .append(", ")
+        .append(std::to_string(config.bytesPerSecond))
+        .append(" bytes/s burst ")
+        .append(std::to_string(config.byteBurst))
+        .append(", concurrent ")
+        .append(std::to_string(config.maxConcurrent))
+        .append("/")
+        .append(std::to_string(config.maxCallerConcurrent))
+        .append(" per caller, wait ")
+        .append(std::to_string(config.maxWaitMs))
+        .append("ms, at most ")
+        .append(std::to_string(config.maxWaiting))
+        .append(" waiting\n")
+        .append("|Admitted    :  ")
+        .append(std::to_string(stats.admitted))
+        .append(", after waiting ")
+        .append(std::to_string(stats.queued))
+        .append(", ")
+        .append(std::to_string(stats.bytes))
+        .append(" bytes\n")
+        .append("|Refused     :  calls ")
+        .append(std::to_string(stats.callLimited))
+        .append(", bytes ")
+        .append(std::to_string(stats.byteLimited))
+        .append(", busy ")
+        .append(std::to_string(stats.busy))
+        .append(", of them waiting at the limit ")
+        .append(std::to_string(stats.waitLimited))
+        .append("\n")
+        .append("|Now         :  in flight ")
+        .append(std::to_string(stats.inFlight))
+        .append(", waiting ")
+        .append(std::to_string(stats.waiting))
+        .append(", callers ")
+        .append(std::to_string(stats.callers))
+        .append("\n");
+    for (const auto &caller : callThrottle_.GetCallerStats(MAX_THROTTLE_DUMP_CALLERS)) {
+        result.append("|pid ")
+            .append(std::to_string(caller.caller.pid))
+            .append(" token ")
+            .append(std::to_string(caller.caller.tokenId))
+            .append(":  admitted ")
+            .append(std::to_string(caller.admitted))
+            .append(", refused ")
+            .append(std::to_string(caller.refused))
+            .append(", ")
+            .append(std::to_string(caller.bytes))
+            .append(" bytes, in flight ")
+            .append(std::to_string(caller.inFlight))
+            .append(", waiting ")
+            .append(std::to_string(caller.waiting))
+            .append("\n");
+    }
+    return result;
+}
+
 std::string PasteboardService::DumpData()
 {
     auto userId = GetCurrentAccountId();
@@ -3093,21 +4034,25 @@ bool PasteboardService::IsFocusedApp(uint32_t tokenId)
         PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "caller is not application");
         return true;
     }
-    FocusChangeInfo info;
-#ifdef SCENE_BOARD_ENABLE
-    WindowManagerLite::GetInstance().GetFocusWindowInfo(info);
-#else
-    WindowManager::GetInstance().GetFocusWindowInfo(info);
-#endif
+    auto info = WindowManager::GetFocusWindowInfo();
     auto callPid = IPCSkeleton::GetCallingPid();
-    if (callPid == info.pid_) {
+    if (callPid == info.pid) {
         PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "pid is same, it is focused app");
         return true;
     }
+    return IsUIExtensionFocused(tokenId);
+}
+
+bool PasteboardService::IsUIExtensionFocused(uint32_t tokenId)
+{
+    // the focus may move between a host and its UI extension without a window focus change, so it is never cached
     bool isFocused = false;
     auto ret = AAFwk::AbilityManagerClient::GetInstance()->CheckUIExtensionIsFocused(tokenId, isFocused);
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "check result:%{public}d, isFocused:%{public}d", ret, isFocused);
-    return ret == NO_ERROR && isFocused;
+    if (ret != NO_ERROR) {
+        return false;
+    }
+    return isFocused;
 }
 
 void PasteboardService::DeletePreSyncP2pFromP2pMap(const std::string &networkId)
@@ -3353,14 +4298,9 @@ void PasteboardService::UnRegisterPreSyncMonitor()
 FocusedAppInfo PasteboardService::GetFocusedAppInfo(void) const
 {
     FocusedAppInfo appInfo = { 0 };
-    FocusChangeInfo info;
-#ifdef SCENE_BOARD_ENABLE
-    WindowManagerLite::GetInstance().GetFocusWindowInfo(info);
-#else
-    WindowManager::GetInstance().GetFocusWindowInfo(info);
-#endif
-    appInfo.windowId = info.windowId_;
-    appInfo.abilityToken = info.abilityToken_;
+    auto info = WindowManager::GetFocusWindowInfo();
+    appInfo.windowId = info.windowId;
+    appInfo.abilityToken = info.abilityToken;
     return appInfo;
 }
 
@@ -3373,12 +4313,6 @@ void PasteboardService::SetPasteDataDot(PasteData &pasteData, const int32_t &use
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "SetPasteData Report!");
     Reporter::GetInstance().PasteboardBehaviour().Report(
         { static_cast<int>(BehaviourPasteboardState::BPS_COPY_STATE), bundleName });
-
-    int state = static_cast<int>(StatisticPasteboardState::SPS_COPY_STATE);
-    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "SetPasteData GetDataSize!");
-    size_t dataSize = GetDataSize(pasteData);
-    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "SetPasteData timeC!");
-    CalculateTimeConsuming timeC(dataSize, state);
 }
 
 void PasteboardService::GetPasteDataDot(PasteData &pasteData, const std::string &bundleName, const int32_t &userId)
@@ -3391,19 +4325,9 @@ void PasteboardService::GetPasteDataDot(PasteData &pasteData, const std::string
     HistoryInfo info{ time, bundleName, "get", remote, userId };
     SetPasteboardHistory(info);
     PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "GetPasteData Report!");
-    int pState = StatisticPasteboardState::SPS_INVALID_STATE;
-    int bState = BehaviourPasteboardState::BPS_INVALID_STATE;
-    if (pasteData.IsRemote()) {
-        pState = static_cast<int>(StatisticPasteboardState::SPS_REMOTE_PASTE_STATE);
-        bState = static_cast<int>(BehaviourPasteboardState::BPS_REMOTE_PASTE_STATE);
-    } else {
-        pState = static_cast<int>(StatisticPasteboardState::SPS_PASTE_STATE);
-        bState = static_cast<int>(BehaviourPasteboardState::BPS_PASTE_STATE);
-    };
-
+    int bState = pasteData.IsRemote() ? static_cast<int>(BehaviourPasteboardState::BPS_REMOTE_PASTE_STATE) :
+        static_cast<int>(BehaviourPasteboardState::BPS_PASTE_STATE);
     Reporter::GetInstance().PasteboardBehaviour().Report({ bState, bundleName });
-    size_t dataSize = GetDataSize(pasteData);
-    CalculateTimeConsuming timeC(dataSize, pState);
 }
 
 std::pair<std::shared_ptr<PasteData>, PasteDateResult> PasteboardService::GetDistributedData(
@@ -3418,7 +4342,11 @@ std::pair<std::shared_ptr<PasteData>, PasteDateResult> PasteboardService::GetDis
         return std::make_pair(nullptr, pasteDateResult);
     }
     std::vector<uint8_t> rawData;
-    auto result = clipPlugin->GetPasteData(event, rawData);
+    std::pair<int32_t, int32_t> result;
+    {
+        PasteboardTraceSpan span(event.pasteId, "ClipPlugin::GetPasteData");
+        result = clipPlugin->GetPasteData(event, rawData);
+    }
     if (result.first != 0) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "get data failed");
         Reporter::GetInstance().PasteboardFault().Report({ user, "GET_REMOTE_DATA_FAILED" });
@@ -3427,9 +4355,12 @@ std::pair<std::shared_ptr<PasteData>, PasteDateResult> PasteboardService::GetDis
         return std::make_pair(nullptr, pasteDateResult);
     }
 
-    currentEvent_ = std::move(event);
     std::shared_ptr<PasteData> pasteData = std::make_shared<PasteData>();
-    pasteData->Decode(rawData);
+    {
+        PasteboardTraceSpan span(event.pasteId, "DecodeRemoteData");
+        pasteData->Decode(rawData);
+    }
+    currentEvent_ = std::move(event);
     pasteData->SetOriginAuthority(std::make_pair(pasteData->GetBundleName(), pasteData->GetAppIndex()));
     pasteData->rawDataSize_ = static_cast<int64_t>(rawData.size());
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "set remote data, dataSize=%{public}" PRId64, pasteData->rawDataSize_);
@@ -3510,57 +4441,11 @@ bool PasteboardService::SetDistributedData(int32_t user, PasteData &data)
 
 bool PasteboardService::SetCurrentDistributedData(PasteData &data, Event event)
 {
-    std::thread thread([this, data, event]() mutable {
-        {
-            std::lock_guard<std::mutex> lock(setDistributedMemory_.mutex);
-            setDistributedMemory_.event = event;
-            setDistributedMemory_.data = std::make_shared<PasteData>(data);
-            if (setDistributedMemory_.isRunning) {
-                return;
-            }
-            setDistributedMemory_.isRunning = true;
-        }
-        bool isNeedCheck = false;
-        while (true) {
-            auto block = std::make_shared<BlockObject<bool>>(SET_DISTRIBUTED_DATA_INTERVAL, false);
-            {
-                std::lock_guard<std::mutex> lock(setDistributedMemory_.mutex);
-                if ((event.seqId == setDistributedMemory_.event.seqId && isNeedCheck) ||
-                    setDistributedMemory_.data == nullptr) {
-                    setDistributedMemory_.data = nullptr;
-                    setDistributedMemory_.isRunning = false;
-                    break;
-                }
-                if (!isNeedCheck) {
-                    isNeedCheck = true;
-                }
-                std::thread thread([this, event, block]() mutable {
-                    PasteData data;
-                    {
-                        std::lock_guard<std::mutex> lock(setDistributedMemory_.mutex);
-                        if (setDistributedMemory_.data == nullptr) {
-                            block->SetValue(true);
-                            return;
-                        }
-                        event = setDistributedMemory_.event;
-                        data = *setDistributedMemory_.data;
-                    }
-                    auto result = SetCurrentData(event, data);
-                    block->SetValue(true);
-                });
-                thread.detach();
-            }
-            bool ret = block->GetValue();
-            if (!ret) {
-                PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "SetCurrentData timeout,seqId:%{public}hu", event.seqId);
-            }
-        }
-    });
-    thread.detach();
-    return true;
+    // the only copy of the clip made for publishing, bursts collapse to the latest one in the publisher
+    return distributedPublisher_.Submit(DistributedPublishTask{ std::move(event), data });
 }
 
-bool PasteboardService::SetCurrentData(Event event, PasteData &data)
+bool PasteboardService::SetCurrentData(Event event, PasteData &data, const std::function<bool()> &isSuperseded)
 {
     auto clipPlugin = GetClipPlugin();
     if (clipPlugin == nullptr) {
@@ -3569,6 +4454,8 @@ bool PasteboardService::SetCurrentData(Event event, PasteData &data)
         return false;
     }
     RADAR_REPORT(DFX_SET_PASTEBOARD, DFX_LOAD_DISTRIBUTED_PLUGIN, DFX_SUCCESS);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGI(isSuperseded == nullptr || !isSuperseded(), false,
+        PASTEBOARD_MODULE_SERVICE, "superseded before encode, seqId:%{public}hu", event.seqId);
     bool needFull = data.IsDelayRecord() &&
         moduleConfig_.GetRemoteDeviceMinVersion() == DistributedModuleConfig::FIRST_VERSION;
     if (needFull) {
@@ -3581,9 +4468,12 @@ bool PasteboardService::SetCurrentData(Event event, PasteData &data)
             PasteboardWebController::GetInstance().CheckAppUriPermission(data);
         }
     }
+    auto remoteVersionMin = moduleConfig_.GetRemoteDeviceMinVersion();
+    if (!needFull && remoteVersionMin != DistributedModuleConfig::FIRST_VERSION && DeferRemotePixelMaps(data)) {
+        event.isDelay = true;
+    }
     GenerateDistributedUri(data);
     std::vector<uint8_t> rawData;
-    auto remoteVersionMin = moduleConfig_.GetRemoteDeviceMinVersion();
     {
         std::shared_lock<std::shared_mutex> read(pasteDataMutex_);
         if (!data.Encode(rawData, remoteVersionMin <= DistributedModuleConfig::SECOND_VERSION)) {
@@ -3599,16 +4489,45 @@ bool PasteboardService::SetCurrentData(Event event, PasteData &data)
             std::bind(&PasteboardService::GetDistributedDelayEntry, this, std::placeholders::_1,
                 std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
     }
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGI(isSuperseded == nullptr || !isSuperseded(), false,
+        PASTEBOARD_MODULE_SERVICE, "superseded before publish, seqId:%{public}hu", event.seqId);
     clipPlugin->SetPasteData(event, rawData);
     return true;
 }
 
+bool PasteboardService::DeferRemotePixelMaps(PasteData &data)
+{
+    static const std::string pixelMapUtdId = UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDMF::SYSTEM_DEFINED_PIXEL_MAP);
+    bool deferred = false;
+    std::shared_lock<std::shared_mutex> read(pasteDataMutex_);
+    for (const auto &record : data.AllRecords()) {
+        auto entry = record == nullptr ? nullptr : record->GetEntry(pixelMapUtdId);
+        auto pixelMap = entry == nullptr ? nullptr : entry->ConvertToPixelMap();
+        if (pixelMap == nullptr || !pixelMapPreviews_.NeedPreview(*pixelMap)) {
+            continue;
+        }
+        // peers fetch the preview or the full image as a delayed entry, the entry of the clip is replaced, not emptied
+        auto delayEntry = std::make_shared<PasteDataEntry>();
+        delayEntry->SetUtdId(pixelMapUtdId);
+        delayEntry->SetMimeType(MIMETYPE_PIXELMAP);
+        record->AddEntry(pixelMapUtdId, delayEntry);
+        record->SetDelayRecordFlag(true);
+        deferred = true;
+    }
+    if (deferred) {
+        data.SetDelayRecord(true);
+        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "pixel maps deferred, dataId:%{public}u", data.GetDataId());
+    }
+    return deferred;
+}
+
 int32_t PasteboardService::GetDistributedDelayEntry(const Event &evt, uint32_t recordId, const std::string &utdId,
     std::vector<uint8_t> &rawData)
 {
+    PasteboardTraceSpan span(evt.pasteId, "GetDistributedDelayEntry");
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "dataId:%{public}u, seqId:%{public}hu, expiration:%{public}" PRIu64
         ", recordId:%{public}u, type:%{public}s", evt.dataId, evt.seqId, evt.expiration, recordId, utdId.c_str());
-    auto [hasData, data] = clips_.Find(evt.user);
+    auto [hasData, data] = FindClip(evt.user);
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(hasData && data, static_cast<int32_t>(PasteboardError::NO_DATA_ERROR),
         PASTEBOARD_MODULE_SERVICE, "data not find, userId=%{public}u", evt.user);
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(evt.dataId == data->GetDataId(),
@@ -3621,7 +4540,8 @@ int32_t PasteboardService::GetDistributedDelayEntry(const Event &evt, uint32_t r
 
     PasteDataEntry entry;
     entry.SetUtdId(utdId);
-    int32_t ret = GetLocalEntryValue(evt.user, *data, *record, entry);
+    int32_t ret = utdId == PIXELMAP_PREVIEW_UTDID ? GetPreviewEntryValue(evt.user, *data, *record, entry) :
+        GetLocalEntryValue(evt.user, *data, *record, entry);
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == static_cast<int32_t>(PasteboardError::E_OK), ret,
         PASTEBOARD_MODULE_SERVICE, "get local entry failed, seqId=%{public}hu, dataId=%{public}u, recordId=%{public}u"
         ", type=%{public}s, ret=%{public}d", evt.seqId, evt.dataId, recordId, utdId.c_str(), ret);
@@ -3729,9 +4649,10 @@ int32_t PasteboardService::ProcessDistributedDelayEntry(PasteDataEntry &entry, s
 
 int32_t PasteboardService::GetDistributedDelayData(const Event &evt, uint8_t version, std::vector<uint8_t> &rawData)
 {
+    PasteboardTraceSpan span(evt.pasteId, "GetDistributedDelayData");
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "dataId:%{public}u, seqId:%{public}hu, expiration:%{public}" PRIu64,
         evt.dataId, evt.seqId, evt.expiration);
-    auto [hasData, data] = clips_.Find(evt.user);
+    auto [hasData, data] = FindClip(evt.user);
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(hasData && data, static_cast<int32_t>(PasteboardError::NO_DATA_ERROR),
         PASTEBOARD_MODULE_SERVICE, "data not find, userId=%{public}u", evt.user);
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(evt.dataId == data->GetDataId(),
@@ -3807,6 +4728,58 @@ int32_t PasteboardService::GetLocalEntryValue(int32_t userId, PasteData &data, P
     return static_cast<int32_t>(PasteboardError::E_OK);
 }
 
+int32_t PasteboardService::GetPreviewEntryValue(int32_t userId, PasteData &data, PasteDataRecord &record,
+    PasteDataEntry &value)
+{
+    static const std::string pixelMapUtdId = UDMF::UtdUtils::GetUtdIdFromUtdEnum(UDMF::SYSTEM_DEFINED_PIXEL_MAP);
+    auto entry = record.GetEntry(pixelMapUtdId);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(entry != nullptr, static_cast<int32_t>(PasteboardError::INVALID_MIMETYPE),
+        PASTEBOARD_MODULE_SERVICE, "no pixel map, recordId=%{public}u", record.GetRecordId());
+    // answered as the pixel map entry of the record, only smaller
+    value.SetUtdId(pixelMapUtdId);
+    value.SetMimeType(MIMETYPE_PIXELMAP);
+    if (data.IsRemote() && !entry->HasContent(pixelMapUtdId)) {
+        return GetRemotePreviewValue(userId, record, value);
+    }
+
+    PasteDataEntry full;
+    full.SetUtdId(pixelMapUtdId);
+    int32_t ret = GetLocalEntryValue(userId, data, record, full);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == static_cast<int32_t>(PasteboardError::E_OK), ret,
+        PASTEBOARD_MODULE_SERVICE, "get pixel map failed, recordId=%{public}u, ret=%{public}d", record.GetRecordId(),
+        ret);
+    auto preview = pixelMapPreviews_.Get(userId, data.GetDataId(), record.GetRecordId(), full.ConvertToPixelMap());
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(preview != nullptr,
+        static_cast<int32_t>(PasteboardError::GET_ENTRY_VALUE_FAILED), PASTEBOARD_MODULE_SERVICE,
+        "get preview failed, recordId=%{public}u", record.GetRecordId());
+    value.SetValue(preview);
+    return static_cast<int32_t>(PasteboardError::E_OK);
+}
+
+int32_t PasteboardService::GetRemotePreviewValue(int32_t userId, PasteDataRecord &record, PasteDataEntry &value)
+{
+    auto clipPlugin = GetClipPlugin();
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(clipPlugin != nullptr, static_cast<int32_t>(PasteboardError::PLUGIN_IS_NULL),
+        PASTEBOARD_MODULE_SERVICE, "plugin is null");
+
+    auto [distRet, distEvt] = GetValidDistributeEvent(userId);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(distRet == static_cast<int32_t>(PasteboardError::E_OK) ||
+        distRet == static_cast<int32_t>(PasteboardError::GET_SAME_REMOTE_DATA), distRet,
+        PASTEBOARD_MODULE_SERVICE, "get distribute event failed, ret=%{public}d", distRet);
+
+    // the peer scales its own image, the preview is not kept in the record so the full image is still fetched
+    std::vector<uint8_t> rawData;
+    int32_t ret = clipPlugin->GetPasteDataEntry(distEvt, record.GetRecordId(), PIXELMAP_PREVIEW_UTDID, rawData);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == 0, ret, PASTEBOARD_MODULE_SERVICE, "get remote preview failed");
+    PasteDataEntry preview;
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(preview.Decode(rawData),
+        static_cast<int32_t>(PasteboardError::GET_ENTRY_VALUE_FAILED), PASTEBOARD_MODULE_SERVICE,
+        "decode remote preview failed, size=%{public}zu", rawData.size());
+    value.SetValue(preview.GetValue());
+    value.rawDataSize_ = static_cast<int64_t>(rawData.size());
+    return static_cast<int32_t>(PasteboardError::E_OK);
+}
+
 int32_t PasteboardService::GetRemoteEntryValue(const AppInfo &appInfo, PasteData &data, PasteDataRecord &record,
     PasteDataEntry &entry)
 {
@@ -3996,7 +4969,7 @@ int32_t PasteboardService::SyncDelayedData()
 {
     auto tokenId = IPCSkeleton::GetCallingTokenID();
     auto appInfo = GetAppInfo(tokenId);
-    auto [hasData, data] = clips_.Find(appInfo.userId);
+    auto [hasData, data] = FindClip(appInfo.userId);
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(hasData && data, static_cast<int32_t>(PasteboardError::NO_DATA_ERROR),
         PASTEBOARD_MODULE_SERVICE, "data not find, userId=%{public}u", appInfo.userId);
     PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(tokenId == data->GetTokenId(),
@@ -4120,6 +5093,7 @@ void PasteboardService::OnConfigChange(bool isOn)
 {
     std::thread thread([=]() {
         OnConfigChangeInner(isOn);
+        PublishChangeStates();
     });
     thread.detach();
 }
@@ -4224,6 +5198,7 @@ void PasteBoardCommonEventSubscriber::OnReceiveEventInner(const EventFwk::Common
             auto accountId = pasteboardService_->GetCurrentAccountId();
             pasteboardService_->switch_.DeInit();
             pasteboardService_->switch_.Init(accountId);
+            pasteboardService_->PublishChangeStates();
             PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "SetSwitch end");
         }
     } else if (action == EventFwk::CommonEventSupport::COMMON_EVENT_USER_STOPPING) {
@@ -4237,10 +5212,16 @@ void PasteBoardCommonEventSubscriber::OnReceiveEventInner(const EventFwk::Common
         std::lock_guard<std::mutex> lock(mutex_);
         PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "screen is locked");
         PasteboardService::currentScreenStatus = ScreenEvent::ScreenLocked;
+        if (pasteboardService_ != nullptr) {
+            pasteboardService_->PublishChangeStates();
+        }
     } else if (action == EventFwk::CommonEventSupport::COMMON_EVENT_SCREEN_UNLOCKED) {
         std::lock_guard<std::mutex> lock(mutex_);
         PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "screen is unlocked");
         PasteboardService::currentScreenStatus = ScreenEvent::ScreenUnlocked;
+        if (pasteboardService_ != nullptr) {
+            pasteboardService_->PublishChangeStates();
+        }
     } else if (action == EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_REMOVED) {
         auto tokenId = want.GetIntParam("accessTokenId", -1);
         if (pasteboardService_ != nullptr) {
@@ -4253,6 +5234,7 @@ void PasteboardService::RevokeUriOnUninstall(int32_t tokenId)
 {
     PASTEBOARD_CHECK_AND_RETURN_LOGE(tokenId >= 0, PASTEBOARD_MODULE_SERVICE, "tokenId is invalids");
     auto userId = GetCurrentAccountId();
+    RestoreSpilledClip(userId);
     clips_.ComputeIfPresent(userId, [this, tokenId, userId](auto, auto &pasteData) {
         if (pasteData == nullptr) {
             return true;
@@ -4276,6 +5258,7 @@ void PasteboardService::RevokeUriOnUninstall(int32_t tokenId)
         });
         return true;
     });
+    changeStates_.Publish(userId);
 }
 
 void PasteboardService::RevokeAndClearUri(std::shared_ptr<PasteData> pasteData)
@@ -4321,6 +5304,7 @@ void PasteBoardAccountStateSubscriber::OnStateChangedInner(const AccountSA::OsAc
     if (data.state == AccountSA::OsAccountState::STOPPING && pasteboardService_ != nullptr) {
         std::lock_guard<std::mutex> lock(mutex_);
         pasteboardService_->CloseDistributedStore(data.fromId, true);
+        pasteboardService_->RemoveClipHistory(data.fromId);
     }
     if (data.callback != nullptr) {
         data.callback->OnComplete();
@@ -4342,6 +5326,8 @@ bool PasteboardService::SubscribeKeyboardEvent()
 
 void PasteboardService::PasteboardEventSubscriber()
 {
+    // a lost disconnect would leave the p2p link of the device open
+    EventCenter::GetInstance().SetReliable(PasteboardEvent::DISCONNECT);
     EventCenter::GetInstance().Subscribe(PasteboardEvent::DISCONNECT, [this](const OHOS::MiscServices::Event &event) {
         auto &evt = static_cast<const PasteboardEvent &>(event);
         auto networkId = evt.GetNetworkId();
@@ -4407,7 +5393,9 @@ int32_t PasteboardService::AppExit(pid_t pid)
     RemoveObserverByPid(userId, pid, observerLocalChangedMap_);
     RemoveObserverByPid(userId, pid, observerRemoteChangedMap_);
     RemoveObserverByPid(COMMON_USERID, pid, observerEventMap_);
-    entityObserverMap_.Erase(pid);
+    if (entityObserverMap_.Erase(pid) != 0) {
+        UpdateEntityRecognizerResident();
+    }
     DisposableManager::GetInstance().RemoveDisposableInfo(pid, false);
     ClearInputMethodPidByPid(userId, pid);
     std::vector<std::string> networkIds;
@@ -4489,10 +5477,11 @@ int32_t PasteboardService::CallbackEnter(uint32_t code)
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "invalid request, only support local, cmd:%{public}u", code);
         return ERR_TRANSACTION_FAILED;
     }
+    pid_t pid = IPCSkeleton::GetCallingPid();
+    PasteboardPerfStat::GetInstance().BeginCall(code, pid);
     if (code == static_cast<uint32_t>(IPasteboardServiceIpcCode::COMMAND_HAS_PASTE_DATA)) {
         return ERR_NONE;
     }
-    pid_t pid = IPCSkeleton::GetCallingPid();
     pid_t uid = IPCSkeleton::GetCallingUid();
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "pid:%{public}d, uid:%{public}d, cmd:%{public}u", pid, uid, code);
     return ERR_NONE;
@@ -4500,6 +5489,7 @@ int32_t PasteboardService::CallbackEnter(uint32_t code)
 
 int32_t PasteboardService::CallbackExit(uint32_t code, int32_t result)
 {
+    PasteboardPerfStat::GetInstance().EndCall(code, result);
     if (code == static_cast<uint32_t>(IPasteboardServiceIpcCode::COMMAND_HAS_PASTE_DATA)) {
         return ERR_NONE;
     }
@@ -4512,34 +5502,50 @@ int32_t PasteboardService::CallbackExit(uint32_t code, int32_t result)
 
 void InputEventCallback::OnKeyInputEventForPaste(std::shared_ptr<MMI::KeyEvent> keyEvent) const
 {
+    auto keyCode = keyEvent->GetKeyCode();
+    bool isCtrl = keyCode == MMI::KeyEvent::KEYCODE_CTRL_LEFT || keyCode == MMI::KeyEvent::KEYCODE_CTRL_RIGHT;
+    if (keyEvent->GetKeyAction() == MMI::KeyEvent::KEY_ACTION_UP) {
+        if (isCtrl) {
+            grants_->ClearInFlight();
+        }
+        return;
+    }
+    if (keyEvent->GetKeyAction() != MMI::KeyEvent::KEY_ACTION_DOWN) {
+        return;
+    }
+    // while a Ctrl key is down a paste check may overtake the Ctrl+V event of its own window
+    if (isCtrl) {
+        grants_->MarkInFlight(static_cast<uint64_t>(PasteBoardTime::GetBootTimeMs()));
+        return;
+    }
     auto keyItems = keyEvent->GetKeyItems();
-    if (keyItems.size() != CTRLV_EVENT_SIZE) {
+    if ((keyItems.size() != CTRLV_EVENT_SIZE) ||
+        ((keyItems[0].GetKeyCode() != MMI::KeyEvent::KEYCODE_CTRL_LEFT) &&
+        (keyItems[0].GetKeyCode() != MMI::KeyEvent::KEYCODE_CTRL_RIGHT)) ||
+        keyItems[1].GetKeyCode() != MMI::KeyEvent::KEYCODE_V) {
         return;
     }
-    if ((keyEvent->GetKeyAction() == MMI::KeyEvent::KEY_ACTION_DOWN) &&
-        ((keyItems[0].GetKeyCode() == MMI::KeyEvent::KEYCODE_CTRL_LEFT) ||
-        (keyItems[0].GetKeyCode() == MMI::KeyEvent::KEYCODE_CTRL_RIGHT)) &&
-        keyItems[1].GetKeyCode() == MMI::KeyEvent::KEYCODE_V) {
-        int32_t windowId = keyEvent->GetTargetWindowId();
-        std::unique_lock<std::shared_mutex> lock(inputEventMutex_);
-        windowPid_ = MMI::InputManager::GetInstance()->GetWindowPid(windowId);
-        actionTime_ =
-            static_cast<uint64_t>(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count());
-        std::shared_ptr<BlockObject<int32_t>> block = nullptr;
-        {
-            std::unique_lock<std::shared_mutex> blockMapLock(blockMapMutex_);
-            auto it = blockMap_.find(windowPid_);
-            if (it != blockMap_.end()) {
-                block = it->second;
-            } else {
-                block = std::make_shared<BlockObject<int32_t>>(WAIT_TIME_OUT, 0);
-                blockMap_.insert(std::make_pair(windowPid_, block));
-            }
+    int32_t windowId = keyEvent->GetTargetWindowId();
+    int32_t windowPid = MMI::InputManager::GetInstance()->GetWindowPid(windowId);
+    grants_->Record(windowPid, windowId, static_cast<uint64_t>(PasteBoardTime::GetBootTimeMs()));
+    SchedulePrune(grants_);
+}
+
+void InputEventCallback::SchedulePrune(std::weak_ptr<CtrlVGrantTable> weakGrants)
+{
+    auto timer = FFRTPool::GetTimer("pasteboard_service");
+    PASTEBOARD_CHECK_AND_RETURN_LOGE(timer != nullptr, PASTEBOARD_MODULE_SERVICE, "timer is null");
+    FFRTTask task = [weakGrants] {
+        auto grants = weakGrants.lock();
+        if (grants == nullptr) {
+            return;
         }
-        if (block != nullptr) {
-            block->SetValue(SET_VALUE_SUCCESS);
+        grants->Prune(static_cast<uint64_t>(PasteBoardTime::GetBootTimeMs()));
+        if (!grants->IsEmpty()) {
+            SchedulePrune(weakGrants);
         }
-    }
+    };
+    timer->SetTimer(CTRLV_GRANT_PRUNE_ID, task, CtrlVGrantTable::GRANT_WINDOW_MS);
 }
 
 void InputEventCallback::OnInputEvent(std::shared_ptr<MMI::KeyEvent> keyEvent) const
@@ -4570,39 +5576,18 @@ void InputEventCallback::OnInputEvent(std::shared_ptr<MMI::AxisEvent> axisEvent)
 
 bool InputEventCallback::IsCtrlVProcess(uint32_t callingPid, bool isFocused)
 {
-    std::shared_ptr<BlockObject<int32_t>> block = nullptr;
-    {
-        std::unique_lock<std::shared_mutex> blockMapLock(blockMapMutex_);
-        auto it = blockMap_.find(callingPid);
-        if (it != blockMap_.end()) {
-            block = it->second;
-        } else {
-            block = std::make_shared<BlockObject<int32_t>>(WAIT_TIME_OUT, 0);
-            blockMap_.insert(std::make_pair(callingPid, block));
-        }
-    }
-    if (block != nullptr) {
-        block->GetValue();
-    }
-    std::shared_lock<std::shared_mutex> lock(inputEventMutex_);
-    auto curTime = static_cast<uint64_t>(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count());
-    auto ret = (callingPid == static_cast<uint32_t>(windowPid_) || isFocused) && curTime >= actionTime_ &&
-        curTime - actionTime_ < EVENT_TIME_OUT;
-    if (!ret) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "windowPid is: %{public}d, callingPid is: %{public}d,"
-            "curTime is: %{public}" PRIu64 ", actionTime is: %{public}" PRIu64 ", isFocused is: %{public}d",
-            windowPid_, callingPid, curTime, actionTime_, isFocused);
-    }
-    return ret;
+    auto nowMs = static_cast<uint64_t>(PasteBoardTime::GetBootTimeMs());
+    return grants_->Consume(static_cast<int32_t>(callingPid), isFocused, nowMs, WAIT_TIME_OUT);
 }
 
 void InputEventCallback::Clear()
 {
-    std::unique_lock<std::shared_mutex> lock(inputEventMutex_);
-    actionTime_ = 0;
-    windowPid_ = 0;
-    std::unique_lock<std::shared_mutex> blockMapLock(blockMapMutex_);
-    blockMap_.clear();
+    grants_->Clear();
+}
+
+CtrlVGrantTable::Stats InputEventCallback::GetGrantStats() const
+{
+    return grants_->GetStats();
 }
 } // namespace MiscServices
 } // namespace OHOS
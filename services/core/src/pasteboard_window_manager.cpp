@@ -15,6 +15,9 @@
 
 #include "pasteboard_window_manager.h"
 
+#include <mutex>
+
+#include "pasteboard_hilog.h"
 #ifdef SCENE_BOARD_ENABLE
 #include "window_manager_lite.h"
 #else
@@ -22,14 +25,152 @@
 #endif // SCENE_BOARD_ENABLE
 
 namespace OHOS::MiscServices {
-int32_t WindowManager::GetFocusWindowId()
-{
-    Rosen::FocusChangeInfo info;
+namespace {
 #ifdef SCENE_BOARD_ENABLE
-    Rosen::WindowManagerLite::GetInstance().GetFocusWindowInfo(info);
+using RosenWindowManager = Rosen::WindowManagerLite;
 #else
-    Rosen::WindowManager::GetInstance().GetFocusWindowInfo(info);
+using RosenWindowManager = Rosen::WindowManager;
 #endif
-    return info.windowId_;
+
+class FocusChangedListener : public Rosen::IFocusChangedListener {
+public:
+    void OnFocused(const sptr<Rosen::FocusChangeInfo> &focusChangeInfo) override
+    {
+        Update(focusChangeInfo, true);
+    }
+
+    void OnUnfocused(const sptr<Rosen::FocusChangeInfo> &focusChangeInfo) override
+    {
+        Update(focusChangeInfo, false);
+    }
+
+private:
+    static void Update(const sptr<Rosen::FocusChangeInfo> &focusChangeInfo, bool focused)
+    {
+        PASTEBOARD_CHECK_AND_RETURN_LOGE(focusChangeInfo != nullptr, PASTEBOARD_MODULE_SERVICE, "info is null");
+        FocusWindowInfo info;
+        info.pid = focusChangeInfo->pid_;
+        info.windowId = focusChangeInfo->windowId_;
+        info.abilityToken = focusChangeInfo->abilityToken_;
+        WindowManager::UpdateFocus(info, focused);
+    }
+};
+
+std::mutex g_subscribeMutex;
+sptr<FocusChangedListener> g_listener = nullptr;
+
+std::mutex g_focusMutex;
+FocusWindowInfo g_focus;
+uint64_t g_generation = 0;
+uint64_t g_lastGeneration = 0;
+bool g_focusEventSeen = false;
+WindowManager::FocusStats g_focusStats;
+} // namespace
+
+int32_t WindowManager::GetFocusWindowId()
+{
+    return GetFocusWindowInfo().windowId;
+}
+
+FocusWindowInfo WindowManager::GetFocusWindowInfo()
+{
+    {
+        std::lock_guard<std::mutex> lock(g_focusMutex);
+        if (g_generation != 0) {
+            ++g_focusStats.hits;
+            return g_focus;
+        }
+        ++g_focusStats.queries;
+    }
+    return QueryFocusWindowInfo();
+}
+
+uint64_t WindowManager::GetFocusGeneration()
+{
+    std::lock_guard<std::mutex> lock(g_focusMutex);
+    return g_generation;
+}
+
+bool WindowManager::SubscribeFocusChange()
+{
+    std::lock_guard<std::mutex> subscribeLock(g_subscribeMutex);
+    if (g_listener != nullptr) {
+        return true;
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_focusMutex);
+        g_focusEventSeen = false;
+    }
+    sptr<FocusChangedListener> listener = new (std::nothrow) FocusChangedListener();
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(listener != nullptr, false, PASTEBOARD_MODULE_SERVICE,
+        "alloc listener failed");
+    auto ret = RosenWindowManager::GetInstance().RegisterFocusChangedListener(listener);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(ret == Rosen::WMError::WM_OK, false, PASTEBOARD_MODULE_SERVICE,
+        "register focus listener failed, ret=%{public}d", static_cast<int32_t>(ret));
+    g_listener = listener;
+
+    // a notification received since the registration is newer than the query
+    auto info = QueryFocusWindowInfo();
+    std::lock_guard<std::mutex> lock(g_focusMutex);
+    if (!g_focusEventSeen) {
+        g_focus = info;
+    }
+    g_generation = ++g_lastGeneration;
+    g_focusStats.subscribed = true;
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "focus subscribed, pid=%{public}d, windowId=%{public}d",
+        g_focus.pid, g_focus.windowId);
+    return true;
+}
+
+void WindowManager::UnsubscribeFocusChange()
+{
+    std::lock_guard<std::mutex> subscribeLock(g_subscribeMutex);
+    {
+        std::lock_guard<std::mutex> lock(g_focusMutex);
+        g_generation = 0;
+        g_focus = FocusWindowInfo();
+        g_focusStats.subscribed = false;
+    }
+    if (g_listener == nullptr) {
+        return;
+    }
+    // fails when the window manager is already gone, the listener went with it
+    auto ret = RosenWindowManager::GetInstance().UnregisterFocusChangedListener(g_listener);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "focus unsubscribed, ret=%{public}d", static_cast<int32_t>(ret));
+    g_listener = nullptr;
+}
+
+void WindowManager::UpdateFocus(const FocusWindowInfo &info, bool focused)
+{
+    std::lock_guard<std::mutex> lock(g_focusMutex);
+    if (focused) {
+        g_focus = info;
+    } else if (g_focus.windowId == info.windowId) {
+        g_focus = FocusWindowInfo();
+    }
+    g_focusEventSeen = true;
+    ++g_focusStats.events;
+    if (g_generation != 0) {
+        g_generation = ++g_lastGeneration;
+    }
+    PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "focused=%{public}d, pid=%{public}d, windowId=%{public}d", focused,
+        info.pid, info.windowId);
+}
+
+WindowManager::FocusStats WindowManager::GetFocusStats()
+{
+    std::lock_guard<std::mutex> lock(g_focusMutex);
+    return g_focusStats;
+}
+
+FocusWindowInfo WindowManager::QueryFocusWindowInfo()
+{
+    Rosen::FocusChangeInfo focusChangeInfo;
+    RosenWindowManager::GetInstance().GetFocusWindowInfo(focusChangeInfo);
+    FocusWindowInfo info;
+    info.pid = focusChangeInfo.pid_;
+    info.windowId = focusChangeInfo.windowId_;
+    info.abilityToken = focusChangeInfo.abilityToken_;
+    return info;
 }
 } // namespace OHOS::MiscServices
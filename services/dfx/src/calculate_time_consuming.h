@@ -16,37 +16,28 @@
 #ifndef TIME_CONSUMING_H
 #define TIME_CONSUMING_H
 
-#include "singleton.h"
+#include <chrono>
+#include <cstdint>
 
 namespace OHOS {
 namespace MiscServices {
-enum class TimeLevel : std::uint32_t {
-    PER_FIVE_HUNDRED_MS_ZERO = 0,
-    PER_FIVE_HUNDRED_MS_ONE,
-    PER_FIVE_HUNDRED_MS_TWO,
-    PER_FIVE_HUNDRED_MS_THREE,
-    PER_FIVE_HUNDRED_MS_FOUR,
-    PER_FIVE_HUNDRED_MS_FIVE,
-    PER_FIVE_HUNDRED_MS_SIX,
-    PER_FIVE_HUNDRED_MS_SEVEN,
-    PER_FIVE_HUNDRED_MS_EIGHT,
-    PER_FIVE_HUNDRED_MS_NINE,
-};
-
-class CalculateTimeConsuming : public Singleton<CalculateTimeConsuming> {
+/*
+ * Measures one pasteboard operation from construction to destruction on the monotonic clock. Only operations
+ * given their data size through Finish are reported, failed ones would skew the latency percentiles.
+ */
+class CalculateTimeConsuming {
 public:
-    CalculateTimeConsuming(const size_t calPasteboardData, const int calPasteboardState);
+    explicit CalculateTimeConsuming(int pasteboardState);
     ~CalculateTimeConsuming();
-    static void SetBeginTime();
+    CalculateTimeConsuming(const CalculateTimeConsuming &) = delete;
+    CalculateTimeConsuming &operator=(const CalculateTimeConsuming &) = delete;
+    void SetPasteboardState(int pasteboardState);
+    void Finish(int64_t dataSize);
 
 private:
-    static uint64_t GetCurrentTimeMicros();
-    int CalculateTime(uint64_t time);
-    int CalculateData(size_t calPasteboardData) const;
-
-    int pasteboardData_;
+    std::chrono::steady_clock::time_point beginTime_;
     int pasteboardState_;
-    static uint64_t lastTime_;
+    int64_t dataSize_ = -1;
 };
 } // namespace MiscServices
 } // namespace OHOS
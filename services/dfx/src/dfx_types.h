@@ -16,24 +16,11 @@
 #ifndef MISCSERVICES_PASTEBOARD_DFX_TYPES_H
 #define MISCSERVICES_PASTEBOARD_DFX_TYPES_H
 
+#include <cstdint>
 #include <string>
 
 namespace OHOS {
 namespace MiscServices {
-enum TimeConsumingStatistic : std::int32_t {
-    TCS_TIME_CONSUMING_LEVEL_ONE = 0,
-    TCS_TIME_CONSUMING_LEVEL_TWO,
-    TCS_TIME_CONSUMING_LEVEL_THREE,
-    TCS_TIME_CONSUMING_LEVEL_FOUR,
-    TCS_TIME_CONSUMING_LEVEL_FIVE,
-    TCS_TIME_CONSUMING_LEVEL_SIX,
-    TCS_TIME_CONSUMING_LEVEL_SEVEN,
-    TCS_TIME_CONSUMING_LEVEL_EIGHT,
-    TCS_TIME_CONSUMING_LEVEL_NINE,
-    TCS_TIME_CONSUMING_LEVEL_TEN,
-    TCS_TIME_CONSUMING_LEVEL_ELEVEN,
-};
-
 enum BehaviourPasteboardState : std::int32_t {
     BPS_COPY_STATE = 0,
     BPS_PASTE_STATE,
@@ -45,6 +32,8 @@ enum StatisticPasteboardState : std::int32_t {
     SPS_COPY_STATE = 0,
     SPS_PASTE_STATE,
     SPS_REMOTE_PASTE_STATE,
+    SPS_GET_ENTRY_STATE,
+    SPS_DETECT_PATTERNS_STATE,
     SPS_INVALID_STATE,
 };
 
@@ -56,6 +45,7 @@ enum DataRange : std::int32_t {
     DR_FIVE_TO_TEN_MB,
     DR_TEN_TO_FIFTY_MB,
     DR_OVER_FIFTY_MB,
+    DR_BUTT,
 };
 
 struct PasteboardFaultMsg {
@@ -70,8 +60,8 @@ struct PasteboardBehaviourMsg {
 
 struct TimeConsumingStat {
     int pasteboardState;
-    int dataSize;
-    int timeConsuming;
+    int64_t dataSize;      // bytes
+    int64_t timeConsuming; // microseconds
 };
 
 enum class ReportStatus {
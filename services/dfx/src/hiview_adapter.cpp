@@ -38,67 +38,13 @@ const std::map<int, std::string> EVENT_COVERT_TABLE = {
 
 bool HiViewAdapter::running_ = false;
 std::mutex HiViewAdapter::runMutex_;
-std::mutex HiViewAdapter::timeConsumingMutex_;
 std::mutex HiViewAdapter::behaviourMutex_;
-std::vector<std::map<int, int>> HiViewAdapter::copyTimeConsumingStat_;
-std::vector<std::map<int, int>> HiViewAdapter::pasteTimeConsumingStat_;
-std::vector<std::map<int, int>> HiViewAdapter::remotePasteTimeConsumingStat_;
+std::array<std::array<LatencyHistogram, DR_BUTT>, SPS_INVALID_STATE> HiViewAdapter::timeConsumingStat_;
 
 std::map<std::string, int> HiViewAdapter::copyPasteboardBehaviour_;
 std::map<std::string, int> HiViewAdapter::pastePasteboardBehaviour_;
 std::map<std::string, int> HiViewAdapter::remotePastePasteboardBehaviour_;
 
-std::map<int, int> HiViewAdapter::dataMap_ = HiViewAdapter::InitDataMap();
-std::map<int, int> HiViewAdapter::timeMap_ = HiViewAdapter::InitTimeMap();
-
-std::map<int, int> HiViewAdapter::InitDataMap()
-{
-    std::map<int, int> dataMap;
-    dataMap.insert(std::pair<int, int>(
-        static_cast<int>(DataRange::DR_ZERO_TO_HUNDRED_KB), static_cast<int>(DataConsumingLevel::DATA_LEVEL_ONE)));
-    dataMap.insert(std::pair<int, int>(static_cast<int>(DataRange::DR_HUNDRED_TO_FIVE_HUNDREDS_KB),
-        static_cast<int>(DataConsumingLevel::DATA_LEVEL_TWO)));
-    dataMap.insert(std::pair<int, int>(static_cast<int>(DataRange::DR_FIVE_HUNDREDS_TO_THOUSAND_KB),
-        static_cast<int>(DataConsumingLevel::DATA_LEVEL_THREE)));
-    dataMap.insert(std::pair<int, int>(
-        static_cast<int>(DataRange::DR_ONE_TO_FIVE_MB), static_cast<int>(DataConsumingLevel::DATA_LEVEL_FOUR)));
-    dataMap.insert(std::pair<int, int>(
-        static_cast<int>(DataRange::DR_FIVE_TO_TEN_MB), static_cast<int>(DataConsumingLevel::DATA_LEVEL_FIVE)));
-    dataMap.insert(std::pair<int, int>(
-        static_cast<int>(DataRange::DR_TEN_TO_FIFTY_MB), static_cast<int>(DataConsumingLevel::DATA_LEVEL_SIX)));
-    dataMap.insert(std::pair<int, int>(
-        static_cast<int>(DataRange::DR_OVER_FIFTY_MB), static_cast<int>(DataConsumingLevel::DATA_LEVEL_SEVEN)));
-    return dataMap;
-}
-
-std::map<int, int> HiViewAdapter::InitTimeMap()
-{
-    std::map<int, int> timeMap;
-    timeMap.insert(std::pair<int, int>(static_cast<int>(TimeConsumingStatistic::TCS_TIME_CONSUMING_LEVEL_ONE),
-        static_cast<int>(TimeConsumingLevel::TIME_LEVEL_ONE)));
-    timeMap.insert(std::pair<int, int>(static_cast<int>(TimeConsumingStatistic::TCS_TIME_CONSUMING_LEVEL_TWO),
-        static_cast<int>(TimeConsumingLevel::TIME_LEVEL_TWO)));
-    timeMap.insert(std::pair<int, int>(static_cast<int>(TimeConsumingStatistic::TCS_TIME_CONSUMING_LEVEL_THREE),
-        static_cast<int>(TimeConsumingLevel::TIME_LEVEL_THREE)));
-    timeMap.insert(std::pair<int, int>(static_cast<int>(TimeConsumingStatistic::TCS_TIME_CONSUMING_LEVEL_FOUR),
-        static_cast<int>(TimeConsumingLevel::TIME_LEVEL_FOUR)));
-    timeMap.insert(std::pair<int, int>(static_cast<int>(TimeConsumingStatistic::TCS_TIME_CONSUMING_LEVEL_FIVE),
-        static_cast<int>(TimeConsumingLevel::TIME_LEVEL_FIVE)));
-    timeMap.insert(std::pair<int, int>(static_cast<int>(TimeConsumingStatistic::TCS_TIME_CONSUMING_LEVEL_SIX),
-        static_cast<int>(TimeConsumingLevel::TIME_LEVEL_SIX)));
-    timeMap.insert(std::pair<int, int>(static_cast<int>(TimeConsumingStatistic::TCS_TIME_CONSUMING_LEVEL_SEVEN),
-        static_cast<int>(TimeConsumingLevel::TIME_LEVEL_SEVEN)));
-    timeMap.insert(std::pair<int, int>(static_cast<int>(TimeConsumingStatistic::TCS_TIME_CONSUMING_LEVEL_EIGHT),
-        static_cast<int>(TimeConsumingLevel::TIME_LEVEL_EIGHT)));
-    timeMap.insert(std::pair<int, int>(static_cast<int>(TimeConsumingStatistic::TCS_TIME_CONSUMING_LEVEL_NINE),
-        static_cast<int>(TimeConsumingLevel::TIME_LEVEL_NINE)));
-    timeMap.insert(std::pair<int, int>(static_cast<int>(TimeConsumingStatistic::TCS_TIME_CONSUMING_LEVEL_TEN),
-        static_cast<int>(TimeConsumingLevel::TIME_LEVEL_TEN)));
-    timeMap.insert(std::pair<int, int>(static_cast<int>(TimeConsumingStatistic::TCS_TIME_CONSUMING_LEVEL_ELEVEN),
-        static_cast<int>(TimeConsumingLevel::TIME_LEVEL_ELEVEN)));
-    return timeMap;
-}
-
 void HiViewAdapter::ReportPasteboardFault(int dfxCode, const PasteboardFaultMsg &msg)
 {
     HiSysEventParam params[] = {
@@ -114,137 +60,49 @@ void HiViewAdapter::ReportPasteboardFault(int dfxCode, const PasteboardFaultMsg
     }
 }
 
-void HiViewAdapter::InitializeTimeConsuming(int initFlag)
-{
-    constexpr const int DATA_LEVEL_NUMBERS = 7;
-    std::map<int, int> initTimeConsuming;
-    initTimeConsuming.insert(std::pair<int, int>(static_cast<int>(TimeConsumingLevel::TIME_LEVEL_ONE), 0));
-    initTimeConsuming.insert(std::pair<int, int>(static_cast<int>(TimeConsumingLevel::TIME_LEVEL_TWO), 0));
-    initTimeConsuming.insert(std::pair<int, int>(static_cast<int>(TimeConsumingLevel::TIME_LEVEL_THREE), 0));
-    initTimeConsuming.insert(std::pair<int, int>(static_cast<int>(TimeConsumingLevel::TIME_LEVEL_FOUR), 0));
-    initTimeConsuming.insert(std::pair<int, int>(static_cast<int>(TimeConsumingLevel::TIME_LEVEL_FIVE), 0));
-    initTimeConsuming.insert(std::pair<int, int>(static_cast<int>(TimeConsumingLevel::TIME_LEVEL_SIX), 0));
-    initTimeConsuming.insert(std::pair<int, int>(static_cast<int>(TimeConsumingLevel::TIME_LEVEL_SEVEN), 0));
-    initTimeConsuming.insert(std::pair<int, int>(static_cast<int>(TimeConsumingLevel::TIME_LEVEL_EIGHT), 0));
-    initTimeConsuming.insert(std::pair<int, int>(static_cast<int>(TimeConsumingLevel::TIME_LEVEL_NINE), 0));
-    initTimeConsuming.insert(std::pair<int, int>(static_cast<int>(TimeConsumingLevel::TIME_LEVEL_TEN), 0));
-    initTimeConsuming.insert(std::pair<int, int>(static_cast<int>(TimeConsumingLevel::TIME_LEVEL_ELEVEN), 0));
-
-    if (initFlag == INIT_COPY_TIME_CONSUMING) {
-        for (int i = 0; i < DATA_LEVEL_NUMBERS; ++i) {
-            copyTimeConsumingStat_.push_back(initTimeConsuming);
-        }
-    } else if (initFlag == INIT_PASTE_TIME_CONSUMING) {
-        for (int i = 0; i < DATA_LEVEL_NUMBERS; ++i) {
-            pasteTimeConsumingStat_.push_back(initTimeConsuming);
-        }
-    } else {
-        for (int i = 0; i < DATA_LEVEL_NUMBERS; ++i) {
-            remotePasteTimeConsumingStat_.push_back(initTimeConsuming);
-        }
-    }
-}
-
-void HiViewAdapter::ReportTimeConsumingStatistic(const TimeConsumingStat &stat)
+int HiViewAdapter::GetDataRange(int64_t dataSize)
 {
-    std::lock_guard<std::mutex> lock(timeConsumingMutex_);
-    if (copyTimeConsumingStat_.empty()) {
-        InitializeTimeConsuming(INIT_COPY_TIME_CONSUMING);
+    constexpr int64_t KB = 1024;
+    constexpr int64_t MB = 1024 * KB;
+    constexpr int64_t HUNDRED_KB = 100 * KB;
+    constexpr int64_t FIVE_HUNDREDS_KB = 500 * KB;
+    constexpr int64_t FIVE_MB = 5 * MB;
+    constexpr int64_t TEN_MB = 10 * MB;
+    constexpr int64_t FIFTY_MB = 50 * MB;
+    if (dataSize < HUNDRED_KB) {
+        return DataRange::DR_ZERO_TO_HUNDRED_KB;
     }
-    if (pasteTimeConsumingStat_.empty()) {
-        InitializeTimeConsuming(INIT_PASTE_TIME_CONSUMING);
+    if (dataSize < FIVE_HUNDREDS_KB) {
+        return DataRange::DR_HUNDRED_TO_FIVE_HUNDREDS_KB;
     }
-    if (remotePasteTimeConsumingStat_.empty()) {
-        InitializeTimeConsuming(INIT_REMOTE_PASTE_TIME_CONSUMING);
+    if (dataSize < MB) {
+        return DataRange::DR_FIVE_HUNDREDS_TO_THOUSAND_KB;
     }
-
-    if (stat.pasteboardState == static_cast<int>(StatisticPasteboardState::SPS_COPY_STATE)) {
-        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "hisysevent pasteboard state is %{public}d", stat.pasteboardState);
-        auto iter = dataMap_.find(stat.dataSize);
-        if (iter != dataMap_.end()) {
-            CopyTimeConsuming(stat, iter->second);
-        } else {
-            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "wrong data level");
-        }
-    } else if ((stat.pasteboardState == static_cast<int>(StatisticPasteboardState::SPS_PASTE_STATE)) ||
-               (stat.pasteboardState == static_cast<int>(StatisticPasteboardState::SPS_REMOTE_PASTE_STATE))) {
-        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "hisysevent pasteboard state is %{public}d", stat.pasteboardState);
-        auto iter = dataMap_.find(stat.dataSize);
-        if (iter != dataMap_.end()) {
-            PasteTimeConsuming(stat, iter->second);
-        } else {
-            PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "wrong data level");
-        }
-    } else {
-        PASTEBOARD_HILOGE(
-            PASTEBOARD_MODULE_SERVICE, "hisysevent wrong pasteboard state! errCode %{public}d", stat.pasteboardState);
+    if (dataSize < FIVE_MB) {
+        return DataRange::DR_ONE_TO_FIVE_MB;
     }
-}
-
-void HiViewAdapter::CopyTimeConsumingCount(int dataLevel, int timeLevel)
-{
-    if (static_cast<int>(copyTimeConsumingStat_.size()) <= dataLevel) {
-        return;
+    if (dataSize < TEN_MB) {
+        return DataRange::DR_FIVE_TO_TEN_MB;
     }
-    auto it = copyTimeConsumingStat_[dataLevel].find(timeLevel);
-    if (it != copyTimeConsumingStat_[dataLevel].end()) {
-        (it->second)++;
-    } else {
-        PASTEBOARD_HILOGE(
-            PASTEBOARD_MODULE_SERVICE, "hisysevent wrong copy time level, time level:  %{public}d", timeLevel);
+    if (dataSize < FIFTY_MB) {
+        return DataRange::DR_TEN_TO_FIFTY_MB;
     }
+    return DataRange::DR_OVER_FIFTY_MB;
 }
 
-void HiViewAdapter::PasteTimeConsumingCount(int dataLevel, int timeLevel)
+void HiViewAdapter::ReportTimeConsumingStatistic(const TimeConsumingStat &stat)
 {
-    if (static_cast<int>(pasteTimeConsumingStat_.size()) <= dataLevel) {
-        return;
-    }
-    auto it = pasteTimeConsumingStat_[dataLevel].find(timeLevel);
-    if (it != pasteTimeConsumingStat_[dataLevel].end()) {
-        (it->second)++;
-    } else {
+    if (stat.pasteboardState < 0 || stat.pasteboardState >= StatisticPasteboardState::SPS_INVALID_STATE) {
         PASTEBOARD_HILOGE(
-            PASTEBOARD_MODULE_SERVICE, "hisysevent wrong copy time level, time level:  %{public}d", timeLevel);
-    }
-}
-
-void HiViewAdapter::RemotePasteTimeConsumingCount(int dataLevel, int timeLevel)
-{
-    if (static_cast<int>(remotePasteTimeConsumingStat_.size()) <= dataLevel) {
+            PASTEBOARD_MODULE_SERVICE, "hisysevent wrong pasteboard state! errCode %{public}d", stat.pasteboardState);
         return;
     }
-    auto it = remotePasteTimeConsumingStat_[dataLevel].find(timeLevel);
-    if (it != remotePasteTimeConsumingStat_[dataLevel].end()) {
-        (it->second)++;
-    } else {
-        PASTEBOARD_HILOGD(
-            PASTEBOARD_MODULE_SERVICE, "hisysevent wrong copy time level, time level:  %{public}d", timeLevel);
-    }
-}
-
-void HiViewAdapter::CopyTimeConsuming(const TimeConsumingStat &stat, int level)
-{
-    auto iter = timeMap_.find(stat.timeConsuming);
-    if (iter != timeMap_.end()) {
-        CopyTimeConsumingCount(level, iter->second);
-    } else {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "wrong time level");
-    }
-}
-
-void HiViewAdapter::PasteTimeConsuming(const TimeConsumingStat &stat, int level)
-{
-    auto iter = timeMap_.find(stat.timeConsuming);
-    if (iter != timeMap_.end()) {
-        if (stat.pasteboardState == SPS_PASTE_STATE) {
-            PasteTimeConsumingCount(level, iter->second);
-        } else {
-            RemotePasteTimeConsumingCount(level, iter->second);
-        }
-    } else {
-        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "wrong time level");
+    if (stat.dataSize < 0 || stat.timeConsuming < 0) {
+        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "wrong data size or time consuming");
+        return;
     }
+    timeConsumingStat_[stat.pasteboardState][GetDataRange(stat.dataSize)].Record(
+        static_cast<uint64_t>(stat.timeConsuming));
 }
 
 void HiViewAdapter::ReportPasteboardBehaviour(const PasteboardBehaviourMsg &msg)
@@ -282,25 +140,25 @@ const char *HiViewAdapter::GetDataLevel(int dataLevel)
 {
     constexpr const char *WRONG_LEVEL = "WRONG_LEVEL";
     switch (dataLevel) {
-        case static_cast<int>(DataConsumingLevel::DATA_LEVEL_ONE): {
+        case DataRange::DR_ZERO_TO_HUNDRED_KB: {
             return ZERO_TO_HUNDRED_KB;
         }
-        case static_cast<int>(DataConsumingLevel::DATA_LEVEL_TWO): {
+        case DataRange::DR_HUNDRED_TO_FIVE_HUNDREDS_KB: {
             return HUNDRED_TO_FIVE_HUNDREDS_KB;
         }
-        case static_cast<int>(DataConsumingLevel::DATA_LEVEL_THREE): {
+        case DataRange::DR_FIVE_HUNDREDS_TO_THOUSAND_KB: {
             return FIVE_HUNDREDS_TO_THOUSAND_KB;
         }
-        case static_cast<int>(DataConsumingLevel::DATA_LEVEL_FOUR): {
+        case DataRange::DR_ONE_TO_FIVE_MB: {
             return ONE_TO_FIVE_MB;
         }
-        case static_cast<int>(DataConsumingLevel::DATA_LEVEL_FIVE): {
+        case DataRange::DR_FIVE_TO_TEN_MB: {
             return FIVE_TO_TEN_MB;
         }
-        case static_cast<int>(DataConsumingLevel::DATA_LEVEL_SIX): {
+        case DataRange::DR_TEN_TO_FIFTY_MB: {
             return TEN_TO_FIFTY_MB;
         }
-        case static_cast<int>(DataConsumingLevel::DATA_LEVEL_SEVEN): {
+        case DataRange::DR_OVER_FIFTY_MB: {
             return OVER_FIFTY_MB;
         }
         default: {
@@ -309,62 +167,108 @@ const char *HiViewAdapter::GetDataLevel(int dataLevel)
     }
 }
 
-void HiViewAdapter::InvokeTimeConsuming()
+const char *HiViewAdapter::GetPasteboardState(int pasteboardState)
 {
-    std::lock_guard<std::mutex> lock(timeConsumingMutex_);
-    ReportStatisticEvent(copyTimeConsumingStat_, COPY_STATE);
-    copyTimeConsumingStat_.clear();
-    ReportStatisticEvent(pasteTimeConsumingStat_, PASTE_STATE);
-    pasteTimeConsumingStat_.clear();
-    ReportStatisticEvent(remotePasteTimeConsumingStat_, REMOTE_PASTE_STATE);
-    remotePasteTimeConsumingStat_.clear();
+    constexpr const char *WRONG_STATE = "WRONG_STATE";
+    switch (pasteboardState) {
+        case StatisticPasteboardState::SPS_COPY_STATE:
+            return COPY_STATE;
+        case StatisticPasteboardState::SPS_PASTE_STATE:
+            return PASTE_STATE;
+        case StatisticPasteboardState::SPS_REMOTE_PASTE_STATE:
+            return REMOTE_PASTE_STATE;
+        case StatisticPasteboardState::SPS_GET_ENTRY_STATE:
+            return GET_ENTRY_STATE;
+        case StatisticPasteboardState::SPS_DETECT_PATTERNS_STATE:
+            return DETECT_PATTERNS_STATE;
+        default:
+            return WRONG_STATE;
+    }
 }
 
-void HiViewAdapter::ReportStatisticEvent(
-    const std::vector<std::map<int, int>> &timeConsumingStat, const std::string &pasteboardState)
+void HiViewAdapter::InvokeTimeConsuming()
 {
-    if (timeConsumingStat.empty()) {
-        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "hisysevent timeConsumingStat is empty.");
-        return;
-    }
-    for (std::int32_t i = 0; i < static_cast<int>(timeConsumingStat.size()); ++i) {
-        std::string buffMsg = ": [";
-        for (std::int32_t j = TimeConsumingLevel::TIME_LEVEL_ONE; j <= TimeConsumingLevel::TIME_LEVEL_ELEVEN; ++j) {
-            buffMsg = buffMsg + std::to_string(timeConsumingStat[i].at(j)) + ",";
+    for (int state = 0; state < StatisticPasteboardState::SPS_INVALID_STATE; ++state) {
+        for (int level = 0; level < DataRange::DR_BUTT; ++level) {
+            auto summary = timeConsumingStat_[state][level].TakeSummary();
+            if (summary.count == 0) {
+                continue;
+            }
+            ReportStatisticEvent(state, level, summary);
         }
-        buffMsg += "]";
+    }
+}
 
-        int ret = -1;
-        if (pasteboardState == REMOTE_PASTE_STATE) {
-            std::string netType = "WIFI";
-            HiSysEventParam params[] = {
-                {.name = {"PASTEBOARD_STATE"}, .t = HISYSEVENT_STRING, .v = { .s = (char *)pasteboardState.c_str()},
-                    .arraySize = 0, },
-                {.name = {"NET_TYPE"}, .t = HISYSEVENT_STRING, .v = { .s = (char *)netType.c_str()}, .arraySize = 0, },
-                {.name = {"DATA_LEVEL"}, .t = HISYSEVENT_STRING, .v = { .s = (char *)GetDataLevel(i)}, .arraySize = 0},
-                {.name = {"CONSUMING_DATA"}, .t = HISYSEVENT_STRING, .v = { .s = (char *)buffMsg.c_str()},
-                    .arraySize = 0, },
-            };
-            size_t len = sizeof(params) / sizeof(params[0]);
-            ret = OH_HiSysEvent_Write(PASTEBOARD_DOMAIN,
-                CoverEventID(DfxCodeConstant::TIME_CONSUMING_STATISTIC).c_str(), HISYSEVENT_STATISTIC, params, len);
-        } else {
-            HiSysEventParam params[] = {
-                {.name = {"PASTEBOARD_STATE"}, .t = HISYSEVENT_STRING, .v = { .s = (char *)pasteboardState.c_str()},
-                    .arraySize = 0, },
-                {.name = {"DATA_LEVEL"}, .t = HISYSEVENT_STRING, .v = { .s = (char *)GetDataLevel(i)}, .arraySize = 0},
-                {.name = {"CONSUMING_DATA"}, .t = HISYSEVENT_STRING, .v = { .s = (char *)buffMsg.c_str()},
-                    .arraySize = 0, },
-            };
-            size_t len = sizeof(params) / sizeof(params[0]);
-            ret = OH_HiSysEvent_Write(PASTEBOARD_DOMAIN,
-                CoverEventID(DfxCodeConstant::TIME_CONSUMING_STATISTIC).c_str(), HISYSEVENT_STATISTIC, params, len);
-        }
-        if (ret != HiviewDFX::SUCCESS) {
-            PASTEBOARD_HILOGD(
-                PASTEBOARD_MODULE_SERVICE, "hisysevent write failed! ret = %{public}d, i = %{public}d.", ret, i);
+std::string HiViewAdapter::DumpTimeConsumingStatistic()
+{
+    std::string result;
+    for (int state = 0; state < StatisticPasteboardState::SPS_INVALID_STATE; ++state) {
+        for (int level = 0; level < DataRange::DR_BUTT; ++level) {
+            auto summary = timeConsumingStat_[state][level].GetSummary();
+            if (summary.count == 0) {
+                continue;
+            }
+            result.append("|")
+                .append(GetPasteboardState(state))
+                .append(" ")
+                .append(GetDataLevel(level))
+                .append(":  count ")
+                .append(std::to_string(summary.count))
+                .append(", p50 ")
+                .append(std::to_string(summary.p50))
+                .append("us, p90 ")
+                .append(std::to_string(summary.p90))
+                .append("us, p99 ")
+                .append(std::to_string(summary.p99))
+                .append("us, max ")
+                .append(std::to_string(summary.max))
+                .append("us\n");
         }
     }
+    return result.empty() ? "|No latency recorded since the last daily report\n" : result;
+}
+
+std::string HiViewAdapter::FormatConsumingData(const LatencyHistogram::Summary &summary)
+{
+    return "count:" + std::to_string(summary.count) + ",p50:" + std::to_string(summary.p50) +
+        ",p90:" + std::to_string(summary.p90) + ",p99:" + std::to_string(summary.p99) +
+        ",max:" + std::to_string(summary.max);
+}
+
+void HiViewAdapter::ReportStatisticEvent(int pasteboardState, int dataLevel, const LatencyHistogram::Summary &summary)
+{
+    std::string consumingData = FormatConsumingData(summary);
+    const char *state = GetPasteboardState(pasteboardState);
+    int ret = -1;
+    if (pasteboardState == StatisticPasteboardState::SPS_REMOTE_PASTE_STATE) {
+        std::string netType = "WIFI";
+        HiSysEventParam params[] = {
+            {.name = {"PASTEBOARD_STATE"}, .t = HISYSEVENT_STRING, .v = { .s = (char *)state}, .arraySize = 0, },
+            {.name = {"NET_TYPE"}, .t = HISYSEVENT_STRING, .v = { .s = (char *)netType.c_str()}, .arraySize = 0, },
+            {.name = {"DATA_LEVEL"}, .t = HISYSEVENT_STRING, .v = { .s = (char *)GetDataLevel(dataLevel)},
+                .arraySize = 0},
+            {.name = {"CONSUMING_DATA"}, .t = HISYSEVENT_STRING, .v = { .s = (char *)consumingData.c_str()},
+                .arraySize = 0, },
+        };
+        size_t len = sizeof(params) / sizeof(params[0]);
+        ret = OH_HiSysEvent_Write(PASTEBOARD_DOMAIN,
+            CoverEventID(DfxCodeConstant::TIME_CONSUMING_STATISTIC).c_str(), HISYSEVENT_STATISTIC, params, len);
+    } else {
+        HiSysEventParam params[] = {
+            {.name = {"PASTEBOARD_STATE"}, .t = HISYSEVENT_STRING, .v = { .s = (char *)state}, .arraySize = 0, },
+            {.name = {"DATA_LEVEL"}, .t = HISYSEVENT_STRING, .v = { .s = (char *)GetDataLevel(dataLevel)},
+                .arraySize = 0},
+            {.name = {"CONSUMING_DATA"}, .t = HISYSEVENT_STRING, .v = { .s = (char *)consumingData.c_str()},
+                .arraySize = 0, },
+        };
+        size_t len = sizeof(params) / sizeof(params[0]);
+        ret = OH_HiSysEvent_Write(PASTEBOARD_DOMAIN,
+            CoverEventID(DfxCodeConstant::TIME_CONSUMING_STATISTIC).c_str(), HISYSEVENT_STATISTIC, params, len);
+    }
+    if (ret != HiviewDFX::SUCCESS) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "hisysevent write failed! ret = %{public}d, state = %{public}s.",
+            ret, state);
+    }
 }
 
 void HiViewAdapter::ReportBehaviour(std::map<std::string, int> &behaviour, const char *pasteboardState)
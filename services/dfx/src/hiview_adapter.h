@@ -19,33 +19,11 @@
 #include "dfx_code_constant.h"
 #include "dfx_types.h"
 #include "hisysevent_c.h"
+#include "latency_histogram.h"
 #include "paste_data.h"
 
 namespace OHOS {
 namespace MiscServices {
-enum DataConsumingLevel : std::int32_t {
-    DATA_LEVEL_ONE = 0,
-    DATA_LEVEL_TWO,
-    DATA_LEVEL_THREE,
-    DATA_LEVEL_FOUR,
-    DATA_LEVEL_FIVE,
-    DATA_LEVEL_SIX,
-    DATA_LEVEL_SEVEN,
-};
-enum TimeConsumingLevel : std::int32_t {
-    TIME_LEVEL_ONE = 0,
-    TIME_LEVEL_TWO,
-    TIME_LEVEL_THREE,
-    TIME_LEVEL_FOUR,
-    TIME_LEVEL_FIVE,
-    TIME_LEVEL_SIX,
-    TIME_LEVEL_SEVEN,
-    TIME_LEVEL_EIGHT,
-    TIME_LEVEL_NINE,
-    TIME_LEVEL_TEN,
-    TIME_LEVEL_ELEVEN,
-};
-
 class API_EXPORT HiViewAdapter {
 public:
     ~HiViewAdapter();
@@ -59,38 +37,29 @@ public:
     static void ReportTimeConsumingStatistic(const TimeConsumingStat &stat);
     static void ReportPasteboardBehaviour(const PasteboardBehaviourMsg &msg);
     static void StartTimerThread();
-    static std::map<int, int> InitDataMap();
-    static std::map<int, int> InitTimeMap();
+    static std::string DumpTimeConsumingStatistic();
+    // the CONSUMING_DATA of TIME_CONSUMING_STATISTIC: "count:N,p50:N,p90:N,p99:N,max:N", the latencies in us
+    static std::string FormatConsumingData(const LatencyHistogram::Summary &summary);
 
     static void ReportUseBehaviour(PasteData &pastData, const char *state, int32_t result);
 
 private:
     static void InvokePasteBoardBehaviour();
-    static void InitializeTimeConsuming(int initFlag);
-    static void CopyTimeConsumingCount(int dataLevel, int timeLevel);
-    static void PasteTimeConsumingCount(int dataLevel, int timeLevel);
-    static void RemotePasteTimeConsumingCount(int dataLevel, int timeLevel);
-    static void CopyTimeConsuming(const TimeConsumingStat &stat, int level);
-    static void PasteTimeConsuming(const TimeConsumingStat &stat, int level);
+    static int GetDataRange(int64_t dataSize);
+    static const char *GetPasteboardState(int pasteboardState);
     static const char *GetDataLevel(int dataLevel);
     static void InvokeTimeConsuming();
     static void ReportBehaviour(std::map<std::string, int> &behaviour, const char *statePasteboard);
-    static void ReportStatisticEvent(
-        const std::vector<std::map<int, int>> &timeConsumingStat, const std::string &pasteboardState);
+    static void ReportStatisticEvent(int pasteboardState, int dataLevel, const LatencyHistogram::Summary &summary);
 
-    static std::mutex timeConsumingMutex_;
-    static std::vector<std::map<int, int>> copyTimeConsumingStat_;
-    static std::vector<std::map<int, int>> pasteTimeConsumingStat_;
-    static std::vector<std::map<int, int>> remotePasteTimeConsumingStat_;
+    // p50/p90/p99/max latency of every pasteboard operation by data size, taken by the daily report
+    static std::array<std::array<LatencyHistogram, DR_BUTT>, SPS_INVALID_STATE> timeConsumingStat_;
 
     static std::mutex behaviourMutex_;
     static std::map<std::string, int> copyPasteboardBehaviour_;
     static std::map<std::string, int> pastePasteboardBehaviour_;
     static std::map<std::string, int> remotePastePasteboardBehaviour_;
 
-    static std::map<int, int> dataMap_;
-    static std::map<int, int> timeMap_;
-
     static std::string CoverEventID(int dfxCode);
 
 private:
@@ -127,6 +96,8 @@ private:
     static inline const char *TOP_TEN_APP = "TOP_TEN_APP";
 
     static inline constexpr const char *REMOTE_PASTE_STATE = "REMOTE_PASTE_STATE";
+    static inline constexpr const char *GET_ENTRY_STATE = "GET_ENTRY_STATE";
+    static inline constexpr const char *DETECT_PATTERNS_STATE = "DETECT_PATTERNS_STATE";
 
     // use behaviour key
     static inline const char *BOOTTIME = "BOOTTIME";
@@ -137,10 +108,6 @@ private:
     static inline const char *ISLOCALPASTE = "ISLOCALPASTE";
     static inline const char *ISREMOTE = "ISREMOTE";
     static inline const char *SHAREOPTION = "SHAREOPTION";
-
-    static inline const int INIT_COPY_TIME_CONSUMING = 7;
-    static inline const int INIT_PASTE_TIME_CONSUMING = 8;
-    static inline constexpr const int INIT_REMOTE_PASTE_TIME_CONSUMING = 9;
 };
 } // namespace MiscServices
 } // namespace OHOS
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISTRIBUTEDDATAMGR_PASTEBOARD_LATENCY_HISTOGRAM_H
+#define DISTRIBUTEDDATAMGR_PASTEBOARD_LATENCY_HISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace OHOS {
+namespace MiscServices {
+/*
+ * Lock-free log-linear histogram of microsecond latencies. Every power of two is split into SUB_BUCKET_COUNT
+ * linear buckets, so a percentile is off by at most 1/SUB_BUCKET_COUNT of its value. Values beyond MAX_GROUP
+ * octaves (about 70 minutes) fall into the last bucket.
+ */
+class LatencyHistogram {
+public:
+    struct Summary {
+        uint64_t count = 0;
+        uint64_t p50 = 0;
+        uint64_t p90 = 0;
+        uint64_t p99 = 0;
+        uint64_t max = 0;
+    };
+    static constexpr uint32_t SUB_BUCKET_BITS = 3;
+    static constexpr uint32_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static constexpr uint32_t MAX_GROUP = 30;
+    static constexpr uint32_t BUCKET_COUNT = MAX_GROUP * SUB_BUCKET_COUNT;
+
+    void Record(uint64_t latencyUs)
+    {
+        buckets_[GetBucketIndex(latencyUs)].fetch_add(1, std::memory_order_relaxed);
+        uint64_t max = max_.load(std::memory_order_relaxed);
+        while (latencyUs > max && !max_.compare_exchange_weak(max, latencyUs, std::memory_order_relaxed)) {
+        }
+    }
+
+    Summary GetSummary() const
+    {
+        std::array<uint64_t, BUCKET_COUNT> counts{};
+        for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+            counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        }
+        return Summarize(counts, max_.load(std::memory_order_relaxed));
+    }
+
+    // Values recorded while taking are either in the returned summary or left for the next one.
+    Summary TakeSummary()
+    {
+        std::array<uint64_t, BUCKET_COUNT> counts{};
+        for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+            counts[i] = buckets_[i].exchange(0, std::memory_order_relaxed);
+        }
+        return Summarize(counts, max_.exchange(0, std::memory_order_relaxed));
+    }
+
+    static uint32_t GetBucketIndex(uint64_t value)
+    {
+        if (value < SUB_BUCKET_COUNT) {
+            return static_cast<uint32_t>(value);
+        }
+        uint32_t msb = static_cast<uint32_t>(63 - __builtin_clzll(value)); // 63: index of the highest bit
+        uint32_t group = msb - SUB_BUCKET_BITS + 1;
+        if (group >= MAX_GROUP) {
+            return BUCKET_COUNT - 1;
+        }
+        uint32_t sub = static_cast<uint32_t>(value >> (msb - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1);
+        return group * SUB_BUCKET_COUNT + sub;
+    }
+
+    static uint64_t GetBucketUpperBound(uint32_t index)
+    {
+        uint32_t group = index / SUB_BUCKET_COUNT;
+        uint64_t sub = index % SUB_BUCKET_COUNT;
+        if (group == 0) {
+            return sub;
+        }
+        uint64_t width = 1ULL << (group - 1);
+        return (SUB_BUCKET_COUNT + sub) * width + width - 1;
+    }
+
+private:
+    static Summary Summarize(const std::array<uint64_t, BUCKET_COUNT> &counts, uint64_t max)
+    {
+        constexpr uint64_t P50 = 50;
+        constexpr uint64_t P90 = 90;
+        constexpr uint64_t P99 = 99;
+        Summary summary;
+        for (auto count : counts) {
+            summary.count += count;
+        }
+        if (summary.count == 0) {
+            return summary;
+        }
+        summary.max = max;
+        summary.p50 = GetPercentile(counts, summary.count, P50, max);
+        summary.p90 = GetPercentile(counts, summary.count, P90, max);
+        summary.p99 = GetPercentile(counts, summary.count, P99, max);
+        return summary;
+    }
+
+    static uint64_t GetPercentile(const std::array<uint64_t, BUCKET_COUNT> &counts, uint64_t total,
+        uint64_t percentile, uint64_t max)
+    {
+        constexpr uint64_t HUNDRED = 100;
+        uint64_t rank = std::max<uint64_t>((total * percentile + HUNDRED - 1) / HUNDRED, 1);
+        uint64_t seen = 0;
+        for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                uint64_t bound = GetBucketUpperBound(i);
+                return max > 0 ? std::min(bound, max) : bound;
+            }
+        }
+        return max;
+    }
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_{};
+    std::atomic<uint64_t> max_ = 0;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // DISTRIBUTEDDATAMGR_PASTEBOARD_LATENCY_HISTOGRAM_H
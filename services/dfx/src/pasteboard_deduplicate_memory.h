@@ -16,81 +16,131 @@
 #ifndef DISTRIBUTEDDATAMGR_PASTEBOARD_DEDUPLICATE_MEMORY_H
 #define DISTRIBUTEDDATAMGR_PASTEBOARD_DEDUPLICATE_MEMORY_H
 
-#include "pasteboard_linked_list.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 
 namespace OHOS {
 namespace MiscServices {
+template <typename T, typename = void>
+struct HasStdHash : std::false_type {};
 
 template <typename T>
+struct HasStdHash<T, std::void_t<decltype(std::hash<T>{}(std::declval<const T &>()))>> : std::true_type {};
+
+/*
+ * std::hash when T has one, otherwise the bytes of T, which is only allowed when equal values have equal bytes,
+ * as for the plain structs of integers remembered by the reporters.
+ */
+template <typename T>
+struct DeduplicateHash {
+    size_t operator()(const T &data) const
+    {
+        if constexpr (HasStdHash<T>::value) {
+            return std::hash<T>{}(data);
+        } else {
+            static_assert(std::has_unique_object_representations_v<T>, "T needs std::hash");
+            constexpr uint64_t fnvOffsetBasis = 14695981039346656037ULL;
+            constexpr uint64_t fnvPrime = 1099511628211ULL;
+            uint64_t hash = fnvOffsetBasis;
+            auto bytes = reinterpret_cast<const uint8_t *>(&data);
+            for (size_t i = 0; i < sizeof(T); ++i) {
+                hash = (hash ^ bytes[i]) * fnvPrime;
+            }
+            return static_cast<size_t>(hash);
+        }
+    }
+};
+
+/*
+ * Remembers each value for expirationMilliSeconds after it is first seen. The values are spread over stripes by
+ * hash, each a hash map for the lookup and a queue in insertion order for the expiry, under a lock of its own.
+ */
+template <typename T, typename Hash = DeduplicateHash<T>>
 class DeduplicateMemory {
 public:
     explicit DeduplicateMemory(int64_t expirationMilliSeconds);
     ~DeduplicateMemory();
     bool IsDuplicate(const T &data);
+    size_t Size();
 
 private:
-    int64_t GetTimestamp();
-    void ClearExpiration();
-    bool FindExist(const T &data);
+    static constexpr size_t STRIPE_COUNT = 16;
 
-    struct MemoryIdentity {
-        int64_t timestamp;
-        const T data;
+    struct Stripe {
+        std::mutex mutex;
+        std::unordered_map<T, int64_t, Hash> timestamps;
+        std::deque<std::pair<int64_t, T>> expiry;
     };
 
-    LinkedList<MemoryIdentity> memory_;
+    int64_t GetTimestamp();
+    void ClearExpiration(Stripe &stripe, int64_t timestamp);
+
+    std::array<Stripe, STRIPE_COUNT> stripes_;
+    Hash hash_;
     int64_t expirationMS_;
 };
 
-template <typename T>
-DeduplicateMemory<T>::DeduplicateMemory(int64_t expirationMilliSeconds) : expirationMS_(expirationMilliSeconds)
+template <typename T, typename Hash>
+DeduplicateMemory<T, Hash>::DeduplicateMemory(int64_t expirationMilliSeconds) : expirationMS_(expirationMilliSeconds)
 {
 }
 
-template <typename T>
-DeduplicateMemory<T>::~DeduplicateMemory()
+template <typename T, typename Hash>
+DeduplicateMemory<T, Hash>::~DeduplicateMemory()
 {
-    memory_.Clear();
 }
 
-template <typename T>
-bool DeduplicateMemory<T>::IsDuplicate(const T &data)
+template <typename T, typename Hash>
+bool DeduplicateMemory<T, Hash>::IsDuplicate(const T &data)
 {
-    ClearExpiration();
-    if (FindExist(data)) {
+    auto &stripe = stripes_[hash_(data) % STRIPE_COUNT];
+    int64_t timestamp = GetTimestamp();
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    ClearExpiration(stripe, timestamp);
+    if (!stripe.timestamps.emplace(data, timestamp).second) {
         return true;
     }
-    int64_t timestamp = GetTimestamp();
-    memory_.InsertFront(MemoryIdentity({.timestamp = timestamp, .data = data}));
+    stripe.expiry.emplace_back(timestamp, data);
     return false;
 }
 
-template <typename T>
-bool DeduplicateMemory<T>::FindExist(const T &data)
+template <typename T, typename Hash>
+size_t DeduplicateMemory<T, Hash>::Size()
 {
-    return memory_.FindExist([data](const MemoryIdentity &identity) {
-        return identity.data == data;
-    });
+    size_t size = 0;
+    for (auto &stripe : stripes_) {
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        size += stripe.timestamps.size();
+    }
+    return size;
 }
 
-template <typename T>
-int64_t DeduplicateMemory<T>::GetTimestamp()
+template <typename T, typename Hash>
+int64_t DeduplicateMemory<T, Hash>::GetTimestamp()
 {
     return std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
-template <typename T>
-void DeduplicateMemory<T>::ClearExpiration()
+template <typename T, typename Hash>
+void DeduplicateMemory<T, Hash>::ClearExpiration(Stripe &stripe, int64_t timestamp)
 {
-    int64_t timestamp = GetTimestamp();
     if (timestamp < expirationMS_) {
         return;
     }
+    // a value is queued once, when first seen, so the queue is in the order of the remembered timestamps
     int64_t expirationTimestamp = timestamp - expirationMS_;
-    memory_.RemoveIf([expirationTimestamp](const MemoryIdentity &identity) {
-        return expirationTimestamp > identity.timestamp;
-    });
+    while (!stripe.expiry.empty() && expirationTimestamp > stripe.expiry.front().first) {
+        stripe.timestamps.erase(stripe.expiry.front().second);
+        stripe.expiry.pop_front();
+    }
 }
 } // namespace MiscServices
 } // namespace OHOS
@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pasteboard_perf_stat.h"
+
+#include <algorithm>
+#include <ctime>
+
+namespace OHOS {
+namespace MiscServices {
+namespace {
+struct CallContext {
+    bool active = false;
+    uint32_t code = 0;
+    int32_t pid = 0;
+    std::chrono::steady_clock::time_point start;
+    std::array<uint64_t, PasteboardPerfStat::STAGE_BUTT> stageUs{};
+};
+thread_local CallContext g_callContext;
+thread_local PerfStageTimer *g_stageTimer = nullptr;
+} // namespace
+
+std::string PasteboardPerfStat::FormatWallTime(int64_t wallTimeMs)
+{
+    constexpr int64_t MS_PER_SECOND = 1000;
+    constexpr size_t TIME_BUFFER_SIZE = 32;
+    constexpr size_t MILLIS_WIDTH = 3;
+    time_t seconds = static_cast<time_t>(wallTimeMs / MS_PER_SECOND);
+    struct tm localTime = {};
+    localtime_r(&seconds, &localTime);
+    char buffer[TIME_BUFFER_SIZE] = { 0 };
+    if (strftime(buffer, sizeof(buffer), "%m-%d %H:%M:%S", &localTime) == 0) {
+        return std::to_string(wallTimeMs);
+    }
+    std::string millis = std::to_string(wallTimeMs % MS_PER_SECOND);
+    return std::string(buffer) + "." + std::string(MILLIS_WIDTH - std::min(millis.size(), MILLIS_WIDTH), '0') + millis;
+}
+
+PasteboardPerfStat &PasteboardPerfStat::GetInstance()
+{
+    static PasteboardPerfStat instance;
+    return instance;
+}
+
+void PasteboardPerfStat::BeginCall(uint32_t code, int32_t pid)
+{
+    g_callContext.active = true;
+    g_callContext.code = code;
+    g_callContext.pid = pid;
+    g_callContext.stageUs.fill(0);
+    g_callContext.start = std::chrono::steady_clock::now();
+}
+
+void PasteboardPerfStat::EndCall(uint32_t code, int32_t result)
+{
+    if (!g_callContext.active || g_callContext.code != code) {
+        return;
+    }
+    g_callContext.active = false;
+    auto cost = std::chrono::steady_clock::now() - g_callContext.start;
+    auto costUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(cost).count());
+    auto entry = GetEntry(code);
+    if (entry != nullptr) {
+        entry->latency.Record(costUs);
+        if (result != 0) {
+            entry->failed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (costUs < slowFloorUs_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    SlowOp op;
+    op.code = code;
+    op.result = result;
+    op.pid = g_callContext.pid;
+    op.wallTimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    op.totalUs = costUs;
+    op.stageUs = g_callContext.stageUs;
+    AddSlowOp(op);
+}
+
+void PasteboardPerfStat::AddStageTime(Stage stage, uint64_t costUs)
+{
+    if (!g_callContext.active || stage >= STAGE_BUTT) {
+        return;
+    }
+    g_callContext.stageUs[stage] += costUs;
+}
+
+PasteboardPerfStat::CallEntry *PasteboardPerfStat::GetEntry(uint32_t code)
+{
+    if (code == INVALID_CODE) {
+        return nullptr;
+    }
+    // open addressing, a slot is claimed once by the first call of a code and never released
+    for (size_t i = 0; i < MAX_CALL_CODES; ++i) {
+        auto &entry = entries_[(code + i) % MAX_CALL_CODES];
+        uint32_t current = entry.code.load(std::memory_order_acquire);
+        if (current == code) {
+            return &entry;
+        }
+        if (current == INVALID_CODE &&
+            (entry.code.compare_exchange_strong(current, code, std::memory_order_acq_rel) || current == code)) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+void PasteboardPerfStat::AddSlowOp(const SlowOp &op)
+{
+    std::lock_guard<std::mutex> lock(slowMutex_);
+    auto pos = std::upper_bound(slowOps_.begin(), slowOps_.end(), op, [](const SlowOp &lhs, const SlowOp &rhs) {
+        return lhs.totalUs > rhs.totalUs;
+    });
+    slowOps_.insert(pos, op);
+    if (slowOps_.size() > MAX_SLOW_OPS) {
+        slowOps_.pop_back();
+    }
+    if (slowOps_.size() == MAX_SLOW_OPS) {
+        slowFloorUs_.store(std::max(SLOW_OP_THRESHOLD_US, slowOps_.back().totalUs), std::memory_order_relaxed);
+    }
+}
+
+std::vector<PasteboardPerfStat::CallStat> PasteboardPerfStat::GetCallStats() const
+{
+    std::vector<CallStat> stats;
+    for (const auto &entry : entries_) {
+        uint32_t code = entry.code.load(std::memory_order_acquire);
+        if (code == INVALID_CODE) {
+            continue;
+        }
+        CallStat stat;
+        stat.code = code;
+        stat.failed = entry.failed.load(std::memory_order_relaxed);
+        stat.latency = entry.latency.GetSummary();
+        stats.push_back(stat);
+    }
+    std::sort(stats.begin(), stats.end(), [](const CallStat &lhs, const CallStat &rhs) {
+        return lhs.code < rhs.code;
+    });
+    return stats;
+}
+
+std::vector<PasteboardPerfStat::SlowOp> PasteboardPerfStat::GetSlowOps() const
+{
+    std::lock_guard<std::mutex> lock(slowMutex_);
+    return slowOps_;
+}
+
+std::string PasteboardPerfStat::DumpCallStats() const
+{
+    std::string result;
+    for (const auto &stat : GetCallStats()) {
+        if (stat.latency.count == 0) {
+            continue;
+        }
+        result.append("|cmd ")
+            .append(std::to_string(stat.code))
+            .append(":  count ")
+            .append(std::to_string(stat.latency.count))
+            .append(", failed ")
+            .append(std::to_string(stat.failed))
+            .append(", p50 ")
+            .append(std::to_string(stat.latency.p50))
+            .append("us, p90 ")
+            .append(std::to_string(stat.latency.p90))
+            .append("us, p99 ")
+            .append(std::to_string(stat.latency.p99))
+            .append("us, max ")
+            .append(std::to_string(stat.latency.max))
+            .append("us\n");
+    }
+    return result.empty() ? "|No IPC call recorded\n" : result;
+}
+
+std::string PasteboardPerfStat::DumpSlowOps() const
+{
+    std::string result;
+    for (const auto &op : GetSlowOps()) {
+        result.append("|")
+            .append(FormatWallTime(op.wallTimeMs))
+            .append(" cmd ")
+            .append(std::to_string(op.code))
+            .append(" pid ")
+            .append(std::to_string(op.pid))
+            .append(" ret ")
+            .append(std::to_string(op.result))
+            .append(":  total ")
+            .append(std::to_string(op.totalUs))
+            .append("us");
+        for (uint32_t stage = 0; stage < STAGE_BUTT; ++stage) {
+            if (op.stageUs[stage] == 0) {
+                continue;
+            }
+            result.append(", ")
+                .append(GetStageName(stage))
+                .append(" ")
+                .append(std::to_string(op.stageUs[stage]))
+                .append("us");
+        }
+        result.append("\n");
+    }
+    return result.empty() ? "|No call slower than " + std::to_string(SLOW_OP_THRESHOLD_US) + "us\n" : result;
+}
+
+PerfStageTimer::PerfStageTimer(PasteboardPerfStat::Stage stage)
+    : stage_(stage), start_(std::chrono::steady_clock::now()), outer_(g_stageTimer)
+{
+    g_stageTimer = this;
+}
+
+PerfStageTimer::~PerfStageTimer()
+{
+    g_stageTimer = outer_;
+    auto cost = std::chrono::steady_clock::now() - start_;
+    auto costUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(cost).count());
+    if (outer_ != nullptr) {
+        outer_->innerUs_ += costUs;
+    }
+    PasteboardPerfStat::AddStageTime(stage_, costUs > innerUs_ ? costUs - innerUs_ : 0);
+}
+
+const char *PasteboardPerfStat::GetStageName(uint32_t stage)
+{
+    static constexpr const char *STAGE_NAMES[STAGE_BUTT] = {
+        "permission", "get data", "remote wait", "encode", "ashmem write", "uri grant"
+    };
+    return stage < STAGE_BUTT ? STAGE_NAMES[stage] : "unknown";
+}
+} // namespace MiscServices
+} // namespace OHOS
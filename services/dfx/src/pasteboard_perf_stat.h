@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISTRIBUTEDDATAMGR_PASTEBOARD_PERF_STAT_H
+#define DISTRIBUTEDDATAMGR_PASTEBOARD_PERF_STAT_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "latency_histogram.h"
+
+namespace OHOS {
+namespace MiscServices {
+/*
+ * Always-on counters of the IPC calls served by the pasteboard. Every call is counted in a lock-free histogram of
+ * its code, and the slowest calls are kept with the time spent in each stage of the call. A call only takes a lock
+ * when it is slower than the fastest call kept.
+ */
+class PasteboardPerfStat {
+public:
+    enum Stage : uint32_t {
+        PERMISSION = 0,
+        GET_DATA,
+        REMOTE_WAIT,
+        ENCODE,
+        ASHMEM_WRITE,
+        URI_GRANT,
+        STAGE_BUTT,
+    };
+    struct CallStat {
+        uint32_t code = 0;
+        uint64_t failed = 0;
+        LatencyHistogram::Summary latency;
+    };
+    struct SlowOp {
+        uint32_t code = 0;
+        int32_t result = 0;
+        int32_t pid = 0;
+        int64_t wallTimeMs = 0;
+        uint64_t totalUs = 0;
+        std::array<uint64_t, STAGE_BUTT> stageUs{};
+    };
+    static constexpr size_t MAX_CALL_CODES = 64;
+    static constexpr size_t MAX_SLOW_OPS = 16;
+    static constexpr uint64_t SLOW_OP_THRESHOLD_US = 20000;
+
+    static PasteboardPerfStat &GetInstance();
+    // BeginCall and EndCall must be called on the thread serving the call
+    void BeginCall(uint32_t code, int32_t pid);
+    void EndCall(uint32_t code, int32_t result);
+    // adds time to the stage of the call served by the current thread, if any
+    static void AddStageTime(Stage stage, uint64_t costUs);
+    std::vector<CallStat> GetCallStats() const;
+    // slowest first
+    std::vector<SlowOp> GetSlowOps() const;
+    std::string DumpCallStats() const;
+    std::string DumpSlowOps() const;
+    static const char *GetStageName(uint32_t stage);
+    // MM-DD hh:mm:ss.mmm in local time
+    static std::string FormatWallTime(int64_t wallTimeMs);
+
+private:
+    static constexpr uint32_t INVALID_CODE = UINT32_MAX;
+    struct CallEntry {
+        std::atomic<uint32_t> code = INVALID_CODE;
+        std::atomic<uint64_t> failed = 0;
+        LatencyHistogram latency;
+    };
+
+    CallEntry *GetEntry(uint32_t code);
+    void AddSlowOp(const SlowOp &op);
+
+    std::array<CallEntry, MAX_CALL_CODES> entries_;
+    std::atomic<uint64_t> slowFloorUs_ = SLOW_OP_THRESHOLD_US;
+    mutable std::mutex slowMutex_;
+    std::vector<SlowOp> slowOps_;
+};
+
+class PerfStageTimer {
+public:
+    explicit PerfStageTimer(PasteboardPerfStat::Stage stage);
+    // a stage timed inside another one is only added to the inner stage
+    ~PerfStageTimer();
+    PerfStageTimer(const PerfStageTimer &) = delete;
+    PerfStageTimer &operator=(const PerfStageTimer &) = delete;
+
+private:
+    PasteboardPerfStat::Stage stage_;
+    std::chrono::steady_clock::time_point start_;
+    PerfStageTimer *outer_ = nullptr;
+    uint64_t innerUs_ = 0;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // DISTRIBUTEDDATAMGR_PASTEBOARD_PERF_STAT_H
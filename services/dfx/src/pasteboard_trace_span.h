@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MISCSERVICES_PASTEBOARD_TRACE_SPAN_H
+#define MISCSERVICES_PASTEBOARD_TRACE_SPAN_H
+
+#include <climits>
+#include <functional>
+#include <string>
+
+#include "hitrace_meter.h"
+
+namespace OHOS {
+namespace MiscServices {
+/*
+ * Async trace span of one stage of a paste. The spans of a paste are named "Paste[<pasteId>] <stage>" and share a
+ * task id derived from the paste id, so the client, the service and the remote device can be put on one timeline
+ * from a captured trace. Nothing is formatted while the trace tag is disabled.
+ */
+class PasteboardTraceSpan {
+public:
+    PasteboardTraceSpan(const std::string &pasteId, const char *stage)
+    {
+        if (pasteId.empty() || stage == nullptr || !IsTagEnabled(HITRACE_TAG_MISC)) {
+            return;
+        }
+        name_ = GetSpanName(pasteId, stage);
+        taskId_ = GetTaskId(pasteId);
+        StartAsyncTrace(HITRACE_TAG_MISC, name_, taskId_);
+    }
+
+    ~PasteboardTraceSpan()
+    {
+        if (!name_.empty()) {
+            FinishAsyncTrace(HITRACE_TAG_MISC, name_, taskId_);
+        }
+    }
+
+    PasteboardTraceSpan(const PasteboardTraceSpan &) = delete;
+    PasteboardTraceSpan &operator=(const PasteboardTraceSpan &) = delete;
+
+    static std::string GetSpanName(const std::string &pasteId, const char *stage)
+    {
+        return std::string("Paste[") + pasteId + "] " + stage;
+    }
+
+    static int32_t GetTaskId(const std::string &pasteId)
+    {
+        return static_cast<int32_t>(std::hash<std::string>{}(pasteId) & INT32_MAX);
+    }
+
+private:
+    std::string name_;
+    int32_t taskId_ = 0;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // MISCSERVICES_PASTEBOARD_TRACE_SPAN_H
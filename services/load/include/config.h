@@ -29,12 +29,31 @@ public:
         bool Marshal(json &node) const override;
         bool Unmarshal(const json &node) override;
     };
+    // budgets of the heavy paste calls of each caller, 0 is no limit. A paste reads the delayed entries of its
+    // records one call each, so the burst of calls covers a paste of many records. Off unless a product enables it
+    // in the "throttle" section of its config, a refused call fails with SERVICE_BUSY
+    class Throttle final : public DistributedData::Serializable {
+    public:
+        bool enabled = false;
+        uint32_t callsPerSecond = 50;
+        uint32_t callBurst = 500;
+        uint64_t bytesPerSecond = 256 * 1024 * 1024;
+        uint64_t byteBurst = 1024 * 1024 * 1024;
+        uint32_t maxConcurrent = 8;
+        uint32_t maxCallerConcurrent = 2;
+        uint32_t maxWaiting = 8;
+        uint32_t maxCallerWaiting = 4;
+        uint32_t maxWaitMs = 1000;
+        bool Marshal(json &node) const override;
+        bool Unmarshal(const json &node) override;
+    };
     std::string processLabel;
     std::string version;
     std::vector<std::string> features;
     std::vector<std::string> plugins;
     std::vector<Component> components;
     int32_t uid = -1;
+    Throttle throttle;
     bool Marshal(json &node) const override;
     bool Unmarshal(const json &node) override;
 };
@@ -23,6 +23,7 @@ public:
     ~Loader();
     void LoadComponents();
     int32_t LoadUid();
+    Config::Throttle LoadThrottle();
     static bool ComponentIsExist(const std::string &);
 
 private:
@@ -36,6 +36,36 @@ bool Config::Component::Unmarshal(const Serializable::json &node)
     return true;
 }
 
+bool Config::Throttle::Marshal(Serializable::json &node) const
+{
+    SetValue(node, enabled, GET_NAME(enabled));
+    SetValue(node, callsPerSecond, GET_NAME(callsPerSecond));
+    SetValue(node, callBurst, GET_NAME(callBurst));
+    SetValue(node, bytesPerSecond, GET_NAME(bytesPerSecond));
+    SetValue(node, byteBurst, GET_NAME(byteBurst));
+    SetValue(node, maxConcurrent, GET_NAME(maxConcurrent));
+    SetValue(node, maxCallerConcurrent, GET_NAME(maxCallerConcurrent));
+    SetValue(node, maxWaiting, GET_NAME(maxWaiting));
+    SetValue(node, maxCallerWaiting, GET_NAME(maxCallerWaiting));
+    SetValue(node, maxWaitMs, GET_NAME(maxWaitMs));
+    return true;
+}
+
+bool Config::Throttle::Unmarshal(const Serializable::json &node)
+{
+    GetValue(node, GET_NAME(enabled), enabled);
+    GetValue(node, GET_NAME(callsPerSecond), callsPerSecond);
+    GetValue(node, GET_NAME(callBurst), callBurst);
+    GetValue(node, GET_NAME(bytesPerSecond), bytesPerSecond);
+    GetValue(node, GET_NAME(byteBurst), byteBurst);
+    GetValue(node, GET_NAME(maxConcurrent), maxConcurrent);
+    GetValue(node, GET_NAME(maxCallerConcurrent), maxCallerConcurrent);
+    GetValue(node, GET_NAME(maxWaiting), maxWaiting);
+    GetValue(node, GET_NAME(maxCallerWaiting), maxCallerWaiting);
+    GetValue(node, GET_NAME(maxWaitMs), maxWaitMs);
+    return true;
+}
+
 bool Config::Marshal(Serializable::json &node) const
 {
     SetValue(node, processLabel, GET_NAME(processLabel));
@@ -44,6 +74,7 @@ bool Config::Marshal(Serializable::json &node) const
     SetValue(node, plugins, GET_NAME(plugins));
     SetValue(node, components, GET_NAME(components));
     SetValue(node, uid, GET_NAME(uid));
+    SetValue(node, throttle, GET_NAME(throttle));
     return true;
 }
 
@@ -55,6 +86,7 @@ bool Config::Unmarshal(const Serializable::json &node)
     GetValue(node, GET_NAME(plugins), plugins);
     GetValue(node, GET_NAME(components), components);
     GetValue(node, GET_NAME(uid), uid);
+    GetValue(node, GET_NAME(throttle), throttle);
     return ret;
 }
 } // namespace OHOS::MiscServices
\ No newline at end of file
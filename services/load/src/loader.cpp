@@ -60,6 +60,12 @@ int32_t Loader::LoadUid()
     return config.uid;
 }
 
+Config::Throttle Loader::LoadThrottle()
+{
+    Config config = LoadConfig();
+    return config.throttle;
+}
+
 Config Loader::LoadConfig()
 {
     Config config;
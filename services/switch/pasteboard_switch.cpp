@@ -17,6 +17,7 @@
 
 #include "datashare_delegate.h"
 #include "dev_profile.h"
+#include "ffrt_utils.h"
 #include "pasteboard_event_ue.h"
 #include "pasteboard_hilog.h"
 
@@ -26,55 +27,138 @@ const constexpr char *DISTRIBUTED_PASTEBOARD_SWITCH = "distributed_pasteboard_sw
 constexpr const char *SUPPORT_STATUS = "1";
 constexpr int32_t ERROR_USERID = -1;
 constexpr const char *UE_SWITCH_STATUS = "PASTEBOARD_SWITCH_STATUS";
+constexpr const char *SWITCH_TIMER_NAME = "pasteboard_switch";
+constexpr const char *SWITCH_TIMER_ID = "set_switch_";
+
 PastedSwitch::PastedSwitch() : userId_(ERROR_USERID)
 {
     switchObserver_ = new (std::nothrow) PastedSwitchObserver([this]() -> void {
-        std::thread thread([userId = userId_, this]() {
-            SetSwitch(userId);
-        });
-        thread.detach();
+        ScheduleSetSwitch();
     });
 }
 
+PastedSwitch::~PastedSwitch()
+{
+    DeInit();
+}
+
 void PastedSwitch::Init(int32_t userId)
 {
     if (userId == ERROR_USERID) {
         PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "userId invalid.");
         return;
     }
+    std::lock_guard<std::mutex> lock(mutex_);
     this->userId_ = userId;
+    {
+        std::lock_guard<std::mutex> timerLock(timers_->mutex);
+        timers_->owner = this;
+        timers_->userId = userId;
+    }
     DataShareDelegate::GetInstance().SetUserId(userId_);
     DataShareDelegate::GetInstance().RegisterObserver(DISTRIBUTED_PASTEBOARD_SWITCH, switchObserver_);
-    SetSwitch(userId);
+    bool isOpen = true;
+    bool isSet = ReadSwitch(userId, isOpen);
+    PublishSwitch(userId, isOpen);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "Init SetSwitch %{public}d", userId);
-    ReportUeSwitchEvent();
+    // an unset switch is enabled for the device status but reported as closed
+    ReportUeSwitchEvent(isSet && isOpen);
 }
 
 void PastedSwitch::SetSwitch(int32_t userId)
 {
-    std::string value;
-    DataShareDelegate::GetInstance().SetUserId(userId);
-    DataShareDelegate::GetInstance().GetValue(DISTRIBUTED_PASTEBOARD_SWITCH, value);
-    if (value.empty()) {
-        PASTEBOARD_HILOGE(PASTEBOARD_MODULE_SERVICE, "empty switch, set status enable, userId=%{public}d", userId);
-        DevProfile::GetInstance().PutDeviceStatus(true);
-        return;
-    }
-    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "switch status=%{public}s, userId=%{public}d", value.c_str(), userId);
-    DevProfile::GetInstance().PutDeviceStatus(value == SUPPORT_STATUS);
+    std::lock_guard<std::mutex> lock(mutex_);
+    bool isOpen = true;
+    ReadSwitch(userId, isOpen);
+    PublishSwitch(userId, isOpen);
 }
 
 void PastedSwitch::DeInit()
 {
+    {
+        std::unique_lock<std::mutex> timerLock(timers_->mutex);
+        timers_->owner = nullptr;
+        auto timer = FFRTPool::GetTimer(SWITCH_TIMER_NAME);
+        for (int32_t userId : timers_->pendingUsers) {
+            timer->CancelTimer(SWITCH_TIMER_ID + std::to_string(userId));
+        }
+        timers_->pendingUsers.clear();
+        // an evaluation already started still uses the switch
+        timers_->idle.wait(timerLock, [this]() {
+            return timers_->running == 0;
+        });
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
     DataShareDelegate::GetInstance().UnregisterObserver(DISTRIBUTED_PASTEBOARD_SWITCH, switchObserver_);
 }
 
-void PastedSwitch::ReportUeSwitchEvent()
+void PastedSwitch::ScheduleSetSwitch()
+{
+    std::lock_guard<std::mutex> lock(timers_->mutex);
+    PASTEBOARD_CHECK_AND_RETURN_LOGD(timers_->owner != nullptr, PASTEBOARD_MODULE_SERVICE, "switch not observed");
+    // the observer of a user is registered for that user only, later changes of the same user replace the pending one
+    int32_t userId = timers_->userId;
+    timers_->pendingUsers.insert(userId);
+    FFRTTask task = [timers = timers_, userId]() {
+        RunSetSwitch(timers, userId);
+    };
+    FFRTPool::GetTimer(SWITCH_TIMER_NAME)->SetTimer(SWITCH_TIMER_ID + std::to_string(userId), task, DEBOUNCE_TIME);
+}
+
+void PastedSwitch::RunSetSwitch(const std::shared_ptr<TimerState> &timers, int32_t userId)
+{
+    PastedSwitch *owner = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(timers->mutex);
+        // a timer DeInit failed to cancel finds its user no longer pending
+        if (timers->owner == nullptr || timers->pendingUsers.erase(userId) == 0) {
+            return;
+        }
+        owner = timers->owner;
+        timers->running++;
+    }
+    owner->SetSwitch(userId);
+    std::lock_guard<std::mutex> lock(timers->mutex);
+    timers->running--;
+    timers->idle.notify_all();
+}
+
+bool PastedSwitch::ReadSwitch(int32_t userId, bool &isOpen)
 {
     std::string value;
+    DataShareDelegate::GetInstance().SetUserId(userId);
     DataShareDelegate::GetInstance().GetValue(DISTRIBUTED_PASTEBOARD_SWITCH, value);
+    isOpen = value.empty() || value == SUPPORT_STATUS;
+    auto it = userSwitches_.find(userId);
+    if (it == userSwitches_.end() || it->second != isOpen) {
+        PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "switch status=%{public}s, userId=%{public}d",
+            value.empty() ? "empty" : value.c_str(), userId);
+    }
+    userSwitches_[userId] = isOpen;
+    return !value.empty();
+}
+
+void PastedSwitch::PublishSwitch(int32_t userId, bool isOpen)
+{
+    if (userId != userId_) {
+        PASTEBOARD_HILOGD(PASTEBOARD_MODULE_SERVICE, "user not current, userId=%{public}d, current=%{public}d",
+            userId, userId_);
+        return;
+    }
+    if (isPublished_ && publishedStatus_ == isOpen) {
+        return;
+    }
+    // an unpublished status is retried by the next evaluation
+    isPublished_ = DevProfile::GetInstance().PutDeviceStatus(isOpen);
+    publishedStatus_ = isOpen;
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "publish status=%{public}d, ret=%{public}d, userId=%{public}d",
+        isOpen, isPublished_, userId);
+}
+
+void PastedSwitch::ReportUeSwitchEvent(bool isOpen)
+{
     UE_SWITCH(UE_SWITCH_STATUS, UeReporter::UE_STATUS_TYPE,
-        (value == SUPPORT_STATUS) ? UeReporter::SwitchStatus::SWITCH_OPEN : UeReporter::SwitchStatus::SWITCH_CLOSE);
+        isOpen ? UeReporter::SwitchStatus::SWITCH_OPEN : UeReporter::SwitchStatus::SWITCH_CLOSE);
 }
 
 void PastedSwitchObserver::OnChange()
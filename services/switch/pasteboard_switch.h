@@ -16,6 +16,12 @@
 #ifndef OHOS_DISTRIBUTED_DATA_PASTEBOARD_SERVICE_PASTEBOARD_SWITCH_H
 #define OHOS_DISTRIBUTED_DATA_PASTEBOARD_SERVICE_PASTEBOARD_SWITCH_H
 
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+
 #include "data_ability_observer_stub.h"
 
 namespace OHOS::MiscServices {
@@ -31,16 +37,44 @@ private:
     ObserverCallback func_;
 };
 
+/*
+ * Publishes the distributed pasteboard switch of the current user as the device status. A burst of setting changes
+ * is coalesced into one evaluation after DEBOUNCE_TIME, and evaluations never overlap, so each one reads the setting
+ * once and the device status is published only when it differs from the last published one.
+ */
 class PastedSwitch {
 public:
+    static constexpr uint32_t DEBOUNCE_TIME = 200; // ms
+
     PastedSwitch();
+    ~PastedSwitch();
     void Init(int32_t userId);
     void DeInit();
     void SetSwitch(int32_t userId);
     int32_t userId_;
 private:
-    void ReportUeSwitchEvent();
+    // shared with the timer tasks, which may start after the switch stops observing or is gone
+    struct TimerState {
+        std::mutex mutex;
+        std::condition_variable idle;
+        PastedSwitch *owner = nullptr; // null while the switch is not observed
+        int32_t userId = -1;
+        std::set<int32_t> pendingUsers;
+        uint32_t running = 0;
+    };
+
+    static void ReportUeSwitchEvent(bool isOpen);
+    static void RunSetSwitch(const std::shared_ptr<TimerState> &timers, int32_t userId);
+    void ScheduleSetSwitch();
+    bool ReadSwitch(int32_t userId, bool &isOpen);
+    void PublishSwitch(int32_t userId, bool isOpen);
+
     sptr<PastedSwitchObserver> switchObserver_;
+    std::shared_ptr<TimerState> timers_ = std::make_shared<TimerState>();
+    std::mutex mutex_; // serializes the evaluations and the user id of DataShareDelegate
+    std::map<int32_t, bool> userSwitches_; // the latest switch read for each user
+    bool isPublished_ = false;
+    bool publishedStatus_ = false;
 };
 } // namespace OHOS::MiscServices
 
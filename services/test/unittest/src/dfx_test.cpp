@@ -14,18 +14,22 @@
  */
 
 #include <gtest/gtest.h>
+#include <thread>
 
 #include "hiview_adapter.h"
 #include "pasteboard_app_event_dfx.h"
 #include "pasteboard_behaviour_reporter_impl.h"
 #include "pasteboard_fault_impl.h"
 #include "pasteboard_hilog.h"
+#include "pasteboard_perf_stat.h"
 #include "reporter.h"
 #include "time_consuming_statistic_impl.h"
 
 namespace OHOS::MiscServices {
 using namespace testing::ext;
 const int32_t NOT_APP_PROCESSORID = -200;
+constexpr int64_t TEST_DATA_SIZE = 1024;
+constexpr int64_t TEST_TIME_CONSUMING = 1500;
 class DFXTest : public testing::Test {
 public:
     static void SetUpTestCase(void);
@@ -75,13 +79,13 @@ HWTEST_F(DFXTest, DFXTest002, TestSize.Level0)
     auto status = Reporter::GetInstance().TimeConsumingStatistic().Report(timeConsumingStat);
     ASSERT_EQ(status, ReportStatus::SUCCESS);
 
-    timeConsumingStat = { .pasteboardState = SPS_COPY_STATE, .dataSize = DATA_LEVEL_ONE, .timeConsuming = -1 };
+    timeConsumingStat = { .pasteboardState = SPS_COPY_STATE, .dataSize = TEST_DATA_SIZE, .timeConsuming = -1 };
     status = Reporter::GetInstance().TimeConsumingStatistic().Report(timeConsumingStat);
     ASSERT_EQ(status, ReportStatus::SUCCESS);
 
     timeConsumingStat = { .pasteboardState = SPS_COPY_STATE,
-        .dataSize = DATA_LEVEL_ONE,
-        .timeConsuming = TCS_TIME_CONSUMING_LEVEL_ONE
+        .dataSize = TEST_DATA_SIZE,
+        .timeConsuming = TEST_TIME_CONSUMING
     };
     status = Reporter::GetInstance().TimeConsumingStatistic().Report(timeConsumingStat);
     ASSERT_EQ(status, ReportStatus::SUCCESS);
@@ -102,13 +106,13 @@ HWTEST_F(DFXTest, DFXTest003, TestSize.Level0)
     auto status = Reporter::GetInstance().TimeConsumingStatistic().Report(timeConsumingStat);
     ASSERT_EQ(status, ReportStatus::SUCCESS);
 
-    timeConsumingStat = { .pasteboardState = SPS_PASTE_STATE, .dataSize = DATA_LEVEL_ONE, .timeConsuming = -1 };
+    timeConsumingStat = { .pasteboardState = SPS_PASTE_STATE, .dataSize = TEST_DATA_SIZE, .timeConsuming = -1 };
     status = Reporter::GetInstance().TimeConsumingStatistic().Report(timeConsumingStat);
     ASSERT_EQ(status, ReportStatus::SUCCESS);
 
     timeConsumingStat = { .pasteboardState = SPS_PASTE_STATE,
-        .dataSize = DATA_LEVEL_ONE,
-        .timeConsuming = TCS_TIME_CONSUMING_LEVEL_ONE };
+        .dataSize = TEST_DATA_SIZE,
+        .timeConsuming = TEST_TIME_CONSUMING };
     status = Reporter::GetInstance().TimeConsumingStatistic().Report(timeConsumingStat);
     ASSERT_EQ(status, ReportStatus::SUCCESS);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_INNERKIT, "End.");
@@ -130,13 +134,13 @@ HWTEST_F(DFXTest, DFXTest004, TestSize.Level0)
     auto status = Reporter::GetInstance().TimeConsumingStatistic().Report(timeConsumingStat);
     ASSERT_EQ(status, ReportStatus::SUCCESS);
 
-    timeConsumingStat = { .pasteboardState = SPS_REMOTE_PASTE_STATE, .dataSize = DATA_LEVEL_ONE, .timeConsuming = -1 };
+    timeConsumingStat = { .pasteboardState = SPS_REMOTE_PASTE_STATE, .dataSize = TEST_DATA_SIZE, .timeConsuming = -1 };
     status = Reporter::GetInstance().TimeConsumingStatistic().Report(timeConsumingStat);
     ASSERT_EQ(status, ReportStatus::SUCCESS);
 
     timeConsumingStat = { .pasteboardState = SPS_REMOTE_PASTE_STATE,
-        .dataSize = DATA_LEVEL_ONE,
-        .timeConsuming = TCS_TIME_CONSUMING_LEVEL_ONE };
+        .dataSize = TEST_DATA_SIZE,
+        .timeConsuming = TEST_TIME_CONSUMING };
     status = Reporter::GetInstance().TimeConsumingStatistic().Report(timeConsumingStat);
     ASSERT_EQ(status, ReportStatus::SUCCESS);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_INNERKIT, "End.");
@@ -153,8 +157,8 @@ HWTEST_F(DFXTest, DFXTest005, TestSize.Level0)
 {
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_INNERKIT, "Start.");
     TimeConsumingStat timeConsumingStat = { .pasteboardState = SPS_INVALID_STATE,
-        .dataSize = DATA_LEVEL_ONE,
-        .timeConsuming = TCS_TIME_CONSUMING_LEVEL_ONE };
+        .dataSize = TEST_DATA_SIZE,
+        .timeConsuming = TEST_TIME_CONSUMING };
     auto status = Reporter::GetInstance().TimeConsumingStatistic().Report(timeConsumingStat);
     ASSERT_EQ(status, ReportStatus::SUCCESS);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_INNERKIT, "End.");
@@ -225,4 +229,211 @@ HWTEST_F(DFXTest, DFXTest008, TestSize.Level0)
     DfxAppEvent::processorId_ = NOT_APP_PROCESSORID;
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_INNERKIT, "End.");
 }
-} // namespace OHOS::MiscServices
\ No newline at end of file
+
+/**
+ * @tc.name: DFXTest009
+ * @tc.desc: test latency histogram buckets and percentiles.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(DFXTest, DFXTest009, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_INNERKIT, "Start.");
+    for (uint64_t value = 0; value < 100000; value += 7) {
+        uint32_t index = LatencyHistogram::GetBucketIndex(value);
+        ASSERT_LT(index, LatencyHistogram::BUCKET_COUNT);
+        ASSERT_GE(LatencyHistogram::GetBucketUpperBound(index), value);
+        ASSERT_LE(LatencyHistogram::GetBucketUpperBound(index), value + value / LatencyHistogram::SUB_BUCKET_COUNT);
+    }
+    ASSERT_EQ(LatencyHistogram::GetBucketIndex(UINT64_MAX), LatencyHistogram::BUCKET_COUNT - 1);
+
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 1000; ++value) {
+        histogram.Record(value);
+    }
+    auto summary = histogram.GetSummary();
+    EXPECT_EQ(summary.count, 1000);
+    EXPECT_EQ(summary.max, 1000);
+    EXPECT_GE(summary.p50, 500);
+    EXPECT_LE(summary.p50, 500 + 500 / LatencyHistogram::SUB_BUCKET_COUNT);
+    EXPECT_GE(summary.p90, 900);
+    EXPECT_LE(summary.p90, 1000);
+    EXPECT_GE(summary.p99, 990);
+    EXPECT_LE(summary.p99, 1000);
+
+    summary = histogram.TakeSummary();
+    EXPECT_EQ(summary.count, 1000);
+    EXPECT_EQ(histogram.GetSummary().count, 0);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_INNERKIT, "End.");
+}
+
+/**
+ * @tc.name: DFXTest010
+ * @tc.desc: test time consuming statistic is dumped by pasteboard state and data size.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(DFXTest, DFXTest010, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_INNERKIT, "Start.");
+    constexpr int64_t TEN_MB = 10 * 1024 * 1024;
+    TimeConsumingStat timeConsumingStat = { .pasteboardState = SPS_DETECT_PATTERNS_STATE,
+        .dataSize = TEN_MB,
+        .timeConsuming = TEST_TIME_CONSUMING };
+    auto status = Reporter::GetInstance().TimeConsumingStatistic().Report(timeConsumingStat);
+    ASSERT_EQ(status, ReportStatus::SUCCESS);
+    std::string dump = HiViewAdapter::DumpTimeConsumingStatistic();
+    EXPECT_NE(dump.find("DETECT_PATTERNS_STATE TEN_TO_FIFTY_MB"), std::string::npos);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_INNERKIT, "End.");
+}
+
+/**
+ * @tc.name: DFXTest011
+ * @tc.desc: test a slow IPC call is counted and kept with its stage breakdown.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(DFXTest, DFXTest011, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_INNERKIT, "Start.");
+    constexpr uint32_t TEST_CODE = 9011;
+    constexpr int32_t TEST_PID = 100;
+    auto &perfStat = PasteboardPerfStat::GetInstance();
+    perfStat.BeginCall(TEST_CODE, TEST_PID);
+    {
+        PerfStageTimer stage(PasteboardPerfStat::ENCODE);
+        std::this_thread::sleep_for(std::chrono::microseconds(PasteboardPerfStat::SLOW_OP_THRESHOLD_US));
+    }
+    perfStat.EndCall(TEST_CODE, 0);
+
+    auto callStats = perfStat.GetCallStats();
+    auto stat = std::find_if(callStats.begin(), callStats.end(), [](const auto &item) {
+        return item.code == TEST_CODE;
+    });
+    ASSERT_NE(stat, callStats.end());
+    EXPECT_EQ(stat->latency.count, 1);
+    EXPECT_EQ(stat->failed, 0);
+    EXPECT_GE(stat->latency.max, PasteboardPerfStat::SLOW_OP_THRESHOLD_US);
+
+    auto slowOps = perfStat.GetSlowOps();
+    auto op = std::find_if(slowOps.begin(), slowOps.end(), [](const auto &item) {
+        return item.code == TEST_CODE;
+    });
+    ASSERT_NE(op, slowOps.end());
+    EXPECT_EQ(op->pid, TEST_PID);
+    EXPECT_GE(op->stageUs[PasteboardPerfStat::ENCODE], PasteboardPerfStat::SLOW_OP_THRESHOLD_US);
+    EXPECT_LE(op->stageUs[PasteboardPerfStat::ENCODE], op->totalUs);
+    EXPECT_EQ(op->stageUs[PasteboardPerfStat::PERMISSION], 0);
+    EXPECT_NE(perfStat.DumpSlowOps().find("encode"), std::string::npos);
+    EXPECT_NE(perfStat.DumpCallStats().find("cmd " + std::to_string(TEST_CODE)), std::string::npos);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_INNERKIT, "End.");
+}
+
+/**
+ * @tc.name: DFXTest012
+ * @tc.desc: test calls not begun on the current thread are not counted.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(DFXTest, DFXTest012, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_INNERKIT, "Start.");
+    constexpr uint32_t TEST_CODE = 9012;
+    constexpr uint32_t OTHER_CODE = 9013;
+    auto &perfStat = PasteboardPerfStat::GetInstance();
+    PasteboardPerfStat::AddStageTime(PasteboardPerfStat::URI_GRANT, PasteboardPerfStat::SLOW_OP_THRESHOLD_US);
+    perfStat.EndCall(TEST_CODE, -1);
+    perfStat.BeginCall(TEST_CODE, 0);
+    perfStat.EndCall(OTHER_CODE, -1);
+    std::thread([&perfStat]() {
+        perfStat.EndCall(TEST_CODE, -1);
+    }).join();
+
+    auto callStats = perfStat.GetCallStats();
+    auto stat = std::find_if(callStats.begin(), callStats.end(), [](const auto &item) {
+        return item.code == TEST_CODE || item.code == OTHER_CODE;
+    });
+    EXPECT_EQ(stat, callStats.end());
+    perfStat.EndCall(TEST_CODE, -1);
+    callStats = perfStat.GetCallStats();
+    stat = std::find_if(callStats.begin(), callStats.end(), [](const auto &item) {
+        return item.code == TEST_CODE;
+    });
+    ASSERT_NE(stat, callStats.end());
+    EXPECT_EQ(stat->latency.count, 1);
+    EXPECT_EQ(stat->failed, 1);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_INNERKIT, "End.");
+}
+
+/**
+ * @tc.name: DFXTest013
+ * @tc.desc: test the consuming data of the daily statistic event names each value.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(DFXTest, DFXTest013, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_INNERKIT, "Start.");
+    LatencyHistogram::Summary summary = { .count = 3, .p50 = 10, .p90 = 20, .p99 = 30, .max = 40 };
+    EXPECT_EQ(HiViewAdapter::FormatConsumingData(summary), "count:3,p50:10,p90:20,p99:30,max:40");
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_INNERKIT, "End.");
+}
+
+/**
+ * @tc.name: DFXTest014
+ * @tc.desc: test a stage timed inside another one is not counted twice.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(DFXTest, DFXTest014, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_INNERKIT, "Start.");
+    constexpr uint32_t TEST_CODE = 9014;
+    auto &perfStat = PasteboardPerfStat::GetInstance();
+    perfStat.BeginCall(TEST_CODE, 0);
+    {
+        PerfStageTimer outer(PasteboardPerfStat::GET_DATA);
+        PerfStageTimer inner(PasteboardPerfStat::ENCODE);
+        std::this_thread::sleep_for(std::chrono::microseconds(PasteboardPerfStat::SLOW_OP_THRESHOLD_US));
+    }
+    perfStat.EndCall(TEST_CODE, 0);
+
+    auto slowOps = perfStat.GetSlowOps();
+    auto op = std::find_if(slowOps.begin(), slowOps.end(), [](const auto &item) {
+        return item.code == TEST_CODE;
+    });
+    ASSERT_NE(op, slowOps.end());
+    EXPECT_GE(op->stageUs[PasteboardPerfStat::ENCODE], PasteboardPerfStat::SLOW_OP_THRESHOLD_US);
+    EXPECT_LT(op->stageUs[PasteboardPerfStat::GET_DATA], PasteboardPerfStat::SLOW_OP_THRESHOLD_US);
+    EXPECT_LE(op->stageUs[PasteboardPerfStat::GET_DATA] + op->stageUs[PasteboardPerfStat::ENCODE], op->totalUs);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_INNERKIT, "End.");
+}
+
+/**
+ * @tc.name: DFXTest015
+ * @tc.desc: test the milliseconds of a slow call time are zero padded.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(DFXTest, DFXTest015, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_INNERKIT, "Start.");
+    constexpr int64_t WALL_TIME_MS = 1700000000005;
+    constexpr int64_t LATER_MS = 120;
+    constexpr size_t MILLIS_LENGTH = 4;
+    std::string wallTime = PasteboardPerfStat::FormatWallTime(WALL_TIME_MS);
+    ASSERT_GT(wallTime.size(), MILLIS_LENGTH);
+    EXPECT_EQ(wallTime.substr(wallTime.size() - MILLIS_LENGTH), ".005");
+    wallTime = PasteboardPerfStat::FormatWallTime(WALL_TIME_MS + LATER_MS);
+    ASSERT_GT(wallTime.size(), MILLIS_LENGTH);
+    EXPECT_EQ(wallTime.substr(wallTime.size() - MILLIS_LENGTH), ".125");
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_INNERKIT, "End.");
+}
+} // namespace OHOS::MiscServices
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "pasteboard_call_throttle.h"
+#include "pasteboard_error.h"
+
+namespace OHOS::MiscServices {
+using namespace testing::ext;
+namespace {
+constexpr int32_t E_OK = static_cast<int32_t>(PasteboardError::E_OK);
+constexpr int32_t BUSY = static_cast<int32_t>(PasteboardError::SERVICE_BUSY);
+const CallThrottle::Caller CALLER_A = { 1001, 11 };
+const CallThrottle::Caller CALLER_B = { 1002, 12 };
+
+void WaitForWaiting(const CallThrottle &throttle, uint32_t waiting)
+{
+    while (throttle.GetStats().waiting < waiting) {
+        std::this_thread::yield();
+    }
+}
+} // namespace
+
+class PasteboardCallThrottleTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void PasteboardCallThrottleTest::SetUpTestCase(void) {}
+
+void PasteboardCallThrottleTest::TearDownTestCase(void) {}
+
+void PasteboardCallThrottleTest::SetUp(void) {}
+
+void PasteboardCallThrottleTest::TearDown(void) {}
+
+/**
+ * @tc.name: EnterTest001
+ * @tc.desc: Test a caller is refused when out of calls or in byte debt, and admitted again once the buckets refill.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardCallThrottleTest, EnterTest001, TestSize.Level0)
+{
+    CallThrottle::Config config;
+    config.enabled = true;
+    config.callsPerSecond = 1;
+    config.callBurst = 2;
+    config.bytesPerSecond = 100;
+    config.byteBurst = 100;
+    CallThrottle throttle(config);
+
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_EQ(throttle.Enter(CALLER_A, 0), E_OK);
+        throttle.Exit(CALLER_A, 0);
+    }
+    EXPECT_EQ(throttle.Enter(CALLER_A, 0), BUSY);
+    EXPECT_EQ(throttle.Enter(CALLER_B, 0), E_OK);
+    throttle.Exit(CALLER_B, 0);
+
+    ASSERT_EQ(throttle.Enter(CALLER_A, 1000), E_OK);
+    throttle.Charge(CALLER_A, 300, 1000);
+    throttle.Exit(CALLER_A, 1000);
+    EXPECT_EQ(throttle.Enter(CALLER_A, 2000), BUSY);
+    ASSERT_EQ(throttle.Enter(CALLER_A, 4000), E_OK);
+    throttle.Exit(CALLER_A, 4000);
+
+    auto stats = throttle.GetStats();
+    EXPECT_EQ(stats.admitted, 5);
+    EXPECT_EQ(stats.callLimited, 1);
+    EXPECT_EQ(stats.byteLimited, 1);
+    EXPECT_EQ(stats.bytes, 300);
+    EXPECT_EQ(stats.inFlight, 0);
+    auto callers = throttle.GetCallerStats(1);
+    ASSERT_EQ(callers.size(), 1);
+    EXPECT_TRUE(callers[0].caller == CALLER_A);
+    EXPECT_EQ(callers[0].refused, 2);
+}
+
+/**
+ * @tc.name: EnterTest002
+ * @tc.desc: Test the waiting callers take the freed slot in turn and a caller with too many waiting calls is busy.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardCallThrottleTest, EnterTest002, TestSize.Level0)
+{
+    CallThrottle::Config config;
+    config.enabled = true;
+    config.maxConcurrent = 1;
+    config.maxCallerWaiting = 2;
+    config.maxWaitMs = 10000;
+    CallThrottle throttle(config);
+    ASSERT_EQ(throttle.Enter(CALLER_A, 0), E_OK);
+
+    std::mutex mutex;
+    std::vector<pid_t> order;
+    std::vector<std::thread> threads;
+    uint32_t waiting = 0;
+    for (const auto &caller : { CALLER_A, CALLER_A, CALLER_B }) {
+        threads.emplace_back([&throttle, &mutex, &order, caller]() {
+            if (throttle.Enter(caller, 0) != E_OK) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(caller.pid);
+            }
+            throttle.Exit(caller, 0);
+        });
+        WaitForWaiting(throttle, ++waiting);
+    }
+    EXPECT_EQ(throttle.Enter(CALLER_A, 0), BUSY);
+
+    throttle.Exit(CALLER_A, 0);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    std::vector<pid_t> expected = { CALLER_A.pid, CALLER_B.pid, CALLER_A.pid };
+    EXPECT_EQ(order, expected);
+    auto stats = throttle.GetStats();
+    EXPECT_EQ(stats.queued, 3);
+    EXPECT_EQ(stats.busy, 1);
+    EXPECT_EQ(stats.inFlight, 0);
+    EXPECT_EQ(stats.waiting, 0);
+}
+
+/**
+ * @tc.name: EnterTest003
+ * @tc.desc: Test a call is busy once the calls of all callers waiting for a slot reach the limit.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardCallThrottleTest, EnterTest003, TestSize.Level0)
+{
+    const CallThrottle::Caller callerC = { 1003, 13 };
+    CallThrottle::Config config;
+    config.enabled = true;
+    config.maxConcurrent = 1;
+    config.maxWaiting = 2;
+    config.maxCallerWaiting = 2;
+    config.maxWaitMs = 10000;
+    CallThrottle throttle(config);
+    ASSERT_EQ(throttle.Enter(CALLER_A, 0), E_OK);
+
+    std::vector<std::thread> threads;
+    uint32_t waiting = 0;
+    for (const auto &caller : { CALLER_A, CALLER_B }) {
+        threads.emplace_back([&throttle, caller]() {
+            if (throttle.Enter(caller, 0) == E_OK) {
+                throttle.Exit(caller, 0);
+            }
+        });
+        WaitForWaiting(throttle, ++waiting);
+    }
+    EXPECT_EQ(throttle.Enter(callerC, 0), BUSY);
+    EXPECT_EQ(throttle.Enter(CALLER_B, 0), BUSY);
+
+    throttle.Exit(CALLER_A, 0);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(throttle.Enter(callerC, 0), E_OK);
+    throttle.Exit(callerC, 0);
+    auto stats = throttle.GetStats();
+    EXPECT_EQ(stats.queued, 2);
+    EXPECT_EQ(stats.busy, 2);
+    EXPECT_EQ(stats.waitLimited, 2);
+    EXPECT_EQ(stats.inFlight, 0);
+    EXPECT_EQ(stats.waiting, 0);
+}
+
+/**
+ * @tc.name: EnterTest004
+ * @tc.desc: Test a refused call, or one that waited for a slot in vain, does not spend a call of the caller.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardCallThrottleTest, EnterTest004, TestSize.Level0)
+{
+    CallThrottle::Config config;
+    config.enabled = true;
+    config.callsPerSecond = 1;
+    config.callBurst = 1;
+    config.bytesPerSecond = 100;
+    config.byteBurst = 100;
+    config.maxConcurrent = 1;
+    config.maxWaitMs = 10;
+    CallThrottle throttle(config);
+    ASSERT_EQ(throttle.Enter(CALLER_A, 0), E_OK);
+    EXPECT_EQ(throttle.Enter(CALLER_B, 0), BUSY);
+    EXPECT_EQ(throttle.Enter(CALLER_B, 0), BUSY);
+    throttle.Charge(CALLER_A, 300, 0);
+    throttle.Exit(CALLER_A, 0);
+    ASSERT_EQ(throttle.Enter(CALLER_B, 0), E_OK);
+    throttle.Exit(CALLER_B, 0);
+
+    EXPECT_EQ(throttle.Enter(CALLER_A, 1000), BUSY);
+    EXPECT_EQ(throttle.Enter(CALLER_A, 1100), BUSY);
+    ASSERT_EQ(throttle.Enter(CALLER_A, 3000), E_OK);
+    throttle.Exit(CALLER_A, 3000);
+
+    auto stats = throttle.GetStats();
+    EXPECT_EQ(stats.admitted, 3);
+    EXPECT_EQ(stats.busy, 2);
+    EXPECT_EQ(stats.byteLimited, 2);
+    EXPECT_EQ(stats.callLimited, 0);
+}
+} // namespace OHOS::MiscServices
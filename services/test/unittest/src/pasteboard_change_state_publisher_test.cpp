@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "pasteboard_change_state_publisher.h"
+#include "pasteboard_error.h"
+
+namespace OHOS::MiscServices {
+using namespace testing::ext;
+namespace {
+constexpr int32_t USER_ID = 100;
+constexpr int32_t OTHER_USER_ID = 101;
+constexpr uint32_t CHANGE_COUNT = 3;
+
+// maps the page the way the clients do
+const ChangeStatePage::Layout *MapPage(int fd)
+{
+    void *addr = mmap(nullptr, sizeof(ChangeStatePage::Layout), PROT_READ, MAP_SHARED, fd, 0);
+    return addr == MAP_FAILED ? nullptr : static_cast<const ChangeStatePage::Layout *>(addr);
+}
+
+void UnmapPage(const ChangeStatePage::Layout *page)
+{
+    munmap(const_cast<ChangeStatePage::Layout *>(page), sizeof(ChangeStatePage::Layout));
+}
+} // namespace
+
+class PasteboardChangeStatePublisherTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void PasteboardChangeStatePublisherTest::SetUpTestCase(void) {}
+
+void PasteboardChangeStatePublisherTest::TearDownTestCase(void) {}
+
+void PasteboardChangeStatePublisherTest::SetUp(void) {}
+
+void PasteboardChangeStatePublisherTest::TearDown(void) {}
+
+/**
+ * @tc.name: ReadTest001
+ * @tc.desc: Test a page is read only once published and not while a write is in progress.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardChangeStatePublisherTest, ReadTest001, TestSize.Level0)
+{
+    ChangeStatePage::Layout page{};
+    ChangeState state;
+    EXPECT_FALSE(ChangeStatePage::Read(page, state));
+
+    ChangeState written = { CHANGE_COUNT, ChangeStatePage::PLAIN | ChangeStatePage::HTML, ChangeStatePage::HAS_DATA };
+    ChangeStatePage::Write(page, written);
+    ASSERT_TRUE(ChangeStatePage::Read(page, state));
+    EXPECT_EQ(state.changeCount, CHANGE_COUNT);
+    EXPECT_EQ(state.mimeTypes, written.mimeTypes);
+    EXPECT_EQ(state.flags, written.flags);
+
+    page.sequence.fetch_add(1);
+    EXPECT_FALSE(ChangeStatePage::Read(page, state));
+
+    // the sequence skips 0 when it wraps around
+    page.sequence.store(UINT32_MAX - 1);
+    ChangeStatePage::Write(page, written);
+    EXPECT_NE(page.sequence.load(), 0);
+    EXPECT_TRUE(ChangeStatePage::Read(page, state));
+
+    EXPECT_EQ(ChangeStatePage::GetMimeTypeBit(MIMETYPE_TEXT_URI), ChangeStatePage::URI);
+    EXPECT_EQ(ChangeStatePage::GetMimeTypeBit("application/octet-stream"), 0);
+}
+
+/**
+ * @tc.name: PublishTest001
+ * @tc.desc: Test a page is created with the current state on request and rewritten on publish.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardChangeStatePublisherTest, PublishTest001, TestSize.Level0)
+{
+    uint32_t changeCount = CHANGE_COUNT;
+    uint32_t calls = 0;
+    ChangeStatePublisher publisher([&changeCount, &calls](int32_t) {
+        calls++;
+        ChangeState state;
+        state.changeCount = changeCount;
+        state.flags = ChangeStatePage::LOCAL_ANSWER;
+        return state;
+    });
+    publisher.Publish(USER_ID);
+    EXPECT_EQ(calls, 0);
+
+    int fd = -1;
+    ASSERT_EQ(publisher.GetFd(USER_ID, fd), static_cast<int32_t>(PasteboardError::E_OK));
+    ASSERT_GE(fd, 0);
+    auto page = MapPage(fd);
+    close(fd);
+    ASSERT_NE(page, nullptr);
+    ChangeState state;
+    ASSERT_TRUE(ChangeStatePage::Read(*page, state));
+    EXPECT_EQ(state.changeCount, CHANGE_COUNT);
+    EXPECT_EQ(state.flags, ChangeStatePage::LOCAL_ANSWER);
+
+    changeCount++;
+    publisher.Publish(OTHER_USER_ID);
+    publisher.Publish(USER_ID);
+    ASSERT_TRUE(ChangeStatePage::Read(*page, state));
+    EXPECT_EQ(state.changeCount, CHANGE_COUNT + 1);
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(publisher.GetPageCount(), 1);
+
+    // the page outlives the publisher for the clients still mapping it
+    publisher.Clear();
+    EXPECT_EQ(publisher.GetPageCount(), 0);
+    EXPECT_TRUE(ChangeStatePage::Read(*page, state));
+    UnmapPage(page);
+}
+} // namespace OHOS::MiscServices
@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <dirent.h>
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+
+#include "pasteboard_clip_history.h"
+
+namespace OHOS::MiscServices {
+using namespace testing::ext;
+namespace {
+const std::string SPILL_ROOT = "/data/local/tmp/pasteboard_clip_history_test";
+constexpr int32_t USER_ID = 100;
+constexpr int32_t OTHER_USER_ID = 101;
+const std::string USER_DIR = SPILL_ROOT + "/" + std::to_string(USER_ID);
+const std::string SPILL_DIR = USER_DIR + "/history";
+
+PasteData MakeTextData(const std::string &text, uint32_t dataId)
+{
+    PasteData data;
+    data.AddTextRecord(text);
+    data.SetDataId(dataId);
+    data.SetBundleInfo("com.example.copy");
+    return data;
+}
+
+ClipHistory::Config MakeConfig(size_t maxClips, const std::string &spillRoot)
+{
+    ClipHistory::Config config;
+    config.maxClips = maxClips;
+    config.spillRoot = spillRoot;
+    config.spillDir = "history";
+    return config;
+}
+
+size_t CountFiles(const std::string &path)
+{
+    DIR *dir = opendir(path.c_str());
+    if (dir == nullptr) {
+        return 0;
+    }
+    size_t count = 0;
+    for (struct dirent *item = readdir(dir); item != nullptr; item = readdir(dir)) {
+        count += item->d_type == DT_REG ? 1 : 0;
+    }
+    closedir(dir);
+    return count;
+}
+} // namespace
+
+class PasteboardClipHistoryTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void PasteboardClipHistoryTest::SetUpTestCase(void)
+{
+    mkdir(SPILL_ROOT.c_str(), S_IRWXU);
+    mkdir(USER_DIR.c_str(), S_IRWXU);
+}
+
+void PasteboardClipHistoryTest::TearDownTestCase(void)
+{
+    rmdir(SPILL_DIR.c_str());
+    rmdir(USER_DIR.c_str());
+    rmdir(SPILL_ROOT.c_str());
+}
+
+void PasteboardClipHistoryTest::SetUp(void) {}
+
+void PasteboardClipHistoryTest::TearDown(void) {}
+
+/**
+ * @tc.name: GetContentHashTest001
+ * @tc.desc: Test the content hash ignores the data id and follows the records.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardClipHistoryTest, GetContentHashTest001, TestSize.Level0)
+{
+    std::vector<uint8_t> first;
+    std::vector<uint8_t> second;
+    std::vector<uint8_t> other;
+    ASSERT_TRUE(MakeTextData("hello", 1).Encode(first));
+    ASSERT_TRUE(MakeTextData("hello", 2).Encode(second));
+    ASSERT_TRUE(MakeTextData("world", 1).Encode(other));
+    EXPECT_NE(first, second);
+    EXPECT_NE(PasteData::GetContentHash(first), 0);
+    EXPECT_EQ(PasteData::GetContentHash(first), PasteData::GetContentHash(second));
+    EXPECT_NE(PasteData::GetContentHash(first), PasteData::GetContentHash(other));
+
+    first.resize(first.size() - 1);
+    EXPECT_EQ(PasteData::GetContentHash(first), 0);
+}
+
+/**
+ * @tc.name: AddTest001
+ * @tc.desc: Test a copy of the same content moves the entry to the front instead of adding one.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardClipHistoryTest, AddTest001, TestSize.Level0)
+{
+    ClipHistory history(MakeConfig(ClipHistory::Config().maxClips, ""));
+    auto hello = MakeTextData("hello", 1);
+    auto world = MakeTextData("world", 2);
+    auto helloAgain = MakeTextData("hello", 3);
+    uint32_t helloId = history.Add(USER_ID, hello);
+    uint32_t worldId = history.Add(USER_ID, world);
+    EXPECT_NE(helloId, 0);
+    EXPECT_NE(worldId, helloId);
+    EXPECT_EQ(history.Add(USER_ID, helloAgain), helloId);
+
+    auto summaries = history.GetSummaries(USER_ID);
+    ASSERT_EQ(summaries.size(), 2);
+    EXPECT_EQ(summaries[0].clipId, helloId);
+    EXPECT_EQ(summaries[0].textPreview, "hello");
+    EXPECT_EQ(summaries[0].bundleName, "com.example.copy");
+    EXPECT_EQ(summaries[0].recordCount, 1);
+    EXPECT_EQ(summaries[1].clipId, worldId);
+    EXPECT_TRUE(history.GetSummaries(OTHER_USER_ID).empty());
+
+    auto stats = history.GetStats();
+    EXPECT_EQ(stats.added, 2);
+    EXPECT_EQ(stats.deduplicated, 1);
+
+    auto data = history.Get(USER_ID, worldId);
+    ASSERT_NE(data, nullptr);
+    ASSERT_NE(data->GetPrimaryText(), nullptr);
+    EXPECT_EQ(*data->GetPrimaryText(), "world");
+    EXPECT_EQ(history.Get(OTHER_USER_ID, worldId), nullptr);
+}
+
+/**
+ * @tc.name: AddTest002
+ * @tc.desc: Test in-app, remote and delayed data are not kept in the history.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardClipHistoryTest, AddTest002, TestSize.Level0)
+{
+    ClipHistory history(MakeConfig(ClipHistory::Config().maxClips, ""));
+    auto inApp = MakeTextData("in app", 1);
+    inApp.SetShareOption(ShareOption::InApp);
+    auto remote = MakeTextData("remote", 2);
+    remote.SetRemote(true);
+    auto delay = MakeTextData("delay", 3);
+    delay.SetDelayData(true);
+    PasteData empty;
+    EXPECT_EQ(history.Add(USER_ID, inApp), 0);
+    EXPECT_EQ(history.Add(USER_ID, remote), 0);
+    EXPECT_EQ(history.Add(USER_ID, delay), 0);
+    EXPECT_EQ(history.Add(USER_ID, empty), 0);
+    EXPECT_TRUE(history.GetSummaries(USER_ID).empty());
+    EXPECT_EQ(history.GetStats().skipped, 4);
+}
+
+/**
+ * @tc.name: AddTest003
+ * @tc.desc: Test the oldest clips of a user are dropped past the clip count limit.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardClipHistoryTest, AddTest003, TestSize.Level0)
+{
+    constexpr size_t maxClips = 3;
+    ClipHistory history(MakeConfig(maxClips, ""));
+    std::vector<uint32_t> clipIds;
+    for (uint32_t i = 0; i < maxClips + 2; ++i) {
+        auto data = MakeTextData("text" + std::to_string(i), i);
+        clipIds.push_back(history.Add(USER_ID, data));
+    }
+    auto other = MakeTextData("other", 0);
+    history.Add(OTHER_USER_ID, other);
+
+    auto summaries = history.GetSummaries(USER_ID);
+    ASSERT_EQ(summaries.size(), maxClips);
+    EXPECT_EQ(summaries[0].clipId, clipIds.back());
+    EXPECT_EQ(summaries[maxClips - 1].clipId, clipIds[2]);
+    EXPECT_EQ(history.Get(USER_ID, clipIds[0]), nullptr);
+    EXPECT_EQ(history.GetSummaries(OTHER_USER_ID).size(), 1);
+    EXPECT_EQ(history.GetStats().evicted, 2);
+
+    history.RemoveUser(USER_ID);
+    EXPECT_TRUE(history.GetSummaries(USER_ID).empty());
+    EXPECT_EQ(history.GetSummaries(OTHER_USER_ID).size(), 1);
+}
+
+/**
+ * @tc.name: AddTest004
+ * @tc.desc: Test a copy of the same content by another app takes over the owner and the share option of the entry.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardClipHistoryTest, AddTest004, TestSize.Level0)
+{
+    ClipHistory history(MakeConfig(ClipHistory::Config().maxClips, ""));
+    auto hello = MakeTextData("hello", 1);
+    auto helloAgain = MakeTextData("hello", 2);
+    helloAgain.SetBundleInfo("com.example.other");
+    helloAgain.SetShareOption(ShareOption::LocalDevice);
+    uint32_t clipId = history.Add(USER_ID, hello);
+    ASSERT_NE(clipId, 0);
+    EXPECT_EQ(history.Add(USER_ID, helloAgain), clipId);
+
+    auto summaries = history.GetSummaries(USER_ID);
+    ASSERT_EQ(summaries.size(), 1);
+    EXPECT_EQ(summaries[0].bundleName, "com.example.other");
+    auto data = history.Get(USER_ID, clipId);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(data->GetShareOption(), ShareOption::LocalDevice);
+}
+
+/**
+ * @tc.name: AddTest005
+ * @tc.desc: Test a clip encoded before the history of its user is removed is not added after it.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardClipHistoryTest, AddTest005, TestSize.Level0)
+{
+    ClipHistory history(MakeConfig(ClipHistory::Config().maxClips, ""));
+    auto hello = MakeTextData("hello", 1);
+    uint64_t generation = history.GetGeneration(USER_ID);
+    ClipHistory::Clip clip;
+    ASSERT_TRUE(history.Encode(hello, clip));
+    history.RemoveUser(USER_ID);
+    EXPECT_EQ(history.Add(USER_ID, std::move(clip), generation), 0);
+    EXPECT_TRUE(history.GetSummaries(USER_ID).empty());
+
+    generation = history.GetGeneration(OTHER_USER_ID);
+    ClipHistory::Clip otherClip;
+    ASSERT_TRUE(history.Encode(hello, otherClip));
+    history.Clear();
+    EXPECT_EQ(history.Add(OTHER_USER_ID, std::move(otherClip), generation), 0);
+    EXPECT_EQ(history.GetStats().skipped, 2);
+
+    generation = history.GetGeneration(USER_ID);
+    ClipHistory::Clip newClip;
+    ASSERT_TRUE(history.Encode(hello, newClip));
+    EXPECT_NE(history.Add(USER_ID, std::move(newClip), generation), 0);
+}
+
+/**
+ * @tc.name: SpillTest001
+ * @tc.desc: Test large clips are spilled to files past the memory budget and read back.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardClipHistoryTest, SpillTest001, TestSize.Level0)
+{
+    constexpr size_t largeSize = 64 * 1024;
+    std::vector<uint8_t> tlv;
+    ASSERT_TRUE(MakeTextData(std::string(largeSize, 'a'), 0).Encode(tlv));
+    size_t clipSize = tlv.size();
+    // room for one large clip in memory and two and a half on disk
+    auto config = MakeConfig(ClipHistory::Config().maxClips, SPILL_ROOT);
+    config.memoryBudget = clipSize + clipSize / 2;
+    config.spillThreshold = clipSize / 2;
+    config.diskBudget = clipSize * 2 + clipSize / 2;
+    {
+        ClipHistory history(config);
+        std::vector<uint32_t> clipIds;
+        for (char c = 'a'; c < 'e'; ++c) {
+            auto data = MakeTextData(std::string(largeSize, c), c);
+            clipIds.push_back(history.Add(USER_ID, data));
+        }
+        auto stats = history.GetStats();
+        EXPECT_LE(stats.residentBytes, config.memoryBudget);
+        EXPECT_LE(stats.spilledBytes, config.diskBudget);
+        EXPECT_GT(stats.spilled, 0);
+        EXPECT_EQ(stats.evicted, 1);
+        EXPECT_EQ(CountFiles(SPILL_DIR), 2);
+
+        auto data = history.Get(USER_ID, clipIds[1]);
+        ASSERT_NE(data, nullptr);
+        ASSERT_NE(data->GetPrimaryText(), nullptr);
+        EXPECT_EQ(*data->GetPrimaryText(), std::string(largeSize, 'b'));
+        EXPECT_EQ(history.GetStats().reloaded, 1);
+        EXPECT_EQ(history.Get(USER_ID, clipIds[0]), nullptr);
+        auto small = MakeTextData("small", 0);
+        EXPECT_NE(history.Add(USER_ID, small), 0);
+
+        history.RemoveUser(USER_ID);
+        EXPECT_EQ(CountFiles(SPILL_DIR), 0);
+        auto again = MakeTextData(std::string(largeSize, 'a'), 0);
+        auto another = MakeTextData(std::string(largeSize, 'b'), 0);
+        history.Add(USER_ID, again);
+        history.Add(USER_ID, another);
+        EXPECT_EQ(CountFiles(SPILL_DIR), 1);
+    }
+    EXPECT_EQ(CountFiles(SPILL_DIR), 0);
+}
+} // namespace OHOS::MiscServices
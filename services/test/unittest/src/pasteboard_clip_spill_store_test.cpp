@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+
+#include "pasteboard_clip_spill_store.h"
+
+namespace OHOS::MiscServices {
+using namespace testing::ext;
+namespace {
+const std::string SPILL_ROOT = "/data/local/tmp/pasteboard_clip_spill_store_test";
+constexpr int32_t USER_ID = 100;
+constexpr int32_t OTHER_USER_ID = 101;
+const std::string USER_DIR = SPILL_ROOT + "/" + std::to_string(USER_ID);
+const std::string SPILL_DIR = USER_DIR + "/clips";
+constexpr uint32_t DATA_ID = 7;
+constexpr size_t LARGE_SIZE = 64 * 1024;
+constexpr size_t SMALL_SIZE = 16;
+constexpr uint64_t NOW_MS = 1000000;
+
+ClipSpillStore::Config MakeConfig()
+{
+    ClipSpillStore::Config config;
+    config.residentBudget = LARGE_SIZE;
+    config.spillThreshold = LARGE_SIZE;
+    config.residentRecordSize = LARGE_SIZE / 2;
+    config.spillRoot = SPILL_ROOT;
+    config.spillDir = "clips";
+    return config;
+}
+} // namespace
+
+class PasteboardClipSpillStoreTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void PasteboardClipSpillStoreTest::SetUpTestCase(void)
+{
+    mkdir(SPILL_ROOT.c_str(), S_IRWXU);
+    mkdir(USER_DIR.c_str(), S_IRWXU);
+}
+
+void PasteboardClipSpillStoreTest::TearDownTestCase(void)
+{
+    rmdir(SPILL_DIR.c_str());
+    rmdir(USER_DIR.c_str());
+    rmdir(SPILL_ROOT.c_str());
+}
+
+void PasteboardClipSpillStoreTest::SetUp(void) {}
+
+void PasteboardClipSpillStoreTest::TearDown(void) {}
+
+/**
+ * @tc.name: SelectSpillTest001
+ * @tc.desc: Test only idle large clips are spilled, the least recently used first, until the budget is met.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardClipSpillStoreTest, SelectSpillTest001, TestSize.Level0)
+{
+    ClipSpillStore store(MakeConfig());
+    auto idleTime = MakeConfig().idleTime;
+    store.Touch(USER_ID, NOW_MS - idleTime - 1);
+    store.Touch(OTHER_USER_ID, NOW_MS - idleTime - 2);
+    std::vector<ClipSpillStore::Clip> clips = {
+        { USER_ID, LARGE_SIZE, true },
+        { OTHER_USER_ID, LARGE_SIZE, true },
+    };
+    auto users = store.SelectSpill(clips, NOW_MS, false);
+    ASSERT_EQ(users.size(), 1);
+    EXPECT_EQ(users[0], OTHER_USER_ID);
+
+    users = store.SelectSpill(clips, NOW_MS, true);
+    ASSERT_EQ(users.size(), 2);
+    EXPECT_EQ(users[1], USER_ID);
+
+    store.Touch(USER_ID, NOW_MS);
+    clips[1].spillable = false;
+    EXPECT_TRUE(store.SelectSpill(clips, NOW_MS, true).empty());
+
+    clips = { { USER_ID, SMALL_SIZE, true } };
+    EXPECT_TRUE(store.SelectSpill(clips, NOW_MS + idleTime, true).empty());
+}
+
+/**
+ * @tc.name: SpillTest001
+ * @tc.desc: Test a spilled clip keeps its metadata and small records in the shell and is restored once.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardClipSpillStoreTest, SpillTest001, TestSize.Level0)
+{
+    ClipSpillStore store(MakeConfig());
+    PasteData data;
+    data.AddTextRecord("small");
+    data.AddHtmlRecord(std::string(LARGE_SIZE, 'h'));
+    data.SetDataId(DATA_ID);
+    data.SetBundleInfo("com.example.copy");
+    data.rawDataSize_ = static_cast<int64_t>(LARGE_SIZE);
+
+    auto shell = store.Spill(USER_ID, data);
+    ASSERT_NE(shell, nullptr);
+    EXPECT_TRUE(store.IsSpilled(USER_ID, shell));
+    EXPECT_FALSE(store.IsSpilled(OTHER_USER_ID, shell));
+    EXPECT_EQ(shell->GetDataId(), DATA_ID);
+    EXPECT_EQ(shell->GetBundleName(), "com.example.copy");
+    EXPECT_EQ(shell->GetRecordCount(), data.GetRecordCount());
+    EXPECT_EQ(shell->GetMimeTypes(), data.GetMimeTypes());
+    ASSERT_NE(shell->GetPrimaryText(), nullptr);
+    EXPECT_EQ(*shell->GetPrimaryText(), "small");
+    EXPECT_GT(store.GetStats().spilledBytes, LARGE_SIZE);
+
+    auto restored = store.Restore(USER_ID, shell);
+    ASSERT_NE(restored, nullptr);
+    ASSERT_NE(restored->GetPrimaryHtml(), nullptr);
+    EXPECT_EQ(restored->GetPrimaryHtml()->size(), LARGE_SIZE);
+    EXPECT_EQ(restored->GetDataId(), DATA_ID);
+    EXPECT_FALSE(store.IsSpilled(USER_ID, shell));
+    EXPECT_EQ(store.Restore(USER_ID, shell), nullptr);
+
+    auto stats = store.GetStats();
+    EXPECT_EQ(stats.spilled, 1);
+    EXPECT_EQ(stats.restored, 1);
+    EXPECT_EQ(stats.clips, 0);
+    EXPECT_EQ(stats.spilledBytes, 0);
+}
+
+/**
+ * @tc.name: SpillTest002
+ * @tc.desc: Test a removed or replaced spill is not restored and a clip is not spilled without its user dir.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardClipSpillStoreTest, SpillTest002, TestSize.Level0)
+{
+    ClipSpillStore store(MakeConfig());
+    PasteData data;
+    data.AddHtmlRecord(std::string(LARGE_SIZE, 'h'));
+    auto shell = store.Spill(USER_ID, data);
+    ASSERT_NE(shell, nullptr);
+    store.Remove(USER_ID);
+    EXPECT_EQ(store.Restore(USER_ID, shell), nullptr);
+
+    shell = store.Spill(USER_ID, data);
+    auto other = store.Spill(USER_ID, data);
+    ASSERT_NE(other, nullptr);
+    EXPECT_FALSE(store.IsSpilled(USER_ID, shell));
+    EXPECT_TRUE(store.IsSpilled(USER_ID, other));
+    EXPECT_EQ(store.GetStats().clips, 1);
+    store.Clear();
+    EXPECT_EQ(store.GetStats().spilledBytes, 0);
+    EXPECT_EQ(store.Spill(OTHER_USER_ID, data), nullptr);
+
+    auto config = MakeConfig();
+    config.spillDir = "";
+    ClipSpillStore memoryOnly(config);
+    EXPECT_EQ(memoryOnly.Spill(USER_ID, data), nullptr);
+    EXPECT_EQ(memoryOnly.GetStats().spillFailed, 1);
+}
+} // namespace OHOS::MiscServices
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "pasteboard_ctrlv_grant_table.h"
+
+namespace OHOS::MiscServices {
+using namespace testing::ext;
+namespace {
+constexpr uint64_t NOW_MS = 100000;
+constexpr int32_t PID = 1;
+constexpr int32_t OTHER_PID = 2;
+constexpr int32_t WINDOW_ID = 10;
+constexpr uint32_t WAIT_MS = 100;
+constexpr uint32_t LONG_WAIT_MS = 5000;
+} // namespace
+
+class PasteboardCtrlVGrantTableTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void PasteboardCtrlVGrantTableTest::SetUpTestCase(void) {}
+
+void PasteboardCtrlVGrantTableTest::TearDownTestCase(void) {}
+
+void PasteboardCtrlVGrantTableTest::SetUp(void) {}
+
+void PasteboardCtrlVGrantTableTest::TearDown(void) {}
+
+/**
+ * @tc.name: ConsumeTest001
+ * @tc.desc: Test a grant is matched by pid or focus within its window and is used once.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardCtrlVGrantTableTest, ConsumeTest001, TestSize.Level0)
+{
+    CtrlVGrantTable table;
+    EXPECT_FALSE(table.Consume(PID, true, NOW_MS, WAIT_MS));
+
+    table.Record(PID, WINDOW_ID, NOW_MS);
+    EXPECT_FALSE(table.Consume(OTHER_PID, false, NOW_MS, WAIT_MS));
+    EXPECT_TRUE(table.Consume(PID, false, NOW_MS + CtrlVGrantTable::GRANT_WINDOW_MS - 1, WAIT_MS));
+    EXPECT_FALSE(table.Consume(PID, false, NOW_MS, WAIT_MS));
+
+    table.Record(PID, WINDOW_ID, NOW_MS);
+    EXPECT_TRUE(table.Consume(OTHER_PID, true, NOW_MS, WAIT_MS));
+
+    table.Record(PID, WINDOW_ID, NOW_MS);
+    EXPECT_FALSE(table.Consume(PID, true, NOW_MS + CtrlVGrantTable::GRANT_WINDOW_MS, WAIT_MS));
+    EXPECT_FALSE(table.Consume(PID, true, NOW_MS - 1, WAIT_MS));
+
+    auto stats = table.GetStats();
+    EXPECT_EQ(stats.recorded, 3);
+    EXPECT_EQ(stats.granted, 2);
+    EXPECT_EQ(stats.denied, 5);
+    EXPECT_EQ(stats.waited, 0);
+}
+
+/**
+ * @tc.name: ConsumeTest002
+ * @tc.desc: Test a check waits only while a Ctrl key is down and ends when the Ctrl+V event arrives.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardCtrlVGrantTableTest, ConsumeTest002, TestSize.Level0)
+{
+    CtrlVGrantTable table;
+    table.MarkInFlight(NOW_MS);
+    EXPECT_FALSE(table.Consume(PID, false, NOW_MS, WAIT_MS));
+    EXPECT_EQ(table.GetStats().waited, 1);
+
+    std::thread keyEvent([&table] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_MS));
+        table.Record(PID, WINDOW_ID, NOW_MS + 1);
+    });
+    auto begin = std::chrono::steady_clock::now();
+    EXPECT_TRUE(table.Consume(PID, false, NOW_MS, LONG_WAIT_MS));
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    keyEvent.join();
+    EXPECT_LT(elapsed, std::chrono::milliseconds(LONG_WAIT_MS));
+
+    table.MarkInFlight(NOW_MS);
+    table.ClearInFlight();
+    EXPECT_FALSE(table.Consume(PID, false, NOW_MS, LONG_WAIT_MS));
+    EXPECT_EQ(table.GetStats().waited, 2);
+}
+
+/**
+ * @tc.name: PruneTest001
+ * @tc.desc: Test stale grants are pruned and the table keeps one grant per pid up to its limit.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardCtrlVGrantTableTest, PruneTest001, TestSize.Level0)
+{
+    CtrlVGrantTable table;
+    table.Record(PID, WINDOW_ID, NOW_MS);
+    table.Record(PID, WINDOW_ID, NOW_MS + 1);
+    table.Record(OTHER_PID, WINDOW_ID, NOW_MS + CtrlVGrantTable::GRANT_WINDOW_MS);
+    EXPECT_EQ(table.GetStats().grants, 2);
+    EXPECT_EQ(table.Prune(NOW_MS + CtrlVGrantTable::GRANT_WINDOW_MS + 1), 1);
+    EXPECT_FALSE(table.IsEmpty());
+    EXPECT_EQ(table.Prune(NOW_MS + CtrlVGrantTable::GRANT_WINDOW_MS * 2), 1);
+    EXPECT_TRUE(table.IsEmpty());
+
+    for (int32_t pid = 0; pid < static_cast<int32_t>(CtrlVGrantTable::MAX_GRANTS) + 1; ++pid) {
+        table.Record(pid, WINDOW_ID, NOW_MS);
+    }
+    EXPECT_EQ(table.GetStats().grants, CtrlVGrantTable::MAX_GRANTS);
+    EXPECT_FALSE(table.Consume(0, false, NOW_MS, WAIT_MS));
+    EXPECT_TRUE(table.Consume(1, false, NOW_MS, WAIT_MS));
+    table.Clear();
+    EXPECT_TRUE(table.IsEmpty());
+}
+} // namespace OHOS::MiscServices
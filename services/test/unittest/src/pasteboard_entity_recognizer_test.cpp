@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "errors.h"
+#include "pasteboard_entity_recognizer.h"
+#include "pasteboard_error.h"
+
+namespace OHOS::MiscServices {
+using namespace testing::ext;
+namespace {
+constexpr uint32_t WAIT_TIMEOUT_MS = 2000;
+constexpr uint32_t WAIT_INTERVAL_MS = 5;
+const std::string TEST_TEXT = "No. 1 West Lake Road";
+const std::string TEST_LOCATION = "[\"West Lake Road\"]";
+
+class FakeProcessor : public IPasteDataProcessor {
+public:
+    int32_t Process(const std::string &data, std::string &result) override
+    {
+        processed++;
+        result = data;
+        return ERR_OK;
+    }
+    std::atomic<uint32_t> processed = 0;
+};
+
+template<typename _Pred>
+bool WaitFor(_Pred pred)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(WAIT_TIMEOUT_MS);
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_INTERVAL_MS));
+    }
+    return true;
+}
+} // namespace
+
+class EntityRecognizerTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+
+protected:
+    EntityRecognizer::Extractor extractor_ = [](const std::string &entity, std::string &location) {
+        location = TEST_LOCATION;
+        return static_cast<int32_t>(PasteboardError::E_OK);
+    };
+    EntityRecognizer::EngineLoader loader_ = [this]() {
+        loads_++;
+        return EntityRecognizer::Engine{ nullptr, &processor_ };
+    };
+    FakeProcessor processor_;
+    std::atomic<uint32_t> loads_ = 0;
+    std::atomic<uint32_t> notified_ = 0;
+};
+
+void EntityRecognizerTest::SetUpTestCase(void) {}
+
+void EntityRecognizerTest::TearDownTestCase(void) {}
+
+void EntityRecognizerTest::SetUp(void) {}
+
+void EntityRecognizerTest::TearDown(void) {}
+
+/**
+ * @tc.name: NotResidentTest
+ * @tc.desc: Test the engine is not loaded while the recognizer is not resident
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(EntityRecognizerTest, NotResidentTest, TestSize.Level0)
+{
+    EntityRecognizer recognizer(extractor_, [this](std::string &location, uint32_t dataLength) {
+        notified_++;
+    }, loader_);
+    EXPECT_FALSE(recognizer.Recognize(1, ""));
+    EXPECT_TRUE(recognizer.Recognize(1, TEST_TEXT));
+    EXPECT_TRUE(WaitFor([&recognizer]() {
+        return recognizer.GetStats().failed == 1;
+    }));
+    EXPECT_EQ(loads_, 0);
+    EXPECT_EQ(notified_, 0);
+    EXPECT_FALSE(recognizer.IsEngineLoaded());
+}
+
+/**
+ * @tc.name: ResidentTest
+ * @tc.desc: Test the engine is loaded once while resident and unloaded when no longer resident
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(EntityRecognizerTest, ResidentTest, TestSize.Level0)
+{
+    uint32_t notifiedLength = 0;
+    EntityRecognizer recognizer(extractor_, [this, &notifiedLength](std::string &location, uint32_t dataLength) {
+        EXPECT_EQ(location, TEST_LOCATION);
+        notifiedLength = dataLength;
+        notified_++;
+    }, loader_);
+    recognizer.SetResident(true);
+    EXPECT_FALSE(recognizer.IsEngineLoaded());
+    EXPECT_TRUE(recognizer.Recognize(1, TEST_TEXT));
+    EXPECT_TRUE(WaitFor([this]() {
+        return notified_ == 1;
+    }));
+    EXPECT_TRUE(recognizer.Recognize(2, TEST_TEXT));
+    EXPECT_TRUE(WaitFor([this]() {
+        return notified_ == 2;
+    }));
+    EXPECT_EQ(notifiedLength, TEST_TEXT.size());
+    EXPECT_EQ(loads_, 1);
+    EXPECT_EQ(processor_.processed, 2);
+    EXPECT_TRUE(recognizer.IsEngineLoaded());
+    EXPECT_EQ(recognizer.GetStats().engineLoads, 1);
+
+    recognizer.SetResident(false);
+    EXPECT_FALSE(recognizer.IsEngineLoaded());
+}
+
+/**
+ * @tc.name: CacheHitTest
+ * @tc.desc: Test the same data is recognized only once
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(EntityRecognizerTest, CacheHitTest, TestSize.Level0)
+{
+    EntityRecognizer recognizer(extractor_, [this](std::string &location, uint32_t dataLength) {
+        EXPECT_EQ(location, TEST_LOCATION);
+        notified_++;
+    }, loader_);
+    recognizer.SetResident(true);
+    EXPECT_TRUE(recognizer.Recognize(1, TEST_TEXT));
+    EXPECT_TRUE(WaitFor([this]() {
+        return notified_ == 1;
+    }));
+    EXPECT_TRUE(recognizer.Recognize(1, TEST_TEXT));
+    EXPECT_TRUE(WaitFor([&recognizer]() {
+        return recognizer.GetStats().notified == 2;
+    }));
+    EXPECT_EQ(notified_, 2);
+    EXPECT_EQ(processor_.processed, 1);
+    EXPECT_EQ(recognizer.GetStats().cacheHits, 1);
+}
+} // namespace OHOS::MiscServices
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "pasteboard_pixel_map_preview.h"
+
+namespace OHOS::MiscServices {
+using namespace testing::ext;
+using namespace OHOS::Media;
+namespace {
+constexpr int32_t USER_ID = 100;
+constexpr uint32_t DATA_ID = 7;
+constexpr uint32_t RECORD_ID = 1;
+constexpr int32_t MAX_EDGE = 16;
+
+std::shared_ptr<PixelMap> CreatePixelMap(int32_t width, int32_t height)
+{
+    std::vector<uint32_t> color(static_cast<size_t>(width) * static_cast<size_t>(height), 0xFF0000FF);
+    InitializationOptions opts = { { width, height }, PixelFormat::RGBA_8888, PixelFormat::RGBA_8888 };
+    std::unique_ptr<PixelMap> pixelMap = PixelMap::Create(color.data(), color.size(), opts);
+    return std::shared_ptr<PixelMap>(std::move(pixelMap));
+}
+
+PixelMapPreviewCache::Config MakeConfig()
+{
+    PixelMapPreviewCache::Config config;
+    config.maxEdge = MAX_EDGE;
+    config.maxRecords = 1;
+    return config;
+}
+} // namespace
+
+class PasteboardPixelMapPreviewTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void PasteboardPixelMapPreviewTest::SetUpTestCase(void) {}
+
+void PasteboardPixelMapPreviewTest::TearDownTestCase(void) {}
+
+void PasteboardPixelMapPreviewTest::SetUp(void) {}
+
+void PasteboardPixelMapPreviewTest::TearDown(void) {}
+
+/**
+ * @tc.name: GetTest001
+ * @tc.desc: Test a large pixel map is previewed within the max edge keeping its aspect ratio, and built once.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardPixelMapPreviewTest, GetTest001, TestSize.Level0)
+{
+    PixelMapPreviewCache cache(MakeConfig());
+    auto source = CreatePixelMap(MAX_EDGE * 4, MAX_EDGE * 2);
+    ASSERT_NE(source, nullptr);
+    EXPECT_TRUE(cache.NeedPreview(*source));
+
+    auto preview = cache.Get(USER_ID, DATA_ID, RECORD_ID, source);
+    ASSERT_NE(preview, nullptr);
+    EXPECT_EQ(preview->GetWidth(), MAX_EDGE);
+    EXPECT_EQ(preview->GetHeight(), MAX_EDGE / 2);
+    EXPECT_EQ(cache.Get(USER_ID, DATA_ID, RECORD_ID, source), preview);
+
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.built, 1);
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.previews, 1);
+    EXPECT_GT(stats.bytes, 0);
+}
+
+/**
+ * @tc.name: GetTest002
+ * @tc.desc: Test a small pixel map is its own preview and previews are dropped with the clip.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteboardPixelMapPreviewTest, GetTest002, TestSize.Level0)
+{
+    PixelMapPreviewCache cache(MakeConfig());
+    auto small = CreatePixelMap(MAX_EDGE, MAX_EDGE / 2);
+    ASSERT_NE(small, nullptr);
+    EXPECT_FALSE(cache.NeedPreview(*small));
+    EXPECT_EQ(cache.Get(USER_ID, DATA_ID, RECORD_ID, small), small);
+    EXPECT_EQ(cache.Get(USER_ID, DATA_ID, RECORD_ID, nullptr), nullptr);
+
+    auto source = CreatePixelMap(MAX_EDGE * 2, MAX_EDGE * 2);
+    ASSERT_NE(source, nullptr);
+    auto preview = cache.Get(USER_ID, DATA_ID, RECORD_ID, source);
+    ASSERT_NE(preview, nullptr);
+    EXPECT_NE(cache.Get(USER_ID, DATA_ID + 1, RECORD_ID, source), preview);
+    // over maxRecords, built again on every request
+    EXPECT_NE(cache.Get(USER_ID, DATA_ID + 1, RECORD_ID + 1, source), nullptr);
+    EXPECT_EQ(cache.GetStats().previews, 1);
+
+    cache.Remove(USER_ID);
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.previews, 0);
+    EXPECT_EQ(stats.built, 3);
+    EXPECT_EQ(stats.hits, 0);
+}
+} // namespace OHOS::MiscServices
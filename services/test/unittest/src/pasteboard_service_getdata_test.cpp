@@ -14,6 +14,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #include "ipc_skeleton.h"
 #include "message_parcel_warp.h"
@@ -41,6 +42,11 @@ const int32_t ACCOUNT_IDS_RANDOM = 1121;
 const uint32_t UINT32_ONE = 1;
 constexpr int64_t MIN_ASHMEM_DATA_SIZE = 32 * 1024;
 constexpr uint32_t EVENT_TIME_OUT = 2000;
+constexpr uint32_t SPILL_DATA_ID = 7;
+constexpr size_t SPILL_HTML_SIZE = 64 * 1024;
+// a peer version that takes the clip as it is, without fetching delayed content
+constexpr uint8_t PEER_VERSION = 2;
+const std::string SPILL_ROOT = "/data/local/tmp/pasteboard_service_getdata_test";
 const std::string TEST_ENTITY_TEXT =
     "清晨，从杭州市中心出发，沿着湖滨路缓缓前行。湖滨路是杭州市中心通往西湖的主要街道之一，两旁绿树成荫，湖光山色尽收眼"
     "底。你可以选择步行或骑行，感受微风拂面的惬意。湖滨路的尽头是南山路，这里有一片开阔的广场，是欣赏西湖全景的绝佳位置"
@@ -465,6 +471,49 @@ HWTEST_F(PasteboardServiceGetDataTest, GetDistributedDelayDataTest001, TestSize.
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetDistributedDelayDataTest001 end");
 }
 
+/**
+ * @tc.name: GetDistributedDelayDataTest002
+ * @tc.desc: test Func GetDistributedDelayData sends the content of a spilled clip, not its shell
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceGetDataTest, GetDistributedDelayDataTest002, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetDistributedDelayDataTest002 start");
+    auto tempPasteboard = std::make_shared<PasteboardService>();
+    ASSERT_NE(tempPasteboard, nullptr);
+    const std::string userDir = SPILL_ROOT + "/" + std::to_string(ACCOUNT_IDS_RANDOM);
+    mkdir(SPILL_ROOT.c_str(), S_IRWXU);
+    mkdir(userDir.c_str(), S_IRWXU);
+    tempPasteboard->clipSpill_.config_.spillRoot = SPILL_ROOT;
+    tempPasteboard->clipSpill_.config_.spillDir = "clips";
+
+    PasteData data;
+    data.AddHtmlRecord(std::string(SPILL_HTML_SIZE, 'h'));
+    data.SetDataId(SPILL_DATA_ID);
+    auto shell = tempPasteboard->clipSpill_.Spill(ACCOUNT_IDS_RANDOM, data);
+    ASSERT_NE(shell, nullptr);
+    tempPasteboard->clips_.InsertOrAssign(ACCOUNT_IDS_RANDOM, shell);
+
+    TestEvent event;
+    event.user = ACCOUNT_IDS_RANDOM;
+    event.dataId = SPILL_DATA_ID;
+    std::vector<uint8_t> rawData;
+    int32_t ret = tempPasteboard->GetDistributedDelayData(event, PEER_VERSION, rawData);
+    EXPECT_EQ(ret, static_cast<int32_t>(PasteboardError::E_OK));
+    EXPECT_FALSE(tempPasteboard->clipSpill_.IsSpilled(ACCOUNT_IDS_RANDOM, shell));
+    PasteData received;
+    ASSERT_TRUE(received.Decode(rawData));
+    ASSERT_NE(received.GetPrimaryHtml(), nullptr);
+    EXPECT_EQ(received.GetPrimaryHtml()->size(), SPILL_HTML_SIZE);
+
+    tempPasteboard->clips_.Erase(ACCOUNT_IDS_RANDOM);
+    tempPasteboard->clipSpill_.Clear();
+    rmdir((userDir + "/clips").c_str());
+    rmdir(userDir.c_str());
+    rmdir(SPILL_ROOT.c_str());
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetDistributedDelayDataTest002 end");
+}
+
 /**
  * @tc.name: GetDistributedDelayEntryTest001
  * @tc.desc: test Func GetDistributedDelayEntry
@@ -18,6 +18,7 @@
 #include <gmock/gmock.h>
 #include <thread>
 
+#include "ability_manager_client.h"
 #include "accesstoken_kit.h"
 #include "default_clip.h"
 #include "dev_profile.h"
@@ -163,6 +164,7 @@ public:
     virtual void RegisterCommand(std::shared_ptr<Command> &cmd) = 0;
     virtual int32_t GetDefaultInputMethod(std::shared_ptr<MiscServices::Property> &property) = 0;
     virtual bool GetBoolParameter(const std::string &key, bool defaultValue) = 0;
+    virtual ErrCode CheckUIExtensionIsFocused(uint32_t uiExtensionTokenId, bool &isFocused) = 0;
 };
 
 class PasteboardServiceInterfaceMock : public PasteboardServiceInterface {
@@ -199,6 +201,7 @@ public:
     MOCK_CONST_METHOD2(Dump, bool(int fd, const std::vector<std::string> &args));
     MOCK_METHOD1(GetDefaultInputMethod, int32_t(std::shared_ptr<MiscServices::Property> &property));
     MOCK_METHOD2(GetBoolParameter, bool(const std::string &key, bool defaultValue));
+    MOCK_METHOD2(CheckUIExtensionIsFocused, ErrCode(uint32_t uiExtensionTokenId, bool &isFocused));
 };
 
 static void *g_interface = nullptr;
@@ -468,6 +471,15 @@ bool OHOS::system::GetBoolParameter(const std::string &key, bool defaultValue)
     return interface->GetBoolParameter(key, defaultValue);
 }
 
+ErrCode AAFwk::AbilityManagerClient::CheckUIExtensionIsFocused(uint32_t uiExtensionTokenId, bool &isFocused)
+{
+    PasteboardServiceInterface *interface = GetPasteboardServiceInterface();
+    if (interface == nullptr) {
+        return INT32_NEGATIVE_NUMBER;
+    }
+    return interface->CheckUIExtensionIsFocused(uiExtensionTokenId, isFocused);
+}
+
 namespace MiscServices {
     int32_t InputMethodController::SendPrivateCommand(
         const std::unordered_map<std::string, PrivateDataValue> &privateCommand)
@@ -3541,5 +3553,27 @@ HWTEST_F(PasteboardServiceTest, SyncDelayedData001, TestSize.Level0)
     EXPECT_EQ(setData->GetMimeTypes().size(), 1);
     EXPECT_STREQ(setData->GetMimeTypes()[0].c_str(), MIMETYPE_TEXT_PLAIN);
 }
+
+/**
+ * @tc.name: IsFocusedAppTest001
+ * @tc.desc: test Func IsFocusedApp follows a UI extension focus change right away
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceTest, IsFocusedAppTest001, TestSize.Level0)
+{
+    uint32_t tokenId = UINT32_ONE;
+    NiceMock<PasteboardServiceInterfaceMock> mock;
+    EXPECT_CALL(mock, GetTokenTypeFlag).WillRepeatedly(Return(ATokenTypeEnum::TOKEN_HAP));
+    EXPECT_CALL(mock, GetCallingPid).WillRepeatedly(Return(WindowManager::GetFocusWindowInfo().pid + INT_ONE));
+    EXPECT_CALL(mock, CheckUIExtensionIsFocused(tokenId, testing::_))
+        .WillOnce(DoAll(SetArgReferee<1>(true), Return(ERR_OK)))
+        .WillOnce(DoAll(SetArgReferee<1>(false), Return(ERR_OK)))
+        .WillOnce(DoAll(SetArgReferee<1>(true), Return(ERR_OK)));
+
+    PasteboardService service;
+    EXPECT_TRUE(service.IsFocusedApp(tokenId));
+    EXPECT_FALSE(service.IsFocusedApp(tokenId));
+    EXPECT_TRUE(service.IsFocusedApp(tokenId));
+}
 }
 } // namespace OHOS::MiscServices
\ No newline at end of file
@@ -20,6 +20,8 @@
 #include "pasteboard_error.h"
 #include "pasteboard_hilog.h"
 #include "pasteboard_service.h"
+#include "pasteboard_time.h"
+#include "pasteboard_window_manager.h"
 #include "paste_data_entry.h"
 #include <thread>
 
@@ -40,7 +42,6 @@ const uint32_t MAX_RECOGNITION_LENGTH = 1000;
 const int32_t ACCOUNT_IDS_RANDOM = 1121;
 const uint32_t UINT32_ONE = 1;
 constexpr int64_t MIN_ASHMEM_DATA_SIZE = 32 * 1024;
-constexpr uint32_t EVENT_TIME_OUT = 2000;
 const std::string TEST_ENTITY_TEXT =
     "清晨，从杭州市中心出发，沿着湖滨路缓缓前行。湖滨路是杭州市中心通往西湖的主要街道之一，两旁绿树成荫，湖光山色尽收眼"
     "底。你可以选择步行或骑行，感受微风拂面的惬意。湖滨路的尽头是南山路，这里有一片开阔的广场，是欣赏西湖全景的绝佳位置"
@@ -140,6 +141,23 @@ public:
     }
 };
 
+class TopEventClipPlugin : public ClipPlugin {
+public:
+    int32_t SetPasteData(const GlobalEvent &event, const std::vector<uint8_t> &data) override
+    {
+        return 0;
+    }
+    std::pair<int32_t, int32_t> GetPasteData(const GlobalEvent &event, std::vector<uint8_t> &data) override
+    {
+        return { 0, 0 };
+    }
+    std::vector<GlobalEvent> GetTopEvents(uint32_t topN, int32_t user) override
+    {
+        return events;
+    }
+    std::vector<GlobalEvent> events;
+};
+
 class PasteboardServiceTest : public testing::Test {
 public:
     static void SetUpTestCase(void);
@@ -324,11 +342,7 @@ HWTEST_F(PasteboardServiceTest, IsCtrlVProcessTest002, TestSize.Level0)
 
     uint32_t callingPid = 1;
     bool isFocused = true;
-    tempPasteboard->windowPid_ = callingPid;
-    tempPasteboard->actionTime_ = static_cast<uint64_t>(
-        duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count());
-    std::shared_ptr<BlockObject<int32_t>> block = std::make_shared<BlockObject<int32_t>>(100, 0);
-    tempPasteboard->blockMap_.insert(std::make_pair(callingPid, block));
+    tempPasteboard->grants_->Record(callingPid, 0, PasteBoardTime::GetBootTimeMs());
     auto result = tempPasteboard->IsCtrlVProcess(callingPid, isFocused);
     EXPECT_EQ(result, true);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "IsCtrlVProcessTest002 end");
@@ -347,11 +361,7 @@ HWTEST_F(PasteboardServiceTest, IsCtrlVProcessTest003, TestSize.Level0)
 
     uint32_t callingPid = 1;
     bool isFocused = true;
-    std::shared_ptr<BlockObject<int32_t>> block = nullptr;
-    tempPasteboard->blockMap_.insert(std::make_pair(callingPid, block));
-    tempPasteboard->windowPid_ = 2;
-    tempPasteboard->actionTime_ = static_cast<uint64_t>(
-        duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count());
+    tempPasteboard->grants_->Record(2, 0, PasteBoardTime::GetBootTimeMs());
     auto result = tempPasteboard->IsCtrlVProcess(callingPid, isFocused);
     EXPECT_EQ(result, true);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "IsCtrlVProcessTest003 end");
@@ -370,9 +380,7 @@ HWTEST_F(PasteboardServiceTest, IsCtrlVProcessTest004, TestSize.Level0)
 
     uint32_t callingPid = 1;
     bool isFocused = false;
-    std::shared_ptr<BlockObject<int32_t>> block = nullptr;
-    tempPasteboard->blockMap_.insert(std::make_pair(callingPid, block));
-    tempPasteboard->windowPid_ = 2;
+    tempPasteboard->grants_->Record(2, 0, PasteBoardTime::GetBootTimeMs());
     auto result = tempPasteboard->IsCtrlVProcess(callingPid, isFocused);
     EXPECT_EQ(result, false);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "IsCtrlVProcessTest004 end");
@@ -391,10 +399,8 @@ HWTEST_F(PasteboardServiceTest, IsCtrlVProcessTest005, TestSize.Level0)
 
     uint32_t callingPid = 1;
     bool isFocused = true;
-    std::shared_ptr<BlockObject<int32_t>> block = nullptr;
-    tempPasteboard->blockMap_.insert(std::make_pair(callingPid, block));
-    tempPasteboard->actionTime_ = static_cast<uint64_t>(
-        duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count()) + 2000;
+    auto actionTime = PasteBoardTime::GetBootTimeMs() + CtrlVGrantTable::GRANT_WINDOW_MS;
+    tempPasteboard->grants_->Record(callingPid, 0, actionTime);
     auto result = tempPasteboard->IsCtrlVProcess(callingPid, isFocused);
     EXPECT_EQ(result, false);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "IsCtrlVProcessTest005 end");
@@ -413,21 +419,37 @@ HWTEST_F(PasteboardServiceTest, IsCtrlVProcessTest006, TestSize.Level0)
 
     uint32_t callingPid = 1;
     bool isFocused = true;
-    std::shared_ptr<BlockObject<int32_t>> block = nullptr;
-    tempPasteboard->blockMap_.insert(std::make_pair(callingPid, block));
-    tempPasteboard->actionTime_ = static_cast<uint64_t>(
-        duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count());
-    auto result = true;
-    if (tempPasteboard->actionTime_ > EVENT_TIME_OUT) {
-        tempPasteboard->actionTime_ -= EVENT_TIME_OUT;
-    } else {
-        tempPasteboard->actionTime_ += EVENT_TIME_OUT;
-    }
-    result = tempPasteboard->IsCtrlVProcess(callingPid, isFocused);
+    auto actionTime = PasteBoardTime::GetBootTimeMs() - CtrlVGrantTable::GRANT_WINDOW_MS;
+    tempPasteboard->grants_->Record(callingPid, 0, actionTime);
+    auto result = tempPasteboard->IsCtrlVProcess(callingPid, isFocused);
     EXPECT_EQ(result, false);
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "IsCtrlVProcessTest006 end");
 }
 
+/**
+ * @tc.name: IsCtrlVProcessTest007
+ * @tc.desc: test Func IsCtrlVProcess
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceTest, IsCtrlVProcessTest007, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "IsCtrlVProcessTest007 start");
+    auto tempPasteboard = std::make_shared<InputEventCallback>();
+    EXPECT_NE(tempPasteboard, nullptr);
+
+    uint32_t callingPid = 1;
+    bool isFocused = false;
+    tempPasteboard->grants_->Record(callingPid, 0, PasteBoardTime::GetBootTimeMs());
+    EXPECT_EQ(tempPasteboard->IsCtrlVProcess(callingPid + 1, isFocused), false);
+    EXPECT_EQ(tempPasteboard->IsCtrlVProcess(callingPid, isFocused), true);
+    EXPECT_EQ(tempPasteboard->IsCtrlVProcess(callingPid, isFocused), false);
+    auto stats = tempPasteboard->GetGrantStats();
+    EXPECT_EQ(stats.granted, 1);
+    EXPECT_EQ(stats.denied, 2);
+    EXPECT_EQ(stats.grants, 0);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "IsCtrlVProcessTest007 end");
+}
+
 /**
  * @tc.name: CallbackEnterTest001
  * @tc.desc: test Func CallbackEnter
@@ -1499,6 +1521,63 @@ HWTEST_F(PasteboardServiceTest, GetFocusedAppInfoTest001, TestSize.Level0)
     PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetFocusedAppInfoTest001 end");
 }
 
+/**
+ * @tc.name: GetFocusedAppInfoTest002
+ * @tc.desc: test Func GetFocusedAppInfo answers from the focus notifications once subscribed
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceTest, GetFocusedAppInfoTest002, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetFocusedAppInfoTest002 start");
+    auto tempPasteboard = std::make_shared<PasteboardService>();
+    EXPECT_NE(tempPasteboard, nullptr);
+
+    tempPasteboard->OnRemoveWindowManager();
+    EXPECT_EQ(WindowManager::GetFocusGeneration(), 0);
+    tempPasteboard->OnAddWindowManager();
+    auto generation = WindowManager::GetFocusGeneration();
+    if (generation != 0) {
+        FocusWindowInfo info;
+        info.pid = INT_THREETHREETHREE;
+        info.windowId = INT_THREETHREETHREE;
+        WindowManager::UpdateFocus(info, true);
+        EXPECT_NE(WindowManager::GetFocusGeneration(), generation);
+        EXPECT_EQ(tempPasteboard->GetFocusedAppInfo().windowId, INT_THREETHREETHREE);
+        WindowManager::UpdateFocus(info, false);
+        EXPECT_EQ(tempPasteboard->GetFocusedAppInfo().windowId, 0);
+    }
+    tempPasteboard->OnRemoveWindowManager();
+    EXPECT_EQ(WindowManager::GetFocusGeneration(), 0);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "GetFocusedAppInfoTest002 end");
+}
+
+/**
+ * @tc.name: DumpStartupTest001
+ * @tc.desc: test Func DumpStartup sums the critical and the deferred phases apart
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceTest, DumpStartupTest001, TestSize.Level0)
+{
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "DumpStartupTest001 start");
+    auto tempPasteboard = std::make_shared<PasteboardService>();
+    EXPECT_NE(tempPasteboard, nullptr);
+
+    constexpr uint64_t costUs = 1500;
+    auto begin = std::chrono::steady_clock::now() - std::chrono::microseconds(costUs);
+    tempPasteboard->AddStartupPhase("handler", false, begin);
+    tempPasteboard->AddStartupPhase("switch", true, begin);
+    auto result = tempPasteboard->DumpStartup();
+    const std::string handler = "|critical handler:  ";
+    auto pos = result.find(handler);
+    ASSERT_NE(pos, std::string::npos);
+    // the cost is in microseconds, not milliseconds read as microseconds
+    EXPECT_GE(std::stoull(result.substr(pos + handler.size())), costUs);
+    EXPECT_NE(result.find("|deferred switch:"), std::string::npos);
+    EXPECT_NE(result.find("|critical total:"), std::string::npos);
+    EXPECT_NE(result.find("|deferred total:"), std::string::npos);
+    PASTEBOARD_HILOGI(PASTEBOARD_MODULE_SERVICE, "DumpStartupTest001 end");
+}
+
 /**
  * @tc.name: OnRemoteDiedTest001
  * @tc.desc: test Func OnRemoteDied
@@ -4167,6 +4246,111 @@ HWTEST_F(PasteboardServiceTest, SaveData004, TestSize.Level0)
     EXPECT_EQ(ret, static_cast<int32_t>(PasteboardError::E_OK));
 }
 
+/**
+ * @tc.name: SaveData005
+ * @tc.desc: test a copy with the content of the current clip only refreshes it
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceTest, SaveData005, TestSize.Level0)
+{
+    constexpr uint64_t contentHash = 1;
+    std::shared_ptr<PasteboardService> tempPasteboard = std::make_shared<PasteboardService>();
+    EXPECT_NE(tempPasteboard, nullptr);
+    PasteData pasteData;
+    pasteData.AddTextRecord("repeated");
+    int64_t dataSize = static_cast<int64_t>(pasteData.CountTLV());
+    pasteData.rawDataSize_ = dataSize;
+    PasteData repeated = pasteData;
+    int32_t ret = tempPasteboard->SaveData(pasteData, dataSize, nullptr, nullptr, contentHash);
+    ASSERT_EQ(ret, static_cast<int32_t>(PasteboardError::E_OK));
+    auto userId = tempPasteboard->GetCurrentAccountId();
+    auto changeCount = tempPasteboard->clipChangeCount_.Find(userId).second;
+
+    ret = tempPasteboard->SaveData(repeated, dataSize, nullptr, nullptr, contentHash);
+    ASSERT_EQ(ret, static_cast<int32_t>(PasteboardError::E_OK));
+    EXPECT_EQ(tempPasteboard->clipDedupHits_.load(), 1);
+    EXPECT_EQ(tempPasteboard->clipChangeCount_.Find(userId).second, changeCount + 1);
+    auto [hasData, data] = tempPasteboard->clips_.Find(userId);
+    ASSERT_TRUE(hasData && data != nullptr);
+    EXPECT_EQ(data->GetDataId(), pasteData.GetDataId());
+
+    PasteData other = repeated;
+    ret = tempPasteboard->SaveData(other, dataSize, nullptr, nullptr, contentHash + 1);
+    ASSERT_EQ(ret, static_cast<int32_t>(PasteboardError::E_OK));
+    EXPECT_EQ(tempPasteboard->clipDedupHits_.load(), 1);
+}
+
+/**
+ * @tc.name: PublishHistoryClipTest001
+ * @tc.desc: test a clip of the history is made current with the owner, share option and uri grants of its copy
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceTest, PublishHistoryClipTest001, TestSize.Level0)
+{
+    constexpr uint32_t ownerTokenId = 0x1234;
+    const std::string ownerBundle = "com.example.owner";
+    std::shared_ptr<PasteboardService> tempPasteboard = std::make_shared<PasteboardService>();
+    ASSERT_NE(tempPasteboard, nullptr);
+    auto userId = tempPasteboard->GetCurrentAccountId();
+    auto clip = std::make_shared<PasteData>();
+    clip->AddUriRecord(OHOS::Uri("file://com.example.owner/data/storage/el2/base/files/a.txt"));
+    clip->SetTokenId(ownerTokenId);
+    clip->SetShareOption(ShareOption::LocalDevice);
+    clip->SetBundleInfo(ownerBundle);
+    clip->AllRecords()[0]->SetGrantUriPermission(true);
+    auto savedDataId = clip->GetDataId();
+
+    int32_t ret = tempPasteboard->PublishHistoryClip(userId, clip);
+    ASSERT_EQ(ret, static_cast<int32_t>(PasteboardError::E_OK));
+    auto [hasData, data] = tempPasteboard->clips_.Find(userId);
+    ASSERT_TRUE(hasData && data != nullptr);
+    EXPECT_EQ(data->GetTokenId(), ownerTokenId);
+    EXPECT_EQ(data->GetShareOption(), ShareOption::LocalDevice);
+    EXPECT_EQ(data->GetBundleName(), ownerBundle);
+    ASSERT_EQ(data->GetRecordCount(), 1);
+    EXPECT_TRUE(data->AllRecords()[0]->HasGrantUriPermission());
+    EXPECT_NE(data->GetDataId(), savedDataId);
+    tempPasteboard->clips_.Erase(userId);
+}
+
+/**
+ * @tc.name: IsPublishedEventCurrentTest001
+ * @tc.desc: test a refreshed clip is published again once a peer published in between or the event expired
+ * @tc.type: FUNC
+ */
+HWTEST_F(PasteboardServiceTest, IsPublishedEventCurrentTest001, TestSize.Level0)
+{
+    constexpr uint16_t seqId = 5;
+    constexpr uint64_t validMs = 10000;
+    std::shared_ptr<PasteboardService> tempPasteboard = std::make_shared<PasteboardService>();
+    ASSERT_NE(tempPasteboard, nullptr);
+    auto plugin = std::make_shared<TopEventClipPlugin>();
+    tempPasteboard->securityLevel_.securityLevel_ = DATA_SEC_LEVEL3;
+    tempPasteboard->clipPlugin_ = plugin;
+    auto userId = tempPasteboard->GetCurrentAccountId();
+    EXPECT_FALSE(tempPasteboard->IsPublishedEventCurrent(userId));
+
+    TestEvent event;
+    event.deviceId = DMAdapter::GetInstance().GetLocalNetworkId();
+    event.seqId = seqId;
+    event.expiration = static_cast<uint64_t>(PasteBoardTime::GetBootTimeMs()) + validMs;
+    tempPasteboard->currentEvent_ = event;
+    plugin->events = { event };
+    EXPECT_TRUE(tempPasteboard->IsPublishedEventCurrent(userId));
+
+    TestEvent peerEvent = event;
+    peerEvent.deviceId = "peerNetworkId";
+    peerEvent.seqId = static_cast<uint16_t>(seqId + 1);
+    plugin->events = { peerEvent };
+    EXPECT_FALSE(tempPasteboard->IsPublishedEventCurrent(userId));
+
+    event.expiration = static_cast<uint64_t>(PasteBoardTime::GetBootTimeMs()) - 1;
+    tempPasteboard->currentEvent_ = event;
+    plugin->events = { event };
+    EXPECT_FALSE(tempPasteboard->IsPublishedEventCurrent(userId));
+    tempPasteboard->clipPlugin_ = nullptr;
+}
+
 /**
  * @tc.name: GetCommonStateTest002
  * @tc.desc: GetCommonStateTest002
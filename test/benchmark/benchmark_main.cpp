@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "benchmark_regression.h"
+#include "deduplicate_memory_benchmark.h"
+#include "global_event_benchmark.h"
+#include "paste_data_benchmark.h"
+
+using namespace OHOS::MiscServices;
+
+namespace {
+constexpr const char *BASELINE_FLAG = "--baseline=";
+constexpr const char *THRESHOLD_FLAG = "--regression_threshold=";
+
+// prints to the console as usual and keeps the real time of each run for the baseline comparison
+class RecordingReporter : public benchmark::ConsoleReporter {
+public:
+    explicit RecordingReporter(BenchmarkRegression &regression) : regression_(regression) {}
+
+    void ReportRuns(const std::vector<Run> &runs) override
+    {
+        ConsoleReporter::ReportRuns(runs);
+        for (const auto &run : runs) {
+            if (run.error_occurred || run.run_type != Run::RT_Iteration || run.iterations == 0) {
+                continue;
+            }
+            double multiplier = benchmark::GetTimeUnitMultiplier(run.time_unit);
+            double realTimeNs = run.GetAdjustedRealTime() * benchmark::GetTimeUnitMultiplier(benchmark::kNanosecond) /
+                multiplier;
+            regression_.AddResult(run.benchmark_name(), realTimeNs);
+        }
+    }
+
+private:
+    BenchmarkRegression &regression_;
+};
+
+bool TakeFlag(const char *arg, const char *flag, std::string &value)
+{
+    size_t length = strlen(flag);
+    if (strncmp(arg, flag, length) != 0) {
+        return false;
+    }
+    value = arg + length;
+    return true;
+}
+} // namespace
+
+/*
+ * Usage: PasteboardDataBenchmark [--benchmark_* flags] [--baseline=<json>] [--regression_threshold=<percent>]
+ * Record a baseline with "--benchmark_repetitions=5 --benchmark_out=<json> --benchmark_out_format=json", later runs
+ * given "--baseline=<json>" exit with 1 when a benchmark is slower than the baseline by more than the threshold,
+ * 10 percent by default. Compare runs of the same device and build type only.
+ */
+int main(int argc, char *argv[])
+{
+    std::string baselinePath;
+    std::string threshold;
+    int count = 0;
+    for (int i = 0; i < argc; ++i) {
+        if (TakeFlag(argv[i], BASELINE_FLAG, baselinePath) || TakeFlag(argv[i], THRESHOLD_FLAG, threshold)) {
+            continue;
+        }
+        argv[count++] = argv[i];
+    }
+    argc = count;
+    double thresholdPercent = BenchmarkRegression::DEFAULT_THRESHOLD_PERCENT;
+    if (!threshold.empty()) {
+        char *end = nullptr;
+        thresholdPercent = strtod(threshold.c_str(), &end);
+        if (end == nullptr || *end != '\0' || thresholdPercent < 0) {
+            std::cerr << "invalid regression threshold " << threshold << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    BenchmarkRegression regression;
+    if (!baselinePath.empty() && !regression.LoadBaseline(baselinePath)) {
+        std::cerr << "can not load baseline " << baselinePath << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return EXIT_FAILURE;
+    }
+    RegisterPasteDataBenchmarks();
+    RegisterDeduplicateMemoryBenchmarks();
+    RegisterGlobalEventBenchmarks();
+    RecordingReporter reporter(regression);
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::Shutdown();
+
+    if (baselinePath.empty()) {
+        return EXIT_SUCCESS;
+    }
+    auto changes = regression.GetChanges();
+    std::cout << "\ncompared with " << baselinePath << ", " << changes.size() << " of "
+              << regression.GetBaselineSize() << " baseline benchmarks run:\n"
+              << BenchmarkRegression::Format(changes);
+    auto regressions = regression.GetRegressions(thresholdPercent);
+    if (regressions.empty()) {
+        return EXIT_SUCCESS;
+    }
+    std::cout << regressions.size() << " benchmarks regressed by more than " << thresholdPercent << "%:\n"
+              << BenchmarkRegression::Format(regressions);
+    return EXIT_FAILURE;
+}
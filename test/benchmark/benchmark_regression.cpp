@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark_regression.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "cJSON.h"
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr double PERCENT = 100.0;
+constexpr double NS_PER_US = 1e3;
+constexpr double NS_PER_MS = 1e6;
+constexpr double NS_PER_S = 1e9;
+
+std::string GetString(const cJSON *object, const char *key)
+{
+    const cJSON *item = cJSON_GetObjectItemCaseSensitive(object, key);
+    return cJSON_IsString(item) && item->valuestring != nullptr ? std::string(item->valuestring) : "";
+}
+} // namespace
+
+bool BenchmarkRegression::LoadBaseline(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    return ParseBaseline(content.str());
+}
+
+bool BenchmarkRegression::ParseBaseline(const std::string &content)
+{
+    cJSON *root = cJSON_Parse(content.c_str());
+    if (root == nullptr) {
+        return false;
+    }
+    const cJSON *benchmarks = cJSON_GetObjectItemCaseSensitive(root, "benchmarks");
+    if (!cJSON_IsArray(benchmarks)) {
+        cJSON_Delete(root);
+        return false;
+    }
+    const cJSON *benchmark = nullptr;
+    cJSON_ArrayForEach(benchmark, benchmarks) {
+        // aggregates (mean, median, stddev) are recomputed from the iteration runs
+        std::string runType = GetString(benchmark, "run_type");
+        if (!runType.empty() && runType != "iteration") {
+            continue;
+        }
+        if (cJSON_IsTrue(cJSON_GetObjectItemCaseSensitive(benchmark, "error_occurred"))) {
+            continue;
+        }
+        std::string name = GetString(benchmark, "name");
+        const cJSON *realTime = cJSON_GetObjectItemCaseSensitive(benchmark, "real_time");
+        if (name.empty() || !cJSON_IsNumber(realTime)) {
+            continue;
+        }
+        double timeNs = ToNanoseconds(realTime->valuedouble, GetString(benchmark, "time_unit"));
+        if (timeNs > 0) {
+            KeepFastest(baseline_, name, timeNs);
+        }
+    }
+    cJSON_Delete(root);
+    return true;
+}
+
+void BenchmarkRegression::AddBaseline(const std::string &name, double realTimeNs)
+{
+    KeepFastest(baseline_, name, realTimeNs);
+}
+
+void BenchmarkRegression::AddResult(const std::string &name, double realTimeNs)
+{
+    KeepFastest(current_, name, realTimeNs);
+}
+
+std::vector<BenchmarkRegression::Change> BenchmarkRegression::GetRegressions(double thresholdPercent) const
+{
+    std::vector<Change> regressions;
+    for (const auto &change : GetChanges()) {
+        if (change.percent > thresholdPercent) {
+            regressions.push_back(change);
+        }
+    }
+    return regressions;
+}
+
+std::vector<BenchmarkRegression::Change> BenchmarkRegression::GetChanges() const
+{
+    std::vector<Change> changes;
+    for (const auto &[name, currentNs] : current_) {
+        auto it = baseline_.find(name);
+        if (it == baseline_.end() || it->second <= 0) {
+            continue;
+        }
+        Change change;
+        change.name = name;
+        change.baselineNs = it->second;
+        change.currentNs = currentNs;
+        change.percent = (currentNs - it->second) / it->second * PERCENT;
+        changes.push_back(std::move(change));
+    }
+    return changes;
+}
+
+size_t BenchmarkRegression::GetBaselineSize() const
+{
+    return baseline_.size();
+}
+
+std::string BenchmarkRegression::Format(const std::vector<Change> &changes)
+{
+    std::string result;
+    for (const auto &change : changes) {
+        char line[64] = { 0 }; // 64: room for the three columns
+        int ret = snprintf(line, sizeof(line), "  %14.0fns %14.0fns %+8.1f%%  ", change.baselineNs, change.currentNs,
+            change.percent);
+        if (ret < 0) {
+            continue;
+        }
+        result.append(line).append(change.name).append("\n");
+    }
+    return result;
+}
+
+double BenchmarkRegression::ToNanoseconds(double time, const std::string &unit)
+{
+    if (unit.empty() || unit == "ns") {
+        return time;
+    }
+    if (unit == "us") {
+        return time * NS_PER_US;
+    }
+    if (unit == "ms") {
+        return time * NS_PER_MS;
+    }
+    if (unit == "s") {
+        return time * NS_PER_S;
+    }
+    return -1;
+}
+
+void BenchmarkRegression::KeepFastest(std::map<std::string, double> &results, const std::string &name,
+    double realTimeNs)
+{
+    auto [it, inserted] = results.emplace(name, realTimeNs);
+    if (!inserted && realTimeNs < it->second) {
+        it->second = realTimeNs;
+    }
+}
+} // namespace OHOS::MiscServices
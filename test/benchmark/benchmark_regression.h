@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_TEST_BENCHMARK_REGRESSION_H
+#define PASTEBOARD_TEST_BENCHMARK_REGRESSION_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace OHOS::MiscServices {
+/*
+ * Compares the real time of each benchmark with a baseline, which is the json output of an earlier run
+ * ("--benchmark_out=<file> --benchmark_out_format=json"). With repetitions the fastest run of each benchmark is
+ * compared on both sides, it is the least noisy one.
+ */
+class BenchmarkRegression {
+public:
+    static constexpr double DEFAULT_THRESHOLD_PERCENT = 10.0;
+    struct Change {
+        std::string name;
+        double baselineNs = 0;
+        double currentNs = 0;
+        double percent = 0;
+    };
+
+    bool LoadBaseline(const std::string &path);
+    bool ParseBaseline(const std::string &content);
+    void AddBaseline(const std::string &name, double realTimeNs);
+    void AddResult(const std::string &name, double realTimeNs);
+    // the benchmarks slower than the baseline by more than thresholdPercent
+    std::vector<Change> GetRegressions(double thresholdPercent) const;
+    // the benchmarks run in both, sorted by name
+    std::vector<Change> GetChanges() const;
+    size_t GetBaselineSize() const;
+    static std::string Format(const std::vector<Change> &changes);
+    static double ToNanoseconds(double time, const std::string &unit);
+
+private:
+    static void KeepFastest(std::map<std::string, double> &results, const std::string &name, double realTimeNs);
+
+    std::map<std::string, double> baseline_;
+    std::map<std::string, double> current_;
+};
+} // namespace OHOS::MiscServices
+#endif // PASTEBOARD_TEST_BENCHMARK_REGRESSION_H
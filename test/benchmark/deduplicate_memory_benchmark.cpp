@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "deduplicate_memory_benchmark.h"
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+#include "pasteboard_deduplicate_memory.h"
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr int64_t EXPIRATION_MS = 3600 * 1000; // nothing expires while a benchmark runs
+constexpr int32_t ERROR_CODE_COUNT = 8;
+constexpr int CONCURRENT_THREADS = 4;
+const std::vector<size_t> SIZES = { 10, 1000, 100000 };
+
+// the shape of the reports remembered by the client
+struct ReportIdentity {
+    pid_t pid;
+    int32_t errorCode;
+};
+
+bool operator==(const ReportIdentity &lhs, const ReportIdentity &rhs)
+{
+    return lhs.pid == rhs.pid && lhs.errorCode == rhs.errorCode;
+}
+
+ReportIdentity MakeIdentity(size_t index)
+{
+    return { static_cast<pid_t>(index / ERROR_CODE_COUNT), static_cast<int32_t>(index % ERROR_CODE_COUNT) };
+}
+
+std::shared_ptr<DeduplicateMemory<ReportIdentity>> MakeMemory(size_t size)
+{
+    auto memory = std::make_shared<DeduplicateMemory<ReportIdentity>>(EXPIRATION_MS);
+    for (size_t i = 0; i < size; ++i) {
+        memory->IsDuplicate(MakeIdentity(i));
+    }
+    return memory;
+}
+
+void IsDuplicateHitBenchmark(benchmark::State &state, size_t size)
+{
+    auto memory = MakeMemory(size);
+    size_t index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(memory->IsDuplicate(MakeIdentity(index)));
+        index = (index + 1) % size;
+    }
+}
+
+// every report is new, the memory grows by one per iteration from the given size
+void IsDuplicateMissBenchmark(benchmark::State &state, size_t size)
+{
+    auto memory = MakeMemory(size);
+    size_t index = size;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(memory->IsDuplicate(MakeIdentity(index++)));
+    }
+}
+
+// the memory is shared by the threads of the run, each repeats reports of its own
+void IsDuplicateConcurrentBenchmark(benchmark::State &state, size_t size,
+    std::shared_ptr<std::shared_ptr<DeduplicateMemory<ReportIdentity>>> shared)
+{
+    if (state.thread_index() == 0) {
+        *shared = MakeMemory(size);
+    }
+    size_t index = static_cast<size_t>(state.thread_index());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize((*shared)->IsDuplicate(MakeIdentity(index)));
+        index = (index + CONCURRENT_THREADS) % size;
+    }
+    if (state.thread_index() == 0) {
+        state.counters["size"] = static_cast<double>((*shared)->Size());
+    }
+}
+} // namespace
+
+void RegisterDeduplicateMemoryBenchmarks()
+{
+    for (size_t size : SIZES) {
+        std::string suffix = "/" + std::to_string(size);
+        benchmark::RegisterBenchmark(("DeduplicateMemory/IsDuplicateHit" + suffix).c_str(),
+            [size](benchmark::State &state) { IsDuplicateHitBenchmark(state, size); });
+        benchmark::RegisterBenchmark(("DeduplicateMemory/IsDuplicateMiss" + suffix).c_str(),
+            [size](benchmark::State &state) { IsDuplicateMissBenchmark(state, size); });
+        auto shared = std::make_shared<std::shared_ptr<DeduplicateMemory<ReportIdentity>>>();
+        benchmark::RegisterBenchmark(("DeduplicateMemory/IsDuplicateConcurrent" + suffix).c_str(),
+            [size, shared](benchmark::State &state) { IsDuplicateConcurrentBenchmark(state, size, shared); })
+            ->Threads(CONCURRENT_THREADS);
+    }
+}
+} // namespace OHOS::MiscServices
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "global_event_benchmark.h"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "clip/clip_plugin.h"
+
+namespace OHOS::MiscServices {
+namespace {
+ClipPlugin::GlobalEvent MakeEvent(uint8_t version)
+{
+    ClipPlugin::GlobalEvent event;
+    event.version = version;
+    event.frameNum = 1;
+    event.user = 100;
+    event.seqId = 0xFFFE;
+    event.status = ClipPlugin::EVT_NORMAL;
+    event.syncTime = 12;
+    event.dataId = 0x12345678;
+    event.expiration = 0x1122334455667788;
+    event.isDelay = true;
+    event.deviceId = "networkId0123456789abcdef";
+    event.account = "account";
+    event.dataType = { "text/plain", "text/html", "text/uri", "pixelMap" };
+    event.pasteId = "GetPasteData_1234_5";
+    return event;
+}
+
+// version 0 is exchanged in JSON, TLV_VERSION in TLV
+void SerializeBenchmark(benchmark::State &state, uint8_t version)
+{
+    auto event = MakeEvent(version);
+    std::vector<uint8_t> buffer;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(event.Serialize(buffer));
+    }
+    state.counters["bytes"] = static_cast<double>(buffer.size());
+}
+
+void DeserializeBenchmark(benchmark::State &state, uint8_t version)
+{
+    std::vector<uint8_t> buffer;
+    if (!MakeEvent(version).Serialize(buffer)) {
+        state.SkipWithError("serialize event failed");
+        return;
+    }
+    for (auto _ : state) {
+        ClipPlugin::GlobalEvent event;
+        benchmark::DoNotOptimize(event.Deserialize(buffer));
+    }
+    state.counters["bytes"] = static_cast<double>(buffer.size());
+}
+} // namespace
+
+void RegisterGlobalEventBenchmarks()
+{
+    benchmark::RegisterBenchmark("GlobalEvent/Json/Serialize", SerializeBenchmark, 0);
+    benchmark::RegisterBenchmark("GlobalEvent/Tlv/Serialize", SerializeBenchmark,
+        ClipPlugin::GlobalEvent::TLV_VERSION);
+    benchmark::RegisterBenchmark("GlobalEvent/Json/Deserialize", DeserializeBenchmark, 0);
+    benchmark::RegisterBenchmark("GlobalEvent/Tlv/Deserialize", DeserializeBenchmark,
+        ClipPlugin::GlobalEvent::TLV_VERSION);
+}
+} // namespace OHOS::MiscServices
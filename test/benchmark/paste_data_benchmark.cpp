@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paste_data_benchmark.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+
+#include "paste_data.h"
+#include "paste_data_entry.h"
+#include "pasteboard_pattern.h"
+#include "pasteboard_utils.h"
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr size_t TEXT_RECORD_SIZE = 64;
+constexpr size_t ENTRY_VALUE_SIZE = 256;
+constexpr uint32_t BYTE_MASK = 0xFF;
+constexpr const char *MISSING_MIME_TYPE = "application/x-benchmark-missing";
+constexpr const char *KV_MIME_TYPE = "application/x-benchmark-kv";
+
+enum class Workload : uint32_t {
+    TEXT,
+    RECORDS,
+    HTML_IMAGES,
+    KV_BLOB,
+    ENTRIES,
+};
+
+struct WorkloadConfig {
+    const char *name;
+    Workload workload;
+    std::vector<size_t> params;
+    bool detectPatterns;
+};
+
+const std::vector<WorkloadConfig> WORKLOADS = {
+    { "Text", Workload::TEXT, { 64, 4096, 65536, 1048576 }, true },
+    { "Records", Workload::RECORDS, { 1, 16, 128, 512 }, true },
+    { "HtmlImages", Workload::HTML_IMAGES, { 1, 16, 128 }, true },
+    { "KvBlob", Workload::KV_BLOB, { 4096, 1048576, 8388608 }, false },
+    { "Entries", Workload::ENTRIES, { 4, 32, 128 }, false },
+};
+
+// deterministic content without digits, so pattern detection scans the whole text before the trailing url matches
+std::string MakeText(size_t size)
+{
+    static const std::string words = "lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor ";
+    std::string text;
+    text.reserve(size);
+    while (text.size() < size) {
+        text.append(words, 0, std::min(words.size(), size - text.size()));
+    }
+    return text + " https://example.com/paste";
+}
+
+std::vector<uint8_t> MakeBlob(size_t size, uint32_t seed)
+{
+    std::vector<uint8_t> blob(size);
+    uint32_t value = seed;
+    for (auto &byte : blob) {
+        value = value * 1103515245 + 12345; // 1103515245, 12345: constants of a linear congruential generator
+        byte = static_cast<uint8_t>((value >> 16) & BYTE_MASK); // 16: the high bits are the most random ones
+    }
+    return blob;
+}
+
+std::string MakeHtml(size_t imageCount)
+{
+    std::string html = "<html><body><p>" + MakeText(TEXT_RECORD_SIZE) + "</p>";
+    for (size_t i = 0; i < imageCount; ++i) {
+        html += "<p>picture " + std::to_string(i) + "</p><img src=\"file:///data/storage/el2/base/files/image_" +
+            std::to_string(i) + ".png\" width=\"640\" height=\"480\">";
+    }
+    return html + "</body></html>";
+}
+
+PasteData MakePasteData(Workload workload, size_t param)
+{
+    PasteData data;
+    switch (workload) {
+        case Workload::TEXT:
+            data.AddTextRecord(MakeText(param));
+            break;
+        case Workload::RECORDS:
+            for (size_t i = 0; i < param; ++i) {
+                data.AddTextRecord(MakeText(TEXT_RECORD_SIZE));
+            }
+            break;
+        case Workload::HTML_IMAGES:
+            data.AddHtmlRecord(MakeHtml(param));
+            break;
+        case Workload::KV_BLOB:
+            data.AddKvRecord(KV_MIME_TYPE, MakeBlob(param, static_cast<uint32_t>(param)));
+            break;
+        case Workload::ENTRIES: {
+            auto record = PasteDataRecord::NewPlainTextRecord(MakeText(TEXT_RECORD_SIZE));
+            for (size_t i = 0; i < param; ++i) {
+                std::string utdId = "com.example.benchmark.type" + std::to_string(i);
+                std::string mimeType = "application/x-benchmark-" + std::to_string(i);
+                EntryValue value = MakeBlob(ENTRY_VALUE_SIZE, static_cast<uint32_t>(i));
+                record->AddEntry(utdId, std::make_shared<PasteDataEntry>(utdId, mimeType, value));
+            }
+            data.AddRecord(record);
+            break;
+        }
+        default:
+            break;
+    }
+    return data;
+}
+
+void EncodeBenchmark(benchmark::State &state, Workload workload, size_t param, bool isRemote)
+{
+    PasteData data = MakePasteData(workload, param);
+    size_t size = 0;
+    for (auto _ : state) {
+        std::vector<uint8_t> buffer;
+        if (!data.Encode(buffer, isRemote)) {
+            state.SkipWithError("encode failed");
+            break;
+        }
+        size = buffer.size();
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+    state.counters["bytes"] = static_cast<double>(size);
+}
+
+void DecodeBenchmark(benchmark::State &state, Workload workload, size_t param, bool isRemote)
+{
+    std::vector<uint8_t> buffer;
+    if (!MakePasteData(workload, param).Encode(buffer, isRemote)) {
+        state.SkipWithError("encode failed");
+        return;
+    }
+    for (auto _ : state) {
+        PasteData data;
+        if (!data.Decode(buffer)) {
+            state.SkipWithError("decode failed");
+            break;
+        }
+        benchmark::DoNotOptimize(data);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * buffer.size()));
+}
+
+void CountTLVBenchmark(benchmark::State &state, Workload workload, size_t param)
+{
+    PasteData data = MakePasteData(workload, param);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(data.CountTLV());
+    }
+}
+
+void CopyBenchmark(benchmark::State &state, Workload workload, size_t param)
+{
+    PasteData data = MakePasteData(workload, param);
+    for (auto _ : state) {
+        PasteData copy(data);
+        benchmark::DoNotOptimize(copy);
+    }
+}
+
+void GetMimeTypesBenchmark(benchmark::State &state, Workload workload, size_t param)
+{
+    PasteData data = MakePasteData(workload, param);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(data.GetMimeTypes());
+    }
+}
+
+void HasMimeTypeBenchmark(benchmark::State &state, Workload workload, size_t param)
+{
+    // a missing mime type visits every record, the worst case
+    PasteData data = MakePasteData(workload, param);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(data.HasMimeType(MISSING_MIME_TYPE));
+    }
+}
+
+void ToUnifiedDataBenchmark(benchmark::State &state, Workload workload, size_t param)
+{
+    PasteData data = MakePasteData(workload, param);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PasteboardUtils::GetInstance().Convert(data));
+    }
+}
+
+void FromUnifiedDataBenchmark(benchmark::State &state, Workload workload, size_t param)
+{
+    auto unifiedData = PasteboardUtils::GetInstance().Convert(MakePasteData(workload, param));
+    if (unifiedData == nullptr) {
+        state.SkipWithError("convert to unified data failed");
+        return;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PasteboardUtils::GetInstance().Convert(*unifiedData));
+    }
+}
+
+void DetectBenchmark(benchmark::State &state, Workload workload, size_t param)
+{
+    PasteData data = MakePasteData(workload, param);
+    const std::set<Pattern> patterns = { Pattern::URL, Pattern::NUMBER, Pattern::EMAIL_ADDRESS };
+    bool hasHTML = data.HasMimeType(MIMETYPE_TEXT_HTML);
+    bool hasPlain = data.HasMimeType(MIMETYPE_TEXT_PLAIN);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PatternDetection::Detect(patterns, data, hasHTML, hasPlain));
+    }
+}
+} // namespace
+
+void RegisterPasteDataBenchmarks()
+{
+    for (const auto &config : WORKLOADS) {
+        for (size_t param : config.params) {
+            std::string suffix = std::string("/") + config.name + "/" + std::to_string(param);
+            Workload workload = config.workload;
+            benchmark::RegisterBenchmark(("PasteData/EncodeLocal" + suffix).c_str(),
+                [workload, param](benchmark::State &state) { EncodeBenchmark(state, workload, param, false); });
+            benchmark::RegisterBenchmark(("PasteData/EncodeRemote" + suffix).c_str(),
+                [workload, param](benchmark::State &state) { EncodeBenchmark(state, workload, param, true); });
+            benchmark::RegisterBenchmark(("PasteData/DecodeLocal" + suffix).c_str(),
+                [workload, param](benchmark::State &state) { DecodeBenchmark(state, workload, param, false); });
+            benchmark::RegisterBenchmark(("PasteData/DecodeRemote" + suffix).c_str(),
+                [workload, param](benchmark::State &state) { DecodeBenchmark(state, workload, param, true); });
+            benchmark::RegisterBenchmark(("PasteData/CountTLV" + suffix).c_str(),
+                [workload, param](benchmark::State &state) { CountTLVBenchmark(state, workload, param); });
+            benchmark::RegisterBenchmark(("PasteData/Copy" + suffix).c_str(),
+                [workload, param](benchmark::State &state) { CopyBenchmark(state, workload, param); });
+            benchmark::RegisterBenchmark(("PasteData/GetMimeTypes" + suffix).c_str(),
+                [workload, param](benchmark::State &state) { GetMimeTypesBenchmark(state, workload, param); });
+            benchmark::RegisterBenchmark(("PasteData/HasMimeType" + suffix).c_str(),
+                [workload, param](benchmark::State &state) { HasMimeTypeBenchmark(state, workload, param); });
+            benchmark::RegisterBenchmark(("PasteboardUtils/ToUnifiedData" + suffix).c_str(),
+                [workload, param](benchmark::State &state) { ToUnifiedDataBenchmark(state, workload, param); });
+            benchmark::RegisterBenchmark(("PasteboardUtils/FromUnifiedData" + suffix).c_str(),
+                [workload, param](benchmark::State &state) { FromUnifiedDataBenchmark(state, workload, param); });
+            if (config.detectPatterns) {
+                benchmark::RegisterBenchmark(("PatternDetection/Detect" + suffix).c_str(),
+                    [workload, param](benchmark::State &state) { DetectBenchmark(state, workload, param); });
+            }
+        }
+    }
+}
+} // namespace OHOS::MiscServices
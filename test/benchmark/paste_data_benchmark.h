@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_TEST_BENCHMARK_PASTE_DATA_BENCHMARK_H
+#define PASTEBOARD_TEST_BENCHMARK_PASTE_DATA_BENCHMARK_H
+
+namespace OHOS::MiscServices {
+/*
+ * Registers the PasteData, PasteboardUtils and PatternDetection benchmarks over fixed workloads, named
+ * "<Class>/<Operation>/<Workload>/<size>" so the names are stable between runs and can be compared with a baseline.
+ */
+void RegisterPasteDataBenchmarks();
+} // namespace OHOS::MiscServices
+#endif // PASTEBOARD_TEST_BENCHMARK_PASTE_DATA_BENCHMARK_H
@@ -57,8 +57,11 @@ const std::vector<IPasteboardServiceIpcCode> CODE_LIST = {
     IPasteboardServiceIpcCode::COMMAND_GET_MIME_TYPES,
     IPasteboardServiceIpcCode::COMMAND_SHOW_PROGRESS,
     IPasteboardServiceIpcCode::COMMAND_GET_CHANGE_COUNT,
+    IPasteboardServiceIpcCode::COMMAND_GET_CHANGE_STATE_PAGE,
     IPasteboardServiceIpcCode::COMMAND_SUBSCRIBE_ENTITY_OBSERVER,
     IPasteboardServiceIpcCode::COMMAND_UNSUBSCRIBE_ENTITY_OBSERVER,
+    IPasteboardServiceIpcCode::COMMAND_GET_CLIP_HISTORY,
+    IPasteboardServiceIpcCode::COMMAND_ACTIVATE_CLIP,
 };
 
 class PasteboardServiceMock : public PasteboardServiceStub {
@@ -210,6 +213,24 @@ public:
         return 0;
     }
 
+    int32_t GetChangeStatePage(int &fd) override
+    {
+        fd = -1;
+        return 0;
+    }
+
+    int32_t GetClipHistory(std::vector<uint8_t> &buffer) override
+    {
+        (void)buffer;
+        return 0;
+    }
+
+    int32_t ActivateClip(uint32_t clipId) override
+    {
+        (void)clipId;
+        return 0;
+    }
+
     int32_t SubscribeEntityObserver(
         EntityType entityType, uint32_t expectedDataLength, const sptr<IEntityRecognitionObserver> &observer) override
     {
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fake_environment.h"
+
+#include "accesstoken_kit.h"
+#include "ipc_skeleton.h"
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr uint32_t TOKEN_BASE = 0x28000000;
+constexpr uint32_t MAX_CLIENTS = 0x01000000;
+constexpr pid_t PID_BASE = 100000;
+constexpr pid_t UID_BASE = FakeEnvironment::LOAD_USER_ID * 200000 + 20010000; // 200000: uid range of each user
+thread_local uint32_t g_currentClient = 0;
+} // namespace
+
+void FakeEnvironment::BindClient(uint32_t client)
+{
+    g_currentClient = client;
+}
+
+uint32_t FakeEnvironment::GetTokenId(uint32_t client)
+{
+    return TOKEN_BASE + client;
+}
+
+pid_t FakeEnvironment::GetPid(uint32_t client)
+{
+    return PID_BASE + static_cast<pid_t>(client);
+}
+
+pid_t FakeEnvironment::GetUid(uint32_t client)
+{
+    return UID_BASE + static_cast<pid_t>(client);
+}
+
+bool FakeEnvironment::GetClient(uint32_t tokenId, uint32_t &client)
+{
+    if (tokenId < TOKEN_BASE || tokenId - TOKEN_BASE >= MAX_CLIENTS) {
+        return false;
+    }
+    client = tokenId - TOKEN_BASE;
+    return true;
+}
+
+std::string FakeEnvironment::GetBundleName(uint32_t client)
+{
+    return "com.example.load" + std::to_string(client);
+}
+
+uint32_t FakeEnvironment::GetCurrentClient()
+{
+    return g_currentClient;
+}
+} // namespace OHOS::MiscServices
+
+namespace OHOS {
+using namespace OHOS::MiscServices;
+using namespace OHOS::Security::AccessToken;
+
+uint32_t IPCSkeleton::GetCallingTokenID()
+{
+    return FakeEnvironment::GetTokenId(FakeEnvironment::GetCurrentClient());
+}
+
+uint64_t IPCSkeleton::GetCallingFullTokenID()
+{
+    return FakeEnvironment::GetTokenId(FakeEnvironment::GetCurrentClient());
+}
+
+pid_t IPCSkeleton::GetCallingPid()
+{
+    return FakeEnvironment::GetPid(FakeEnvironment::GetCurrentClient());
+}
+
+pid_t IPCSkeleton::GetCallingUid()
+{
+    return FakeEnvironment::GetUid(FakeEnvironment::GetCurrentClient());
+}
+
+int AccessTokenKit::VerifyAccessToken(AccessTokenID tokenID, const std::string &permissionName)
+{
+    (void)permissionName;
+    uint32_t client = 0;
+    return FakeEnvironment::GetClient(tokenID, client) ? PermissionState::PERMISSION_GRANTED
+                                                       : PermissionState::PERMISSION_DENIED;
+}
+
+ATokenTypeEnum AccessTokenKit::GetTokenTypeFlag(AccessTokenID tokenID)
+{
+    uint32_t client = 0;
+    return FakeEnvironment::GetClient(tokenID, client) ? ATokenTypeEnum::TOKEN_HAP : ATokenTypeEnum::TOKEN_NATIVE;
+}
+
+int AccessTokenKit::GetHapTokenInfo(AccessTokenID tokenID, HapTokenInfo &hapTokenInfoRes)
+{
+    uint32_t client = 0;
+    if (!FakeEnvironment::GetClient(tokenID, client)) {
+        return -1;
+    }
+    hapTokenInfoRes.bundleName = FakeEnvironment::GetBundleName(client);
+    hapTokenInfoRes.userID = FakeEnvironment::LOAD_USER_ID;
+    hapTokenInfoRes.instIndex = 0;
+    hapTokenInfoRes.apiVersion = FakeEnvironment::LOAD_API_VERSION;
+    hapTokenInfoRes.tokenID = tokenID;
+    return 0;
+}
+} // namespace OHOS
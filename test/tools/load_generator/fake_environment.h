@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_TEST_TOOLS_FAKE_ENVIRONMENT_H
+#define PASTEBOARD_TEST_TOOLS_FAKE_ENVIRONMENT_H
+
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+
+namespace OHOS::MiscServices {
+/*
+ * Identity of the simulated client calling on this thread. IPCSkeleton and AccessTokenKit are replaced in the load
+ * generator, every client is a granted application of LOAD_USER_ID with its own token, pid and bundle name.
+ */
+class FakeEnvironment {
+public:
+    static constexpr int32_t LOAD_USER_ID = 100;
+    static constexpr int32_t LOAD_API_VERSION = 12;
+
+    static void BindClient(uint32_t client);
+    static uint32_t GetTokenId(uint32_t client);
+    static pid_t GetPid(uint32_t client);
+    static pid_t GetUid(uint32_t client);
+    static bool GetClient(uint32_t tokenId, uint32_t &client);
+    static std::string GetBundleName(uint32_t client);
+    static uint32_t GetCurrentClient();
+};
+} // namespace OHOS::MiscServices
+#endif // PASTEBOARD_TEST_TOOLS_FAKE_ENVIRONMENT_H
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+#include "load_runner.h"
+#include "service_load_target.h"
+
+using namespace OHOS::MiscServices;
+
+namespace {
+constexpr uint32_t DEFAULT_CLIENTS = 16;
+constexpr uint32_t DEFAULT_OPS = 1000;
+constexpr uint32_t DEFAULT_THREADS = 8;
+constexpr const char *DEFAULT_MIX = "set=10,get=30,has=55,types=0,observer=5,bytes=1024";
+
+struct Options {
+    std::string trace;
+    std::string mix = DEFAULT_MIX;
+    uint32_t clients = DEFAULT_CLIENTS;
+    uint32_t ops = DEFAULT_OPS;
+    uint32_t threads = DEFAULT_THREADS;
+    uint32_t seed = 0;
+};
+
+bool ParseUint(const std::string &value, uint32_t &result)
+{
+    char *end = nullptr;
+    unsigned long number = strtoul(value.c_str(), &end, 10); // 10: decimal
+    if (value.empty() || *end != '\0' || number > UINT32_MAX) {
+        return false;
+    }
+    result = static_cast<uint32_t>(number);
+    return true;
+}
+
+bool ParseOptions(int argc, char *argv[], Options &options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto pos = arg.find('=');
+        if (arg.compare(0, 2, "--") != 0 || pos == std::string::npos) { // 2: length of "--"
+            return false;
+        }
+        std::string key = arg.substr(2, pos - 2); // 2: length of "--"
+        std::string value = arg.substr(pos + 1);
+        bool valid = true;
+        if (key == "trace") {
+            options.trace = value;
+        } else if (key == "mix") {
+            options.mix = value;
+        } else if (key == "clients") {
+            valid = ParseUint(value, options.clients) && options.clients > 0;
+        } else if (key == "ops") {
+            valid = ParseUint(value, options.ops);
+        } else if (key == "threads") {
+            valid = ParseUint(value, options.threads) && options.threads > 0;
+        } else if (key == "seed") {
+            valid = ParseUint(value, options.seed);
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LoadOps(const Options &options, LoadTrace &trace)
+{
+    if (!options.trace.empty()) {
+        std::ifstream file(options.trace);
+        if (!file.is_open()) {
+            std::cerr << "can not open " << options.trace << std::endl;
+            return false;
+        }
+        std::string error;
+        if (!trace.Parse(file, error)) {
+            std::cerr << options.trace << ": " << error << std::endl;
+            return false;
+        }
+        return true;
+    }
+    LoadTrace::Mix mix;
+    if (!LoadTrace::ParseMix(options.mix, mix)) {
+        std::cerr << "invalid mix " << options.mix << std::endl;
+        return false;
+    }
+    trace.Generate(mix, options.clients, options.ops, options.seed);
+    return true;
+}
+} // namespace
+
+/*
+ * Usage: pasteboard_load_generator [--trace=<file> | --mix=<weights>] [--clients=N] [--ops=N] [--threads=N] [--seed=N]
+ * Replays a trace, or a generated mix of calls, against a pasteboard service running in this process. The calls go
+ * through the service proxy and stub, the caller identity and the permissions of the simulated clients are faked.
+ * The default mix is the one of a device with an input method polling HasDataType:
+ *     --mix=set=10,get=30,has=55,types=0,observer=5,bytes=1024
+ */
+int main(int argc, char *argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0] << " [--trace=<file> | --mix=<weights>] [--clients=N] [--ops=N]"
+                  << " [--threads=N] [--seed=N]" << std::endl;
+        return 1;
+    }
+    LoadTrace trace;
+    if (!LoadOps(options, trace)) {
+        return 1;
+    }
+    if (trace.GetOps().empty()) {
+        std::cerr << "no call to replay" << std::endl;
+        return 1;
+    }
+    auto target = std::make_unique<ServiceLoadTarget>();
+    auto report = LoadRunner::Run(trace, *target, options.threads);
+    target = nullptr;
+    std::cout << LoadRunner::Format(report);
+    return 0;
+}
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "load_runner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <sys/resource.h>
+#include <thread>
+#include <vector>
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr uint64_t US_PER_SECOND = 1000000;
+constexpr uint64_t NS_PER_US = 1000;
+constexpr double PERCENT = 100.0;
+
+struct OpCounters {
+    LatencyHistogram latency;
+    std::atomic<uint64_t> failed = 0;
+    std::atomic<uint64_t> totalUs = 0;
+    std::atomic<uint64_t> offCpuUs = 0;
+    std::atomic<uint64_t> blocked = 0;
+    std::atomic<uint64_t> switches = 0;
+};
+
+uint64_t NowUs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint64_t ThreadCpuUs()
+{
+    struct timespec ts = { 0, 0 };
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(ts.tv_sec) * US_PER_SECOND + static_cast<uint64_t>(ts.tv_nsec) / NS_PER_US;
+}
+
+uint64_t VoluntarySwitches()
+{
+    struct rusage usage;
+    (void)memset(&usage, 0, sizeof(usage));
+    if (getrusage(RUSAGE_THREAD, &usage) != 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(usage.ru_nvcsw);
+}
+
+void RunCall(const LoadTrace::Op &op, LoadTarget &target, OpCounters &counters)
+{
+    target.BindClient(op.client);
+    uint64_t switches = VoluntarySwitches();
+    uint64_t cpuUs = ThreadCpuUs();
+    uint64_t beginUs = NowUs();
+    int32_t ret = target.Execute(op);
+    uint64_t costUs = NowUs() - beginUs;
+    cpuUs = ThreadCpuUs() - cpuUs;
+    switches = VoluntarySwitches() - switches;
+    counters.latency.Record(costUs);
+    counters.totalUs.fetch_add(costUs, std::memory_order_relaxed);
+    counters.offCpuUs.fetch_add(costUs > cpuUs ? costUs - cpuUs : 0, std::memory_order_relaxed);
+    counters.switches.fetch_add(switches, std::memory_order_relaxed);
+    if (switches > 0) {
+        counters.blocked.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (ret != 0) {
+        counters.failed.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+std::string FormatLine(const char *format, ...) __attribute__((format(printf, 1, 2)));
+std::string FormatLine(const char *format, ...)
+{
+    char buffer[256] = { 0 }; // 256: longer than any line of the report
+    va_list args;
+    va_start(args, format);
+    int ret = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    return ret > 0 ? std::string(buffer) : std::string();
+}
+} // namespace
+
+LoadRunner::Report LoadRunner::Run(const LoadTrace &trace, LoadTarget &target, uint32_t threads)
+{
+    Report report;
+    report.threads = threads == 0 ? 1 : threads;
+    report.clients = trace.GetClientCount();
+    std::vector<std::vector<const LoadTrace::Op *>> plans(report.threads);
+    for (const auto &op : trace.GetOps()) {
+        plans[op.client % report.threads].push_back(&op);
+    }
+    std::array<OpCounters, LoadTrace::OP_BUTT> counters;
+    std::atomic<bool> finished = false;
+    std::atomic<int64_t> rssPeakKb = ReadStatusKb("VmRSS");
+    report.rssBeforeKb = rssPeakKb.load();
+    std::thread sampler([&finished, &rssPeakKb]() {
+        while (!finished.load()) {
+            rssPeakKb.store(std::max(rssPeakKb.load(), ReadStatusKb("VmRSS")));
+            std::this_thread::sleep_for(std::chrono::milliseconds(RSS_SAMPLE_INTERVAL_MS));
+        }
+    });
+
+    uint64_t beginUs = NowUs();
+    std::vector<std::thread> workers;
+    for (const auto &plan : plans) {
+        workers.emplace_back([&plan, &target, &counters]() {
+            for (const auto *op : plan) {
+                if (op->type == LoadTrace::WAIT) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(op->value));
+                    continue;
+                }
+                RunCall(*op, target, counters[op->type]);
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    report.wallUs = NowUs() - beginUs;
+    finished.store(true);
+    sampler.join();
+
+    report.rssPeakKb = std::max(rssPeakKb.load(), ReadStatusKb("VmRSS"));
+    report.hwmKb = ReadStatusKb("VmHWM");
+    for (uint32_t i = 0; i < LoadTrace::OP_BUTT; ++i) {
+        auto &op = report.ops[i];
+        op.latency = counters[i].latency.GetSummary();
+        op.failed = counters[i].failed.load();
+        op.totalUs = counters[i].totalUs.load();
+        op.offCpuUs = counters[i].offCpuUs.load();
+        op.blocked = counters[i].blocked.load();
+        op.switches = counters[i].switches.load();
+        report.calls += op.latency.count;
+    }
+    report.targetDump = target.Dump();
+    return report;
+}
+
+std::string LoadRunner::Format(const Report &report)
+{
+    double seconds = static_cast<double>(report.wallUs) / US_PER_SECOND;
+    double throughput = report.wallUs == 0 ? 0 : static_cast<double>(report.calls) / seconds;
+    std::string result = FormatLine("%" PRIu64 " calls of %u clients on %u threads in %.3fs, %.1f calls/s\n",
+        report.calls, report.clients, report.threads, seconds, throughput);
+    result += FormatLine("%-12s %9s %7s %9s %9s %9s %9s %7s %8s %9s\n", "call", "count", "failed", "p50(us)",
+        "p90(us)", "p99(us)", "max(us)", "offcpu", "blocked", "cs/call");
+    for (uint32_t i = 0; i < LoadTrace::OP_BUTT; ++i) {
+        const auto &op = report.ops[i];
+        if (op.latency.count == 0) {
+            continue;
+        }
+        double offCpu = op.totalUs == 0 ? 0 : static_cast<double>(op.offCpuUs) * PERCENT / op.totalUs;
+        double blocked = static_cast<double>(op.blocked) * PERCENT / op.latency.count;
+        double switches = static_cast<double>(op.switches) / op.latency.count;
+        result += FormatLine("%-12s %9" PRIu64 " %7" PRIu64 " %9" PRIu64 " %9" PRIu64 " %9" PRIu64 " %9" PRIu64
+            " %6.1f%% %7.1f%% %9.2f\n", LoadTrace::GetOpName(static_cast<LoadTrace::OpType>(i)), op.latency.count,
+            op.failed, op.latency.p50, op.latency.p90, op.latency.p99, op.latency.max, offCpu, blocked, switches);
+    }
+    result += FormatLine("memory: rss %" PRId64 " kB before, %" PRId64 " kB peak (%+" PRId64 " kB), VmHWM %" PRId64
+        " kB\n", report.rssBeforeKb, report.rssPeakKb, report.rssPeakKb - report.rssBeforeKb, report.hwmKb);
+    return result + report.targetDump;
+}
+
+int64_t LoadRunner::ReadStatusKb(const char *key)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    size_t keyLen = strlen(key);
+    while (std::getline(status, line)) {
+        if (line.compare(0, keyLen, key) != 0 || line.size() <= keyLen || line[keyLen] != ':') {
+            continue;
+        }
+        char *end = nullptr;
+        long long value = strtoll(line.c_str() + keyLen + 1, &end, 10); // 10: decimal
+        return end == line.c_str() + keyLen + 1 ? -1 : static_cast<int64_t>(value);
+    }
+    return -1;
+}
+} // namespace OHOS::MiscServices
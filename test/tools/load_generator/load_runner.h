@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_TEST_TOOLS_LOAD_RUNNER_H
+#define PASTEBOARD_TEST_TOOLS_LOAD_RUNNER_H
+
+#include <array>
+#include <string>
+
+#include "latency_histogram.h"
+#include "load_trace.h"
+
+namespace OHOS::MiscServices {
+class LoadTarget {
+public:
+    virtual ~LoadTarget() = default;
+    // called on the worker thread before each call of the client
+    virtual void BindClient(uint32_t client) = 0;
+    // returns 0 when the call succeeded
+    virtual int32_t Execute(const LoadTrace::Op &op) = 0;
+    // extra lines of the report, such as the statistics kept by the target itself
+    virtual std::string Dump() const = 0;
+};
+
+/*
+ * Replays a trace on a pool of threads, the calls of a client always run on the same thread. Besides the latency of
+ * each call type, the off-cpu share of the latency and the voluntary context switches are reported as the lock
+ * contention, the resident memory is sampled for its high-water mark.
+ */
+class LoadRunner {
+public:
+    struct OpReport {
+        LatencyHistogram::Summary latency;
+        uint64_t failed = 0;
+        uint64_t totalUs = 0;
+        uint64_t offCpuUs = 0;
+        uint64_t blocked = 0; // calls with at least one voluntary context switch
+        uint64_t switches = 0;
+    };
+    struct Report {
+        uint32_t threads = 0;
+        uint32_t clients = 0;
+        uint64_t wallUs = 0;
+        uint64_t calls = 0;
+        std::array<OpReport, LoadTrace::OP_BUTT> ops;
+        int64_t rssBeforeKb = -1;
+        int64_t rssPeakKb = -1;
+        int64_t hwmKb = -1;
+        std::string targetDump;
+    };
+    static constexpr uint32_t RSS_SAMPLE_INTERVAL_MS = 10;
+
+    static Report Run(const LoadTrace &trace, LoadTarget &target, uint32_t threads);
+    static std::string Format(const Report &report);
+    // reads a "<key>:  <value> kB" line of /proc/self/status, -1 when it is absent
+    static int64_t ReadStatusKb(const char *key);
+};
+} // namespace OHOS::MiscServices
+#endif // PASTEBOARD_TEST_TOOLS_LOAD_RUNNER_H
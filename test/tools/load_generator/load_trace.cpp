@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "load_trace.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr int DECIMAL = 10;
+constexpr const char *DEFAULT_MIME_TYPE = "text/plain";
+constexpr const char *OP_NAMES[] = { "set", "get", "has", "types", "subscribe", "unsubscribe", "wait" };
+
+bool ParseUint(const std::string &value, uint64_t &result)
+{
+    if (value.empty() || value[0] == '-') {
+        return false;
+    }
+    char *end = nullptr;
+    result = std::strtoull(value.c_str(), &end, DECIMAL);
+    return end != nullptr && *end == '\0';
+}
+
+bool ParseOpType(const std::string &name, LoadTrace::OpType &type)
+{
+    for (uint32_t i = 0; i < LoadTrace::OP_BUTT; ++i) {
+        if (name == OP_NAMES[i]) {
+            type = static_cast<LoadTrace::OpType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace
+
+bool LoadTrace::Parse(std::istream &input, std::string &error)
+{
+    ops_.clear();
+    clientCount_ = 0;
+    std::string line;
+    size_t lineNo = 0;
+    while (std::getline(input, line)) {
+        lineNo++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string client;
+        std::string name;
+        std::string arg;
+        if (!(fields >> client)) {
+            continue;
+        }
+        fields >> name >> arg;
+        Op op;
+        uint64_t clientId = 0;
+        if (!ParseUint(client, clientId) || clientId > UINT32_MAX || !ParseOpType(name, op.type)) {
+            error = "line " + std::to_string(lineNo) + ": expect \"<client> <op> [arg]\"";
+            return false;
+        }
+        op.client = static_cast<uint32_t>(clientId);
+        if (op.type == SET || op.type == WAIT) {
+            if (!ParseUint(arg, op.value) || (op.type == SET && op.value == 0)) {
+                error = "line " + std::to_string(lineNo) + ": invalid " + name + " argument";
+                return false;
+            }
+        } else if (op.type == HAS_TYPE) {
+            op.mimeType = arg.empty() ? DEFAULT_MIME_TYPE : arg;
+        }
+        clientCount_ = std::max(clientCount_, op.client + 1);
+        ops_.push_back(std::move(op));
+    }
+    return true;
+}
+
+void LoadTrace::Generate(const Mix &mix, uint32_t clients, uint32_t opsPerClient, uint32_t seed)
+{
+    ops_.clear();
+    clientCount_ = clients;
+    const std::vector<uint32_t> weights = { mix.set, mix.get, mix.hasType, mix.getTypes, mix.observer };
+    uint32_t total = 0;
+    for (auto weight : weights) {
+        total += weight;
+    }
+    if (clients == 0 || total == 0) {
+        return;
+    }
+    std::mt19937 random(seed);
+    std::discrete_distribution<uint32_t> pick(weights.begin(), weights.end());
+    std::vector<bool> subscribed(clients, false);
+    for (uint32_t round = 0; round < opsPerClient; ++round) {
+        for (uint32_t client = 0; client < clients; ++client) {
+            Op op;
+            op.client = client;
+            switch (pick(random)) {
+                case 0: // 0: set
+                    op.type = SET;
+                    op.value = mix.setBytes;
+                    break;
+                case 1: // 1: get
+                    op.type = GET;
+                    break;
+                case 2: // 2: has type
+                    op.type = HAS_TYPE;
+                    op.mimeType = DEFAULT_MIME_TYPE;
+                    break;
+                case 3: // 3: get types
+                    op.type = GET_TYPES;
+                    break;
+                default:
+                    op.type = subscribed[client] ? UNSUBSCRIBE : SUBSCRIBE;
+                    subscribed[client] = !subscribed[client];
+                    break;
+            }
+            ops_.push_back(std::move(op));
+            if (mix.waitUs > 0) {
+                ops_.push_back({ client, WAIT, mix.waitUs, "" });
+            }
+        }
+    }
+}
+
+const std::vector<LoadTrace::Op> &LoadTrace::GetOps() const
+{
+    return ops_;
+}
+
+uint32_t LoadTrace::GetClientCount() const
+{
+    return clientCount_;
+}
+
+bool LoadTrace::ParseMix(const std::string &value, Mix &mix)
+{
+    std::istringstream items(value);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        size_t pos = item.find('=');
+        uint64_t number = 0;
+        if (pos == std::string::npos || !ParseUint(item.substr(pos + 1), number) || number > UINT32_MAX) {
+            return false;
+        }
+        std::string key = item.substr(0, pos);
+        if (key == "set") {
+            mix.set = static_cast<uint32_t>(number);
+        } else if (key == "get") {
+            mix.get = static_cast<uint32_t>(number);
+        } else if (key == "has") {
+            mix.hasType = static_cast<uint32_t>(number);
+        } else if (key == "types") {
+            mix.getTypes = static_cast<uint32_t>(number);
+        } else if (key == "observer") {
+            mix.observer = static_cast<uint32_t>(number);
+        } else if (key == "bytes" && number > 0) {
+            mix.setBytes = number;
+        } else if (key == "wait") {
+            mix.waitUs = number;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+const char *LoadTrace::GetOpName(OpType type)
+{
+    return type < OP_BUTT ? OP_NAMES[type] : "unknown";
+}
+} // namespace OHOS::MiscServices
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_TEST_TOOLS_LOAD_TRACE_H
+#define PASTEBOARD_TEST_TOOLS_LOAD_TRACE_H
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace OHOS::MiscServices {
+/*
+ * A trace of pasteboard calls made by simulated clients. One call per line, "#" starts a comment:
+ *     <client> set <bytes>         copy a text of the given size
+ *     <client> get                 paste
+ *     <client> has <mimeType>      HasDataType, as polled by input methods
+ *     <client> types               GetMimeTypes
+ *     <client> subscribe           subscribe a local change observer
+ *     <client> unsubscribe         unsubscribe it
+ *     <client> wait <us>           think time of the client
+ * The calls of one client keep their order, the calls of different clients run concurrently.
+ */
+class LoadTrace {
+public:
+    enum OpType : uint32_t {
+        SET,
+        GET,
+        HAS_TYPE,
+        GET_TYPES,
+        SUBSCRIBE,
+        UNSUBSCRIBE,
+        WAIT,
+        OP_BUTT,
+    };
+    struct Op {
+        uint32_t client = 0;
+        OpType type = OP_BUTT;
+        uint64_t value = 0; // bytes of a set, microseconds of a wait
+        std::string mimeType;
+    };
+    // relative weights of the generated calls, "observer" toggles the subscription of the client
+    struct Mix {
+        uint32_t set = 0;
+        uint32_t get = 0;
+        uint32_t hasType = 0;
+        uint32_t getTypes = 0;
+        uint32_t observer = 0;
+        uint64_t setBytes = 1024;
+        uint64_t waitUs = 0;
+    };
+
+    bool Parse(std::istream &input, std::string &error);
+    void Generate(const Mix &mix, uint32_t clients, uint32_t opsPerClient, uint32_t seed);
+    const std::vector<Op> &GetOps() const;
+    uint32_t GetClientCount() const;
+
+    // "set=10,get=30,has=55,types=0,observer=5,bytes=4096,wait=1000"
+    static bool ParseMix(const std::string &value, Mix &mix);
+    static const char *GetOpName(OpType type);
+
+private:
+    std::vector<Op> ops_;
+    uint32_t clientCount_ = 0;
+};
+} // namespace OHOS::MiscServices
+#endif // PASTEBOARD_TEST_TOOLS_LOAD_TRACE_H
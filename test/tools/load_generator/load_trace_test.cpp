@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+
+#include "load_runner.h"
+#include "load_trace.h"
+
+namespace OHOS::MiscServices {
+using namespace testing::ext;
+namespace {
+const std::string TEST_TRACE = "# client op arg\n"
+                               "0 subscribe\n"
+                               "0 set 4096\n"
+                               "\n"
+                               "1 wait 100 # think time\n"
+                               "1 get\n"
+                               "2 has text/html\n"
+                               "2 has\n"
+                               "2 types\n"
+                               "0 unsubscribe\n";
+
+class FakeLoadTarget : public LoadTarget {
+public:
+    void BindClient(uint32_t client) override
+    {
+        client_ = client;
+    }
+
+    int32_t Execute(const LoadTrace::Op &op) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (client_ != op.client) {
+            mismatched_++;
+        }
+        threads_[op.client].insert(std::this_thread::get_id());
+        executed_.push_back(op.type);
+        return op.type == LoadTrace::GET ? -1 : 0;
+    }
+
+    std::string Dump() const override
+    {
+        return "fake target\n";
+    }
+
+    std::mutex mutex_;
+    std::vector<LoadTrace::OpType> executed_;
+    std::map<uint32_t, std::set<std::thread::id>> threads_;
+    uint32_t mismatched_ = 0;
+    static thread_local uint32_t client_;
+};
+thread_local uint32_t FakeLoadTarget::client_ = 0;
+} // namespace
+
+class LoadTraceTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void LoadTraceTest::SetUpTestCase(void) {}
+
+void LoadTraceTest::TearDownTestCase(void) {}
+
+void LoadTraceTest::SetUp(void) {}
+
+void LoadTraceTest::TearDown(void) {}
+
+/**
+ * @tc.name: ParseTest001
+ * @tc.desc: Test a trace with comments, blank lines and every call type is parsed.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LoadTraceTest, ParseTest001, TestSize.Level0)
+{
+    std::istringstream input(TEST_TRACE);
+    LoadTrace trace;
+    std::string error;
+    ASSERT_TRUE(trace.Parse(input, error));
+    EXPECT_TRUE(error.empty());
+    EXPECT_EQ(trace.GetClientCount(), 3);
+
+    const auto &ops = trace.GetOps();
+    ASSERT_EQ(ops.size(), 8);
+    EXPECT_EQ(ops[0].type, LoadTrace::SUBSCRIBE);
+    EXPECT_EQ(ops[1].type, LoadTrace::SET);
+    EXPECT_EQ(ops[1].value, 4096);
+    EXPECT_EQ(ops[2].client, 1);
+    EXPECT_EQ(ops[2].type, LoadTrace::WAIT);
+    EXPECT_EQ(ops[2].value, 100);
+    EXPECT_EQ(ops[3].type, LoadTrace::GET);
+    EXPECT_EQ(ops[4].type, LoadTrace::HAS_TYPE);
+    EXPECT_EQ(ops[4].mimeType, "text/html");
+    EXPECT_EQ(ops[5].mimeType, "text/plain");
+    EXPECT_EQ(ops[6].type, LoadTrace::GET_TYPES);
+    EXPECT_EQ(ops[7].type, LoadTrace::UNSUBSCRIBE);
+}
+
+/**
+ * @tc.name: ParseTest002
+ * @tc.desc: Test malformed lines are rejected with the line number.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LoadTraceTest, ParseTest002, TestSize.Level0)
+{
+    const std::vector<std::string> invalidTraces = { "0 get\n1 paste\n", "0 get\nx get\n", "0 get\n-1 get\n",
+        "0 get\n0 set\n", "0 get\n0 set 0\n", "0 get\n0 wait abc\n" };
+    for (const auto &text : invalidTraces) {
+        std::istringstream input(text);
+        LoadTrace trace;
+        std::string error;
+        EXPECT_FALSE(trace.Parse(input, error)) << text;
+        EXPECT_EQ(error.find("line 2"), 0) << error;
+    }
+}
+
+/**
+ * @tc.name: ParseMixTest001
+ * @tc.desc: Test the weights of a mix are parsed and unknown keys are rejected.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LoadTraceTest, ParseMixTest001, TestSize.Level0)
+{
+    LoadTrace::Mix mix;
+    ASSERT_TRUE(LoadTrace::ParseMix("set=10,get=30,has=55,types=1,observer=5,bytes=4096,wait=1000", mix));
+    EXPECT_EQ(mix.set, 10);
+    EXPECT_EQ(mix.get, 30);
+    EXPECT_EQ(mix.hasType, 55);
+    EXPECT_EQ(mix.getTypes, 1);
+    EXPECT_EQ(mix.observer, 5);
+    EXPECT_EQ(mix.setBytes, 4096);
+    EXPECT_EQ(mix.waitUs, 1000);
+
+    LoadTrace::Mix invalid;
+    EXPECT_FALSE(LoadTrace::ParseMix("paste=1", invalid));
+    EXPECT_FALSE(LoadTrace::ParseMix("set", invalid));
+    EXPECT_FALSE(LoadTrace::ParseMix("set=-1", invalid));
+    EXPECT_FALSE(LoadTrace::ParseMix("bytes=0", invalid));
+}
+
+/**
+ * @tc.name: GenerateTest001
+ * @tc.desc: Test a generated trace is reproducible and follows the weights of the mix.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LoadTraceTest, GenerateTest001, TestSize.Level0)
+{
+    LoadTrace::Mix mix;
+    ASSERT_TRUE(LoadTrace::ParseMix("set=1,has=1,observer=1,bytes=2048,wait=50", mix));
+    constexpr uint32_t clients = 4;
+    constexpr uint32_t opsPerClient = 300;
+    LoadTrace trace;
+    trace.Generate(mix, clients, opsPerClient, 1);
+    LoadTrace same;
+    same.Generate(mix, clients, opsPerClient, 1);
+    EXPECT_EQ(trace.GetClientCount(), clients);
+    ASSERT_EQ(trace.GetOps().size(), clients * opsPerClient * 2);
+    ASSERT_EQ(same.GetOps().size(), trace.GetOps().size());
+
+    std::map<LoadTrace::OpType, uint32_t> counts;
+    std::vector<bool> subscribed(clients, false);
+    for (size_t i = 0; i < trace.GetOps().size(); ++i) {
+        const auto &op = trace.GetOps()[i];
+        EXPECT_EQ(op.type, same.GetOps()[i].type);
+        counts[op.type]++;
+        if (op.type == LoadTrace::SET) {
+            EXPECT_EQ(op.value, 2048);
+        } else if (op.type == LoadTrace::SUBSCRIBE || op.type == LoadTrace::UNSUBSCRIBE) {
+            EXPECT_EQ(op.type == LoadTrace::UNSUBSCRIBE, subscribed[op.client]);
+            subscribed[op.client] = !subscribed[op.client];
+        }
+    }
+    EXPECT_EQ(counts[LoadTrace::WAIT], clients * opsPerClient);
+    EXPECT_EQ(counts[LoadTrace::GET], 0);
+    EXPECT_EQ(counts[LoadTrace::GET_TYPES], 0);
+    EXPECT_GT(counts[LoadTrace::SET], 0);
+    EXPECT_GT(counts[LoadTrace::HAS_TYPE], 0);
+    EXPECT_GT(counts[LoadTrace::SUBSCRIBE], 0);
+}
+
+/**
+ * @tc.name: RunTest001
+ * @tc.desc: Test the runner keeps each client on one thread, in order, and counts the calls and failures.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LoadTraceTest, RunTest001, TestSize.Level0)
+{
+    std::istringstream input(TEST_TRACE);
+    LoadTrace trace;
+    std::string error;
+    ASSERT_TRUE(trace.Parse(input, error));
+    FakeLoadTarget target;
+    auto report = LoadRunner::Run(trace, target, 2);
+
+    EXPECT_EQ(report.threads, 2);
+    EXPECT_EQ(report.clients, 3);
+    EXPECT_EQ(report.calls, 7);
+    EXPECT_EQ(target.executed_.size(), 7);
+    EXPECT_EQ(target.mismatched_, 0);
+    for (const auto &[client, threads] : target.threads_) {
+        EXPECT_EQ(threads.size(), 1) << client;
+    }
+    EXPECT_EQ(report.ops[LoadTrace::GET].latency.count, 1);
+    EXPECT_EQ(report.ops[LoadTrace::GET].failed, 1);
+    EXPECT_EQ(report.ops[LoadTrace::HAS_TYPE].latency.count, 2);
+    EXPECT_EQ(report.ops[LoadTrace::HAS_TYPE].failed, 0);
+    EXPECT_EQ(report.ops[LoadTrace::WAIT].latency.count, 0);
+    EXPECT_GE(report.wallUs, 100);
+
+    std::string text = LoadRunner::Format(report);
+    EXPECT_NE(text.find("7 calls of 3 clients on 2 threads"), std::string::npos);
+    EXPECT_NE(text.find("has "), std::string::npos);
+    EXPECT_EQ(text.find("wait "), std::string::npos);
+    EXPECT_NE(text.find("fake target"), std::string::npos);
+}
+
+/**
+ * @tc.name: ReadStatusKbTest001
+ * @tc.desc: Test the memory of the process is read from /proc/self/status.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LoadTraceTest, ReadStatusKbTest001, TestSize.Level0)
+{
+    EXPECT_GT(LoadRunner::ReadStatusKb("VmRSS"), 0);
+    EXPECT_GE(LoadRunner::ReadStatusKb("VmHWM"), LoadRunner::ReadStatusKb("VmRSS") / 2);
+    EXPECT_EQ(LoadRunner::ReadStatusKb("VmNotExist"), -1);
+    EXPECT_EQ(LoadRunner::ReadStatusKb("VmRS"), -1);
+}
+} // namespace OHOS::MiscServices
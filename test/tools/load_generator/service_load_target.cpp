@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "service_load_target.h"
+
+#include <chrono>
+#include <cinttypes>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+
+#include "default_clip.h"
+#include "fake_environment.h"
+#include "message_parcel_warp.h"
+#include "pasteboard_error.h"
+#include "pasteboard_perf_stat.h"
+#include "pasteboard_service.h"
+#include "pasteboard_service_proxy.h"
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr int64_t MIN_ASHMEM_DATA_SIZE = 32 * 1024;
+constexpr uint32_t NOTIFY_DRAIN_MS = 200;
+
+uint64_t NowUs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+} // namespace
+
+void ServiceLoadTarget::LoadObserver::OnPasteboardChanged()
+{
+    target_.notifications_.fetch_add(1, std::memory_order_relaxed);
+    uint64_t lastSetUs = target_.lastSetUs_.load(std::memory_order_relaxed);
+    uint64_t nowUs = NowUs();
+    target_.notifyLatency_.Record(nowUs > lastSetUs ? nowUs - lastSetUs : 0);
+}
+
+ServiceLoadTarget::ServiceLoadTarget()
+{
+    service_ = new PasteboardService();
+    PasteboardService::currentUserId_ = FakeEnvironment::LOAD_USER_ID;
+    PasteboardService::currentScreenStatus = ScreenEvent::ScreenUnlocked;
+    service_->clipPlugin_ = std::make_shared<DefaultClip>();
+    service_->ffrtTimer_ = FFRTPool::GetTimer("pasteboard_load");
+    proxy_ = new PasteboardServiceProxy(service_->AsObject());
+}
+
+ServiceLoadTarget::~ServiceLoadTarget()
+{
+    std::map<uint32_t, sptr<LoadObserver>> observers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        observers.swap(observers_);
+    }
+    for (const auto &[client, observer] : observers) {
+        FakeEnvironment::BindClient(client);
+        proxy_->UnsubscribeObserver(PasteboardObserverType::OBSERVER_LOCAL, observer);
+    }
+    // the service notifies observers on detached threads
+    std::this_thread::sleep_for(std::chrono::milliseconds(NOTIFY_DRAIN_MS));
+    proxy_ = nullptr;
+    service_ = nullptr;
+}
+
+void ServiceLoadTarget::BindClient(uint32_t client)
+{
+    FakeEnvironment::BindClient(client);
+}
+
+int32_t ServiceLoadTarget::Execute(const LoadTrace::Op &op)
+{
+    switch (op.type) {
+        case LoadTrace::SET:
+            return SetPasteData(op.value);
+        case LoadTrace::GET:
+            return GetPasteData(op.client);
+        case LoadTrace::HAS_TYPE: {
+            bool hasType = false;
+            return proxy_->HasDataType(op.mimeType, hasType);
+        }
+        case LoadTrace::GET_TYPES: {
+            std::vector<std::string> mimeTypes;
+            return proxy_->GetMimeTypes(mimeTypes);
+        }
+        case LoadTrace::SUBSCRIBE:
+            return Subscribe(op.client);
+        case LoadTrace::UNSUBSCRIBE:
+            return Unsubscribe(op.client);
+        default:
+            return static_cast<int32_t>(PasteboardError::INVALID_PARAM_ERROR);
+    }
+}
+
+std::string ServiceLoadTarget::Dump() const
+{
+    auto notify = notifyLatency_.GetSummary();
+    char line[160] = { 0 }; // 160: longer than the line
+    int ret = snprintf(line, sizeof(line), "observers: %" PRIu64 " notifications, since the latest copy p50 %" PRIu64
+        "us p90 %" PRIu64 "us p99 %" PRIu64 "us max %" PRIu64 "us\n", notifications_.load(), notify.p50, notify.p90,
+        notify.p99, notify.max);
+    std::string result = ret > 0 ? std::string(line) : std::string();
+    result += "service calls:\n" + PasteboardPerfStat::GetInstance().DumpCallStats();
+    result += "service slow calls:\n" + PasteboardPerfStat::GetInstance().DumpSlowOps();
+    return result;
+}
+
+int32_t ServiceLoadTarget::SetPasteData(uint64_t bytes)
+{
+    const auto &tlv = GetPayload(bytes);
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(!tlv.empty(), static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR),
+        PASTEBOARD_MODULE_SERVICE, "encode load data failed");
+    // the same as PasteboardClient::WritePasteData
+    MessageParcelWarp messageData;
+    MessageParcel parcelData;
+    std::vector<uint8_t> buffer;
+    int fd = -1;
+    auto tlvSize = static_cast<int64_t>(tlv.size());
+    if (tlvSize > MIN_ASHMEM_DATA_SIZE) {
+        if (!messageData.WriteRawData(parcelData, tlv.data(), tlv.size())) {
+            return static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR);
+        }
+        fd = messageData.GetWriteDataFd();
+    } else {
+        fd = messageData.CreateTmpFd();
+        buffer = tlv;
+    }
+    PASTEBOARD_CHECK_AND_RETURN_RET_LOGE(fd >= 0, static_cast<int32_t>(PasteboardError::SERIALIZATION_ERROR),
+        PASTEBOARD_MODULE_SERVICE, "create fd failed");
+    lastSetUs_.store(NowUs(), std::memory_order_relaxed);
+    return proxy_->SetPasteDataOnly(fd, tlvSize, buffer);
+}
+
+int32_t ServiceLoadTarget::GetPasteData(uint32_t client)
+{
+    std::string pasteId = "GetPasteData_" + std::to_string(FakeEnvironment::GetPid(client)) + "_" +
+        std::to_string(sequence_.fetch_add(1));
+    int fd = -1;
+    int64_t size = 0;
+    std::vector<uint8_t> rawData;
+    int32_t syncTime = 0;
+    int32_t realErrCode = 0;
+    int32_t ret = proxy_->GetPasteData(fd, size, rawData, pasteId, syncTime, realErrCode);
+    if (ret == ERR_OK) {
+        ret = realErrCode;
+    }
+    PasteData data;
+    if (ret == static_cast<int32_t>(PasteboardError::E_OK)) {
+        bool decoded = false;
+        if (size > MIN_ASHMEM_DATA_SIZE && fd >= 0) {
+            void *ptr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            if (ptr != MAP_FAILED) {
+                const uint8_t *begin = reinterpret_cast<const uint8_t *>(ptr);
+                decoded = data.Decode(std::vector<uint8_t>(begin, begin + size));
+                ::munmap(ptr, size);
+            }
+        } else {
+            decoded = data.Decode(rawData);
+        }
+        ret = decoded ? ret : static_cast<int32_t>(PasteboardError::DESERIALIZATION_ERROR);
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+    return ret;
+}
+
+int32_t ServiceLoadTarget::Subscribe(uint32_t client)
+{
+    sptr<LoadObserver> observer;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto &item = observers_[client];
+        if (item == nullptr) {
+            item = sptr<LoadObserver>::MakeSptr(*this);
+        }
+        observer = item;
+    }
+    return proxy_->SubscribeObserver(PasteboardObserverType::OBSERVER_LOCAL, observer);
+}
+
+int32_t ServiceLoadTarget::Unsubscribe(uint32_t client)
+{
+    sptr<LoadObserver> observer;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = observers_.find(client);
+        if (it == observers_.end()) {
+            return ERR_OK;
+        }
+        observer = it->second;
+        observers_.erase(it);
+    }
+    return proxy_->UnsubscribeObserver(PasteboardObserverType::OBSERVER_LOCAL, observer);
+}
+
+const std::vector<uint8_t> &ServiceLoadTarget::GetPayload(uint64_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = payloads_.find(bytes);
+    if (it != payloads_.end()) {
+        return it->second;
+    }
+    PasteData data;
+    data.AddTextRecord(std::string(bytes, 'a'));
+    std::vector<uint8_t> tlv;
+    if (!data.Encode(tlv)) {
+        tlv.clear();
+    }
+    return payloads_.emplace(bytes, std::move(tlv)).first->second;
+}
+} // namespace OHOS::MiscServices
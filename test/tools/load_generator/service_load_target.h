@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_TEST_TOOLS_SERVICE_LOAD_TARGET_H
+#define PASTEBOARD_TEST_TOOLS_SERVICE_LOAD_TARGET_H
+
+#include <map>
+#include <mutex>
+
+#include "ipasteboard_service.h"
+#include "load_runner.h"
+#include "pasteboard_observer.h"
+
+namespace OHOS::MiscServices {
+class PasteboardService;
+
+/*
+ * Drives an in-process PasteboardService through the generated service proxy, so every call is marshalled and goes
+ * through OnRemoteRequest, CallbackEnter and CallbackExit as it does on a device, without binder and samgr.
+ */
+class ServiceLoadTarget : public LoadTarget {
+public:
+    ServiceLoadTarget();
+    ~ServiceLoadTarget() override;
+
+    void BindClient(uint32_t client) override;
+    int32_t Execute(const LoadTrace::Op &op) override;
+    std::string Dump() const override;
+
+private:
+    class LoadObserver : public PasteboardObserver {
+    public:
+        explicit LoadObserver(ServiceLoadTarget &target) : target_(target) {}
+        void OnPasteboardChanged() override;
+
+    private:
+        ServiceLoadTarget &target_;
+    };
+
+    int32_t SetPasteData(uint64_t bytes);
+    int32_t GetPasteData(uint32_t client);
+    int32_t Subscribe(uint32_t client);
+    int32_t Unsubscribe(uint32_t client);
+    const std::vector<uint8_t> &GetPayload(uint64_t bytes);
+
+    sptr<PasteboardService> service_;
+    sptr<IPasteboardService> proxy_;
+    std::mutex mutex_;
+    std::map<uint64_t, std::vector<uint8_t>> payloads_;
+    std::map<uint32_t, sptr<LoadObserver>> observers_;
+    std::atomic<uint32_t> sequence_ = 0;
+    std::atomic<uint64_t> lastSetUs_ = 0;
+    std::atomic<uint64_t> notifications_ = 0;
+    LatencyHistogram notifyLatency_;
+};
+} // namespace OHOS::MiscServices
+#endif // PASTEBOARD_TEST_TOOLS_SERVICE_LOAD_TARGET_H
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paste_timeline.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+namespace OHOS::MiscServices {
+namespace {
+constexpr const char *MARK_WRITE = "tracing_mark_write: ";
+constexpr const char *SPAN_PREFIX = "Paste[";
+constexpr const char *SPAN_SEPARATOR = "] ";
+constexpr const char *TAG_PREFIX = "H:";
+constexpr int64_t US_PER_SECOND = 1000000;
+constexpr size_t MIN_MARKER_FIELDS = 4; // type|pid|name|taskId, newer formats append more fields
+constexpr size_t FRACTION_DIGITS = 6;
+constexpr int DECIMAL = 10;
+constexpr double US_PER_MS = 1000.0;
+
+std::vector<std::string> Split(const std::string &value, char separator)
+{
+    std::vector<std::string> fields;
+    size_t begin = 0;
+    while (true) {
+        size_t end = value.find(separator, begin);
+        fields.push_back(value.substr(begin, end == std::string::npos ? std::string::npos : end - begin));
+        if (end == std::string::npos) {
+            return fields;
+        }
+        begin = end + 1;
+    }
+}
+
+bool ParseInt(const std::string &value, int64_t &result)
+{
+    if (value.empty()) {
+        return false;
+    }
+    char *end = nullptr;
+    result = std::strtoll(value.c_str(), &end, DECIMAL);
+    return end != nullptr && *end == '\0';
+}
+
+std::string FormatMs(int64_t us)
+{
+    char buffer[32] = { 0 }; // 32: enough for any int64 in milliseconds
+    int ret = snprintf(buffer, sizeof(buffer), "%.3fms", static_cast<double>(us) / US_PER_MS);
+    return ret > 0 ? std::string(buffer) : std::to_string(us) + "us";
+}
+} // namespace
+
+bool PasteTimeline::AddLine(const std::string &line)
+{
+    Marker marker;
+    if (!ParseMarker(line, marker)) {
+        return false;
+    }
+    std::string key = marker.pasteId + "\n" + marker.stage + "\n" + std::to_string(marker.taskId);
+    if (marker.isBegin) {
+        Span span;
+        span.stage = marker.stage;
+        span.thread = marker.thread;
+        span.pid = marker.pid;
+        span.beginUs = marker.timeUs;
+        openSpans_[key].push_back(spans_.size());
+        spans_.emplace_back(marker.pasteId, std::move(span));
+        return true;
+    }
+    auto it = openSpans_.find(key);
+    if (it == openSpans_.end() || it->second.empty()) {
+        // the begin marker was before the capture started
+        return true;
+    }
+    spans_[it->second.back()].second.endUs = marker.timeUs;
+    it->second.pop_back();
+    return true;
+}
+
+std::vector<PasteTimeline::Timeline> PasteTimeline::Build() const
+{
+    std::map<std::string, Timeline> timelines;
+    for (const auto &[pasteId, span] : spans_) {
+        auto &timeline = timelines[pasteId];
+        timeline.pasteId = pasteId;
+        timeline.spans.push_back(span);
+    }
+    std::vector<Timeline> result;
+    for (auto &[pasteId, timeline] : timelines) {
+        auto getEnd = [](const Span &span) {
+            return span.endUs == UNFINISHED ? INT64_MAX : span.endUs;
+        };
+        std::sort(timeline.spans.begin(), timeline.spans.end(), [&getEnd](const Span &lhs, const Span &rhs) {
+            return lhs.beginUs != rhs.beginUs ? lhs.beginUs < rhs.beginUs : getEnd(lhs) > getEnd(rhs);
+        });
+        std::vector<int64_t> enclosing;
+        for (auto &span : timeline.spans) {
+            while (!enclosing.empty() && enclosing.back() < getEnd(span)) {
+                enclosing.pop_back();
+            }
+            span.depth = static_cast<uint32_t>(enclosing.size());
+            enclosing.push_back(getEnd(span));
+        }
+        result.push_back(std::move(timeline));
+    }
+    std::sort(result.begin(), result.end(), [](const Timeline &lhs, const Timeline &rhs) {
+        return lhs.spans.front().beginUs < rhs.spans.front().beginUs;
+    });
+    return result;
+}
+
+std::string PasteTimeline::Format(const Timeline &timeline)
+{
+    if (timeline.spans.empty()) {
+        return "";
+    }
+    int64_t start = timeline.spans.front().beginUs;
+    int64_t end = start;
+    for (const auto &span : timeline.spans) {
+        end = std::max(end, span.endUs);
+    }
+    std::string result = "Paste " + timeline.pasteId + ":  " + FormatMs(end - start) + ", " +
+        std::to_string(timeline.spans.size()) + " spans\n";
+    for (const auto &span : timeline.spans) {
+        std::string offset = "+" + FormatMs(span.beginUs - start);
+        std::string cost = span.endUs == UNFINISHED ? "unfinished" : FormatMs(span.endUs - span.beginUs);
+        char prefix[64] = { 0 }; // 64: room for both columns
+        if (snprintf(prefix, sizeof(prefix), "  %12s %12s  ", offset.c_str(), cost.c_str()) < 0) {
+            continue;
+        }
+        result.append(prefix)
+            .append(std::string(span.depth * 2, ' ')) // 2: indent of each nested level
+            .append(span.stage)
+            .append("  [")
+            .append(span.thread)
+            .append(" pid ")
+            .append(std::to_string(span.pid))
+            .append("]\n");
+    }
+    return result;
+}
+
+bool PasteTimeline::ParseMarker(const std::string &line, Marker &marker)
+{
+    size_t markPos = line.find(MARK_WRITE);
+    if (markPos == std::string::npos) {
+        return false;
+    }
+    std::string payload = line.substr(markPos + std::char_traits<char>::length(MARK_WRITE));
+    payload.erase(payload.find_last_not_of(" \r\n") + 1);
+    auto fields = Split(payload, '|');
+    if (fields.size() < MIN_MARKER_FIELDS || (fields[0] != "S" && fields[0] != "F")) {
+        return false;
+    }
+    std::string name = fields[2]; // 2: index of the span name
+    if (name.compare(0, std::char_traits<char>::length(TAG_PREFIX), TAG_PREFIX) == 0) {
+        name.erase(0, std::char_traits<char>::length(TAG_PREFIX));
+    }
+    size_t prefixLen = std::char_traits<char>::length(SPAN_PREFIX);
+    size_t separator = name.find(SPAN_SEPARATOR, prefixLen);
+    if (name.compare(0, prefixLen, SPAN_PREFIX) != 0 || separator == std::string::npos) {
+        return false;
+    }
+    int64_t pid = 0;
+    int64_t taskId = 0;
+    if (!ParseInt(fields[1], pid) || !ParseInt(fields[3], taskId) || // 3: index of the task id
+        !ParseTimeUs(line, markPos, marker.timeUs)) {
+        return false;
+    }
+    marker.isBegin = fields[0] == "S";
+    marker.pasteId = name.substr(prefixLen, separator - prefixLen);
+    marker.stage = name.substr(separator + std::char_traits<char>::length(SPAN_SEPARATOR));
+    marker.pid = static_cast<int32_t>(pid);
+    marker.taskId = static_cast<int32_t>(taskId);
+    marker.thread = ParseThread(line);
+    return !marker.pasteId.empty();
+}
+
+bool PasteTimeline::ParseTimeUs(const std::string &line, size_t markPos, int64_t &timeUs)
+{
+    // "<thread>-<tid> (<pid>) [<cpu>] <flags> <seconds>.<micros>: tracing_mark_write: ..."
+    size_t colon = line.rfind(':', markPos);
+    if (colon == std::string::npos || colon == 0) {
+        return false;
+    }
+    size_t begin = line.rfind(' ', colon - 1);
+    begin = begin == std::string::npos ? 0 : begin + 1;
+    std::string timestamp = line.substr(begin, colon - begin);
+    size_t dot = timestamp.find('.');
+    int64_t seconds = 0;
+    if (!ParseInt(timestamp.substr(0, dot), seconds)) {
+        return false;
+    }
+    int64_t fraction = 0;
+    if (dot != std::string::npos) {
+        std::string digits = timestamp.substr(dot + 1, FRACTION_DIGITS);
+        digits.append(FRACTION_DIGITS - digits.size(), '0');
+        if (!ParseInt(digits, fraction)) {
+            return false;
+        }
+    }
+    timeUs = seconds * US_PER_SECOND + fraction;
+    return true;
+}
+
+std::string PasteTimeline::ParseThread(const std::string &line)
+{
+    size_t begin = line.find_first_not_of(' ');
+    if (begin == std::string::npos) {
+        return "";
+    }
+    // the pid column in parentheses is optional, the cpu column in brackets is not
+    size_t end = std::min(line.find(" (", begin), line.find(" [", begin));
+    std::string thread = line.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+    size_t tid = thread.rfind('-');
+    return tid == std::string::npos ? thread : thread.substr(0, tid);
+}
+} // namespace OHOS::MiscServices
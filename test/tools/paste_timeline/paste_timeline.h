@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PASTEBOARD_TEST_TOOLS_PASTE_TIMELINE_H
+#define PASTEBOARD_TEST_TOOLS_PASTE_TIMELINE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace OHOS::MiscServices {
+/*
+ * Rebuilds the timeline of each paste from the "Paste[<pasteId>] <stage>" async spans of a captured trace, such as
+ * the output of "hitrace -t 10 misc -o <file>".
+ */
+class PasteTimeline {
+public:
+    static constexpr int64_t UNFINISHED = -1;
+    struct Span {
+        std::string stage;
+        std::string thread;
+        int32_t pid = 0;
+        int64_t beginUs = 0;
+        int64_t endUs = UNFINISHED;
+        uint32_t depth = 0;
+    };
+    struct Timeline {
+        std::string pasteId;
+        std::vector<Span> spans; // sorted by begin time, an enclosing span comes before the spans it encloses
+    };
+
+    // returns true when the line is a begin or end marker of a paste span
+    bool AddLine(const std::string &line);
+    std::vector<Timeline> Build() const;
+    static std::string Format(const Timeline &timeline);
+
+private:
+    struct Marker {
+        bool isBegin = false;
+        std::string pasteId;
+        std::string stage;
+        std::string thread;
+        int32_t pid = 0;
+        int32_t taskId = 0;
+        int64_t timeUs = 0;
+    };
+    static bool ParseMarker(const std::string &line, Marker &marker);
+    static bool ParseTimeUs(const std::string &line, size_t markPos, int64_t &timeUs);
+    static std::string ParseThread(const std::string &line);
+
+    // spans still open, keyed by paste id, stage and task id
+    std::map<std::string, std::vector<size_t>> openSpans_;
+    std::vector<std::pair<std::string, Span>> spans_;
+};
+} // namespace OHOS::MiscServices
+#endif // PASTEBOARD_TEST_TOOLS_PASTE_TIMELINE_H
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fstream>
+#include <iostream>
+
+#include "paste_timeline.h"
+
+using namespace OHOS::MiscServices;
+
+/*
+ * Usage: paste_timeline <trace file> [pasteId]
+ * Capture the trace with "hitrace -b 20480 -t 10 misc -o <trace file>" while pasting. A trace of each device can be
+ * given in turn, the clocks of different devices are not aligned.
+ */
+int main(int argc, char *argv[])
+{
+    constexpr int MIN_ARGC = 2;
+    constexpr int PASTE_ID_ARG = 2;
+    if (argc < MIN_ARGC) {
+        std::cerr << "usage: " << argv[0] << " <trace file> [pasteId]" << std::endl;
+        return 1;
+    }
+    std::ifstream file(argv[1]);
+    if (!file.is_open()) {
+        std::cerr << "can not open " << argv[1] << std::endl;
+        return 1;
+    }
+    PasteTimeline builder;
+    std::string line;
+    while (std::getline(file, line)) {
+        builder.AddLine(line);
+    }
+    std::string pasteId = argc > PASTE_ID_ARG ? argv[PASTE_ID_ARG] : "";
+    size_t count = 0;
+    for (const auto &timeline : builder.Build()) {
+        if (!pasteId.empty() && timeline.pasteId != pasteId) {
+            continue;
+        }
+        std::cout << PasteTimeline::Format(timeline) << std::endl;
+        count++;
+    }
+    if (count == 0) {
+        std::cerr << "no paste span found" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "paste_timeline.h"
+
+namespace OHOS::MiscServices {
+using namespace testing::ext;
+namespace {
+const std::vector<std::string> TEST_TRACE = {
+    "  com.example.app-4321  ( 4321) [001] .... 100.000100: tracing_mark_write: "
+    "S|4321|Paste[GetPasteData_4321_0] PasteboardClient::GetPasteData|11",
+    "  com.example.app-4321  ( 4321) [001] .... 100.000200: tracing_mark_write: "
+    "S|4321|Paste[GetPasteData_4321_0] IPC GetPasteData|11",
+    "  PasteboardServi-1234  ( 1234) [002] .... 100.000300: tracing_mark_write: "
+    "S|1234|H:Paste[GetPasteData_4321_0] PasteboardService::GetPasteData|11|M62",
+    "  PasteboardServi-1234  ( 1234) [002] .... 100.000400: tracing_mark_write: B|1234|H:GetLocalData",
+    "  PasteboardServi-1234  ( 1234) [002] .... 100.002300: tracing_mark_write: "
+    "F|1234|H:Paste[GetPasteData_4321_0] PasteboardService::GetPasteData|11|M62",
+    "  com.example.app-4321  ( 4321) [001] .... 100.002400: tracing_mark_write: "
+    "F|4321|Paste[GetPasteData_4321_0] IPC GetPasteData|11",
+    "  com.example.app-4321  ( 4321) [001] .... 100.002500: tracing_mark_write: "
+    "S|4321|Paste[GetPasteData_4321_0] DecodePasteData|11\r",
+    "  com.example.app-4321  ( 4321) [001] .... 100.003000: tracing_mark_write: "
+    "F|4321|Paste[GetPasteData_4321_0] DecodePasteData|11\r",
+    "  com.example.app-4321  ( 4321) [001] .... 100.003100: tracing_mark_write: "
+    "F|4321|Paste[GetPasteData_4321_0] PasteboardClient::GetPasteData|11",
+    "  com.example.app-4321  ( 4321) [001] .... 101.000000: tracing_mark_write: "
+    "S|4321|Paste[GetPasteData_4321_1] PasteboardClient::GetPasteData|12",
+};
+} // namespace
+
+class PasteTimelineTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void PasteTimelineTest::SetUpTestCase(void) {}
+
+void PasteTimelineTest::TearDownTestCase(void) {}
+
+void PasteTimelineTest::SetUp(void) {}
+
+void PasteTimelineTest::TearDown(void) {}
+
+/**
+ * @tc.name: BuildTest001
+ * @tc.desc: Test the spans of each paste are grouped, matched and nested.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteTimelineTest, BuildTest001, TestSize.Level0)
+{
+    PasteTimeline builder;
+    size_t markers = 0;
+    for (const auto &line : TEST_TRACE) {
+        markers += builder.AddLine(line) ? 1 : 0;
+    }
+    EXPECT_EQ(markers, TEST_TRACE.size() - 1);
+
+    auto timelines = builder.Build();
+    ASSERT_EQ(timelines.size(), 2);
+    const auto &first = timelines[0];
+    EXPECT_EQ(first.pasteId, "GetPasteData_4321_0");
+    ASSERT_EQ(first.spans.size(), 4);
+    EXPECT_EQ(first.spans[0].stage, "PasteboardClient::GetPasteData");
+    EXPECT_EQ(first.spans[0].depth, 0);
+    EXPECT_EQ(first.spans[0].endUs - first.spans[0].beginUs, 3000);
+    EXPECT_EQ(first.spans[0].thread, "com.example.app");
+    EXPECT_EQ(first.spans[1].stage, "IPC GetPasteData");
+    EXPECT_EQ(first.spans[1].depth, 1);
+    EXPECT_EQ(first.spans[2].stage, "PasteboardService::GetPasteData");
+    EXPECT_EQ(first.spans[2].depth, 2);
+    EXPECT_EQ(first.spans[2].pid, 1234);
+    EXPECT_EQ(first.spans[2].endUs - first.spans[2].beginUs, 2000);
+    EXPECT_EQ(first.spans[3].stage, "DecodePasteData");
+    EXPECT_EQ(first.spans[3].depth, 1);
+
+    const auto &second = timelines[1];
+    EXPECT_EQ(second.pasteId, "GetPasteData_4321_1");
+    ASSERT_EQ(second.spans.size(), 1);
+    EXPECT_EQ(second.spans[0].endUs, PasteTimeline::UNFINISHED);
+}
+
+/**
+ * @tc.name: FormatTest001
+ * @tc.desc: Test a timeline is formatted with offsets, costs and the process of each span.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(PasteTimelineTest, FormatTest001, TestSize.Level0)
+{
+    PasteTimeline builder;
+    for (const auto &line : TEST_TRACE) {
+        builder.AddLine(line);
+    }
+    auto timelines = builder.Build();
+    ASSERT_EQ(timelines.size(), 2);
+    std::string output = PasteTimeline::Format(timelines[0]);
+    EXPECT_NE(output.find("Paste GetPasteData_4321_0:  3.000ms, 4 spans"), std::string::npos);
+    EXPECT_NE(output.find("+0.200ms"), std::string::npos);
+    EXPECT_NE(output.find("    PasteboardService::GetPasteData  [PasteboardServi pid 1234]"), std::string::npos);
+    EXPECT_NE(PasteTimeline::Format(timelines[1]).find("unfinished"), std::string::npos);
+}
+} // namespace OHOS::MiscServices